@@ -35,6 +35,108 @@ bash "examples/sdkl_npu_mm_u8i8_i32/build.sh" --arm-arch armv8 --cpu-os qclinux
 
 bash "examples/sdkl_npu_mm_u8i8_i32/build.sh" --arm-arch armv9 --cpu-os android26
 
+bash "examples/sdkl_weights/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_weights/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_weights/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_async/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_async/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_async/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_batched/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_batched/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_batched/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_grouped_mm/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_grouped_mm/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_grouped_mm/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_epilogue/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_epilogue/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_epilogue/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_quant/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_quant/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_quant/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_nd/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_nd/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_nd/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_npu_register_buffer/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_npu_register_buffer/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_npu_register_buffer/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_npu_pool/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_npu_pool/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_npu_pool/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_sharded/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_sharded/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_sharded/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_hetero/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_hetero/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_hetero/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_autotune/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_tensor_autotune/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_tensor_autotune/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_mm_plan/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_mm_plan/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_mm_plan/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_trace/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_trace/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_trace/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_stats/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_stats/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_stats/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_bench/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_bench/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_bench/build.sh" --arm-arch armv9 --cpu-os android26
+
+bash "examples/sdkl_gemv/build.sh" --arm-arch armv8 --cpu-os android26
+
+bash "examples/sdkl_gemv/build.sh" --arm-arch armv8 --cpu-os qclinux
+
+bash "examples/sdkl_gemv/build.sh" --arm-arch armv9 --cpu-os android26
+
 bash "examples/hexkl_micro_hmx_mm_u8i4_i32/build.sh" --hex-arch v73
 
 bash "examples/hexkl_micro_hmx_mm_u8i4_i32/build.sh" --hex-arch v75
@@ -59,3 +161,44 @@ bash "examples/hexkl_macro_mm_f16/build.sh" --hex-arch v75
 
 bash "examples/hexkl_macro_mm_f16/build.sh" --hex-arch v79
 
+bash "examples/hexkl_macro_ext_mm_epilogue/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_mm_epilogue/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_mm_epilogue/build.sh" --hex-arch v79
+
+bash "examples/hexkl_macro_ext_mm_multi/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_mm_multi/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_mm_multi/build.sh" --hex-arch v79
+
+bash "examples/hexkl_macro_ext_mm_sched/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_mm_sched/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_mm_sched/build.sh" --hex-arch v79
+
+bash "examples/hexkl_macro_ext_vtcm/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_vtcm/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_vtcm/build.sh" --hex-arch v79
+
+bash "examples/hexkl_macro_ext_mm_dma/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_mm_dma/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_mm_dma/build.sh" --hex-arch v79
+
+bash "examples/hexkl_macro_ext_mm_chain/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_mm_chain/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_mm_chain/build.sh" --hex-arch v79
+
+bash "examples/hexkl_macro_ext_acc_slots/build.sh" --hex-arch v73
+
+bash "examples/hexkl_macro_ext_acc_slots/build.sh" --hex-arch v75
+
+bash "examples/hexkl_macro_ext_acc_slots/build.sh" --hex-arch v79
@@ -0,0 +1,399 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define MAX_VAL (5U) // Random values are in [0, MAX_VAL]
+#define N_ROW   (128U)
+#define N_COL   (64U)
+#define N_INNER (512U)
+#define N_SPLIT (4U) // Inner dimension split into N_SPLIT panels of weight tiles
+
+#define N_KTILES  (N_INNER / HEXKL_HMX_INT8_BLOCK_N_INNER)
+#define N_RBLOCKS (N_ROW / HEXKL_HMX_INT8_BLOCK_N_ROW)
+#define N_CBLOCKS (N_COL / HEXKL_HMX_INT8_BLOCK_N_COL)
+#define N_SPLIT_K (N_KTILES / N_SPLIT)
+
+#define INT8_WEIGHT_TILE_BYTES (HEXKL_HMX_INT8_BLOCK_N_INNER * HEXKL_HMX_INT8_BLOCK_N_COL)
+#define F16_TILE_BYTES         (HEXKL_HMX_F16_BLOCK_N_ROW * HEXKL_HMX_F16_BLOCK_N_COL * sizeof(_Float16))
+
+#define F16_N_KTILES (8U)
+
+/*!
+  @brief
+  Compares HEXKL MICRO API result vs Standard C reference.
+*/
+int hexkl_vector_check_i32(size_t size, const int32_t* ref, const int32_t* vec) {
+  for (size_t i = 0; i < size; i++) {
+    if (ref[i] != vec[i]) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %ld vec[%ld] = %ld\n", (long)i, (long)ref[i], (long)i, (long)vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+/*!
+ @brief
+ Reference Standard C code
+*/
+static void matmul_u8i8_ref(
+  uint32_t n_row,
+  uint32_t n_inner,
+  uint32_t n_col,
+  int32_t* restrict A,
+  const uint8_t* restrict X,
+  const int8_t* restrict W
+) {
+  for (uint32_t row = 0; row < n_row; row++) {
+    for (uint32_t col = 0; col < n_col; col++) {
+      int32_t acc = 0;
+      for (uint32_t k = 0; k < n_inner; k++) {
+        acc += (int32_t)X[row * n_inner + k] * (int32_t)W[k * n_col + col];
+      }
+      A[row * n_col + col] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Split-K int8 matrix multiplication on the micro API. The inner dimension is split into N_SPLIT parts; for each
+  part, the weight tiles of all column blocks are converted once into a resident panel, and every output tile in
+  turn resumes its accumulation from its slot, multiplies the tiles of the part and is spilled back. The slots hold
+  the results at the end.
+*/
+static int matmul_u8i8_i32_split_k(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  int32_t* A,
+  const uint8_t* X,
+  const int8_t* W
+) {
+  uint32_t act_offsets[N_SPLIT_K];
+  uint32_t wt_offsets[N_SPLIT_K];
+  uint32_t slot_offsets[N_RBLOCKS][N_CBLOCKS];
+  uint32_t config_offset, act_offset, weight_offset, scratch_offset;
+  hexkl_vtcm_arena_t arena;
+  int res;
+
+  res = hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &config_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_ACTIVATION, N_SPLIT_K * HEXKL_HMX_ACTIVATION_ALIGNMENT, &act_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_ACTIVATION, HEXKL_MACRO_EXT_ACC_SLOT_INT32_BYTES, &scratch_offset
+    );
+  }
+  for (uint32_t rb = 0; rb < N_RBLOCKS; rb++) {
+    for (uint32_t cb = 0; res == AEE_SUCCESS && cb < N_CBLOCKS; cb++) {
+      res = hexkl_macro_ext_vtcm_alloc(
+        &arena, HEXKL_VTCM_ACTIVATION, HEXKL_MACRO_EXT_ACC_SLOT_INT32_BYTES, &slot_offsets[rb][cb]
+      );
+      if (res == AEE_SUCCESS) {
+        res = hexkl_macro_ext_hmx_acc_slot_init_int32(vtcm_base, slot_offsets[rb][cb]);
+      }
+    }
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_WEIGHTS, N_CBLOCKS * N_SPLIT_K * INT8_WEIGHT_TILE_BYTES, &weight_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_setup_acc_read_int32(vtcm_base, config_offset);
+  }
+  for (uint32_t i = 0; i < N_SPLIT_K; i++) {
+    act_offsets[i] = act_offset + i * HEXKL_HMX_ACTIVATION_ALIGNMENT;
+  }
+
+  for (uint32_t part = 0; res == AEE_SUCCESS && part < N_SPLIT; part++) {
+    uint32_t kt0 = part * N_SPLIT_K;
+
+    // Weight panel of this part, resident for every output tile
+    for (uint32_t cb = 0; cb < N_CBLOCKS; cb++) {
+      for (uint32_t i = 0; res == AEE_SUCCESS && i < N_SPLIT_K; i++) {
+        res = hexkl_micro_hmx_rm_to_wh_i8(
+          vtcm_base, weight_offset + (cb * N_SPLIT_K + i) * INT8_WEIGHT_TILE_BYTES, W, kt0 + i, cb, N_COL
+        );
+      }
+    }
+
+    for (uint32_t rb = 0; res == AEE_SUCCESS && rb < N_RBLOCKS; rb++) {
+      for (uint32_t i = 0; res == AEE_SUCCESS && i < N_SPLIT_K; i++) {
+        res = hexkl_micro_hmx_copy_submatrix_to_8b_activation(
+          vtcm_base, act_offsets[i], X, rb, kt0 + i, N_ROW, N_INNER
+        );
+      }
+
+      for (uint32_t cb = 0; res == AEE_SUCCESS && cb < N_CBLOCKS; cb++) {
+        for (uint32_t i = 0; i < N_SPLIT_K; i++) {
+          wt_offsets[i] = weight_offset + (cb * N_SPLIT_K + i) * INT8_WEIGHT_TILE_BYTES;
+        }
+        res = hexkl_macro_ext_hmx_acc_restore_int32(vtcm_base, slot_offsets[rb][cb]);
+        if (res == AEE_SUCCESS) {
+          res = hexkl_macro_ext_hmx_mm_u8i8_chain(vtcm_base, act_offsets, wt_offsets, N_SPLIT_K);
+        }
+        if (res == AEE_SUCCESS) {
+          res = hexkl_macro_ext_hmx_acc_save_int32(vtcm_base, config_offset, slot_offsets[rb][cb], scratch_offset);
+        }
+      }
+    }
+  }
+
+  for (uint32_t rb = 0; rb < N_RBLOCKS; rb++) {
+    for (uint32_t cb = 0; res == AEE_SUCCESS && cb < N_CBLOCKS; cb++) {
+      res = hexkl_micro_hmx_copy_32b_to_submatrix(vtcm_base, slot_offsets[rb][cb], A, rb, cb, N_ROW, N_COL);
+    }
+  }
+  return res;
+}
+
+/*!
+  @brief
+  Accumulates F16_N_KTILES pairs of random FP16 tiles without interruption, then again with the accumulation spilled
+  to a slot halfway while another slot accumulates other pairs, and checks that both read out the same bits.
+*/
+static int check_f16_slots(uint8_t* vtcm_base, uint32_t vtcm_size) {
+  uint32_t act_offsets[F16_N_KTILES];
+  uint32_t wt_offsets[F16_N_KTILES];
+  uint32_t config_offset, stage_offset, ref_offset, slot_offset, other_offset;
+  uint32_t half = F16_N_KTILES / 2;
+  _Float16* W   = NULL;
+  hexkl_vtcm_arena_t arena;
+  int res;
+
+  W = malloc(F16_N_KTILES * F16_TILE_BYTES);
+  if (W == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  for (uint32_t i = 0; i < F16_N_KTILES * F16_TILE_BYTES / sizeof(_Float16); i++) {
+    W[i] = (_Float16)((float)rand() / (float)RAND_MAX - 0.5f);
+  }
+
+  res = hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &config_offset);
+  }
+  for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &act_offsets[kt]);
+  }
+  for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, F16_TILE_BYTES, &wt_offsets[kt]);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &stage_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &ref_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_ACTIVATION, HEXKL_MACRO_EXT_ACC_SLOT_F16_BYTES, &slot_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_ACTIVATION, HEXKL_MACRO_EXT_ACC_SLOT_F16_BYTES, &other_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_setup_acc_read_f16(vtcm_base, config_offset);
+  }
+
+  // Activation tiles: the weight matrix itself, one 32x32 tile per inner tile
+  for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+    res = hexkl_micro_hmx_copy_submatrix_to_f16(
+      vtcm_base, stage_offset, W, kt, 0, F16_N_KTILES * HEXKL_HMX_F16_BLOCK_N_ROW, HEXKL_HMX_F16_BLOCK_N_COL
+    );
+    if (res == AEE_SUCCESS) {
+      res = hexkl_micro_hmx_rm_to_ah_f16(vtcm_base, act_offsets[kt], stage_offset);
+    }
+    if (res == AEE_SUCCESS) {
+      res = hexkl_micro_hmx_rm_to_wh_f16(vtcm_base, wt_offsets[kt], W, kt, 0, HEXKL_HMX_F16_BLOCK_N_COL);
+    }
+  }
+
+  // Uninterrupted
+  if (res == AEE_SUCCESS) {
+    hexkl_micro_hmx_acc_clear_f16();
+    res = hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act_offsets, wt_offsets, F16_N_KTILES);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_acc_read_f16(vtcm_base, config_offset, ref_offset);
+  }
+
+  // First half, another accumulation in between, second half
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_slot_init_f16(vtcm_base, slot_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_slot_init_f16(vtcm_base, other_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_restore_f16(vtcm_base, slot_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act_offsets, wt_offsets, half);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_save_f16(vtcm_base, config_offset, slot_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_restore_f16(vtcm_base, other_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act_offsets + half, wt_offsets, half);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_save_f16(vtcm_base, config_offset, other_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_restore_f16(vtcm_base, slot_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act_offsets + half, wt_offsets + half, F16_N_KTILES - half);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_hmx_acc_save_f16(vtcm_base, config_offset, slot_offset);
+  }
+  if (res == AEE_SUCCESS && memcmp(vtcm_base + ref_offset, vtcm_base + slot_offset, F16_TILE_BYTES) != 0) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Interrupted FP16 accumulation differs from the uninterrupted one\n");
+    res = AEE_EFAILED;
+  }
+
+  free(W);
+  return res;
+}
+
+char version[256];
+
+int main() {
+  int res            = AEE_SUCCESS;
+  int res2           = AEE_SUCCESS;
+  uint8_t* vtcm_base = NULL;
+  uint32_t vtcm_size = 0;
+  int major          = 0;
+  int minor          = 0;
+  int patch          = 0;
+  int hex_version    = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  uint8_t* X     = NULL;
+  int8_t* W      = NULL;
+  int32_t* A     = NULL;
+  int32_t* A_ref = NULL;
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  srand(42);
+  X     = malloc(N_ROW * N_INNER * sizeof(uint8_t));
+  W     = malloc(N_INNER * N_COL * sizeof(int8_t));
+  A     = malloc(N_ROW * N_COL * sizeof(int32_t));
+  A_ref = malloc(N_ROW * N_COL * sizeof(int32_t));
+  if (X == NULL || W == NULL || A == NULL || A_ref == NULL) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Allocation failed\n");
+    res = AEE_ENOMEMORY;
+    goto TEST_END;
+  }
+  for (uint32_t i = 0; i < N_ROW * N_INNER; i++) {
+    X[i] = (uint8_t)(rand() % (MAX_VAL + 1));
+  }
+  for (uint32_t i = 0; i < N_INNER * N_COL; i++) {
+    W[i] = (int8_t)(rand() % (2 * MAX_VAL + 1) - (int)MAX_VAL);
+  }
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  /* -------  Split-K int8 matmul rotating through the output tiles ------*/
+  matmul_u8i8_ref(N_ROW, N_INNER, N_COL, A_ref, X, W);
+  res = matmul_u8i8_i32_split_k(vtcm_base, vtcm_size, A, X, W);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_i32(N_ROW * N_COL, A_ref, A);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Split-K int8 matmul failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Split-K int8 matmul over %u parts OK\n", N_SPLIT);
+
+  /* -------  Interrupted FP16 accumulation ------*/
+  res = check_f16_slots(vtcm_base, vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP16 slots failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] FP16 slots OK\n");
+
+  /* -------  Argument checks ------*/
+  if (hexkl_macro_ext_hmx_acc_slot_init_int32(NULL, 0) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_acc_restore_int32(vtcm_base, 64) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_acc_save_int32(vtcm_base, 0, 0, 64) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_acc_slot_init_f16(vtcm_base, 64) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_acc_restore_f16(NULL, 0) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_acc_save_f16(vtcm_base, 0, 64) != AEE_EBADPARM) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Invalid arguments accepted\n");
+    res = AEE_EFAILED;
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Invalid arguments rejected OK\n");
+
+TEST_END:
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  free(X);
+  free(W);
+  free(A);
+  free(A_ref);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
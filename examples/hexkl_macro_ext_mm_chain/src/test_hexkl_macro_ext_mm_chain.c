@@ -0,0 +1,410 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "HAP_perf.h"
+#include "remote.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define MAX_VAL (5U) // Random values are in [0, MAX_VAL]
+#define N_ROW   (256U)
+#define N_COL   (64U)
+#define N_INNER (1024U) // Chains of 32 tile pairs
+
+#define N_KTILES (N_INNER / HEXKL_HMX_INT8_BLOCK_N_INNER)
+
+#define INT8_WEIGHT_TILE_BYTES (HEXKL_HMX_INT8_BLOCK_N_INNER * HEXKL_HMX_INT8_BLOCK_N_COL)
+#define INT32_ACC_TILE_BYTES   (HEXKL_HMX_INT8_BLOCK_N_ROW * HEXKL_HMX_INT8_BLOCK_N_COL * sizeof(int32_t))
+#define F16_TILE_BYTES         (HEXKL_HMX_F16_BLOCK_N_ROW * HEXKL_HMX_F16_BLOCK_N_COL * sizeof(_Float16))
+
+#define F16_N_KTILES (16U)
+
+/*!
+  @brief
+  Compares HEXKL MICRO API result vs Standard C reference.
+*/
+int hexkl_vector_check_i32(size_t size, const int32_t* ref, const int32_t* vec) {
+  for (size_t i = 0; i < size; i++) {
+    if (ref[i] != vec[i]) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %ld vec[%ld] = %ld\n", (long)i, (long)ref[i], (long)i, (long)vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+/*!
+ @brief
+ Reference Standard C code
+*/
+static void matmul_u8i8_ref(
+  uint32_t n_row,
+  uint32_t n_inner,
+  uint32_t n_col,
+  int32_t* restrict A,
+  const uint8_t* restrict X,
+  const int8_t* restrict W
+) {
+  for (uint32_t row = 0; row < n_row; row++) {
+    for (uint32_t col = 0; col < n_col; col++) {
+      int32_t acc = 0;
+      for (uint32_t k = 0; k < n_inner; k++) {
+        acc += (int32_t)X[row * n_inner + k] * (int32_t)W[k * n_col + col];
+      }
+      A[row * n_col + col] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  int8 matrix multiplication on the micro API with all weight tiles resident in VTCM, converted to WH layout once.
+  Each accumulation over the inner tiles is issued as one chain if `chain`, or as one `hexkl_micro_hmx_mm_u8i8()`
+  call per tile pair otherwise. Adds the QTimer ticks spent in the multiplications to `*mm_ticks`.
+*/
+static int matmul_u8i8_i32(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  bool chain,
+  int32_t* A,
+  const uint8_t* X,
+  const int8_t* W,
+  uint64_t* mm_ticks
+) {
+  uint32_t n_cblocks = N_COL / HEXKL_HMX_INT8_BLOCK_N_COL;
+  uint32_t act_offsets[N_KTILES];
+  uint32_t wt_offsets[N_KTILES];
+  uint32_t config_offset, act_offset, result_offset, weight_offset;
+  hexkl_vtcm_arena_t arena;
+  int res;
+
+  res = hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &config_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_ACTIVATION, N_KTILES * HEXKL_HMX_ACTIVATION_ALIGNMENT, &act_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, INT32_ACC_TILE_BYTES, &result_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      &arena, HEXKL_VTCM_WEIGHTS, n_cblocks * N_KTILES * INT8_WEIGHT_TILE_BYTES, &weight_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_setup_acc_read_int32(vtcm_base, config_offset);
+  }
+  for (uint32_t cb = 0; res == AEE_SUCCESS && cb < n_cblocks; cb++) {
+    for (uint32_t kt = 0; res == AEE_SUCCESS && kt < N_KTILES; kt++) {
+      res = hexkl_micro_hmx_rm_to_wh_i8(
+        vtcm_base, weight_offset + (cb * N_KTILES + kt) * INT8_WEIGHT_TILE_BYTES, W, kt, cb, N_COL
+      );
+    }
+  }
+  for (uint32_t kt = 0; kt < N_KTILES; kt++) {
+    act_offsets[kt] = act_offset + kt * HEXKL_HMX_ACTIVATION_ALIGNMENT;
+  }
+
+  for (uint32_t row = 0; res == AEE_SUCCESS && row < N_ROW; row += HEXKL_HMX_INT8_BLOCK_N_ROW) {
+    uint32_t tile_row = row / HEXKL_HMX_INT8_BLOCK_N_ROW;
+
+    for (uint32_t kt = 0; res == AEE_SUCCESS && kt < N_KTILES; kt++) {
+      res = hexkl_micro_hmx_copy_submatrix_to_8b_activation(
+        vtcm_base, act_offsets[kt], X, tile_row, kt, N_ROW, N_INNER
+      );
+    }
+
+    for (uint32_t cb = 0; res == AEE_SUCCESS && cb < n_cblocks; cb++) {
+      uint64_t t0;
+
+      for (uint32_t kt = 0; kt < N_KTILES; kt++) {
+        wt_offsets[kt] = weight_offset + (cb * N_KTILES + kt) * INT8_WEIGHT_TILE_BYTES;
+      }
+
+      hexkl_micro_hmx_acc_clear_int32();
+      t0 = HAP_perf_get_qtimer_count();
+      if (chain) {
+        res = hexkl_macro_ext_hmx_mm_u8i8_chain(vtcm_base, act_offsets, wt_offsets, N_KTILES);
+      } else {
+        for (uint32_t kt = 0; res == AEE_SUCCESS && kt < N_KTILES; kt++) {
+          res = hexkl_micro_hmx_mm_u8i8(vtcm_base, act_offsets[kt], wt_offsets[kt]);
+        }
+      }
+      *mm_ticks += HAP_perf_get_qtimer_count() - t0;
+
+      if (res == AEE_SUCCESS) {
+        res = hexkl_micro_hmx_acc_read_int32(vtcm_base, config_offset, result_offset);
+      }
+      if (res == AEE_SUCCESS) {
+        res = hexkl_micro_hmx_copy_32b_to_submatrix(vtcm_base, result_offset, A, tile_row, cb, N_ROW, N_COL);
+      }
+    }
+  }
+  return res;
+}
+
+/*!
+  @brief
+  Accumulates F16_N_KTILES pairs of random FP16 tiles in AH and WH layout with one call per pair and with one chain,
+  and checks that both accumulators read out the same bits.
+*/
+static int check_f16_chain(uint8_t* vtcm_base, uint32_t vtcm_size) {
+  uint32_t act_offsets[F16_N_KTILES];
+  uint32_t wt_offsets[F16_N_KTILES];
+  uint32_t config_offset, stage_offset, loop_offset, chain_offset;
+  _Float16* W = NULL;
+  hexkl_vtcm_arena_t arena;
+  int res;
+
+  W = malloc(F16_N_KTILES * F16_TILE_BYTES);
+  if (W == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  for (uint32_t i = 0; i < F16_N_KTILES * F16_TILE_BYTES / sizeof(_Float16); i++) {
+    W[i] = (_Float16)((float)rand() / (float)RAND_MAX - 0.5f);
+  }
+
+  res = hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &config_offset);
+  }
+  for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &act_offsets[kt]);
+  }
+  for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, F16_TILE_BYTES, &wt_offsets[kt]);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &stage_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &loop_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, F16_TILE_BYTES, &chain_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_setup_acc_read_f16(vtcm_base, config_offset);
+  }
+
+  // Activation tiles: the weight matrix itself, one 32x32 tile per inner tile
+  for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+    res = hexkl_micro_hmx_copy_submatrix_to_f16(
+      vtcm_base, stage_offset, W, kt, 0, F16_N_KTILES * HEXKL_HMX_F16_BLOCK_N_ROW, HEXKL_HMX_F16_BLOCK_N_COL
+    );
+    if (res == AEE_SUCCESS) {
+      res = hexkl_micro_hmx_rm_to_ah_f16(vtcm_base, act_offsets[kt], stage_offset);
+    }
+    if (res == AEE_SUCCESS) {
+      res = hexkl_micro_hmx_rm_to_wh_f16(vtcm_base, wt_offsets[kt], W, kt, 0, HEXKL_HMX_F16_BLOCK_N_COL);
+    }
+  }
+
+  if (res == AEE_SUCCESS) {
+    hexkl_micro_hmx_acc_clear_f16();
+    for (uint32_t kt = 0; res == AEE_SUCCESS && kt < F16_N_KTILES; kt++) {
+      res = hexkl_micro_hmx_mm_f16(vtcm_base, act_offsets[kt], wt_offsets[kt]);
+    }
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_acc_read_f16(vtcm_base, config_offset, loop_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    hexkl_micro_hmx_acc_clear_f16();
+    res = hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act_offsets, wt_offsets, F16_N_KTILES);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_acc_read_f16(vtcm_base, config_offset, chain_offset);
+  }
+  if (res == AEE_SUCCESS && memcmp(vtcm_base + loop_offset, vtcm_base + chain_offset, F16_TILE_BYTES) != 0) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP16 chain differs from the loop of calls\n");
+    res = AEE_EFAILED;
+  }
+
+  free(W);
+  return res;
+}
+
+/*!
+  @brief
+  Checks that invalid chains are rejected before any multiplication: the accumulator keeps the value of the last
+  valid chain. Lays its tiles out at the start of VTCM.
+*/
+static int check_invalid_chains(uint8_t* vtcm_base, uint32_t vtcm_size) {
+  uint32_t config_offset = vtcm_size - HEXKL_HMX_CONFIG_ALIGNMENT;
+  uint32_t act[2]        = {0, HEXKL_HMX_ACTIVATION_ALIGNMENT};
+  uint32_t wt[2]         = {2 * HEXKL_HMX_ACTIVATION_ALIGNMENT, 2 * HEXKL_HMX_ACTIVATION_ALIGNMENT + 1};
+  uint32_t before        = 4 * HEXKL_HMX_ACTIVATION_ALIGNMENT;
+  uint32_t after         = before + INT32_ACC_TILE_BYTES;
+  int res;
+
+  memset(vtcm_base, 1, 2 * HEXKL_HMX_ACTIVATION_ALIGNMENT + INT8_WEIGHT_TILE_BYTES);
+  res = hexkl_micro_hmx_setup_acc_read_int32(vtcm_base, config_offset);
+  if (res == AEE_SUCCESS) {
+    hexkl_micro_hmx_acc_clear_int32();
+    res = hexkl_macro_ext_hmx_mm_u8i8_chain(vtcm_base, act, wt, 1);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_acc_read_int32(vtcm_base, config_offset, before);
+  }
+  if (res != AEE_SUCCESS) {
+    return res;
+  }
+
+  // The second weight tile is misaligned: the first pair must not be multiplied either
+  if (hexkl_macro_ext_hmx_mm_u8i8_chain(vtcm_base, act, wt, 2) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_mm_u8i4_chain(vtcm_base, act, wt, 2) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act, wt, 2) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_mm_u8i8_chain(vtcm_base, act, wt, 0) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_mm_u8i8_chain(vtcm_base, NULL, wt, 1) != AEE_EBADPARM ||
+      hexkl_macro_ext_hmx_mm_u8i8_chain(NULL, act, wt, 1) != AEE_EBADPARM) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Invalid chain accepted\n");
+    return AEE_EFAILED;
+  }
+  res = hexkl_micro_hmx_acc_read_int32(vtcm_base, config_offset, after);
+  if (res == AEE_SUCCESS && memcmp(vtcm_base + before, vtcm_base + after, INT32_ACC_TILE_BYTES) != 0) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Invalid chain modified the accumulator\n");
+    res = AEE_EFAILED;
+  }
+  return res;
+}
+
+char version[256];
+
+int main() {
+  int res            = AEE_SUCCESS;
+  int res2           = AEE_SUCCESS;
+  uint8_t* vtcm_base = NULL;
+  uint32_t vtcm_size = 0;
+  int major          = 0;
+  int minor          = 0;
+  int patch          = 0;
+  int hex_version    = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  uint8_t* X           = NULL;
+  int8_t* W            = NULL;
+  int32_t* A_loop      = NULL;
+  int32_t* A_chain     = NULL;
+  int32_t* A_ref       = NULL;
+  uint64_t loop_ticks  = 0;
+  uint64_t chain_ticks = 0;
+  uint32_t n_pairs     = (N_ROW / HEXKL_HMX_INT8_BLOCK_N_ROW) * (N_COL / HEXKL_HMX_INT8_BLOCK_N_COL) * N_KTILES;
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  srand(42);
+  X       = malloc(N_ROW * N_INNER * sizeof(uint8_t));
+  W       = malloc(N_INNER * N_COL * sizeof(int8_t));
+  A_loop  = malloc(N_ROW * N_COL * sizeof(int32_t));
+  A_chain = malloc(N_ROW * N_COL * sizeof(int32_t));
+  A_ref   = malloc(N_ROW * N_COL * sizeof(int32_t));
+  if (X == NULL || W == NULL || A_loop == NULL || A_chain == NULL || A_ref == NULL) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Allocation failed\n");
+    res = AEE_ENOMEMORY;
+    goto TEST_END;
+  }
+  for (uint32_t i = 0; i < N_ROW * N_INNER; i++) {
+    X[i] = (uint8_t)(rand() % (MAX_VAL + 1));
+  }
+  for (uint32_t i = 0; i < N_INNER * N_COL; i++) {
+    W[i] = (int8_t)(rand() % (2 * MAX_VAL + 1) - (int)MAX_VAL);
+  }
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  /* -------  int8 matmul: one call per tile pair, then one chain per accumulation ------*/
+  matmul_u8i8_ref(N_ROW, N_INNER, N_COL, A_ref, X, W);
+  res = matmul_u8i8_i32(vtcm_base, vtcm_size, false, A_loop, X, W, &loop_ticks);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_i32(N_ROW * N_COL, A_ref, A_loop);
+  }
+  if (res == AEE_SUCCESS) {
+    res = matmul_u8i8_i32(vtcm_base, vtcm_size, true, A_chain, X, W, &chain_ticks);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_i32(N_ROW * N_COL, A_ref, A_chain);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] int8 matmul failed\n");
+    goto TEST_END;
+  }
+  printf(
+    "[HEXKL_MACRO_EXT] %u u8i8 tile pairs: calls %llu us, chains of %u %llu us\n",
+    n_pairs,
+    (unsigned long long)HAP_perf_qtimer_count_to_us(loop_ticks),
+    N_KTILES,
+    (unsigned long long)HAP_perf_qtimer_count_to_us(chain_ticks)
+  );
+
+  /* -------  FP16 chain ------*/
+  res = check_f16_chain(vtcm_base, vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP16 chain failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] FP16 chain OK\n");
+
+  /* -------  Invalid chains ------*/
+  res = check_invalid_chains(vtcm_base, vtcm_size);
+  if (res != AEE_SUCCESS) {
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Invalid chains rejected OK\n");
+
+TEST_END:
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  free(X);
+  free(W);
+  free(A_loop);
+  free(A_chain);
+  free(A_ref);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
@@ -0,0 +1,327 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define N_ROW   (200U) // Last row block partial
+#define N_COL   (256U)
+#define N_INNER (512U)
+
+#define X_STRIDE    (N_INNER + 64U) // Window of a wider activation buffer
+#define WIDE_ROW    (40U)
+#define WIDE_STRIDE (40000U) // Rows too far apart for a DMA descriptor
+
+#define TILE     (32U)
+#define N_COPIES (3U * HEXKL_MACRO_EXT_DMA_DEPTH) // Wraps the descriptor ring twice
+
+#define N_ORDERS (3U)
+
+static const hexkl_mm_order_e orders[N_ORDERS] = {
+  HEXKL_MM_ORDER_ACTIVATION_STATIONARY, HEXKL_MM_ORDER_WEIGHT_STATIONARY, HEXKL_MM_ORDER_OUTPUT_STATIONARY
+};
+static const char* order_names[N_ORDERS] = {"activation-stationary", "weight-stationary", "output-stationary"};
+
+/*!
+ @brief
+ Reference Standard C code: A = X * W, rows of X `x_row_stride` elements apart
+*/
+static void matmul_ref(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  size_t x_row_stride,
+  const _Float16* restrict W // W[n_inner][n_col]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += (float)X[i * x_row_stride + k] * (float)W[k * n_col + j];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares HEXKL result vs Standard C reference. Tolerates 1% error or 0.05 absolute error (FP16 accumulation)
+*/
+int hexkl_vector_check_f32(size_t size, const float* ref, const float* vec) {
+  for (size_t i = 0; i < size; i++) {
+    float diff = fabsf(ref[i] - vec[i]);
+
+    if (isnan(vec[i]) || isinf(vec[i]) || ((diff > fabsf(ref[i] / 100.f)) && (diff > 0.05f))) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %f vec[%ld] = %f\n", (long)i, ref[i], (long)i, vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+static _Float16* random_f16(size_t n, float offset) {
+  _Float16* v = malloc(n * sizeof(_Float16));
+
+  if (v != NULL) {
+    for (size_t i = 0; i < n; i++) {
+      v[i] = (_Float16)((float)rand() / (float)RAND_MAX + offset);
+    }
+  }
+  return v;
+}
+
+/*!
+  @brief
+  Copies N_COPIES 32x32 FP16 tiles of W (N_INNER x N_COL) into VTCM with one queue, walking the tiles of a column
+  block, and checks every tile against W. Waits for the first half of the copies one by one, newest first, and for
+  the rest all at once.
+*/
+static int test_dma_copies(uint8_t* vtcm_base) {
+  hexkl_dma_queue_t queue;
+  hexkl_dma_token_t tokens[N_COPIES];
+  const _Float16* W = NULL;
+  int res;
+
+  W = random_f16(N_INNER * N_COL, -0.5f);
+  if (W == NULL) {
+    return AEE_ENOMEMORY;
+  }
+
+  res = hexkl_macro_ext_dma_init(&queue);
+  for (uint32_t i = 0; i < N_COPIES && res == AEE_SUCCESS; i++) {
+    uint32_t kt     = i % (N_INNER / TILE);
+    uint32_t ct     = i / (N_INNER / TILE);
+    const void* src = W + (size_t)kt * TILE * N_COL + ct * TILE;
+
+    res = hexkl_macro_ext_dma_copy_async(
+      &queue, vtcm_base, i * TILE * TILE * sizeof(_Float16), src, N_COL * sizeof(_Float16), TILE * sizeof(_Float16),
+      TILE, &tokens[i]
+    );
+    if (res == AEE_SUCCESS && tokens[i] != i) {
+      res = AEE_EFAILED;
+    }
+  }
+  for (uint32_t i = N_COPIES / 2; i > 0 && res == AEE_SUCCESS; i--) {
+    res = hexkl_macro_ext_dma_wait(&queue, tokens[i - 1]);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_dma_wait_all(&queue);
+  }
+
+  for (uint32_t i = 0; i < N_COPIES && res == AEE_SUCCESS; i++) {
+    uint32_t kt          = i % (N_INNER / TILE);
+    uint32_t ct          = i / (N_INNER / TILE);
+    const _Float16* tile = (const _Float16*)(vtcm_base + i * TILE * TILE * sizeof(_Float16));
+
+    for (uint32_t r = 0; r < TILE; r++) {
+      if (memcmp(tile + r * TILE, W + (size_t)(kt * TILE + r) * N_COL + ct * TILE, TILE * sizeof(_Float16)) != 0) {
+        printf("[HEXKL_MACRO_EXT][ERROR] Copy %u differs at row %u\n", i, r);
+        res = AEE_EFAILED;
+        break;
+      }
+    }
+  }
+
+  // Argument checks
+  if (res == AEE_SUCCESS) {
+    hexkl_dma_token_t token;
+
+    if (hexkl_macro_ext_dma_init(NULL) != AEE_EBADPARM ||
+        hexkl_macro_ext_dma_copy_async(&queue, vtcm_base, 0, W, 64, 0, 1, &token) != AEE_EBADPARM ||
+        hexkl_macro_ext_dma_copy_async(&queue, vtcm_base, 0, W, 32, 64, 1, &token) != AEE_EBADPARM ||
+        hexkl_macro_ext_dma_copy_async(&queue, vtcm_base, 0, W, HEXKL_MACRO_EXT_DMA_MAX + 1, 64, 1, &token) !=
+          AEE_EBADPARM ||
+        hexkl_macro_ext_dma_copy_async(&queue, vtcm_base, 0, NULL, 64, 64, 1, &token) != AEE_EBADPARM ||
+        hexkl_macro_ext_dma_wait(&queue, N_COPIES) != AEE_EBADPARM ||
+        hexkl_macro_ext_dma_wait_all(NULL) != AEE_EBADPARM) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Invalid arguments accepted\n");
+      res = AEE_EFAILED;
+    }
+  }
+
+  free((void*)W);
+  return res;
+}
+
+/*!
+  @brief
+  Runs A = X * W with loop order `order`, tiles copied with DMA if `dma`, and returns the counters in `*stats`.
+*/
+static int run_mm(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  hexkl_mm_order_e order,
+  int dma,
+  float* A,
+  const _Float16* X,
+  const _Float16* W,
+  hexkl_macro_ext_stats_t* stats
+) {
+  int res = hexkl_macro_ext_set_mm_order(order);
+
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_set_mm_dma(dma);
+  }
+  if (res == AEE_SUCCESS) {
+    hexkl_macro_ext_reset_stats();
+    res = hexkl_macro_ext_mm_f16f16_f32_strided(vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A, X, X_STRIDE, W, NULL);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_get_stats(stats);
+  }
+  return res;
+}
+
+static void print_mm(const char* order, const char* copies, const hexkl_macro_ext_stats_t* s) {
+  printf(
+    "[HEXKL_MACRO_EXT] %-21s %-4s act %6llu us, weight load + hmx %6llu us, total %6llu us\n",
+    order,
+    copies,
+    (unsigned long long)s->act_load_us,
+    (unsigned long long)s->hmx_us,
+    (unsigned long long)(s->act_load_us + s->hmx_us + s->acc_read_us + s->store_us)
+  );
+}
+
+char version[256];
+
+int main() {
+  int res            = AEE_SUCCESS;
+  int res2           = AEE_SUCCESS;
+  uint8_t* vtcm_base = NULL;
+  uint32_t vtcm_size = 0;
+  int major          = 0;
+  int minor          = 0;
+  int patch          = 0;
+  int hex_version    = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  _Float16* X      = NULL;
+  _Float16* W      = NULL;
+  _Float16* X_wide = NULL;
+  float* A_sync    = NULL;
+  float* A_dma     = NULL;
+  float* A_ref     = NULL;
+  hexkl_macro_ext_stats_t sync_stats, dma_stats;
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  srand(42);
+  X      = random_f16(N_ROW * X_STRIDE, 0.f);
+  W      = random_f16(N_INNER * N_COL, -0.5f);
+  X_wide = random_f16((size_t)WIDE_ROW * WIDE_STRIDE, 0.f);
+  A_sync = malloc(N_ROW * N_COL * sizeof(float));
+  A_dma  = malloc(N_ROW * N_COL * sizeof(float));
+  A_ref  = malloc(N_ROW * N_COL * sizeof(float));
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  /* -------  Asynchronous copies ------*/
+  res = test_dma_copies(vtcm_base);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] DMA copies failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] %u DMA tile copies OK\n", N_COPIES);
+
+  /* -------  Matrix multiplication with synchronous and DMA tile copies: same results and traffic ------*/
+  matmul_ref(N_ROW, N_COL, N_INNER, A_ref, X, X_STRIDE, W);
+  for (uint32_t i = 0; i < N_ORDERS; i++) {
+    res = run_mm(vtcm_base, vtcm_size, orders[i], 0, A_sync, X, W, &sync_stats);
+    if (res == AEE_SUCCESS) {
+      res = hexkl_vector_check_f32(N_ROW * N_COL, A_ref, A_sync);
+    }
+    if (res == AEE_SUCCESS) {
+      res = run_mm(vtcm_base, vtcm_size, orders[i], 1, A_dma, X, W, &dma_stats);
+    }
+    // The tiles converted to AH and WH layout are the same, only the copies into VTCM differ
+    if (res == AEE_SUCCESS && (memcmp(A_dma, A_sync, N_ROW * N_COL * sizeof(float)) != 0 ||
+                               dma_stats.bytes_to_vtcm != sync_stats.bytes_to_vtcm)) {
+      printf("[HEXKL_MACRO_EXT][ERROR] DMA results or traffic differ from synchronous copies\n");
+      res = AEE_EFAILED;
+    }
+    if (res != AEE_SUCCESS) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Order %s failed\n", order_names[i]);
+      goto TEST_END;
+    }
+    print_mm(order_names[i], "sync", &sync_stats);
+    print_mm(order_names[i], "dma", &dma_stats);
+  }
+  printf("[HEXKL_MACRO_EXT] DMA matmuls OK\n");
+
+  /* -------  Activation rows too far apart for DMA: synchronous fallback ------*/
+  hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_AUTO);
+  hexkl_macro_ext_set_mm_dma(1);
+  matmul_ref(WIDE_ROW, N_COL, N_INNER, A_ref, X_wide, WIDE_STRIDE, W);
+  res = hexkl_macro_ext_mm_f16f16_f32_strided(
+    vtcm_base, vtcm_size, WIDE_ROW, N_COL, N_INNER, A_dma, X_wide, WIDE_STRIDE, W, NULL
+  );
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_f32(WIDE_ROW * N_COL, A_ref, A_dma);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Wide activation stride failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Wide activation stride OK\n");
+
+TEST_END:
+  hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_AUTO);
+  hexkl_macro_ext_set_mm_dma(1);
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  free(X);
+  free(W);
+  free(X_wide);
+  free(A_sync);
+  free(A_dma);
+  free(A_ref);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
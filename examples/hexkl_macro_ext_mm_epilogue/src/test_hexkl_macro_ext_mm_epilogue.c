@@ -0,0 +1,358 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define N_ROW   (48U) // Not a multiple of the tile height: exercises the partial last row block
+#define N_COL   (64U)
+#define N_INNER (128U)
+
+#define X_WIDE_STRIDE (N_INNER + 80U) // Row stride of the buffer the strided activations are a window of
+#define X_WIDE_COL0   (48U)           // First column of the window
+
+#define N_ROW_TILES ((N_ROW + 31U) / 32U) // Row blocks, each loading all weight tiles once
+
+#define N_TRACE_EVENTS (256U)
+#define TRACE_PATH     "hexkl_macro_ext_trace.json"
+
+/*!
+  @brief
+  Compares HEXKL result vs Standard C reference. Tolerates 1% error or 0.02 absolute error (FP16 accumulation)
+*/
+int hexkl_vector_check_f32(size_t size, const float* ref, const float* vec) {
+  int res = AEE_SUCCESS;
+  for (size_t i = 0; i < size; i++) {
+    float diff     = fabsf(ref[i] - vec[i]);
+    float diff_rel = fabsf(ref[i] / (float)100.0f);
+
+    if (isnan(vec[i]) || isinf(vec[i]) || ((diff > diff_rel) && (diff > 0.02f))) {
+      res = AEE_EFAILED;
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %f vec[%ld] = %f\n", (long)i, ref[i], (long)i, vec[i]);
+      break;
+    }
+  }
+  return res;
+}
+
+/*!
+ @brief
+ Reference Standard C code: A = activation(X * W + bias) + residual
+*/
+static void matmul_epilogue(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W, // W[n_inner][n_col]
+  const float* bias,
+  hexkl_activation_e activation,
+  const float* residual
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += (float)X[i * n_inner + k] * (float)W[k * n_col + j];
+      }
+      if (bias != NULL) {
+        acc += bias[j];
+      }
+      switch (activation) {
+        case HEXKL_ACT_RELU:
+          acc = acc > 0.f ? acc : 0.f;
+          break;
+        case HEXKL_ACT_SILU:
+          acc = acc / (1.f + expf(-acc));
+          break;
+        case HEXKL_ACT_GELU:
+          acc = 0.5f * acc * (1.f + tanhf(0.7978845608f * (acc + 0.044715f * acc * acc * acc)));
+          break;
+        default:
+          break;
+      }
+      if (residual != NULL) {
+        acc += residual[i * n_col + j];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+char version[256];
+
+int main() {
+  int res             = AEE_SUCCESS;
+  int res2            = AEE_SUCCESS;
+  float* A_f32_ref    = NULL;
+  float* A_f32        = NULL;
+  _Float16* A_f16     = NULL;
+  float* A_f16_as_f32 = NULL;
+  _Float16* X_f16     = NULL;
+  _Float16* X_wide    = NULL;
+  _Float16* W_f16     = NULL;
+  float* bias         = NULL;
+  float* res_f32      = NULL;
+  _Float16* res_f16   = NULL;
+  uint8_t* vtcm_base  = NULL;
+  uint32_t vtcm_size  = 0;
+  int major           = 0;
+  int minor           = 0;
+  int patch           = 0;
+  int hex_version     = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  hexkl_epilogue_t epilogue;
+  hexkl_macro_ext_stats_t stats;
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  A_f32_ref    = malloc(N_ROW * N_COL * sizeof(float));
+  A_f32        = malloc(N_ROW * N_COL * sizeof(float));
+  A_f16        = malloc(N_ROW * N_COL * sizeof(_Float16));
+  A_f16_as_f32 = malloc(N_ROW * N_COL * sizeof(float));
+  X_f16        = malloc(N_ROW * N_INNER * sizeof(_Float16));
+  X_wide       = malloc(N_ROW * X_WIDE_STRIDE * sizeof(_Float16));
+  W_f16        = malloc(N_INNER * N_COL * sizeof(_Float16));
+  bias         = malloc(N_COL * sizeof(float));
+  res_f32      = malloc(N_ROW * N_COL * sizeof(float));
+  res_f16      = malloc(N_ROW * N_COL * sizeof(_Float16));
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  // The expected counters below are those of the activation-stationary loop order
+  res = hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_ACTIVATION_STATIONARY);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Loop order setting failed\n");
+    goto TEST_END;
+  }
+
+  // Initialization
+  srand(42);
+  for (size_t i = 0; i < N_ROW * N_INNER; i++) {
+    X_f16[i] = (_Float16)((float)rand() / (float)RAND_MAX);
+  }
+  for (size_t i = 0; i < N_ROW * X_WIDE_STRIDE; i++) {
+    X_wide[i] = (_Float16)-1.0f;
+  }
+  for (size_t i = 0; i < N_ROW; i++) {
+    memcpy(X_wide + i * X_WIDE_STRIDE + X_WIDE_COL0, X_f16 + i * N_INNER, N_INNER * sizeof(_Float16));
+  }
+  for (size_t i = 0; i < N_INNER * N_COL; i++) {
+    W_f16[i] = (_Float16)((float)rand() / (float)RAND_MAX - 0.5f);
+  }
+  for (size_t j = 0; j < N_COL; j++) {
+    bias[j] = (float)rand() / (float)RAND_MAX - 0.5f;
+  }
+  for (size_t i = 0; i < N_ROW * N_COL; i++) {
+    res_f16[i] = (_Float16)((float)rand() / (float)RAND_MAX - 0.5f);
+    res_f32[i] = (float)res_f16[i];
+  }
+
+  /* -------  FP32 output, bias + SiLU + residual ------*/
+  epilogue.bias       = bias;
+  epilogue.activation = HEXKL_ACT_SILU;
+  epilogue.residual   = res_f32;
+
+  matmul_epilogue(N_ROW, N_COL, N_INNER, A_f32_ref, X_f16, W_f16, bias, HEXKL_ACT_SILU, res_f32);
+
+  res = hexkl_macro_ext_mm_f16f16_f32(vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A_f32, X_f16, W_f16, &epilogue);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP32 output with bias + SiLU + residual failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] FP32 output with bias + SiLU + residual OK\n");
+
+  /* -------  FP16 output, bias + GELU + residual ------*/
+  epilogue.activation = HEXKL_ACT_GELU;
+  epilogue.residual   = res_f16;
+
+  matmul_epilogue(N_ROW, N_COL, N_INNER, A_f32_ref, X_f16, W_f16, bias, HEXKL_ACT_GELU, res_f32);
+
+  res = hexkl_macro_ext_mm_f16(vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A_f16, X_f16, W_f16, &epilogue);
+  if (res == AEE_SUCCESS) {
+    for (size_t i = 0; i < N_ROW * N_COL; i++) {
+      A_f16_as_f32[i] = (float)A_f16[i];
+    }
+    res = hexkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f16_as_f32);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP16 output with bias + GELU + residual failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] FP16 output with bias + GELU + residual OK\n");
+
+  /* -------  FP32 output without epilogue ------*/
+  matmul_epilogue(N_ROW, N_COL, N_INNER, A_f32_ref, X_f16, W_f16, NULL, HEXKL_ACT_NONE, NULL);
+
+  res = hexkl_macro_ext_mm_f16f16_f32(vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A_f32, X_f16, W_f16, NULL);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP32 output without epilogue failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] FP32 output without epilogue OK\n");
+
+  /* -------  FP32 output, activations read from a column window of a wider buffer ------*/
+  memset(A_f32, 0, N_ROW * N_COL * sizeof(float));
+
+  res = hexkl_macro_ext_mm_f16f16_f32_strided(
+    vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A_f32, X_wide + X_WIDE_COL0, X_WIDE_STRIDE, W_f16, NULL
+  );
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP32 output with strided activations failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] FP32 output with strided activations OK\n");
+
+  /* -------  Same FP32 matmul traced, spans written to the simulator file system ------*/
+  hexkl_macro_ext_reset_stats();
+  res = hexkl_macro_ext_trace_start(N_TRACE_EVENTS);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_mm_f16f16_f32(vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A_f32, X_f16, W_f16, NULL);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_trace_dump(TRACE_PATH);
+  }
+  hexkl_macro_ext_trace_finalize();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Traced FP32 output failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Traced FP32 output OK, spans written to %s\n", TRACE_PATH);
+
+  /* -------  Counters of the traced call ------*/
+  res = hexkl_macro_ext_get_stats(&stats);
+  if (res == AEE_SUCCESS &&
+      (stats.n_matmuls != 1 || stats.n_macs != (uint64_t)N_ROW * N_COL * N_INNER ||
+       stats.bytes_to_vtcm != (uint64_t)N_ROW * N_INNER * sizeof(_Float16) +
+                                (uint64_t)N_ROW_TILES * N_COL * N_INNER * sizeof(_Float16) ||
+       stats.bytes_from_vtcm != (uint64_t)N_ROW * N_COL * sizeof(float))) {
+    res = AEE_EFAILED;
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Counters failed\n");
+    goto TEST_END;
+  }
+  printf(
+    "[HEXKL_MACRO_EXT] Counters OK: %llu MACs, %llu B to VTCM, %llu B from VTCM, "
+    "act load %llu us, HMX %llu us, acc read %llu us, store %llu us\n",
+    (unsigned long long)stats.n_macs,
+    (unsigned long long)stats.bytes_to_vtcm,
+    (unsigned long long)stats.bytes_from_vtcm,
+    (unsigned long long)stats.act_load_us,
+    (unsigned long long)stats.hmx_us,
+    (unsigned long long)stats.acc_read_us,
+    (unsigned long long)stats.store_us
+  );
+
+  /* -------  Few-row (GEMV) path: 1 .. HEXKL_MACRO_EXT_GEMV_MAX_ROWS rows, strided activations and epilogue ------*/
+  hexkl_macro_ext_reset_stats();
+  epilogue.activation = HEXKL_ACT_SILU;
+  epilogue.residual   = res_f32;
+
+  for (uint32_t n_row = 1; n_row <= HEXKL_MACRO_EXT_GEMV_MAX_ROWS && res == AEE_SUCCESS; n_row++) {
+    matmul_epilogue(n_row, N_COL, N_INNER, A_f32_ref, X_f16, W_f16, bias, HEXKL_ACT_SILU, res_f32);
+
+    res = hexkl_macro_ext_mm_f16f16_f32_strided(
+      vtcm_base, vtcm_size, n_row, N_COL, N_INNER, A_f32, X_wide + X_WIDE_COL0, X_WIDE_STRIDE, W_f16, &epilogue
+    );
+    if (res == AEE_SUCCESS) {
+      res = hexkl_vector_check_f32(n_row * N_COL, A_f32_ref, A_f32);
+    }
+    if (res != AEE_SUCCESS) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Few-row path with %u row(s) failed\n", (unsigned)n_row);
+    }
+  }
+  if (res != AEE_SUCCESS) {
+    goto TEST_END;
+  }
+
+  // The few-row path runs without VTCM and reads every weight once per call
+  res = hexkl_macro_ext_get_stats(&stats);
+  if (res == AEE_SUCCESS &&
+      (stats.n_matmuls != HEXKL_MACRO_EXT_GEMV_MAX_ROWS || stats.bytes_to_vtcm != 0 ||
+       stats.bytes_streamed < (uint64_t)HEXKL_MACRO_EXT_GEMV_MAX_ROWS * N_COL * N_INNER * sizeof(_Float16))) {
+    res = AEE_EFAILED;
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Few-row path counters failed\n");
+    goto TEST_END;
+  }
+  printf(
+    "[HEXKL_MACRO_EXT] Few-row path OK: %llu B streamed in %llu us\n",
+    (unsigned long long)stats.bytes_streamed,
+    (unsigned long long)stats.gemv_us
+  );
+
+TEST_END:
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  free(A_f32_ref);
+  free(A_f32);
+  free(A_f16);
+  free(A_f16_as_f32);
+  free(X_f16);
+  free(X_wide);
+  free(W_f16);
+  free(bias);
+  free(res_f32);
+  free(res_f16);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
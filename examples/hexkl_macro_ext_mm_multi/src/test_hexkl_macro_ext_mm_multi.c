@@ -0,0 +1,272 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define N_ROW     (80U) // Three row blocks, the last one partial
+#define N_ROW_DEC (4U)  // Few-row (GEMV) path
+#define N_INNER   (256U)
+#define N_Q       (128U) // Columns of the Q projection
+#define N_KV      (64U)  // Columns of the K and V projections (grouped-query attention)
+#define N_FF      (96U)  // Columns of the gate and up projections
+
+#define N_QKV       (3U)
+#define N_ROW_TILES ((N_ROW + 31U) / 32U)
+
+/*!
+ @brief
+ Reference Standard C code: A = X * W
+*/
+static void matmul_ref(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W // W[n_inner][n_col]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += (float)X[i * n_inner + k] * (float)W[k * n_col + j];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares HEXKL result vs Standard C reference. Tolerates 1% error or 0.05 absolute error (FP16 accumulation)
+*/
+int hexkl_vector_check_f32(size_t size, const float* ref, const float* vec) {
+  for (size_t i = 0; i < size; i++) {
+    float diff = fabsf(ref[i] - vec[i]);
+
+    if (isnan(vec[i]) || isinf(vec[i]) || ((diff > fabsf(ref[i] / 100.f)) && (diff > 0.05f))) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %f vec[%ld] = %f\n", (long)i, ref[i], (long)i, vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+static _Float16* random_f16(size_t n, float offset) {
+  _Float16* v = malloc(n * sizeof(_Float16));
+
+  if (v != NULL) {
+    for (size_t i = 0; i < n; i++) {
+      v[i] = (_Float16)((float)rand() / (float)RAND_MAX + offset);
+    }
+  }
+  return v;
+}
+
+char version[256];
+
+int main() {
+  int res            = AEE_SUCCESS;
+  int res2           = AEE_SUCCESS;
+  uint8_t* vtcm_base = NULL;
+  uint32_t vtcm_size = 0;
+  int major          = 0;
+  int minor          = 0;
+  int patch          = 0;
+  int hex_version    = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  const uint32_t n_cols[N_QKV] = {N_Q, N_KV, N_KV};
+  _Float16* W[N_QKV]           = {NULL};
+  _Float16* A_multi[N_QKV]     = {NULL};
+  _Float16* A_single[N_QKV]    = {NULL};
+  _Float16* X                  = NULL;
+  _Float16* W_gate             = NULL;
+  _Float16* W_up               = NULL;
+  float* A_gate                = NULL;
+  float* A_up                  = NULL;
+  float* A_ref                 = NULL;
+  hexkl_mm_weight_t qkv[N_QKV];
+  hexkl_mm_weight_t gate_up[2];
+  hexkl_epilogue_t silu = {.bias = NULL, .activation = HEXKL_ACT_SILU, .residual = NULL};
+  hexkl_macro_ext_stats_t stats;
+  uint64_t weight_bytes = 0;
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  srand(42);
+  X = random_f16(N_ROW * N_INNER, 0.f);
+  for (uint32_t w = 0; w < N_QKV; w++) {
+    W[w]          = random_f16(N_INNER * n_cols[w], -0.5f);
+    A_multi[w]    = malloc(N_ROW * n_cols[w] * sizeof(_Float16));
+    A_single[w]   = malloc(N_ROW * n_cols[w] * sizeof(_Float16));
+    weight_bytes += (uint64_t)N_INNER * n_cols[w] * sizeof(_Float16);
+  }
+  W_gate = random_f16(N_INNER * N_FF, -0.5f);
+  W_up   = random_f16(N_INNER * N_FF, -0.5f);
+  A_gate = malloc(N_ROW * N_FF * sizeof(float));
+  A_up   = malloc(N_ROW * N_FF * sizeof(float));
+  A_ref  = malloc(N_ROW * N_Q * sizeof(float));
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  // The expected counters below are those of the activation-stationary loop order
+  res = hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_ACTIVATION_STATIONARY);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Loop order setting failed\n");
+    goto TEST_END;
+  }
+
+  /* -------  Fused Q/K/V projections, FP16 outputs ------*/
+  for (uint32_t w = 0; w < N_QKV; w++) {
+    qkv[w].W        = W[w];
+    qkv[w].A        = A_multi[w];
+    qkv[w].n_col    = n_cols[w];
+    qkv[w].epilogue = NULL;
+  }
+
+  hexkl_macro_ext_reset_stats();
+  res = hexkl_macro_ext_mm_f16_multi(vtcm_base, vtcm_size, N_ROW, N_INNER, X, qkv, N_QKV);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_get_stats(&stats);
+  }
+  // One activation load for the three projections
+  if (res == AEE_SUCCESS &&
+      (stats.n_matmuls != N_QKV || stats.n_macs != (uint64_t)N_ROW * (N_Q + 2 * N_KV) * N_INNER ||
+       stats.bytes_to_vtcm != (uint64_t)N_ROW * N_INNER * sizeof(_Float16) + N_ROW_TILES * weight_bytes)) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Unexpected counters\n");
+    res = AEE_EFAILED;
+  }
+  // Same results as separate calls
+  for (uint32_t w = 0; w < N_QKV && res == AEE_SUCCESS; w++) {
+    res = hexkl_macro_ext_mm_f16(vtcm_base, vtcm_size, N_ROW, n_cols[w], N_INNER, A_single[w], X, W[w], NULL);
+    if (res == AEE_SUCCESS && memcmp(A_multi[w], A_single[w], N_ROW * n_cols[w] * sizeof(_Float16)) != 0) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Output %u differs from a separate call\n", (unsigned)w);
+      res = AEE_EFAILED;
+    }
+  }
+  if (res == AEE_SUCCESS) {
+    matmul_ref(N_ROW, N_Q, N_INNER, A_ref, X, W[0]);
+    for (size_t i = 0; i < N_ROW * N_Q; i++) {
+      res |= fabsf(A_ref[i] - (float)A_multi[0][i]) > 0.05f + fabsf(A_ref[i]) / 100.f ? AEE_EFAILED : AEE_SUCCESS;
+    }
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Fused Q/K/V projections failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Fused Q/K/V projections OK, %llu B to VTCM\n", (unsigned long long)stats.bytes_to_vtcm);
+
+  /* -------  Fused gate/up projections, FP32 outputs, SiLU on the gate ------*/
+  gate_up[0].W        = W_gate;
+  gate_up[0].A        = A_gate;
+  gate_up[0].n_col    = N_FF;
+  gate_up[0].epilogue = &silu;
+  gate_up[1].W        = W_up;
+  gate_up[1].A        = A_up;
+  gate_up[1].n_col    = N_FF;
+  gate_up[1].epilogue = NULL;
+
+  res = hexkl_macro_ext_mm_f16f16_f32_multi(vtcm_base, vtcm_size, N_ROW, N_INNER, X, gate_up, 2);
+  if (res == AEE_SUCCESS) {
+    matmul_ref(N_ROW, N_FF, N_INNER, A_ref, X, W_gate);
+    for (size_t i = 0; i < N_ROW * N_FF; i++) {
+      A_ref[i] = A_ref[i] / (1.f + expf(-A_ref[i]));
+    }
+    res = hexkl_vector_check_f32(N_ROW * N_FF, A_ref, A_gate);
+  }
+  if (res == AEE_SUCCESS) {
+    matmul_ref(N_ROW, N_FF, N_INNER, A_ref, X, W_up);
+    res = hexkl_vector_check_f32(N_ROW * N_FF, A_ref, A_up);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Fused gate/up projections failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Fused gate/up projections with SiLU OK\n");
+
+  /* -------  Few rows: the fused call takes the GEMV path as well ------*/
+  res = hexkl_macro_ext_mm_f16f16_f32_multi(vtcm_base, vtcm_size, N_ROW_DEC, N_INNER, X, gate_up, 2);
+  if (res == AEE_SUCCESS) {
+    matmul_ref(N_ROW_DEC, N_FF, N_INNER, A_ref, X, W_up);
+    res = hexkl_vector_check_f32(N_ROW_DEC * N_FF, A_ref, A_up);
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Fused gate/up projections with %u rows failed\n", N_ROW_DEC);
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Fused gate/up projections with %u rows OK\n", N_ROW_DEC);
+
+  /* -------  Invalid entries are rejected before any output is written ------*/
+  memset(A_multi[0], 0, N_ROW * N_Q * sizeof(_Float16));
+  qkv[2].n_col = N_KV + 1;
+  if (hexkl_macro_ext_mm_f16_multi(vtcm_base, vtcm_size, N_ROW, N_INNER, X, qkv, N_QKV) != AEE_EBADPARM ||
+      hexkl_macro_ext_mm_f16_multi(vtcm_base, vtcm_size, N_ROW, N_INNER, X, qkv, 0) != AEE_EBADPARM ||
+      A_multi[0][0] != (_Float16)0.f) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Invalid weight entry accepted\n");
+    res = AEE_EFAILED;
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Invalid weight entries rejected OK\n");
+
+TEST_END:
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  for (uint32_t w = 0; w < N_QKV; w++) {
+    free(W[w]);
+    free(A_multi[w]);
+    free(A_single[w]);
+  }
+  free(X);
+  free(W_gate);
+  free(W_up);
+  free(A_gate);
+  free(A_up);
+  free(A_ref);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
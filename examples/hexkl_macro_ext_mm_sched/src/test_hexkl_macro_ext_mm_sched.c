@@ -0,0 +1,296 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define N_ROW   (256U) // Eight row blocks sharing every weight tile
+#define N_COL   (512U)
+#define N_INNER (512U)
+
+#define N_ORDERS (4U)
+
+#define VTCM_SMALL (24U * 1024U)  // Region too small for a row of activation tiles
+#define VTCM_PANEL (128U * 1024U) // Region holding a few column blocks of weight tiles
+
+static const char* order_names[N_ORDERS] = {"auto", "output-stationary", "activation-stationary", "weight-stationary"};
+
+/*!
+ @brief
+ Reference Standard C code: A = X * W
+*/
+static void matmul_ref(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W // W[n_inner][n_col]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += (float)X[i * n_inner + k] * (float)W[k * n_col + j];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares HEXKL result vs Standard C reference. Tolerates 1% error or 0.05 absolute error (FP16 accumulation)
+*/
+int hexkl_vector_check_f32(size_t size, const float* ref, const float* vec) {
+  for (size_t i = 0; i < size; i++) {
+    float diff = fabsf(ref[i] - vec[i]);
+
+    if (isnan(vec[i]) || isinf(vec[i]) || ((diff > fabsf(ref[i] / 100.f)) && (diff > 0.05f))) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %f vec[%ld] = %f\n", (long)i, ref[i], (long)i, vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+static _Float16* random_f16(size_t n, float offset) {
+  _Float16* v = malloc(n * sizeof(_Float16));
+
+  if (v != NULL) {
+    for (size_t i = 0; i < n; i++) {
+      v[i] = (_Float16)((float)rand() / (float)RAND_MAX + offset);
+    }
+  }
+  return v;
+}
+
+/*!
+  @brief
+  Runs A = X * W with loop order `order` in the first `vtcm_size` bytes of VTCM and checks that the bytes copied to
+  VTCM are those predicted by `hexkl_macro_ext_mm_select_order()`. Returns the order used in `*used` and the
+  counters in `*stats`.
+*/
+static int run_order(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  hexkl_mm_order_e order,
+  float* A,
+  const _Float16* X,
+  const _Float16* W,
+  hexkl_mm_order_e* used,
+  hexkl_macro_ext_stats_t* stats
+) {
+  uint64_t predicted = 0;
+  int res            = hexkl_macro_ext_set_mm_order(order);
+
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_mm_select_order(vtcm_size, N_ROW, N_COL, N_INNER, used, &predicted);
+  }
+  if (res == AEE_SUCCESS) {
+    hexkl_macro_ext_reset_stats();
+    res = hexkl_macro_ext_mm_f16f16_f32(vtcm_base, vtcm_size, N_ROW, N_COL, N_INNER, A, X, W, NULL);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_get_stats(stats);
+  }
+  if (res == AEE_SUCCESS && stats->bytes_to_vtcm != predicted) {
+    printf(
+      "[HEXKL_MACRO_EXT][ERROR] %s: %llu B to VTCM, %llu B predicted\n",
+      order_names[order],
+      (unsigned long long)stats->bytes_to_vtcm,
+      (unsigned long long)predicted
+    );
+    res = AEE_EFAILED;
+  }
+  return res;
+}
+
+static void print_order(
+  const char* region,
+  hexkl_mm_order_e order,
+  hexkl_mm_order_e used,
+  const hexkl_macro_ext_stats_t* s
+) {
+  printf(
+    "[HEXKL_MACRO_EXT] %s %-21s -> %-21s %9llu B to VTCM, act %llu us, hmx %llu us, read %llu us, store %llu us\n",
+    region,
+    order_names[order],
+    order_names[used],
+    (unsigned long long)s->bytes_to_vtcm,
+    (unsigned long long)s->act_load_us,
+    (unsigned long long)s->hmx_us,
+    (unsigned long long)s->acc_read_us,
+    (unsigned long long)s->store_us
+  );
+}
+
+char version[256];
+
+int main() {
+  int res            = AEE_SUCCESS;
+  int res2           = AEE_SUCCESS;
+  uint8_t* vtcm_base = NULL;
+  uint32_t vtcm_size = 0;
+  int major          = 0;
+  int minor          = 0;
+  int patch          = 0;
+  int hex_version    = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  _Float16* X    = NULL;
+  _Float16* W    = NULL;
+  float* A       = NULL;
+  float* A_first = NULL;
+  float* A_ref   = NULL;
+  hexkl_mm_order_e used;
+  hexkl_macro_ext_stats_t stats;
+  uint64_t bytes[N_ORDERS] = {0};
+  const hexkl_mm_order_e panel_orders[2] = {HEXKL_MM_ORDER_AUTO, HEXKL_MM_ORDER_WEIGHT_STATIONARY};
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  srand(42);
+  X       = random_f16(N_ROW * N_INNER, 0.f);
+  W       = random_f16(N_INNER * N_COL, -0.5f);
+  A       = malloc(N_ROW * N_COL * sizeof(float));
+  A_first = malloc(N_ROW * N_COL * sizeof(float));
+  A_ref   = malloc(N_ROW * N_COL * sizeof(float));
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  matmul_ref(N_ROW, N_COL, N_INNER, A_ref, X, W);
+
+  /* -------  Every order in the whole VTCM: same results, predicted traffic ------*/
+  for (uint32_t order = 0; order < N_ORDERS; order++) {
+    res = run_order(vtcm_base, vtcm_size, (hexkl_mm_order_e)order, order == 0 ? A_first : A, X, W, &used, &stats);
+    if (res == AEE_SUCCESS && order == 0) {
+      res = hexkl_vector_check_f32(N_ROW * N_COL, A_ref, A_first);
+    }
+    // All orders accumulate the inner tiles in the same order
+    if (res == AEE_SUCCESS && order != 0 && memcmp(A, A_first, N_ROW * N_COL * sizeof(float)) != 0) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Results differ from those of the automatic order\n");
+      res = AEE_EFAILED;
+    }
+    if (res != AEE_SUCCESS) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Order %s failed\n", order_names[order]);
+      goto TEST_END;
+    }
+    bytes[order] = stats.bytes_to_vtcm;
+    print_order("full VTCM ", (hexkl_mm_order_e)order, used, &stats);
+  }
+  // The automatic order moves the fewest bytes; with many row blocks, keeping the weights resident wins
+  if (bytes[HEXKL_MM_ORDER_AUTO] > bytes[HEXKL_MM_ORDER_OUTPUT_STATIONARY] ||
+      bytes[HEXKL_MM_ORDER_AUTO] > bytes[HEXKL_MM_ORDER_ACTIVATION_STATIONARY] ||
+      bytes[HEXKL_MM_ORDER_WEIGHT_STATIONARY] >= bytes[HEXKL_MM_ORDER_ACTIVATION_STATIONARY]) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Automatic order not the cheapest\n");
+    res = AEE_EFAILED;
+    goto TEST_END;
+  }
+  printf(
+    "[HEXKL_MACRO_EXT] Weight-stationary order OK, DDR to VTCM traffic %.2fx lower than activation-stationary\n",
+    (double)bytes[HEXKL_MM_ORDER_ACTIVATION_STATIONARY] / (double)bytes[HEXKL_MM_ORDER_WEIGHT_STATIONARY]
+  );
+
+  /* -------  Weight panels of a few column blocks ------*/
+  for (uint32_t i = 0; i < 2; i++) {
+    hexkl_mm_order_e order = panel_orders[i];
+
+    res = run_order(vtcm_base, VTCM_PANEL, order, A, X, W, &used, &stats);
+    if (res == AEE_SUCCESS && memcmp(A, A_first, N_ROW * N_COL * sizeof(float)) != 0) {
+      res = AEE_EFAILED;
+    }
+    if (res != AEE_SUCCESS) {
+      printf("[HEXKL_MACRO_EXT][ERROR] Order %s in %u bytes failed\n", order_names[order], VTCM_PANEL);
+      goto TEST_END;
+    }
+    print_order("small VTCM", order, used, &stats);
+  }
+
+  /* -------  Region too small for a row of activation tiles: output-stationary only ------*/
+  res = run_order(vtcm_base, VTCM_SMALL, HEXKL_MM_ORDER_AUTO, A, X, W, &used, &stats);
+  if (res == AEE_SUCCESS && (used != HEXKL_MM_ORDER_OUTPUT_STATIONARY ||
+                             memcmp(A, A_first, N_ROW * N_COL * sizeof(float)) != 0)) {
+    res = AEE_EFAILED;
+  }
+  if (res == AEE_SUCCESS) {
+    print_order("tiny VTCM ", HEXKL_MM_ORDER_AUTO, used, &stats);
+    hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_ACTIVATION_STATIONARY);
+    if (hexkl_macro_ext_mm_f16f16_f32(vtcm_base, VTCM_SMALL, N_ROW, N_COL, N_INNER, A, X, W, NULL) !=
+        AEE_ENOMEMORY) {
+      res = AEE_EFAILED;
+    }
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Order in %u bytes failed\n", VTCM_SMALL);
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Output-stationary fallback OK\n");
+
+  /* -------  Argument checks ------*/
+  if (hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_INVALID) != AEE_EBADPARM ||
+      hexkl_macro_ext_get_mm_order() != HEXKL_MM_ORDER_ACTIVATION_STATIONARY ||
+      hexkl_macro_ext_mm_select_order(vtcm_size, N_ROW, N_COL, N_INNER, NULL, NULL) != AEE_EBADPARM ||
+      hexkl_macro_ext_mm_select_order(vtcm_size, HEXKL_MACRO_EXT_GEMV_MAX_ROWS, N_COL, N_INNER, &used, NULL) !=
+        AEE_EBADPARM) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Invalid arguments accepted\n");
+    res = AEE_EFAILED;
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Invalid arguments rejected OK\n");
+
+TEST_END:
+  hexkl_macro_ext_set_mm_order(HEXKL_MM_ORDER_AUTO);
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  free(X);
+  free(W);
+  free(A);
+  free(A_first);
+  free(A_ref);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
@@ -0,0 +1,420 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+#define MAX_VAL (5U) // Random values are in [0, MAX_VAL]
+#define N_ROW   (256U)
+#define N_COL   (256U)
+#define N_INNER (512U)
+
+#define RESIDENT_SIZE (64U * 1024U) // VTCM kept by the caller across the FP16 matmul
+
+#define INT8_WEIGHT_TILE_BYTES (HEXKL_HMX_INT8_BLOCK_N_INNER * HEXKL_HMX_INT8_BLOCK_N_COL)
+#define INT32_ACC_TILE_BYTES   (HEXKL_HMX_INT8_BLOCK_N_ROW * HEXKL_HMX_INT8_BLOCK_N_COL * sizeof(int32_t))
+
+/*!
+  @brief
+  Compares HEXKL MICRO API result vs Standard C reference.
+*/
+int hexkl_vector_check_i32(size_t size, const int32_t* ref, const int32_t* vec) {
+  for (size_t i = 0; i < size; i++) {
+    if (ref[i] != vec[i]) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %ld vec[%ld] = %ld\n", (long)i, (long)ref[i], (long)i, (long)vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+/*!
+  @brief
+  Compares HEXKL result vs Standard C reference. Tolerates 1% error or 0.05 absolute error (FP16 accumulation)
+*/
+int hexkl_vector_check_f32(size_t size, const float* ref, const float* vec) {
+  for (size_t i = 0; i < size; i++) {
+    float diff = fabsf(ref[i] - vec[i]);
+
+    if (isnan(vec[i]) || isinf(vec[i]) || ((diff > fabsf(ref[i] / 100.f)) && (diff > 0.05f))) {
+      printf("[HEXKL_MACRO_EXT][ERROR] ref[%ld] = %f vec[%ld] = %f\n", (long)i, ref[i], (long)i, vec[i]);
+      return AEE_EFAILED;
+    }
+  }
+  return AEE_SUCCESS;
+}
+
+/*!
+ @brief
+ Reference Standard C code
+*/
+static void matmul_u8i8_ref(
+  uint32_t n_row,
+  uint32_t n_inner,
+  uint32_t n_col,
+  int32_t* restrict A,
+  const uint8_t* restrict X,
+  const int8_t* restrict W
+) {
+  for (uint32_t row = 0; row < n_row; row++) {
+    for (uint32_t col = 0; col < n_col; col++) {
+      int32_t acc = 0;
+      for (uint32_t k = 0; k < n_inner; k++) {
+        acc += (int32_t)X[row * n_inner + k] * (int32_t)W[k * n_col + col];
+      }
+      A[row * n_col + col] = acc;
+    }
+  }
+}
+
+static void matmul_f16_ref(
+  uint32_t n_row,
+  uint32_t n_inner,
+  uint32_t n_col,
+  float* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W
+) {
+  for (uint32_t row = 0; row < n_row; row++) {
+    for (uint32_t col = 0; col < n_col; col++) {
+      float acc = 0.f;
+      for (uint32_t k = 0; k < n_inner; k++) {
+        acc += (float)X[row * n_inner + k] * (float)W[k * n_col + col];
+      }
+      A[row * n_col + col] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  int8 matrix multiplication on the micro API with its VTCM laid out by an arena, inside a frame: the HMX
+  configuration, one row of activation tiles, the accumulator read-out and, in the rest of the region, a panel of as
+  many column blocks of weight tiles as fit. Each panel is converted to WH layout once, during the first row block,
+  and reused by the others. Returns the number of column blocks per panel in `*n_panel`.
+*/
+static int matmul_u8i8_i32_arena(
+  uint8_t* vtcm_base,
+  hexkl_vtcm_arena_t* arena,
+  uint32_t n_row,
+  uint32_t n_inner,
+  uint32_t n_col,
+  int32_t* A,
+  const uint8_t* X,
+  const int8_t* W,
+  uint32_t* n_panel
+) {
+  uint32_t n_ktiles    = n_inner / HEXKL_HMX_INT8_BLOCK_N_INNER;
+  uint32_t n_cblocks   = n_col / HEXKL_HMX_INT8_BLOCK_N_COL;
+  uint32_t panel_bytes = n_ktiles * INT8_WEIGHT_TILE_BYTES;
+  uint32_t config_offset, act_offset, result_offset, weight_offset;
+  hexkl_vtcm_frame_t frame;
+  int res;
+
+  res = hexkl_macro_ext_vtcm_frame_begin(arena, &frame);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &config_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(
+      arena, HEXKL_VTCM_ACTIVATION, n_ktiles * HEXKL_HMX_ACTIVATION_ALIGNMENT, &act_offset
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(arena, HEXKL_VTCM_ACTIVATION, INT32_ACC_TILE_BYTES, &result_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    // Size the weight panel to the VTCM actually left
+    *n_panel = hexkl_macro_ext_vtcm_available(arena, HEXKL_VTCM_WEIGHTS) / panel_bytes;
+    *n_panel = *n_panel < n_cblocks ? *n_panel : n_cblocks;
+    res      = *n_panel == 0 ? AEE_ENOMEMORY : AEE_SUCCESS;
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_alloc(arena, HEXKL_VTCM_WEIGHTS, *n_panel * panel_bytes, &weight_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_micro_hmx_setup_acc_read_int32(vtcm_base, config_offset);
+  }
+
+  for (uint32_t cb0 = 0; res == AEE_SUCCESS && cb0 < n_cblocks; cb0 += *n_panel) {
+    uint32_t cb1 = cb0 + *n_panel < n_cblocks ? cb0 + *n_panel : n_cblocks;
+
+    for (uint32_t row = 0; res == AEE_SUCCESS && row < n_row; row += HEXKL_HMX_INT8_BLOCK_N_ROW) {
+      uint32_t tile_row = row / HEXKL_HMX_INT8_BLOCK_N_ROW;
+
+      for (uint32_t kt = 0; res == AEE_SUCCESS && kt < n_ktiles; kt++) {
+        res = hexkl_micro_hmx_copy_submatrix_to_8b_activation(
+          vtcm_base, act_offset + kt * HEXKL_HMX_ACTIVATION_ALIGNMENT, X, tile_row, kt, n_row, n_inner
+        );
+      }
+
+      for (uint32_t cb = cb0; res == AEE_SUCCESS && cb < cb1; cb++) {
+        uint32_t panel_offset = weight_offset + (cb - cb0) * panel_bytes;
+
+        hexkl_micro_hmx_acc_clear_int32();
+        for (uint32_t kt = 0; res == AEE_SUCCESS && kt < n_ktiles; kt++) {
+          uint32_t weight_tile = panel_offset + kt * INT8_WEIGHT_TILE_BYTES;
+
+          if (row == 0) {
+            res = hexkl_micro_hmx_rm_to_wh_i8(vtcm_base, weight_tile, W, kt, cb, n_col);
+          }
+          if (res == AEE_SUCCESS) {
+            res = hexkl_micro_hmx_mm_u8i8(vtcm_base, act_offset + kt * HEXKL_HMX_ACTIVATION_ALIGNMENT, weight_tile);
+          }
+        }
+        if (res == AEE_SUCCESS) {
+          res = hexkl_micro_hmx_acc_read_int32(vtcm_base, config_offset, result_offset);
+        }
+        if (res == AEE_SUCCESS) {
+          res = hexkl_micro_hmx_copy_32b_to_submatrix(vtcm_base, result_offset, A, tile_row, cb, n_row, n_col);
+        }
+      }
+    }
+  }
+
+  // Release the layout even on failure
+  if (hexkl_macro_ext_vtcm_frame_end(arena, &frame) != AEE_SUCCESS && res == AEE_SUCCESS) {
+    res = AEE_EFAILED;
+  }
+  return res;
+}
+
+/*!
+  @brief
+  Checks allocation alignments, frames, exhaustion and the high-water mark of an arena over `vtcm_size` bytes.
+*/
+static int check_arena(uint32_t vtcm_size) {
+  hexkl_vtcm_arena_t arena;
+  hexkl_vtcm_frame_t outer, inner;
+  hexkl_vtcm_usage_t usage;
+  uint32_t config, act, weights, scratch, big;
+
+  if (hexkl_macro_ext_vtcm_init(&arena, vtcm_size) != AEE_SUCCESS ||
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &config) != AEE_SUCCESS ||
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, 100, &weights) != AEE_SUCCESS ||
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, 3000, &act) != AEE_SUCCESS) {
+    return AEE_EFAILED;
+  }
+  // The configuration comes from the end of the region, the tiles from its base, each with its alignment
+  if (config % HEXKL_HMX_CONFIG_ALIGNMENT != 0 || config + hexkl_micro_hmx_config_size() > vtcm_size ||
+      config < vtcm_size - hexkl_micro_hmx_config_size() - HEXKL_HMX_CONFIG_ALIGNMENT || weights != 0 ||
+      act != HEXKL_HMX_ACTIVATION_ALIGNMENT) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Unexpected offsets %u %u %u\n", config, weights, act);
+    return AEE_EFAILED;
+  }
+
+  // Nested frames release their allocations; ending them out of order is rejected
+  hexkl_macro_ext_vtcm_frame_begin(&arena, &outer);
+  hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, 128, &scratch);
+  hexkl_macro_ext_vtcm_frame_begin(&arena, &inner);
+  big = hexkl_macro_ext_vtcm_available(&arena, HEXKL_VTCM_ACTIVATION);
+  if (hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, big, &scratch) != AEE_SUCCESS ||
+      hexkl_macro_ext_vtcm_available(&arena, HEXKL_VTCM_WEIGHTS) != 0 ||
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, 1, &scratch) != AEE_ENOMEMORY ||
+      hexkl_macro_ext_vtcm_get_usage(&arena, &usage) != AEE_SUCCESS || usage.used != vtcm_size ||
+      usage.high_water != vtcm_size) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Full arena not reported\n");
+    return AEE_EFAILED;
+  }
+  if (hexkl_macro_ext_vtcm_frame_end(&arena, &outer) != AEE_SUCCESS ||
+      hexkl_macro_ext_vtcm_frame_end(&arena, &inner) != AEE_EBADPARM ||
+      hexkl_macro_ext_vtcm_get_usage(&arena, &usage) != AEE_SUCCESS ||
+      usage.used != act + 3000 + (vtcm_size - config) || usage.high_water <= usage.used) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Frames not released\n");
+    return AEE_EFAILED;
+  }
+
+  // Argument checks
+  if (hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_INVALID, 1, &scratch) != AEE_EBADPARM ||
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, 0, &scratch) != AEE_EBADPARM ||
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_WEIGHTS, 1, NULL) != AEE_EBADPARM ||
+      hexkl_macro_ext_vtcm_init(NULL, vtcm_size) != AEE_EBADPARM ||
+      hexkl_macro_ext_vtcm_get_usage(&arena, NULL) != AEE_EBADPARM) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Invalid arguments accepted\n");
+    return AEE_EFAILED;
+  }
+
+  return AEE_SUCCESS;
+}
+
+char version[256];
+
+int main() {
+  int res            = AEE_SUCCESS;
+  int res2           = AEE_SUCCESS;
+  uint8_t* vtcm_base = NULL;
+  uint32_t vtcm_size = 0;
+  int major          = 0;
+  int minor          = 0;
+  int patch          = 0;
+  int hex_version    = 0;
+  char version_prerel[HEXKL_PREREL_STR_LEN];
+  uint8_t* X_u8        = NULL;
+  int8_t* W_i8         = NULL;
+  int32_t* A_i32       = NULL;
+  int32_t* A_i32_ref   = NULL;
+  _Float16* X_f16      = NULL;
+  _Float16* W_f16      = NULL;
+  float* A_f32         = NULL;
+  float* A_f32_ref     = NULL;
+  uint32_t n_panel     = 0;
+  uint32_t resident    = 0;
+  uint32_t rest_offset = 0;
+  uint32_t rest_size   = 0;
+  hexkl_vtcm_arena_t arena;
+  hexkl_vtcm_usage_t usage;
+  hexkl_macro_ext_stats_t stats;
+
+  printf("[HEXKL_MACRO_EXT] Test Start:\n");
+
+  X_u8      = malloc(N_ROW * N_INNER);
+  W_i8      = malloc(N_INNER * N_COL);
+  A_i32     = malloc(N_ROW * N_COL * sizeof(int32_t));
+  A_i32_ref = malloc(N_ROW * N_COL * sizeof(int32_t));
+  X_f16     = malloc(N_ROW * N_INNER * sizeof(_Float16));
+  W_f16     = malloc(N_INNER * N_COL * sizeof(_Float16));
+  A_f32     = malloc(N_ROW * N_COL * sizeof(float));
+  A_f32_ref = malloc(N_ROW * N_COL * sizeof(float));
+
+  srand(42);
+  for (uint32_t i = 0; i < N_ROW * N_INNER; i++) {
+    X_u8[i]  = (uint8_t)(rand() % (MAX_VAL + 1));
+    X_f16[i] = (_Float16)((float)rand() / (float)RAND_MAX);
+  }
+  for (uint32_t i = 0; i < N_INNER * N_COL; i++) {
+    W_i8[i]  = (int8_t)(rand() % (2 * MAX_VAL + 1)) - (int8_t)MAX_VAL;
+    W_f16[i] = (_Float16)((float)rand() / (float)RAND_MAX - 0.5f);
+  }
+  matmul_u8i8_ref(N_ROW, N_INNER, N_COL, A_i32_ref, X_u8, W_i8);
+  matmul_f16_ref(N_ROW, N_INNER, N_COL, A_f32_ref, X_f16, W_f16);
+
+  res = hexkl_micro_hw_init(&vtcm_base, &vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Init failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] VTCM base = 0x%p  VTCM size = %d bytes:\n", vtcm_base, (int)vtcm_size);
+  }
+
+  res = hexkl_micro_get_version(&major, &minor, &patch, version_prerel, &hex_version);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Version access failed\n");
+    goto TEST_END;
+  } else {
+    sprintf(version, "%d_%d_%d_%s_HEXAGON_V%d", major, minor, patch, version_prerel, hex_version);
+    printf("[HEXKL_MACRO_EXT] Version is: %s\n", version);
+  }
+
+  res = hexkl_micro_hmx_lock();
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Lock failed\n");
+    goto TEST_END;
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Lock OK\n");
+  }
+
+  /* -------  Arena ------*/
+  res = check_arena(vtcm_size);
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] Arena checks failed\n");
+    goto TEST_END;
+  }
+  printf("[HEXKL_MACRO_EXT] Arena checks OK\n");
+
+  /* -------  int8 micro matmul with a weight panel sized to the VTCM available ------*/
+  hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  res = matmul_u8i8_i32_arena(vtcm_base, &arena, N_ROW, N_INNER, N_COL, A_i32, X_u8, W_i8, &n_panel);
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_i32(N_ROW * N_COL, A_i32_ref, A_i32);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_vtcm_get_usage(&arena, &usage);
+  }
+  if (res == AEE_SUCCESS && (usage.used != 0 || usage.high_water > vtcm_size)) {
+    res = AEE_EFAILED;
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] int8 matmul in an arena failed\n");
+    goto TEST_END;
+  }
+  printf(
+    "[HEXKL_MACRO_EXT] int8 matmul OK, weight panels of %u/%u column blocks, VTCM high-water %u of %u bytes\n",
+    n_panel,
+    N_COL / HEXKL_HMX_INT8_BLOCK_N_COL,
+    usage.high_water,
+    vtcm_size
+  );
+
+  /* -------  FP16 matmul in the VTCM left next to resident data ------*/
+  hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  res = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, RESIDENT_SIZE, &resident);
+  if (res == AEE_SUCCESS) {
+    rest_size = hexkl_macro_ext_vtcm_available(&arena, HEXKL_VTCM_ACTIVATION);
+    res       = hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, rest_size, &rest_offset);
+  }
+  if (res == AEE_SUCCESS) {
+    memset(vtcm_base + resident, 0x5A, RESIDENT_SIZE);
+    hexkl_macro_ext_reset_stats();
+    res = hexkl_macro_ext_mm_f16f16_f32(
+      vtcm_base + rest_offset, rest_size, N_ROW, N_COL, N_INNER, A_f32, X_f16, W_f16, NULL
+    );
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  }
+  if (res == AEE_SUCCESS) {
+    res = hexkl_macro_ext_get_stats(&stats);
+  }
+  // The matmul stays within its region: the resident data is intact
+  for (uint32_t i = 0; res == AEE_SUCCESS && i < RESIDENT_SIZE; i++) {
+    res = vtcm_base[resident + i] == 0x5A ? AEE_SUCCESS : AEE_EFAILED;
+  }
+  if (res == AEE_SUCCESS && (stats.vtcm_high_water == 0 || stats.vtcm_high_water > rest_size)) {
+    res = AEE_EFAILED;
+  }
+  if (res != AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT][ERROR] FP16 matmul next to resident data failed\n");
+    goto TEST_END;
+  }
+  printf(
+    "[HEXKL_MACRO_EXT] FP16 matmul OK in %u bytes after %u resident bytes, VTCM high-water %llu bytes\n",
+    rest_size,
+    RESIDENT_SIZE,
+    (unsigned long long)stats.vtcm_high_water
+  );
+
+TEST_END:
+  res2 = hexkl_micro_hmx_unlock();
+  if (res2 != AEE_SUCCESS) {
+    res |= res2;
+    printf("[HEXKL_MACRO_EXT][ERROR] HMX Unlock failed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] HMX Unlock OK\n");
+  }
+
+  free(X_u8);
+  free(W_i8);
+  free(A_i32);
+  free(A_i32_ref);
+  free(X_f16);
+  free(W_f16);
+  free(A_f32);
+  free(A_f32_ref);
+
+  if (res == AEE_SUCCESS) {
+    printf("[HEXKL_MACRO_EXT] Test Passed\n");
+  } else {
+    printf("[HEXKL_MACRO_EXT] Test Failed\n");
+  }
+
+  return res;
+}
@@ -0,0 +1,640 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*
+  GEMM benchmark: sweeps shape grids, data types and entry points, and reports latency percentiles, throughput and
+  effective bandwidth as JSON.
+
+  Built with SDKL_BENCH_CPU_ONLY (build.sh --cpu-os linux), it only references the CPU engine of the extensions and
+  runs on a Linux host without libsdkl or a DSP.
+*/
+
+#define DEFAULT_MIN_ITERS   10
+#define DEFAULT_MIN_TIME_MS 200
+#define DEFAULT_WARMUP      2
+#define MAX_ITERS           1000
+#define DEFAULT_JSON_PATH   "sdkl_bench.json"
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+typedef struct {
+  const char* grid;
+  size_t n_row;
+  size_t n_col;
+  size_t n_inner;
+} bench_shape_t;
+
+/* Shape grids. Every `n_col` and `n_inner` is a multiple of 32, as required by the NPU entry points. */
+static const bench_shape_t shapes[] = {
+  {"prefill", 128, 4096, 4096},
+  {"prefill", 512, 4096, 4096},
+  {"prefill", 128, 11008, 4096},
+  {"decode", 1, 4096, 4096},
+  {"decode", 1, 11008, 4096},
+  {"decode", 1, 4096, 11008},
+  {"square", 256, 256, 256},
+  {"square", 1024, 1024, 1024},
+  {"square", 2048, 2048, 2048},
+  {"skinny", 16, 3072, 8192},
+  {"skinny", 4096, 64, 1024},
+};
+#define N_SHAPES (sizeof(shapes) / sizeof(shapes[0]))
+
+typedef enum {
+  BENCH_F16,    // FP16 x FP16 -> FP16
+  BENCH_F32F16, // FP32 x FP16 -> FP32
+  BENCH_U8I8,   // U8 x I8 -> I32
+  BENCH_U8I4,   // U8 x I4 -> I32
+  BENCH_N_DTYPES
+} bench_dtype_e;
+
+static const char* dtype_names[BENCH_N_DTYPES] = {"f16", "f32f16", "u8i8", "u8i4"};
+
+typedef enum {
+  BENCH_CPU_TENSOR, // sdkl_cpu_mm_tensor(), the CPU engine of the extensions
+  BENCH_NPU_TENSOR, // sdkl_mm_tensor() on NPU0 with WH weights
+  BENCH_NPU_FLAT,   // sdkl_npu_mm_*() on NPU0 with WH weights
+  BENCH_N_ENTRIES
+} bench_entry_e;
+
+static const char* entry_names[BENCH_N_ENTRIES] = {"cpu", "npu_tensor", "npu"};
+
+/* Returns the name of the function benchmarked by `entry` for `dtype`. */
+static const char* entry_function(bench_entry_e entry, bench_dtype_e dtype) {
+  static const char* npu_flat[BENCH_N_DTYPES] = {
+    "sdkl_npu_mm_f16f16_f16", "sdkl_npu_mm_f32f16_f32", "sdkl_npu_mm_u8i8_i32", "sdkl_npu_mm_u8i4_i32"
+  };
+
+  switch (entry) {
+    case BENCH_CPU_TENSOR:
+      return "sdkl_cpu_mm_tensor";
+    case BENCH_NPU_TENSOR:
+      return "sdkl_mm_tensor";
+    default:
+      return npu_flat[dtype];
+  }
+}
+
+/* Returns true if `entry` implements `dtype`. */
+static bool entry_supports(bench_entry_e entry, bench_dtype_e dtype) {
+  switch (entry) {
+    case BENCH_CPU_TENSOR:
+      return dtype != BENCH_U8I4;
+    case BENCH_NPU_TENSOR:
+      return dtype == BENCH_F16 || dtype == BENCH_F32F16;
+    default:
+      return true;
+  }
+}
+
+typedef struct {
+  const char* grid;     // NULL for all grids
+  int dtype;            // -1 for all data types
+  int entry;            // -1 for all entry points
+  bool cpu_only;
+  int min_iters;
+  int min_time_ms;
+  int warmup;
+  const char* json_path;
+} bench_options_t;
+
+/* Operands of one shape and data type, with the weights in the layout of each entry point. */
+typedef struct {
+  size_t x_size;
+  size_t w_size;
+  size_t a_size;
+  void* X;
+  void* W;     // Row-major, CPU engine
+  void* W_npu; // WH layout, NPU entry points
+  void* A;
+} bench_buffers_t;
+
+typedef struct {
+  int n_iters;
+  double median_us;
+  double p99_us;
+  double min_us;
+  double mean_us;
+} bench_result_t;
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void* bench_alloc(size_t size) {
+#ifdef SDKL_BENCH_CPU_ONLY
+  return calloc(1, size);
+#else
+  void* ptr = NULL;
+
+  return sdkl_npu_alloc(size, &ptr) == AEE_SUCCESS ? ptr : NULL;
+#endif
+}
+
+static void bench_free(void* ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+#ifdef SDKL_BENCH_CPU_ONLY
+  free(ptr);
+#else
+  sdkl_npu_free(ptr);
+#endif
+}
+
+/* Element sizes of the activations, weights and results of `dtype`. I4 weights are sized by `weight_bytes()`. */
+static size_t x_elem_size(bench_dtype_e dtype) {
+  return dtype == BENCH_F16 ? 2 : dtype == BENCH_F32F16 ? 4 : 1;
+}
+
+static size_t a_elem_size(bench_dtype_e dtype) {
+  return dtype == BENCH_F16 ? 2 : 4;
+}
+
+static size_t weight_bytes(bench_dtype_e dtype, size_t n_col, size_t n_inner) {
+  switch (dtype) {
+    case BENCH_F16:
+    case BENCH_F32F16:
+      return n_col * n_inner * sizeof(_Float16);
+    case BENCH_U8I8:
+      return n_col * n_inner;
+    default:
+      return (n_col * n_inner + 1) / 2;
+  }
+}
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static void free_buffers(bench_buffers_t* b) {
+  bench_free(b->X);
+  bench_free(b->W);
+  bench_free(b->W_npu);
+  bench_free(b->A);
+  memset(b, 0, sizeof(*b));
+}
+
+/*
+  Allocates and fills the operands of `shape` and `dtype`. The WH weights are prepared only if an NPU entry point
+  runs. Returns AEE_ENOMEMORY if a buffer cannot be allocated.
+*/
+static int setup_buffers(const bench_shape_t* shape, bench_dtype_e dtype, bool npu, bench_buffers_t* b) {
+  size_t n_x = shape->n_row * shape->n_inner;
+  size_t n_w = shape->n_col * shape->n_inner;
+
+  memset(b, 0, sizeof(*b));
+  b->x_size = n_x * x_elem_size(dtype);
+  b->w_size = weight_bytes(dtype, shape->n_col, shape->n_inner);
+  b->a_size = shape->n_row * shape->n_col * a_elem_size(dtype);
+  b->X      = bench_alloc(b->x_size);
+  b->A      = bench_alloc(b->a_size);
+  // Row-major weights, also the source of the I4 WH layout
+  b->W = bench_alloc(dtype == BENCH_U8I4 ? n_w : b->w_size);
+  if (b->X == NULL || b->A == NULL || b->W == NULL) {
+    free_buffers(b);
+    return AEE_ENOMEMORY;
+  }
+
+  for (size_t i = 0; i < n_x; i++) {
+    float v = (float)rand() / (float)RAND_MAX;
+    if (dtype == BENCH_F16) {
+      ((_Float16*)b->X)[i] = (_Float16)v;
+    } else if (dtype == BENCH_F32F16) {
+      ((float*)b->X)[i] = v;
+    } else {
+      ((uint8_t*)b->X)[i] = (uint8_t)(rand() % 127);
+    }
+  }
+  for (size_t i = 0; i < n_w; i++) {
+    if (dtype == BENCH_F16 || dtype == BENCH_F32F16) {
+      ((_Float16*)b->W)[i] = (_Float16)((float)rand() / (float)RAND_MAX - 0.5f);
+    } else if (dtype == BENCH_U8I8) {
+      ((int8_t*)b->W)[i] = (int8_t)(rand() % 255 - 127);
+    } else {
+      ((int8_t*)b->W)[i] = (int8_t)(rand() % 16 - 8);
+    }
+  }
+
+#ifndef SDKL_BENCH_CPU_ONLY
+  if (npu) {
+    b->W_npu = bench_alloc(b->w_size);
+    if (b->W_npu == NULL) {
+      free_buffers(b);
+      return AEE_ENOMEMORY;
+    }
+    if (dtype == BENCH_U8I4) {
+      SDKL_CHECK(sdkl_cpu_rm_to_wh_i4(b->W_npu, b->W, shape->n_inner, shape->n_col));
+    } else {
+      memcpy(b->W_npu, b->W, b->w_size);
+      if (dtype == BENCH_U8I8) {
+        SDKL_CHECK(sdkl_cpu_rm_to_wh_i8_inplace(shape->n_col, shape->n_inner, b->W_npu));
+      } else {
+        SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(shape->n_col, shape->n_inner, b->W_npu));
+      }
+    }
+  }
+#else
+  (void)npu;
+#endif
+
+  return AEE_SUCCESS;
+}
+
+/* Runs one matrix multiplication of `entry`. */
+static int run_once(bench_entry_e entry, bench_dtype_e dtype, const bench_shape_t* s, bench_buffers_t* b) {
+  static const sdkl_tensor_dtype_e x_dtypes[BENCH_N_DTYPES] = {
+    SDKL_DTYPE_FP16, SDKL_DTYPE_FP32, SDKL_DTYPE_U8, SDKL_DTYPE_U8
+  };
+  static const sdkl_tensor_dtype_e w_dtypes[BENCH_N_DTYPES] = {
+    SDKL_DTYPE_FP16, SDKL_DTYPE_FP16, SDKL_DTYPE_I8, SDKL_DTYPE_I4
+  };
+  static const sdkl_tensor_dtype_e a_dtypes[BENCH_N_DTYPES] = {
+    SDKL_DTYPE_FP16, SDKL_DTYPE_FP32, SDKL_DTYPE_I32, SDKL_DTYPE_I32
+  };
+  sdkl_tensor_t r, x, w;
+
+  if (entry == BENCH_CPU_TENSOR || entry == BENCH_NPU_TENSOR) {
+    setup_tensor(&r, b->A, s->n_row, s->n_col, SDKL_LAYOUT_2D_ROW_MAJOR, a_dtypes[dtype]);
+    setup_tensor(&x, b->X, s->n_row, s->n_inner, SDKL_LAYOUT_2D_ROW_MAJOR, x_dtypes[dtype]);
+  }
+
+  switch (entry) {
+    case BENCH_CPU_TENSOR:
+      setup_tensor(&w, b->W, s->n_col, s->n_inner, SDKL_LAYOUT_2D_ROW_MAJOR, w_dtypes[dtype]);
+      return sdkl_cpu_mm_tensor(&r, &x, &w);
+#ifndef SDKL_BENCH_CPU_ONLY
+    case BENCH_NPU_TENSOR:
+      setup_tensor(&w, b->W_npu, s->n_col, s->n_inner, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, w_dtypes[dtype]);
+      return sdkl_mm_tensor(platform_npu, &r, &x, &w);
+    case BENCH_NPU_FLAT:
+      switch (dtype) {
+        case BENCH_F16:
+          return sdkl_npu_mm_f16f16_f16(platform_npu, s->n_row, s->n_col, s->n_inner, b->A, b->X, b->W_npu);
+        case BENCH_F32F16:
+          return sdkl_npu_mm_f32f16_f32(platform_npu, s->n_row, s->n_col, s->n_inner, b->A, b->X, b->W_npu);
+        case BENCH_U8I8:
+          return sdkl_npu_mm_u8i8_i32(platform_npu, s->n_row, s->n_col, s->n_inner, b->A, b->X, b->W_npu);
+        default:
+          return sdkl_npu_mm_u8i4_i32(platform_npu, s->n_row, s->n_col, s->n_inner, b->A, b->X, b->W_npu);
+      }
+#endif
+    default:
+      return AEE_EUNSUPPORTED;
+  }
+}
+
+static int compare_double(const void* a, const void* b) {
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+/*
+  Runs `warmup` untimed calls, then timed calls until at least `min_iters` calls and `min_time_ms` have elapsed (at
+  most MAX_ITERS calls), and computes the latency statistics.
+*/
+static int bench_run(
+  bench_entry_e entry,
+  bench_dtype_e dtype,
+  const bench_shape_t* s,
+  bench_buffers_t* b,
+  const bench_options_t* opt,
+  bench_result_t* result
+) {
+  static double latencies[MAX_ITERS];
+  uint64_t start = 0, budget_ns = (uint64_t)opt->min_time_ms * 1000000ULL;
+  double sum     = 0.;
+  int n          = 0;
+
+  for (int it = 0; it < opt->warmup; it++) {
+    int ret = run_once(entry, dtype, s, b);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+  }
+
+  start = now_ns();
+  while (n < MAX_ITERS && (n < opt->min_iters || now_ns() - start < budget_ns)) {
+    uint64_t t0 = now_ns();
+    int ret     = run_once(entry, dtype, s, b);
+
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+    latencies[n] = (double)(now_ns() - t0) / 1000.;
+    sum += latencies[n];
+    n++;
+  }
+
+  qsort(latencies, n, sizeof(double), compare_double);
+  result->n_iters   = n;
+  result->median_us = n % 2 ? latencies[n / 2] : 0.5 * (latencies[n / 2 - 1] + latencies[n / 2]);
+  result->p99_us    = latencies[(size_t)((n * 99 + 99) / 100) - 1]; // nearest rank
+  result->min_us    = latencies[0];
+  result->mean_us   = sum / n;
+
+  return AEE_SUCCESS;
+}
+
+static void print_usage(const char* name) {
+  printf("Usage: %s [options]\n", name);
+  printf("  --grid <prefill|decode|square|skinny>   Shape grid (default: all)\n");
+  printf("  --dtype <f16|f32f16|u8i8|u8i4>          Data type (default: all)\n");
+  printf("  --entry <cpu|npu_tensor|npu>            Entry point (default: all)\n");
+  printf("  --cpu-only                              Run the CPU engine only, without initializing the NPU\n");
+  printf("  --min-iters <n>                         Minimum timed calls per case (default: %d)\n", DEFAULT_MIN_ITERS);
+  printf(
+    "  --min-time-ms <ms>                      Minimum timed duration per case (default: %d)\n", DEFAULT_MIN_TIME_MS
+  );
+  printf("  --warmup <n>                            Untimed calls per case (default: %d)\n", DEFAULT_WARMUP);
+  printf("  --json <path>                           JSON report path (default: %s)\n", DEFAULT_JSON_PATH);
+}
+
+/* Returns the index of `value` in `names`, -1 if absent. */
+static int find_name(const char* const* names, int n, const char* value) {
+  for (int i = 0; i < n; i++) {
+    if (strcmp(names[i], value) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int parse_options(int argc, char** argv, bench_options_t* opt) {
+  opt->grid        = NULL;
+  opt->dtype       = -1;
+  opt->entry       = -1;
+  opt->min_iters   = DEFAULT_MIN_ITERS;
+  opt->min_time_ms = DEFAULT_MIN_TIME_MS;
+  opt->warmup      = DEFAULT_WARMUP;
+  opt->json_path   = DEFAULT_JSON_PATH;
+#ifdef SDKL_BENCH_CPU_ONLY
+  opt->cpu_only = true;
+#else
+  opt->cpu_only = false;
+#endif
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg   = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+    if (strcmp(arg, "--cpu-only") == 0) {
+      opt->cpu_only = true;
+      continue;
+    }
+    if (strcmp(arg, "--help") == 0 || value == NULL) {
+      return AEE_EBADPARM;
+    }
+    i++;
+    if (strcmp(arg, "--grid") == 0) {
+      opt->grid = value;
+    } else if (strcmp(arg, "--dtype") == 0) {
+      opt->dtype = find_name(dtype_names, BENCH_N_DTYPES, value);
+      if (opt->dtype < 0) {
+        return AEE_EBADPARM;
+      }
+    } else if (strcmp(arg, "--entry") == 0) {
+      opt->entry = find_name(entry_names, BENCH_N_ENTRIES, value);
+      if (opt->entry < 0) {
+        return AEE_EBADPARM;
+      }
+    } else if (strcmp(arg, "--min-iters") == 0) {
+      opt->min_iters = atoi(value);
+    } else if (strcmp(arg, "--min-time-ms") == 0) {
+      opt->min_time_ms = atoi(value);
+    } else if (strcmp(arg, "--warmup") == 0) {
+      opt->warmup = atoi(value);
+    } else if (strcmp(arg, "--json") == 0) {
+      opt->json_path = value;
+    } else {
+      return AEE_EBADPARM;
+    }
+  }
+  if (opt->min_iters < 1 || opt->min_iters > MAX_ITERS || opt->min_time_ms < 0 || opt->warmup < 0) {
+    return AEE_EBADPARM;
+  }
+
+  return AEE_SUCCESS;
+}
+
+int main(int argc, char** argv) {
+  bench_options_t opt;
+  int n_cases = 0, n_failed = 0;
+  FILE* json;
+
+  if (parse_options(argc, argv, &opt) != AEE_SUCCESS) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+#ifndef SDKL_BENCH_CPU_ONLY
+  if (!opt.cpu_only) {
+    char version[SDKL_VERSION_STR_LEN];
+
+    SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+    SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+    printf("SDKL Version: %s\n", version);
+  }
+#endif
+
+  json = fopen(opt.json_path, "w");
+  if (json == NULL) {
+    printf("ERROR cannot write %s\n", opt.json_path);
+    return 1;
+  }
+  fprintf(
+    json,
+    "{\"benchmark\":\"sdkl_bench\",\"cpu_only\":%s,\"min_iters\":%d,\"min_time_ms\":%d,\"warmup\":%d,\"results\":[",
+    opt.cpu_only ? "true" : "false",
+    opt.min_iters,
+    opt.min_time_ms,
+    opt.warmup
+  );
+
+  srand(42);
+  printf("SDKL Bench Start:\n");
+  printf(
+    "%-8s %5s %6s %6s %-7s %-24s %6s %11s %11s %9s %8s\n",
+    "grid",
+    "M",
+    "N",
+    "K",
+    "dtype",
+    "function",
+    "iters",
+    "median(us)",
+    "p99(us)",
+    "GOP/s",
+    "GB/s"
+  );
+
+  for (size_t si = 0; si < N_SHAPES; si++) {
+    const bench_shape_t* s = &shapes[si];
+
+    if (opt.grid != NULL && strcmp(opt.grid, s->grid) != 0) {
+      continue;
+    }
+    for (int d = 0; d < BENCH_N_DTYPES; d++) {
+      bench_buffers_t buffers;
+      bool any_entry = false, npu = false;
+
+      if (opt.dtype >= 0 && opt.dtype != d) {
+        continue;
+      }
+      for (int e = 0; e < BENCH_N_ENTRIES; e++) {
+        if ((opt.entry < 0 || opt.entry == e) && (e == BENCH_CPU_TENSOR || !opt.cpu_only) &&
+            entry_supports(e, d)) {
+          any_entry = true;
+          npu |= e != BENCH_CPU_TENSOR;
+        }
+      }
+      if (!any_entry) {
+        continue;
+      }
+      if (setup_buffers(s, d, npu, &buffers) != AEE_SUCCESS) {
+        printf("ERROR cannot allocate %zux%zux%zu %s\n", s->n_row, s->n_col, s->n_inner, dtype_names[d]);
+        n_failed++;
+        continue;
+      }
+
+      for (int e = 0; e < BENCH_N_ENTRIES; e++) {
+        bench_result_t r;
+        double ops, bytes, gops, gbps;
+        int ret;
+
+        if ((opt.entry >= 0 && opt.entry != e) || (e != BENCH_CPU_TENSOR && opt.cpu_only) || !entry_supports(e, d)) {
+          continue;
+        }
+
+        ret = bench_run(e, d, s, &buffers, &opt, &r);
+        if (ret != AEE_SUCCESS) {
+          printf(
+            "ERROR %s %s %zux%zux%zu failed: %d\n",
+            entry_function(e, d),
+            dtype_names[d],
+            s->n_row,
+            s->n_col,
+            s->n_inner,
+            ret
+          );
+          n_failed++;
+          continue;
+        }
+
+        ops   = 2. * (double)s->n_row * (double)s->n_col * (double)s->n_inner;
+        bytes = (double)(buffers.x_size + buffers.w_size + buffers.a_size);
+        gops  = ops / (r.median_us * 1e3);
+        gbps  = bytes / (r.median_us * 1e3);
+
+        printf(
+          "%-8s %5zu %6zu %6zu %-7s %-24s %6d %11.1f %11.1f %9.1f %8.2f\n",
+          s->grid,
+          s->n_row,
+          s->n_col,
+          s->n_inner,
+          dtype_names[d],
+          entry_function(e, d),
+          r.n_iters,
+          r.median_us,
+          r.p99_us,
+          gops,
+          gbps
+        );
+        fprintf(
+          json,
+          "%s\n{\"grid\":\"%s\",\"m\":%zu,\"n\":%zu,\"k\":%zu,\"dtype\":\"%s\",\"entry\":\"%s\",\"function\":\"%s\","
+          "\"iters\":%d,\"median_us\":%.3f,\"p99_us\":%.3f,\"min_us\":%.3f,\"mean_us\":%.3f,\"gops\":%.3f,"
+          "\"tops\":%.6f,\"bandwidth_gbps\":%.3f}",
+          n_cases == 0 ? "" : ",",
+          s->grid,
+          s->n_row,
+          s->n_col,
+          s->n_inner,
+          dtype_names[d],
+          entry_names[e],
+          entry_function(e, d),
+          r.n_iters,
+          r.median_us,
+          r.p99_us,
+          r.min_us,
+          r.mean_us,
+          gops,
+          gops / 1e3,
+          gbps
+        );
+        n_cases++;
+      }
+      free_buffers(&buffers);
+    }
+  }
+
+  fprintf(json, "\n]}\n");
+  if (fclose(json) != 0) {
+    n_failed++;
+  }
+  printf("%d cases written to %s\n", n_cases, opt.json_path);
+
+  if (n_failed == 0 && n_cases > 0) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_cpu_finalize());
+#ifndef SDKL_BENCH_CPU_ONLY
+  if (!opt.cpu_only) {
+    SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+  }
+#endif
+
+  return n_failed == 0 && n_cases > 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+#define N_ITER   50
+#define MAX_ROWS 9    // 1 .. 8 rows take the GEMV path, 9 the tiled one
+#define N_COL    1000 // not a multiple of the column tile, to cover partial tiles
+#define N_INNER  1000 // not a multiple of the inner block or of the vector width
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+float* X_f32;     /* Activations X[MAX_ROWS][N_INNER] */
+_Float16* X_f16;  /* Same activations in FP16 */
+float* X_t;       /* Activations stored column-major, X_t[N_INNER][MAX_ROWS] */
+_Float16* W_f16;  /* Weights W[N_COL][N_INNER], row-major */
+float* bias;      /* Bias[N_COL] */
+float* A_ref;     /* Reference results */
+float* A_f32;     /* FP32 results */
+_Float16* A_f16;  /* FP16 results */
+
+// Matrix multiplication A = X * W^T, accumulated in double
+__attribute__((noinline)) void matmul_ref(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* A,         // A[n_row][n_col]
+  const float* X,   // X[n_row][n_inner]
+  const _Float16* W // W[n_col][n_inner]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      double acc = 0.;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += (double)X[i * n_inner + k] * (double)W[j * n_inner + k];
+      }
+      A[i * n_col + j] = (float)acc;
+    }
+  }
+}
+
+/*!
+  @brief Checks `n` results against the reference with a tolerance relative to the largest reference magnitude.
+*/
+static bool check_f32(const char* name, size_t n_row, size_t n, const float* ref, const float* out, float rel_tol) {
+  float max_ref = 0.f, max_err = 0.f;
+
+  for (size_t i = 0; i < n; i++) {
+    max_ref = fmaxf(max_ref, fabsf(ref[i]));
+    max_err = fmaxf(max_err, fabsf(ref[i] - out[i]));
+  }
+  if (max_err > rel_tol * max_ref) {
+    printf("ERROR %s, %zu rows: max error %g for max magnitude %g\n", name, n_row, max_err, max_ref);
+    return false;
+  }
+  return true;
+}
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_epilogue_t epilogue;
+  float* A_tmp;
+
+  X_f32 = malloc(MAX_ROWS * N_INNER * sizeof(float));
+  X_f16 = malloc(MAX_ROWS * N_INNER * sizeof(_Float16));
+  X_t   = malloc(MAX_ROWS * N_INNER * sizeof(float));
+  W_f16 = malloc(N_COL * N_INNER * sizeof(_Float16));
+  bias  = malloc(N_COL * sizeof(float));
+  A_ref = malloc(MAX_ROWS * N_COL * sizeof(float));
+  A_f32 = malloc(MAX_ROWS * N_COL * sizeof(float));
+  A_f16 = malloc(MAX_ROWS * N_COL * sizeof(_Float16));
+  A_tmp = malloc(MAX_ROWS * N_COL * sizeof(float));
+  if (!X_f32 || !X_f16 || !X_t || !W_f16 || !bias || !A_ref || !A_f32 || !A_f16 || !A_tmp) {
+    printf("ERROR allocation failed\n");
+    return 1;
+  }
+
+  // Initialization by random values. X values are representable in FP16, so both paths share the reference.
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < MAX_ROWS * N_INNER; k++) {
+    X_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX));
+    X_f32[k] = (float)X_f16[k];
+  }
+  for (size_t i = 0; i < MAX_ROWS; i++) {
+    for (size_t k = 0; k < N_INNER; k++) {
+      X_t[k * MAX_ROWS + i] = X_f32[i * N_INNER + k];
+    }
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  for (size_t j = 0; j < N_COL; j++) {
+    bias[j] = ((float)rand() / (float)RAND_MAX) - 0.5f;
+  }
+
+  /* -------  FP32 and FP16 activations, 1 .. MAX_ROWS rows ------*/
+  for (size_t n_row = 1; n_row <= MAX_ROWS; n_row++) {
+    double time_f32;
+
+    matmul_ref(n_row, N_COL, N_INNER, A_ref, X_f32, W_f16);
+
+    gettimeofday(&start, NULL);
+    for (int it = 0; it < N_ITER; it++) {
+      SDKL_CHECK(sdkl_cpu_mm_f32f16_f32(n_row, N_COL, N_INNER, A_f32, X_f32, W_f16));
+    }
+    gettimeofday(&end, NULL);
+    time_f32 = elapsed(start, end) / N_ITER;
+    printf("%zu row(s): %.1f us per call, %.2f GB/s of weights\n", n_row, time_f32 * 1e6,
+           (double)N_COL * N_INNER * sizeof(_Float16) / time_f32 / 1e9);
+    res &= check_f32("FP32", n_row, n_row * N_COL, A_ref, A_f32, 1e-5f);
+
+    SDKL_CHECK(sdkl_cpu_mm_f16f16_f16(n_row, N_COL, N_INNER, A_f16, X_f16, W_f16));
+    for (size_t i = 0; i < n_row * N_COL; i++) {
+      A_tmp[i] = (float)A_f16[i];
+    }
+    res &= check_f32("FP16", n_row, n_row * N_COL, A_ref, A_tmp, 2e-3f);
+  }
+
+  /* -------  Strided activations: a column-major X read through its strides ------*/
+  matmul_ref(3, N_COL, N_INNER, A_ref, X_f32, W_f16);
+  setup_tensor(&res_mat, A_f32, 3, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&left_mat, X_t, 3, N_INNER, SDKL_LAYOUT_2D_COL_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&right_mat, W_f16, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  left_mat.num_elements = MAX_ROWS * N_INNER;
+  left_mat.strides[0]   = 1;
+  left_mat.strides[1]   = MAX_ROWS;
+  SDKL_CHECK(sdkl_cpu_mm_tensor(&res_mat, &left_mat, &right_mat));
+  res &= check_f32("column-major X", 3, 3 * N_COL, A_ref, A_f32, 1e-5f);
+
+  /* -------  Epilogue on the GEMV path ------*/
+  matmul_ref(4, N_COL, N_INNER, A_ref, X_f32, W_f16);
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t j = 0; j < N_COL; j++) {
+      float v                = A_ref[i * N_COL + j] + bias[j];
+      A_ref[i * N_COL + j] = v > 0.f ? v : 0.f;
+    }
+  }
+  setup_tensor(&res_mat, A_f32, 4, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&left_mat, X_f32, 4, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  epilogue.bias       = bias;
+  epilogue.activation = SDKL_ACT_RELU;
+  epilogue.residual   = NULL;
+  SDKL_CHECK(sdkl_ext_mm_tensor_epilogue(SDKL_PLATFORM_CPU, &res_mat, &left_mat, &right_mat, &epilogue));
+  res &= check_f32("bias + ReLU", 4, 4 * N_COL, A_ref, A_f32, 1e-5f);
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  free(X_f32);
+  free(X_f16);
+  free(X_t);
+  free(W_f16);
+  free(bias);
+  free(A_ref);
+  free(A_f32);
+  free(A_f16);
+  free(A_tmp);
+
+  SDKL_CHECK(sdkl_cpu_finalize());
+
+  return res ? 0 : 1;
+}
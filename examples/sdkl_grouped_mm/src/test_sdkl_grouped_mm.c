@@ -0,0 +1,252 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_EXPERTS 8
+#define N_TOKENS  48
+#define TOP_K     2 // Experts per token
+#define N_ROWS    (N_TOKENS * TOP_K)
+#define N_COL     512
+#define N_INNER   1024
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+size_t offsets[N_EXPERTS + 1];
+_Float16* W_f16_npu[N_EXPERTS]; /* Per-expert FP16 weights in WH layout */
+uint8_t* W_i4_npu[N_EXPERTS];   /* Per-expert i4 weights in WH layout */
+int8_t* W_i8_cpu[N_EXPERTS];    /* Per-expert i4 values, row-major W[n_col][n_inner] */
+
+/*!
+  @brief
+  Compares SDKL API i32 result vs Standard C reference. Requires exact match
+*/
+bool sdkl_vector_check_i32(size_t size, int32_t* ref, int32_t* vec) {
+  for (size_t i = 0; i < size; i++) {
+    if (ref[i] != vec[i]) {
+      printf("ERROR ref[%ld] = %d vec[%ld] = %d\n", (long)i, ref[i], (long)i, vec[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_reference = 0;
+  bool res              = true;
+  int domain            = CDSP_DOMAIN_ID;
+  size_t counts[N_EXPERTS];
+
+  size_t n_col_32   = (N_COL + 31) & ~31;
+  size_t n_inner_32 = (N_INNER + 31) & ~31;
+  size_t A_f16_size = N_ROWS * N_COL * sizeof(_Float16);
+  size_t A_i32_size = N_ROWS * N_COL * sizeof(int32_t);
+  size_t X_f16_size = N_ROWS * N_INNER * sizeof(_Float16);
+  size_t X_u8_size  = N_ROWS * N_INNER * sizeof(uint8_t);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+  size_t W_i8_size  = n_col_32 * n_inner_32 * sizeof(int8_t);
+  size_t W_i4_size  = (n_col_32 * n_inner_32 + 1) / 2;
+
+  int32_t* A_i32_ref     = malloc(A_i32_size);
+  _Float16* A_f16_single = NULL;
+  _Float16* A_f16_npu    = NULL;
+  int32_t* A_i32_npu     = NULL;
+  _Float16* X_f16_npu    = NULL;
+  uint8_t* X_u8_npu      = NULL;
+
+  // Initialize SDKL
+  SDKL_CHECK(sdkl_npu_initialize(domain, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(domain, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_single));
+  SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_i32_size, (void**)&A_i32_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_f16_size, (void**)&X_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_u8_size, (void**)&X_u8_npu));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  // Route every token to TOP_K experts. Experts 3 and 6 receive no tokens.
+  memset(counts, 0, sizeof(counts));
+  for (size_t t = 0; t < N_TOKENS; t++) {
+    for (size_t r = 0; r < TOP_K; r++) {
+      size_t e;
+      do {
+        e = (size_t)rand() % N_EXPERTS;
+      } while (e == 3 || e == 6);
+      counts[e]++;
+    }
+  }
+  offsets[0] = 0;
+  for (size_t e = 0; e < N_EXPERTS; e++) {
+    offsets[e + 1] = offsets[e] + counts[e];
+  }
+
+  // Packed activations: rows of expert e are [offsets[e], offsets[e + 1])
+  for (size_t i = 0; i < N_ROWS * N_INNER; i++) {
+    X_f16_npu[i] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX));
+    X_u8_npu[i]  = (uint8_t)(rand() % 127);
+  }
+
+  for (size_t e = 0; e < N_EXPERTS; e++) {
+    W_f16_npu[e] = NULL;
+    W_i4_npu[e]  = NULL;
+    W_i8_cpu[e]  = NULL;
+    if (counts[e] == 0) {
+      continue; // weights of experts without tokens are never read
+    }
+
+    SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu[e]));
+    SDKL_CHECK(sdkl_npu_alloc(W_i4_size, (void**)&W_i4_npu[e]));
+    W_i8_cpu[e] = calloc(W_i8_size, 1);
+
+    for (size_t i = 0; i < N_COL * N_INNER; i++) {
+      W_f16_npu[e][i] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+    }
+    for (size_t i = 0; i < N_COL; i++) {
+      for (size_t j = 0; j < N_INNER; j++) {
+        W_i8_cpu[e][i * n_inner_32 + j] = (int8_t)(rand() % 16) - 8;
+      }
+    }
+
+    SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu[e]));
+    SDKL_CHECK(sdkl_cpu_rm_to_wh_i4(W_i4_npu[e], W_i8_cpu[e], n_inner_32, n_col_32));
+  }
+
+  for (size_t e = 0; e < N_EXPERTS; e++) {
+    printf("  expert %zu: %zu rows\n", e, counts[e]);
+  }
+
+  /* -------  One call per expert ------*/
+  gettimeofday(&start, NULL);
+  for (size_t e = 0; e < N_EXPERTS; e++) {
+    if (counts[e] > 0) {
+      SDKL_CHECK(sdkl_npu_mm_f16f16_f16(
+        domain,
+        counts[e],
+        N_COL,
+        N_INNER,
+        A_f16_single + offsets[e] * N_COL,
+        X_f16_npu + offsets[e] * N_INNER,
+        W_f16_npu[e]
+      ));
+    }
+  }
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("FP16 per-expert calls run %-.5lf s\n", time_reference);
+
+  /* -------  Grouped FP16 ------*/
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_grouped_mm_f16f16_f16(
+    domain, N_EXPERTS, offsets, N_COL, N_INNER, A_f16_npu, X_f16_npu, (const _Float16* const*)W_f16_npu
+  ));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("FP16 grouped matmul runs %-.5lf s\n", time_reference);
+
+  if (memcmp(A_f16_single, A_f16_npu, A_f16_size) != 0) {
+    printf("ERROR grouped FP16 results differ from per-expert calls\n");
+    res = false;
+  }
+
+  /* -------  Grouped i4 ------*/
+  for (size_t e = 0; e < N_EXPERTS; e++) {
+    size_t r0 = offsets[e];
+    for (size_t i = 0; i < counts[e]; i++) {
+      for (size_t j = 0; j < N_COL; j++) {
+        int32_t acc = 0;
+        for (size_t k = 0; k < N_INNER; k++) {
+          acc += (int32_t)X_u8_npu[(r0 + i) * N_INNER + k] * (int32_t)W_i8_cpu[e][j * n_inner_32 + k];
+        }
+        A_i32_ref[(r0 + i) * N_COL + j] = acc;
+      }
+    }
+  }
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_grouped_mm_u8i4_i32(
+    domain, N_EXPERTS, offsets, N_COL, N_INNER, A_i32_npu, X_u8_npu, (const uint8_t* const*)W_i4_npu
+  ));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("i4 grouped matmul runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_i32(N_ROWS * N_COL, A_i32_ref, A_i32_npu);
+
+  // Decreasing offsets must be rejected
+  offsets[1] = offsets[2] + 1;
+  res &= sdkl_grouped_mm_u8i4_i32(
+           domain, N_EXPERTS, offsets, N_COL, N_INNER, A_i32_npu, X_u8_npu, (const uint8_t* const*)W_i4_npu
+         ) == AEE_EBADPARM;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  for (size_t e = 0; e < N_EXPERTS; e++) {
+    if (counts[e] > 0) {
+      SDKL_CHECK(sdkl_npu_free(W_f16_npu[e]));
+      SDKL_CHECK(sdkl_npu_free(W_i4_npu[e]));
+      free(W_i8_cpu[e]);
+    }
+  }
+
+  free(A_i32_ref);
+
+  SDKL_CHECK(sdkl_npu_free(A_f16_single));
+  SDKL_CHECK(sdkl_npu_free(A_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(A_i32_npu));
+  SDKL_CHECK(sdkl_npu_free(X_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(X_u8_npu));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_npu_finalize(domain));
+
+  return res ? 0 : 1;
+}
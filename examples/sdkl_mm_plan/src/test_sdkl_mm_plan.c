@@ -0,0 +1,206 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ITER  1000
+#define N_ROW   4 // Decode-like shape, where per-call overhead matters most
+#define N_COL   256
+#define N_INNER 256
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+_Float16* X_f16[2];   /* Two input buffers, bound alternately as in a serving loop */
+float* X_f32[2];
+_Float16* W_f16;      /* Weights W[N_COL][N_INNER], row-major */
+_Float16* W_f16_npu;  /* Same weights in WH layout */
+_Float16* A_f16[2];   /* NPU results: sdkl_mm_tensor(), plan */
+float* A_f32[2];      /* CPU results: sdkl_cpu_mm_tensor(), plan */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_tensor, time_plan;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_mm_plan_t* plan;
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  for (int b = 0; b < 2; b++) {
+    SDKL_CHECK(sdkl_npu_alloc(N_ROW * N_INNER * sizeof(_Float16), (void**)&X_f16[b]));
+    SDKL_CHECK(sdkl_npu_alloc(N_ROW * N_INNER * sizeof(float), (void**)&X_f32[b]));
+    SDKL_CHECK(sdkl_npu_alloc(N_ROW * N_COL * sizeof(_Float16), (void**)&A_f16[b]));
+    SDKL_CHECK(sdkl_npu_alloc(N_ROW * N_COL * sizeof(float), (void**)&A_f32[b]));
+  }
+  SDKL_CHECK(sdkl_npu_alloc(N_COL * N_INNER * sizeof(_Float16), (void**)&W_f16));
+  SDKL_CHECK(sdkl_npu_alloc(N_COL * N_INNER * sizeof(_Float16), (void**)&W_f16_npu));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (int b = 0; b < 2; b++) {
+    for (size_t k = 0; k < N_ROW * N_INNER; k++) {
+      X_f32[b][k] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+      X_f16[b][k] = (_Float16)X_f32[b][k];
+    }
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  memcpy(W_f16_npu, W_f16, N_COL * N_INNER * sizeof(_Float16));
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+
+  /* -------  NPU: FP16 activations, HMX weights ------*/
+  setup_tensor(&res_mat, A_f16[0], N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  setup_tensor(&left_mat, X_f16[0], N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  setup_tensor(&right_mat, W_f16_npu, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, SDKL_DTYPE_FP16);
+  SDKL_CHECK(sdkl_mm_plan_create(platform_npu, &res_mat, &left_mat, &right_mat, &plan));
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITER; it++) {
+    left_mat.data = X_f16[it % 2];
+    SDKL_CHECK(sdkl_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat));
+  }
+  gettimeofday(&end, NULL);
+  time_tensor = elapsed(start, end);
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITER; it++) {
+    SDKL_CHECK(sdkl_mm_plan_execute(plan, A_f16[1], X_f16[it % 2], W_f16_npu));
+  }
+  gettimeofday(&end, NULL);
+  time_plan = elapsed(start, end);
+
+  printf("NPU sdkl_mm_tensor():       %8.2lf us per call\n", time_tensor * 1e6 / N_ITER);
+  printf("NPU sdkl_mm_plan_execute(): %8.2lf us per call\n", time_plan * 1e6 / N_ITER);
+  printf("NPU per-call time removed:  %8.2lf us\n", (time_tensor - time_plan) * 1e6 / N_ITER);
+  if (memcmp(A_f16[0], A_f16[1], N_ROW * N_COL * sizeof(_Float16)) != 0) {
+    printf("ERROR NPU plan results differ from sdkl_mm_tensor() results\n");
+    res = false;
+  }
+  SDKL_CHECK(sdkl_mm_plan_destroy(plan));
+
+  /* -------  CPU: FP32 activations, row-major FP16 weights ------*/
+  setup_tensor(&res_mat, A_f32[0], N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&left_mat, X_f32[0], N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&right_mat, W_f16, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  SDKL_CHECK(sdkl_mm_plan_create(SDKL_PLATFORM_CPU, &res_mat, &left_mat, &right_mat, &plan));
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITER; it++) {
+    left_mat.data = X_f32[it % 2];
+    SDKL_CHECK(sdkl_cpu_mm_tensor(&res_mat, &left_mat, &right_mat));
+  }
+  gettimeofday(&end, NULL);
+  time_tensor = elapsed(start, end);
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITER; it++) {
+    SDKL_CHECK(sdkl_mm_plan_execute(plan, A_f32[1], X_f32[it % 2], W_f16));
+  }
+  gettimeofday(&end, NULL);
+  time_plan = elapsed(start, end);
+
+  printf("CPU sdkl_cpu_mm_tensor():   %8.2lf us per call\n", time_tensor * 1e6 / N_ITER);
+  printf("CPU sdkl_mm_plan_execute(): %8.2lf us per call\n", time_plan * 1e6 / N_ITER);
+  printf("CPU per-call time removed:  %8.2lf us\n", (time_tensor - time_plan) * 1e6 / N_ITER);
+  if (memcmp(A_f32[0], A_f32[1], N_ROW * N_COL * sizeof(float)) != 0) {
+    printf("ERROR CPU plan results differ from sdkl_cpu_mm_tensor() results\n");
+    res = false;
+  }
+  SDKL_CHECK(sdkl_mm_plan_destroy(plan));
+
+  // Validation happens at creation
+  right_mat.dims[1] = N_INNER + 1;
+  res &= sdkl_mm_plan_create(SDKL_PLATFORM_CPU, &res_mat, &left_mat, &right_mat, &plan) != AEE_SUCCESS;
+  res &= sdkl_mm_plan_create(SDKL_PLATFORM_INVALID, &res_mat, &left_mat, &right_mat, &plan) == AEE_EBADPARM;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  for (int b = 0; b < 2; b++) {
+    SDKL_CHECK(sdkl_npu_free(X_f16[b]));
+    SDKL_CHECK(sdkl_npu_free(X_f32[b]));
+    SDKL_CHECK(sdkl_npu_free(A_f16[b]));
+    SDKL_CHECK(sdkl_npu_free(A_f32[b]));
+  }
+  SDKL_CHECK(sdkl_npu_free(W_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_cpu_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
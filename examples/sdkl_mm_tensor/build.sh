@@ -70,6 +70,9 @@ fi
 ALGO_NAME=$(basename "$(dirname "$(realpath "$0")")")
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 
+# SDKL extension sources, compiled together with the example
+SDKL_EXT_SRCS=$(ls $SCRIPT_DIR/../../src/sdkl_ext/*.c)
+
 if [ "$CPU_OS" == "android26" ]; then
   # Set march flags based on ARM_ARCH
   if [ "$ARM_ARCH" == "armv8" ]; then
@@ -90,10 +93,10 @@ if [ "$CPU_OS" == "android26" ]; then
 
   $CPU_CC  -target aarch64-linux-android26 \
           $MARCH_FLAGS -ffast-math -O3 \
-          -Wall -Wno-missing-braces  -I$SCRIPT_DIR/../../include  -I$HEXAGON_SDK_ROOT/incs \
+          -Wall -Wno-missing-braces  -I$SCRIPT_DIR/../../include -I$SCRIPT_DIR/../../src/sdkl_ext -I$HEXAGON_SDK_ROOT/incs \
           -fPIE -L$HEXAGON_SDK_ROOT/ipc/fastrpc/remote/ship/android_aarch64 \
           -L$ANDROID_ROOT_DIR/platforms/android-26/arch-arm64/usr/lib \
-          -L$SCRIPT_DIR/../../lib/${ARM_ARCH}_android26 $SCRIPT_DIR/src/test_$ALGO_NAME.c \
+          -L$SCRIPT_DIR/../../lib/${ARM_ARCH}_android26 $SCRIPT_DIR/src/test_$ALGO_NAME.c $SDKL_EXT_SRCS \
           -llog -lm -lcdsprpc -fPIE $SCRIPT_DIR/../../lib/${ARM_ARCH}_android26/libsdkl.so \
           -o $SCRIPT_DIR/build/${ARM_ARCH}_android26/test_$ALGO_NAME
 elif [ "$CPU_OS" == "qclinux" ]; then
@@ -116,10 +119,10 @@ elif [ "$CPU_OS" == "qclinux" ]; then
 
   mkdir -p $SCRIPT_DIR/build/${ARM_ARCH}_qclinux
 
-  $CPU_CC $MARCH_FLAGS  $SCRIPT_DIR/src/test_$ALGO_NAME.c $SCRIPT_DIR/../../lib/${ARM_ARCH}_qclinux/libsdkl.so \
+  $CPU_CC $MARCH_FLAGS  $SCRIPT_DIR/src/test_$ALGO_NAME.c $SDKL_EXT_SRCS $SCRIPT_DIR/../../lib/${ARM_ARCH}_qclinux/libsdkl.so \
            $HEXAGON_SDK_ROOT/ipc/fastrpc/remote/ship/UbuntuARM_aarch64/libcdsprpc.so \
           -fPIC -Wall -Wno-missing-braces -DVERIFY_PRINT_ERROR -DUSE_SYSLOG -std=gnu99 -O2 -fno-strict-aliasing \
-          -I$SCRIPT_DIR/../../include  -I$HEXAGON_SDK_ROOT/incs -isystem $LV_TOOLS_DIR/libc/usr/include  \
+          -I$SCRIPT_DIR/../../include -I$SCRIPT_DIR/../../src/sdkl_ext -I$HEXAGON_SDK_ROOT/incs -isystem $LV_TOOLS_DIR/libc/usr/include  \
           -L$LV_TOOLS_DIR/lib/gcc/aarch64-linux-gnu/7.5.0   -L$HEXAGON_SDK_ROOT/ipc/fastrpc/remote/ship/UbuntuARM_aarch64  \
-          -o $SCRIPT_DIR/build/${ARM_ARCH}_qclinux/test_$ALGO_NAME  -lm -lcdsprpc -lc -lstdc++ -lgcc_eh -lgcc
+          -o $SCRIPT_DIR/build/${ARM_ARCH}_qclinux/test_$ALGO_NAME  -lm -lpthread -lcdsprpc -lc -lstdc++ -lgcc_eh -lgcc
 fi
\ No newline at end of file
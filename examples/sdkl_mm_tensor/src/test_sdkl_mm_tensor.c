@@ -11,6 +11,7 @@
 #include <sys/time.h>  
 
 #include "sdkl.h"
+#include "sdkl_ext.h"
 
 /*!
  @brief to get SDKL version string from  sdkl_npu_get_version()
@@ -21,6 +22,11 @@ char version[SDKL_VERSION_STR_LEN];
 #define N_ROW   1024
 #define N_COL   3072
 #define N_INNER 8192
+
+/*!
+ @brief Throughput in GFLOPS of an N_ROW x N_COL x N_INNER matrix multiplication that ran in `seconds`
+*/
+#define MM_GFLOPS(seconds) (2.0 * N_ROW * N_COL * N_INNER / (seconds) / 1e9)
 /*!
  @brief Utility macro to check SDKL returns 0 and, if an error occurred,
         pretty-print the \ref error and exit on EXIT_FAILURE
@@ -575,7 +581,8 @@ void matmul_sdkl_scenario_4() {
 
   After executing the multiplication on the NPU, the same operation is repeated on the CPU using a separate output
   tensor. This allows direct performance comparison between hardware-accelerated and software-based execution paths
-  using identical input data and tensor configurations.
+  using identical input data and tensor configurations. The CPU run is done twice: by `sdkl_mm_tensor()` (single
+  thread) and by the multithreaded CPU engine through `sdkl_ext_mm_tensor()`, and both are reported in GFLOPS.
 
   The function configures tensor metadata including dimensions, strides, quantization type,
   and data layout, then invokes `sdkl_mm_tensor()` for both platforms.
@@ -585,8 +592,9 @@ void matmul_sdkl_scenario_4() {
   @see sdkl_mm_tensor
 */
 
-_Float16* A_f16_cpu_scenario_5  = NULL; /* SDKL CPU output */
-_Float16* A_f16_sdkl_scenario_5 = NULL; /* SDKL NPU output */
+_Float16* A_f16_cpu_scenario_5    = NULL; /* SDKL CPU output */
+_Float16* A_f16_cpu_mt_scenario_5 = NULL; /* SDKL CPU engine output */
+_Float16* A_f16_sdkl_scenario_5   = NULL; /* SDKL NPU output */
 
 /*!
   @brief
@@ -666,7 +674,27 @@ void matmul_sdkl_scenario_5() {
 
   time_reference = elapsed(start, end);
 
-  printf("Scenario 5, CPU Tensor single thread runs %-.5lf s\n", time_reference);
+  printf(
+    "Scenario 5, CPU Tensor single thread runs %-.5lf s (%.2lf GFLOPS)\n", time_reference, MM_GFLOPS(time_reference)
+  );
+
+  res_cpu_mat.data = A_f16_cpu_mt_scenario_5;
+
+  gettimeofday(&start, NULL);
+
+  /* Multithreaded CPU engine matrix multiplication */
+  SDKL_CHECK(sdkl_ext_mm_tensor(platform_cpu, &res_cpu_mat, &left_mat, &right_mat));
+
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+
+  printf(
+    "Scenario 5, CPU engine %u threads runs %-.5lf s (%.2lf GFLOPS)\n",
+    sdkl_cpu_get_num_threads(),
+    time_reference,
+    MM_GFLOPS(time_reference)
+  );
 }
 
 /*!
@@ -1082,20 +1110,25 @@ int main() {
   /* -------  SCENARIO 5 ------*/
   size_t A_f16_size_scenario_5 = ((N_ROW - 1) * res_stride + N_COL + res_offset) * sizeof(*A_f16_cpu_scenario_5);
 
-  A_f16_cpu_scenario_5  = malloc(A_f16_size_scenario_5);
-  A_f16_sdkl_scenario_5 = malloc(A_f16_size_scenario_5);
+  A_f16_cpu_scenario_5    = malloc(A_f16_size_scenario_5);
+  A_f16_cpu_mt_scenario_5 = malloc(A_f16_size_scenario_5);
+  A_f16_sdkl_scenario_5   = malloc(A_f16_size_scenario_5);
 
   memset(A_f16_sdkl_scenario_5, 0, A_f16_size_scenario_5);
   memset(A_f16_cpu_scenario_5, 0, A_f16_size_scenario_5);
+  memset(A_f16_cpu_mt_scenario_5, 0, A_f16_size_scenario_5);
 
   matmul_sdkl_scenario_5();
 
   // Check if the result differs from the reference
   res &= sdkl_vector_check_f16(A_f16_size_scenario_5 / sizeof(_Float16), A_f16_cpu_scenario_5, A_f16_sdkl_scenario_5);
+  res &= sdkl_vector_check_f16(A_f16_size_scenario_5 / sizeof(_Float16), A_f16_cpu_scenario_5, A_f16_cpu_mt_scenario_5);
 
   // Cleanup scenario 5 arrays
   if (A_f16_cpu_scenario_5)
     free(A_f16_cpu_scenario_5);
+  if (A_f16_cpu_mt_scenario_5)
+    free(A_f16_cpu_mt_scenario_5);
   if (A_f16_sdkl_scenario_5)
     free(A_f16_sdkl_scenario_5);
 
@@ -1239,6 +1272,7 @@ int main() {
     sdkl_npu_free(W_f16_npu);
 
   // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_cpu_finalize());
   SDKL_CHECK(sdkl_npu_finalize(platform_npu));
 
   return res ? 0 : 1;
@@ -0,0 +1,224 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_LAYERS 8
+#define N_ROW    128
+#define N_COL    2048
+#define N_INNER  4096
+#define Q_DEPTH  2
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+float* X_f32[N_LAYERS];      /* Raw per-layer inputs */
+_Float16* X_f16[N_LAYERS];   /* Prepared per-layer inputs */
+_Float16* A_f16_sync[N_LAYERS];
+_Float16* A_f16_async[N_LAYERS];
+_Float16* W_f16_npu = NULL;  /* Shared weights in WH layout */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief
+  CPU-side preparation of a layer input: RMS-normalizes every row and converts it to FP16.
+*/
+void prepare_input(const float* X, _Float16* Y) {
+  for (size_t i = 0; i < N_ROW; i++) {
+    const float* x = X + i * N_INNER;
+    float sum      = 0.f;
+
+    for (size_t k = 0; k < N_INNER; k++) {
+      sum += x[k] * x[k];
+    }
+    float scale = 1.f / sqrtf(sum / N_INNER + 1e-6f);
+    for (size_t k = 0; k < N_INNER; k++) {
+      Y[i * N_INNER + k] = (_Float16)(x[k] * scale);
+    }
+  }
+}
+
+/*!
+  @brief Fills the tensor descriptors of layer `l`.
+*/
+void setup_tensors(int l, _Float16* A, sdkl_tensor_t* res_mat, sdkl_tensor_t* left_mat, sdkl_tensor_t* right_mat) {
+  right_mat->data          = (void*)W_f16_npu;
+  right_mat->ndims         = 2;
+  right_mat->dims[0]       = N_INNER;
+  right_mat->dims[1]       = N_COL;
+  right_mat->num_elements  = N_INNER * N_COL;
+  right_mat->is_continuous = 1;
+  right_mat->quantization  = SDKL_QUANT_NONE;
+  right_mat->layout        = SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX;
+  right_mat->data_dtype    = SDKL_DTYPE_FP16;
+  right_mat->data_offset   = 0;
+  right_mat->strides[0]    = N_COL;
+  right_mat->strides[1]    = 1;
+
+  left_mat->data          = (void*)X_f16[l];
+  left_mat->ndims         = 2;
+  left_mat->dims[0]       = N_ROW;
+  left_mat->dims[1]       = N_INNER;
+  left_mat->num_elements  = N_ROW * N_INNER;
+  left_mat->is_continuous = 1;
+  left_mat->quantization  = SDKL_QUANT_NONE;
+  left_mat->layout        = SDKL_LAYOUT_2D_ROW_MAJOR;
+  left_mat->data_dtype    = SDKL_DTYPE_FP16;
+  left_mat->data_offset   = 0;
+  left_mat->strides[0]    = N_INNER;
+  left_mat->strides[1]    = 1;
+
+  res_mat->data          = (void*)A;
+  res_mat->ndims         = 2;
+  res_mat->dims[0]       = N_ROW;
+  res_mat->dims[1]       = N_COL;
+  res_mat->num_elements  = N_ROW * N_COL;
+  res_mat->is_continuous = 1;
+  res_mat->quantization  = SDKL_QUANT_NONE;
+  res_mat->layout        = SDKL_LAYOUT_2D_ROW_MAJOR;
+  res_mat->data_dtype    = SDKL_DTYPE_FP16;
+  res_mat->data_offset   = 0;
+  res_mat->strides[0]    = N_COL;
+  res_mat->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_sync, time_async;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_fence_t fence[N_LAYERS];
+
+  size_t X_f32_size = N_ROW * N_INNER * sizeof(float);
+  size_t X_f16_size = N_ROW * N_INNER * sizeof(_Float16);
+  size_t A_f16_size = N_ROW * N_COL * sizeof(_Float16);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+  for (int l = 0; l < N_LAYERS; l++) {
+    X_f32[l] = malloc(X_f32_size);
+    SDKL_CHECK(sdkl_npu_alloc(X_f16_size, (void**)&X_f16[l]));
+    SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_sync[l]));
+    SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_async[l]));
+  }
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    for (size_t i = 0; i < N_ROW * N_INNER; i++) {
+      X_f32[l][i] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+    }
+  }
+  for (size_t i = 0; i < N_COL * N_INNER; i++) {
+    W_f16_npu[i] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+
+  /* -------  Synchronous chain: prepare, then multiply ------*/
+  gettimeofday(&start, NULL);
+  for (int l = 0; l < N_LAYERS; l++) {
+    prepare_input(X_f32[l], X_f16[l]);
+    setup_tensors(l, A_f16_sync[l], &res_mat, &left_mat, &right_mat);
+    SDKL_CHECK(sdkl_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat));
+  }
+  gettimeofday(&end, NULL);
+
+  time_sync = elapsed(start, end);
+  printf("Synchronous chain of %d GEMMs runs %-.5lf s\n", N_LAYERS, time_sync);
+
+  /* -------  Asynchronous chain: prepare layer l + 1 while layer l runs on the NPU ------*/
+  SDKL_CHECK(sdkl_queue_set_depth(platform_npu, Q_DEPTH));
+
+  gettimeofday(&start, NULL);
+  prepare_input(X_f32[0], X_f16[0]);
+  for (int l = 0; l < N_LAYERS; l++) {
+    setup_tensors(l, A_f16_async[l], &res_mat, &left_mat, &right_mat);
+    SDKL_CHECK(sdkl_mm_tensor_async(platform_npu, &res_mat, &left_mat, &right_mat, &fence[l]));
+    if (l + 1 < N_LAYERS) {
+      prepare_input(X_f32[l + 1], X_f16[l + 1]);
+    }
+  }
+  for (int l = 0; l < N_LAYERS; l++) {
+    SDKL_CHECK(sdkl_fence_wait(&fence[l]));
+  }
+  gettimeofday(&end, NULL);
+
+  time_async = elapsed(start, end);
+  printf("Asynchronous chain of %d GEMMs, queue depth %d, runs %-.5lf s\n", N_LAYERS, Q_DEPTH, time_async);
+  printf("End-to-end speedup %.2lfx\n", time_sync / time_async);
+
+  // A completed fence polls to its status
+  res &= sdkl_fence_poll(&fence[N_LAYERS - 1]) == AEE_SUCCESS;
+
+  // Check that both chains produced the same results
+  for (int l = 0; l < N_LAYERS; l++) {
+    if (memcmp(A_f16_sync[l], A_f16_async[l], A_f16_size) != 0) {
+      printf("ERROR layer %d results differ\n", l);
+      res = false;
+    }
+  }
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_queue_finalize(platform_npu));
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    free(X_f32[l]);
+    SDKL_CHECK(sdkl_npu_free(X_f16[l]));
+    SDKL_CHECK(sdkl_npu_free(A_f16_sync[l]));
+    SDKL_CHECK(sdkl_npu_free(A_f16_async[l]));
+  }
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW_MAX  256
+#define N_COL      1024
+#define N_INNER    1024
+#define CACHE_PATH "sdkl_autotune_cache.txt"
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+static const size_t shapes[] = {1, 16, N_ROW_MAX}; // Decode to prefill numbers of rows
+#define N_SHAPES (sizeof(shapes) / sizeof(shapes[0]))
+
+static const char* strategy_names[SDKL_AUTOTUNE_INVALID] = {"CPU", "NPU", "NPU pre-laid"};
+
+float* X_f32;         /* Activations X[N_ROW_MAX][N_INNER] */
+_Float16* W_f16;      /* Weights W[N_COL][N_INNER], row-major */
+float* A_f32_ref;     /* Standard C reference */
+float* A_f32;         /* SDKL results */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+/*!
+  @brief Standard C reference: A = X * W^T
+*/
+void mm_ref(size_t n_row, size_t n_col, size_t n_inner, float* A, const float* X, const _Float16* W) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.0f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += X[i * n_inner + k] * (float)W[j * n_inner + k];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares SDKL API result vs Standard C reference. Tolerates 0.1% error, plus 0.001 absolute for values near zero
+*/
+bool sdkl_vector_check_f32(size_t size, float* ref, float* vec) {
+  bool res = true;
+  for (size_t i = 0; i < size; i++) {
+    float tolerance = fabsf(ref[i] / (float)1000.0f) + 1e-3f;
+
+    if (isnan(vec[i]) || isinf(vec[i]) || fabsf(ref[i] - vec[i]) > tolerance) {
+      res = false;
+      printf("ERROR ref[%ld] = %f vec[%ld] = %f\n", (long)i, (float)ref[i], (long)i, (float)vec[i]);
+      break;
+    }
+  }
+  return res;
+}
+
+/*!
+  @brief
+  Runs every shape once through the autotuner, checks the results and whether tuning happened, and records the
+  strategies in `strategies`
+*/
+static bool run_shapes(
+  const sdkl_weights_t* weights,
+  bool expect_tuning,
+  sdkl_autotune_strategy_e strategies[N_SHAPES]
+) {
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_autotune_info_t info;
+  bool res = true;
+
+  setup_tensor(&right_mat, W_f16, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+
+  for (size_t s = 0; s < N_SHAPES; s++) {
+    size_t n_row = shapes[s];
+    uint64_t start, end;
+    struct timeval tv;
+
+    setup_tensor(&res_mat, A_f32, n_row, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+    setup_tensor(&left_mat, X_f32, n_row, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+    memset(A_f32, 0, n_row * N_COL * sizeof(float));
+
+    gettimeofday(&tv, NULL);
+    start = (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    SDKL_CHECK(sdkl_ext_mm_tensor_autotune(platform_npu, &res_mat, &left_mat, &right_mat, weights, &info));
+    gettimeofday(&tv, NULL);
+    end = (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+
+    if (info.tuned) {
+      printf(
+        "N_ROW %3zu: tuned in %7llu us (CPU %llu us, NPU %llu us, NPU pre-laid %llu us) -> %s\n",
+        n_row,
+        (unsigned long long)(end - start),
+        (unsigned long long)info.us[SDKL_AUTOTUNE_CPU],
+        (unsigned long long)info.us[SDKL_AUTOTUNE_NPU],
+        (unsigned long long)info.us[SDKL_AUTOTUNE_NPU_PRELAID],
+        strategy_names[info.strategy]
+      );
+    } else {
+      printf(
+        "N_ROW %3zu: cached   %7llu us -> %s\n", n_row, (unsigned long long)(end - start), strategy_names[info.strategy]
+      );
+    }
+
+    if ((bool)info.tuned != expect_tuning) {
+      printf("ERROR N_ROW %zu: expected %s\n", n_row, expect_tuning ? "tuning" : "a cached decision");
+      res = false;
+    }
+    if (!expect_tuning && info.strategy != strategies[s]) {
+      printf("ERROR N_ROW %zu: cached strategy differs from the tuned one\n", n_row);
+      res = false;
+    }
+    strategies[s] = info.strategy;
+    res &= sdkl_vector_check_f32(n_row * N_COL, A_f32_ref, A_f32);
+  }
+
+  return res;
+}
+
+int main() {
+  bool res = true;
+  sdkl_weights_t* weights;
+  sdkl_autotune_strategy_e strategies[N_SHAPES];
+  char line[256];
+  int n_lines = 0;
+  FILE* f;
+
+  size_t X_f32_size = N_ROW_MAX * N_INNER * sizeof(float);
+  size_t A_f32_size = N_ROW_MAX * N_COL * sizeof(float);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU and the autotuner, starting from an empty cache
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+  unlink(CACHE_PATH);
+  SDKL_CHECK(sdkl_autotune_initialize(CACHE_PATH));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(X_f32_size, (void**)&X_f32));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16));
+  SDKL_CHECK(sdkl_npu_alloc(A_f32_size, (void**)&A_f32));
+  A_f32_ref = malloc(A_f32_size);
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < N_ROW_MAX * N_INNER; k++) {
+    X_f32[k] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  mm_ref(N_ROW_MAX, N_COL, N_INNER, A_f32_ref, X_f32, W_f16);
+  SDKL_CHECK(sdkl_weights_create(platform_npu, SDKL_DTYPE_FP16, N_COL, N_INNER, W_f16, &weights));
+
+  /* -------  First sight of each shape: every strategy is benchmarked ------*/
+  printf("First run:\n");
+  res &= run_shapes(weights, true, strategies);
+
+  /* -------  Same process: decisions are reused ------*/
+  printf("Second run:\n");
+  res &= run_shapes(weights, false, strategies);
+
+  /* -------  Restart: decisions are loaded from the cache file ------*/
+  SDKL_CHECK(sdkl_autotune_finalize());
+  SDKL_CHECK(sdkl_autotune_initialize(CACHE_PATH));
+  printf("After reloading %s:\n", CACHE_PATH);
+  res &= run_shapes(weights, false, strategies);
+
+  f = fopen(CACHE_PATH, "r");
+  if (f != NULL) {
+    while (fgets(line, sizeof(line), f) != NULL) {
+      n_lines += line[0] != '#';
+    }
+    fclose(f);
+  }
+  if (n_lines != (int)N_SHAPES) {
+    printf("ERROR %s holds %d decisions\n", CACHE_PATH, n_lines);
+    res = false;
+  }
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_weights_destroy(weights));
+  SDKL_CHECK(sdkl_npu_free(X_f32));
+  SDKL_CHECK(sdkl_npu_free(W_f16));
+  SDKL_CHECK(sdkl_npu_free(A_f32));
+  free(A_f32_ref);
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_autotune_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
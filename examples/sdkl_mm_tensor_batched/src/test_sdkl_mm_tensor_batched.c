@@ -0,0 +1,191 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_LAYERS 8
+#define N_PROJ   3 // Q, K and V projections share the layer input
+#define N_ITEMS  (N_LAYERS * N_PROJ)
+#define N_ROW    8 // Decode-like number of rows
+#define N_COL    512
+#define N_INNER  1024
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+_Float16* X_f16[N_LAYERS];       /* Per-layer inputs */
+_Float16* W_f16_npu[N_ITEMS];    /* Per-projection weights in WH layout */
+_Float16* A_f16_single[N_ITEMS]; /* Results of separate calls */
+_Float16* A_f16_batch[N_ITEMS];  /* Results of the batch */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+sdkl_tensor_t res_mat[N_ITEMS], left_mat[N_ITEMS], right_mat[N_ITEMS];
+uint64_t item_us[N_ITEMS];
+
+/*!
+  @brief Fills a 2D row-major tensor descriptor.
+*/
+void setup_tensor(sdkl_tensor_t* t, void* data, size_t n_row, size_t n_col, sdkl_tensor_layout_e layout) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = SDKL_DTYPE_FP16;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_single;
+  bool res = true;
+  sdkl_batch_timing_t timing;
+
+  size_t X_f16_size = N_ROW * N_INNER * sizeof(_Float16);
+  size_t A_f16_size = N_ROW * N_COL * sizeof(_Float16);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    SDKL_CHECK(sdkl_npu_alloc(X_f16_size, (void**)&X_f16[l]));
+  }
+  for (int i = 0; i < N_ITEMS; i++) {
+    SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu[i]));
+    SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_single[i]));
+    SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_batch[i]));
+  }
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    for (size_t k = 0; k < N_ROW * N_INNER; k++) {
+      X_f16[l][k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX));
+    }
+  }
+  for (int i = 0; i < N_ITEMS; i++) {
+    for (size_t k = 0; k < N_COL * N_INNER; k++) {
+      W_f16_npu[i][k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+    }
+    SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu[i]));
+  }
+
+  for (int i = 0; i < N_ITEMS; i++) {
+    setup_tensor(&res_mat[i], A_f16_single[i], N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR);
+    setup_tensor(&left_mat[i], X_f16[i / N_PROJ], N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR);
+    setup_tensor(&right_mat[i], W_f16_npu[i], N_INNER, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX);
+  }
+
+  /* -------  One call per matmul ------*/
+  gettimeofday(&start, NULL);
+  for (int i = 0; i < N_ITEMS; i++) {
+    SDKL_CHECK(sdkl_mm_tensor(platform_npu, &res_mat[i], &left_mat[i], &right_mat[i]));
+  }
+  gettimeofday(&end, NULL);
+
+  time_single = elapsed(start, end);
+  printf("%d separate calls run %-.5lf s (%.1lf us/call)\n", N_ITEMS, time_single, time_single * 1e6 / N_ITEMS);
+
+  /* -------  Batch ------*/
+  for (int i = 0; i < N_ITEMS; i++) {
+    res_mat[i].data = A_f16_batch[i];
+  }
+
+  SDKL_CHECK(sdkl_mm_tensor_batched(platform_npu, N_ITEMS, res_mat, left_mat, right_mat, item_us, &timing));
+
+  printf(
+    "Batch of %d matmuls runs %-.5lf s (%.1lf us/item), %u shared buffers mapped in %.1lf us\n",
+    N_ITEMS,
+    timing.total_us / 1e6,
+    (double)timing.total_us / N_ITEMS,
+    timing.n_mapped,
+    (double)timing.map_us
+  );
+  for (int i = 0; i < N_ITEMS; i++) {
+    printf("  item %2d: %llu us\n", i, (unsigned long long)item_us[i]);
+  }
+  printf("Speedup vs separate calls %.2lfx\n", time_single * 1e6 / timing.total_us);
+
+  // Check that the batch produced the same results as separate calls
+  for (int i = 0; i < N_ITEMS; i++) {
+    if (memcmp(A_f16_single[i], A_f16_batch[i], A_f16_size) != 0) {
+      printf("ERROR item %d results differ\n", i);
+      res = false;
+    }
+  }
+
+  // An invalid descriptor anywhere in the batch must be rejected before any item executes
+  memset(A_f16_batch[0], 0, A_f16_size);
+  left_mat[N_ITEMS - 1].dims[1] = N_INNER / 2;
+  res &= sdkl_mm_tensor_batched(platform_npu, N_ITEMS, res_mat, left_mat, right_mat, NULL, NULL) != AEE_SUCCESS;
+  for (size_t k = 0; k < N_ROW * N_COL; k++) {
+    res &= A_f16_batch[0][k] == 0;
+  }
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  for (int l = 0; l < N_LAYERS; l++) {
+    SDKL_CHECK(sdkl_npu_free(X_f16[l]));
+  }
+  for (int i = 0; i < N_ITEMS; i++) {
+    SDKL_CHECK(sdkl_npu_free(W_f16_npu[i]));
+    SDKL_CHECK(sdkl_npu_free(A_f16_single[i]));
+    SDKL_CHECK(sdkl_npu_free(A_f16_batch[i]));
+  }
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW   64
+#define N_COL   1024
+#define N_INNER 1024
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+static float activate_ref(float x, sdkl_activation_e activation) {
+  switch (activation) {
+    case SDKL_ACT_RELU:
+      return x > 0.f ? x : 0.f;
+    case SDKL_ACT_SILU:
+      return x / (1.f + expf(-x));
+    case SDKL_ACT_GELU:
+      return 0.5f * x * (1.f + tanhf(0.7978845608f * (x + 0.044715f * x * x * x)));
+    default:
+      return x;
+  }
+}
+
+// Matrix multiplication A = X * W^T
+__attribute__((noinline)) void matmul_f32f16_f32(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* A,         // A[n_row][n_col]
+  const float* X,   // X[n_row][n_inner]
+  const _Float16* W // W[n_col][n_inner]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += X[i * n_inner + k] * (float)W[j * n_inner + k];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+// Epilogue A = act(A + bias) + residual, applied as a separate pass over A
+__attribute__((noinline)) void epilogue_f32(
+  size_t n_row,
+  size_t n_col,
+  float* A,              // A[n_row][n_col]
+  const float* bias,     // bias[n_col]
+  sdkl_activation_e act, // activation
+  const float* R         // R[n_row][n_col]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      A[i * n_col + j] = activate_ref(A[i * n_col + j] + bias[j], act) + R[i * n_col + j];
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares SDKL API result vs Standard C reference. Tolerates 0.1% error, plus 0.001 absolute for values near zero
+*/
+bool sdkl_vector_check_f32(size_t size, float* ref, float* vec) {
+  bool res = true;
+  for (size_t i = 0; i < size; i++) {
+    float tolerance = fabsf(ref[i] / (float)1000.0f) + 1e-3f;
+
+    if (isnan(vec[i]) || isinf(vec[i]) || fabsf(ref[i] - vec[i]) > tolerance) {
+      res = false;
+      printf("ERROR ref[%ld] = %f vec[%ld] = %f\n", (long)i, (float)ref[i], (long)i, (float)vec[i]);
+      break;
+    }
+  }
+  return res;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+static void set_tensor_2d(sdkl_tensor_t* t, void* data, sdkl_tensor_dtype_e dtype, size_t dim0, size_t dim1) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = dim0;
+  t->dims[1]       = dim1;
+  t->num_elements  = dim0 * dim1;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = SDKL_LAYOUT_2D_ROW_MAJOR;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = dim1;
+  t->strides[1]    = 1;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_reference = 0;
+  bool res              = true;
+  int domain            = CDSP_DOMAIN_ID;
+
+  sdkl_tensor_platform_e platform_cpu = SDKL_PLATFORM_CPU;
+  sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+  sdkl_tensor_t res_mat, left_mat, right_mat, residual_mat;
+  sdkl_epilogue_t epilogue;
+
+  size_t A_size  = N_ROW * N_COL * sizeof(float);
+  size_t X_size  = N_ROW * N_INNER * sizeof(float);
+  size_t W_size  = N_COL * N_INNER * sizeof(_Float16);
+  size_t R_size  = N_ROW * N_COL * sizeof(float);
+  size_t Rh_size = N_ROW * N_COL * sizeof(_Float16);
+
+  float* A_ref     = malloc(A_size);
+  float* A_silu    = malloc(A_size);
+  float* A_gelu    = malloc(A_size);
+  float* bias      = malloc(N_COL * sizeof(float));
+  float* R_f32_ref = malloc(R_size);
+
+  float* A_npu        = NULL;
+  float* X_npu        = NULL;
+  _Float16* W_npu     = NULL;
+  float* R_f32_npu    = NULL;
+  _Float16* R_f16_npu = NULL;
+
+  // Initialize SDKL
+  SDKL_CHECK(sdkl_npu_initialize(domain, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(domain, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(A_size, (void**)&A_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_size, (void**)&X_npu));
+  SDKL_CHECK(sdkl_npu_alloc(W_size, (void**)&W_npu));
+  SDKL_CHECK(sdkl_npu_alloc(R_size, (void**)&R_f32_npu));
+  SDKL_CHECK(sdkl_npu_alloc(Rh_size, (void**)&R_f16_npu));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t i = 0; i < N_ROW * N_INNER; i++) {
+    X_npu[i] = ((float)rand() / (float)RAND_MAX) - 0.5f;
+  }
+  for (size_t i = 0; i < N_COL * N_INNER; i++) {
+    W_npu[i] = ((float)rand() / (float)RAND_MAX) - 0.5f;
+  }
+  for (size_t j = 0; j < N_COL; j++) {
+    bias[j] = 4.f * ((float)rand() / (float)RAND_MAX) - 2.f;
+  }
+  for (size_t i = 0; i < N_ROW * N_COL; i++) {
+    R_f16_npu[i] = ((float)rand() / (float)RAND_MAX) - 0.5f;
+    R_f32_npu[i] = (float)R_f16_npu[i];
+    R_f32_ref[i] = R_f32_npu[i];
+  }
+
+  set_tensor_2d(&left_mat, X_npu, SDKL_DTYPE_FP32, N_ROW, N_INNER);
+  set_tensor_2d(&right_mat, W_npu, SDKL_DTYPE_FP16, N_INNER, N_COL);
+
+  /* -------  Unfused reference on the CPU engine: GEMM, then a separate epilogue pass ------*/
+  set_tensor_2d(&res_mat, A_ref, SDKL_DTYPE_FP32, N_ROW, N_COL);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor(platform_cpu, &res_mat, &left_mat, &right_mat));
+  epilogue_f32(N_ROW, N_COL, A_ref, bias, SDKL_ACT_SILU, R_f32_ref);
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("CPU engine GEMM + separate bias/SiLU/residual pass runs %-.5lf s\n", time_reference);
+
+  /* -------  Fused epilogue on the CPU engine ------*/
+  set_tensor_2d(&res_mat, A_silu, SDKL_DTYPE_FP32, N_ROW, N_COL);
+  set_tensor_2d(&residual_mat, R_f32_npu, SDKL_DTYPE_FP32, N_ROW, N_COL);
+
+  epilogue.bias       = bias;
+  epilogue.activation = SDKL_ACT_SILU;
+  epilogue.residual   = &residual_mat;
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_epilogue(platform_cpu, &res_mat, &left_mat, &right_mat, &epilogue));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("CPU engine GEMM with fused bias/SiLU/residual runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_ref, A_silu);
+
+  /* -------  NPU with FP16 residual and GELU ------*/
+  set_tensor_2d(&res_mat, A_gelu, SDKL_DTYPE_FP32, N_ROW, N_COL);
+  SDKL_CHECK(sdkl_ext_mm_tensor(platform_cpu, &res_mat, &left_mat, &right_mat));
+  epilogue_f32(N_ROW, N_COL, A_gelu, bias, SDKL_ACT_GELU, R_f32_ref);
+
+  set_tensor_2d(&res_mat, A_npu, SDKL_DTYPE_FP32, N_ROW, N_COL);
+  set_tensor_2d(&residual_mat, R_f16_npu, SDKL_DTYPE_FP16, N_ROW, N_COL);
+
+  epilogue.activation = SDKL_ACT_GELU;
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_epilogue(platform_npu, &res_mat, &left_mat, &right_mat, &epilogue));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("NPU GEMM with bias/GELU/residual epilogue runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_gelu, A_npu);
+
+  /* -------  Invalid epilogues must be rejected ------*/
+  set_tensor_2d(&residual_mat, R_f16_npu, SDKL_DTYPE_FP16, N_ROW / 2, N_COL);
+  res &= sdkl_ext_mm_tensor_epilogue(platform_cpu, &res_mat, &left_mat, &right_mat, &epilogue) != 0;
+
+  epilogue.residual   = NULL;
+  epilogue.activation = SDKL_ACT_INVALID;
+  res &= sdkl_ext_mm_tensor_epilogue(platform_cpu, &res_mat, &left_mat, &right_mat, &epilogue) != 0;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  free(A_ref);
+  free(A_silu);
+  free(A_gelu);
+  free(bias);
+  free(R_f32_ref);
+
+  SDKL_CHECK(sdkl_npu_free(A_npu));
+  SDKL_CHECK(sdkl_npu_free(X_npu));
+  SDKL_CHECK(sdkl_npu_free(W_npu));
+  SDKL_CHECK(sdkl_npu_free(R_f32_npu));
+  SDKL_CHECK(sdkl_npu_free(R_f16_npu));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_cpu_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(domain));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW       64
+#define N_COL       2048
+#define N_INNER     1024
+#define N_ITER      10 // Adaptive calls
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+float* X_f32;         /* Activations X[N_ROW][N_INNER] */
+_Float16* W_f16;      /* Weights W[N_COL][N_INNER], row-major */
+_Float16* W_f16_npu;  /* Same weights in WH layout */
+float* A_f32_ref;     /* Standard C reference */
+float* A_f32;         /* SDKL results */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+/*!
+  @brief Standard C reference: A = X * W^T
+*/
+void mm_ref(size_t n_row, size_t n_col, size_t n_inner, float* A, const float* X, const _Float16* W) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.0f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += X[i * n_inner + k] * (float)W[j * n_inner + k];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares SDKL API result vs Standard C reference. Tolerates 0.1% error, plus 0.001 absolute for values near zero
+*/
+bool sdkl_vector_check_f32(size_t size, float* ref, float* vec) {
+  bool res = true;
+  for (size_t i = 0; i < size; i++) {
+    float tolerance = fabsf(ref[i] / (float)1000.0f) + 1e-3f;
+
+    if (isnan(vec[i]) || isinf(vec[i]) || fabsf(ref[i] - vec[i]) > tolerance) {
+      res = false;
+      printf("ERROR ref[%ld] = %f vec[%ld] = %f\n", (long)i, (float)ref[i], (long)i, (float)vec[i]);
+      break;
+    }
+  }
+  return res;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_npu, time_cpu;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat, right_mat_npu;
+  sdkl_hetero_config_t config;
+  sdkl_hetero_info_t info;
+  sdkl_hetero_t* hetero;
+
+  size_t X_f32_size = N_ROW * N_INNER * sizeof(float);
+  size_t A_f32_size = N_ROW * N_COL * sizeof(float);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(X_f32_size, (void**)&X_f32));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_f32_size, (void**)&A_f32));
+  A_f32_ref = malloc(A_f32_size);
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < N_ROW * N_INNER; k++) {
+    X_f32[k] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  memcpy(W_f16_npu, W_f16, W_f16_size);
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+  mm_ref(N_ROW, N_COL, N_INNER, A_f32_ref, X_f32, W_f16);
+
+  setup_tensor(&res_mat, A_f32, N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&left_mat, X_f32, N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&right_mat, W_f16, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  setup_tensor(&right_mat_npu, W_f16_npu, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, SDKL_DTYPE_FP16);
+
+  /* -------  Each backend alone ------*/
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat_npu));
+  gettimeofday(&end, NULL);
+  time_npu = elapsed(start, end);
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_cpu_mm_tensor(&res_mat, &left_mat, &right_mat));
+  gettimeofday(&end, NULL);
+  time_cpu = elapsed(start, end);
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+
+  printf("NPU alone: %-.5lf s\n", time_npu);
+  printf("CPU alone: %-.5lf s\n", time_cpu);
+
+  /* -------  Fixed split: a quarter of the columns on the CPU ------*/
+  config.npu_platform = platform_npu;
+  config.cpu_fraction = 0.25f;
+  config.adaptive     = 0;
+  SDKL_CHECK(sdkl_hetero_create(&config, &hetero));
+
+  memset(A_f32, 0, A_f32_size);
+  SDKL_CHECK(sdkl_ext_mm_tensor_hetero(hetero, &res_mat, &left_mat, &right_mat));
+  SDKL_CHECK(sdkl_hetero_get_info(hetero, &info));
+  printf("Fixed split at column %llu: %-.5lf s\n", (unsigned long long)info.split, info.last_us / 1000000.);
+
+  res &= info.split == N_COL * 3 / 4;
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  SDKL_CHECK(sdkl_hetero_destroy(hetero));
+
+  /* -------  Adaptive split ------*/
+  config.cpu_fraction = 0.5f;
+  config.adaptive     = 1;
+  SDKL_CHECK(sdkl_hetero_create(&config, &hetero));
+
+  for (int it = 0; it < N_ITER; it++) {
+    memset(A_f32, 0, A_f32_size);
+    SDKL_CHECK(sdkl_ext_mm_tensor_hetero(hetero, &res_mat, &left_mat, &right_mat));
+    SDKL_CHECK(sdkl_hetero_get_info(hetero, &info));
+    printf(
+      "Adaptive call %2d: split at column %4llu, %-.5lf s, next CPU fraction %.3f (CPU %.1f, NPU %.1f elem/us)\n",
+      it,
+      (unsigned long long)info.split,
+      info.last_us / 1000000.,
+      info.cpu_fraction,
+      info.cpu_rate,
+      info.npu_rate
+    );
+    res &= sdkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32);
+  }
+  res &= info.cpu_rate > 0.0f && info.npu_rate > 0.0f && info.cpu_fraction > 0.0f && info.cpu_fraction < 1.0f;
+  printf(
+    "Speedup over NPU alone %.2lfx, over CPU alone %.2lfx\n",
+    time_npu / (info.last_us / 1000000.),
+    time_cpu / (info.last_us / 1000000.)
+  );
+
+  // HMX weights can neither be split nor read by the CPU engine
+  res &= sdkl_ext_mm_tensor_hetero(hetero, &res_mat, &left_mat, &right_mat_npu) == AEE_EUNSUPPORTED;
+  SDKL_CHECK(sdkl_hetero_destroy(hetero));
+
+  config.npu_platform = SDKL_PLATFORM_CPU;
+  res &= sdkl_hetero_create(&config, &hetero) == AEE_EBADPARM;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_npu_free(X_f32));
+  SDKL_CHECK(sdkl_npu_free(W_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(A_f32));
+  free(A_f32_ref);
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_queue_finalize(platform_npu));
+  SDKL_CHECK(sdkl_cpu_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+#define N_BATCH 2  // Sequences sharing the keys of every head
+#define N_HEADS 16 // Attention heads
+#define N_SEQ   128
+#define N_DIM   64
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+float* Q;           /* Q[N_BATCH][N_HEADS][N_SEQ][N_DIM] */
+float* K;           /* K[N_HEADS][N_SEQ][N_DIM] */
+float* S_head;      /* S[N_HEADS][N_SEQ][N_SEQ], one call per head */
+float* S_nd;        /* S[N_HEADS][N_SEQ][N_SEQ], one N-dimensional call */
+float* S_broadcast; /* S[N_BATCH][N_HEADS][N_SEQ][N_SEQ], queries of every batch against the shared keys */
+
+sdkl_tensor_platform_e platform_cpu = SDKL_PLATFORM_CPU;
+
+/*!
+  @brief Fills a 2D row-major FP32 tensor descriptor over `num_elements` elements.
+*/
+void setup_tensor(sdkl_tensor_t* t, void* data, size_t n_row, size_t n_col, size_t num_elements) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = num_elements;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = SDKL_LAYOUT_2D_ROW_MAJOR;
+  t->data_dtype    = SDKL_DTYPE_FP32;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+/*!
+  @brief Fills an N-dimensional FP32 tensor descriptor of contiguous `n_row` x `n_col` matrices.
+*/
+void setup_tensor_nd(
+  sdkl_tensor_nd_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  uint8_t n_batch_dims,
+  const uint64_t* batch_dims
+) {
+  size_t num_elements = n_row * n_col;
+
+  memset(t, 0, sizeof(*t));
+  t->n_batch_dims = n_batch_dims;
+  for (int d = n_batch_dims - 1; d >= 0; d--) {
+    t->batch_dims[d]    = batch_dims[d];
+    t->batch_strides[d] = num_elements;
+    num_elements *= batch_dims[d];
+  }
+  setup_tensor(&t->matrix, data, n_row, n_col, num_elements);
+}
+
+// Reference scores of one head S = Q * K^T
+__attribute__((noinline)) void scores_ref(
+  float* S,       // S[N_SEQ][N_SEQ]
+  const float* q, // q[N_SEQ][N_DIM]
+  const float* k  // k[N_SEQ][N_DIM]
+) {
+  for (size_t i = 0; i < N_SEQ; i++) {
+    for (size_t j = 0; j < N_SEQ; j++) {
+      double acc = 0.;
+      for (size_t d = 0; d < N_DIM; d++) {
+        acc += (double)q[i * N_DIM + d] * k[j * N_DIM + d];
+      }
+      S[i * N_SEQ + j] = (float)acc;
+    }
+  }
+}
+
+static bool check_scores(const char* name, const float* S, const float* q, const float* k, float* S_ref) {
+  scores_ref(S_ref, q, k);
+  for (size_t i = 0; i < N_SEQ * N_SEQ; i++) {
+    if (fabsf(S[i] - S_ref[i]) > 1e-3f * N_DIM) {
+      printf("ERROR %s element %zu: %f expected %f\n", name, i, S[i], S_ref[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_head, time_nd;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_tensor_nd_t res_nd, left_nd, right_nd;
+
+  const uint64_t heads_dims[1] = {N_HEADS};
+  const uint64_t batch_dims[2] = {N_BATCH, N_HEADS};
+  const size_t head_q          = N_SEQ * N_DIM;
+  const size_t head_s          = N_SEQ * N_SEQ;
+
+  Q           = malloc(N_BATCH * N_HEADS * head_q * sizeof(float));
+  K           = malloc(N_HEADS * head_q * sizeof(float));
+  S_head      = malloc(N_HEADS * head_s * sizeof(float));
+  S_nd        = malloc(N_HEADS * head_s * sizeof(float));
+  S_broadcast = malloc(N_BATCH * N_HEADS * head_s * sizeof(float));
+  float* S_ref = malloc(head_s * sizeof(float));
+  if (!Q || !K || !S_head || !S_nd || !S_broadcast || !S_ref) {
+    printf("ERROR allocating buffers\n");
+    return 1;
+  }
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t i = 0; i < N_BATCH * N_HEADS * head_q; i++) {
+    Q[i] = ((float)rand() / (float)RAND_MAX) - 0.5f;
+  }
+  for (size_t i = 0; i < N_HEADS * head_q; i++) {
+    K[i] = ((float)rand() / (float)RAND_MAX) - 0.5f;
+  }
+
+  /* -------  One call per head ------*/
+  gettimeofday(&start, NULL);
+  for (int h = 0; h < N_HEADS; h++) {
+    setup_tensor(&res_mat, S_head + h * head_s, N_SEQ, N_SEQ, head_s);
+    setup_tensor(&left_mat, Q + h * head_q, N_SEQ, N_DIM, head_q);
+    setup_tensor(&right_mat, K + h * head_q, N_SEQ, N_DIM, head_q); // K[seq][dim] multiplies as K^T
+    SDKL_CHECK(sdkl_ext_mm_tensor(platform_cpu, &res_mat, &left_mat, &right_mat));
+  }
+  gettimeofday(&end, NULL);
+  time_head = elapsed(start, end);
+
+  /* -------  One call over [heads][seq][dim] ------*/
+  setup_tensor_nd(&res_nd, S_nd, N_SEQ, N_SEQ, 1, heads_dims);
+  setup_tensor_nd(&left_nd, Q, N_SEQ, N_DIM, 1, heads_dims);
+  setup_tensor_nd(&right_nd, K, N_SEQ, N_DIM, 1, heads_dims);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_nd(platform_cpu, &res_nd, &left_nd, &right_nd));
+  gettimeofday(&end, NULL);
+  time_nd = elapsed(start, end);
+
+  printf("%d heads, one call per head:  %-.5lf s\n", N_HEADS, time_head);
+  printf("%d heads, one N-D call:       %-.5lf s\n", N_HEADS, time_nd);
+  printf("Speedup %.2lfx\n", time_head / time_nd);
+
+  if (memcmp(S_head, S_nd, N_HEADS * head_s * sizeof(float)) != 0) {
+    printf("ERROR N-D results differ from per-head results\n");
+    res = false;
+  }
+  for (int h = 0; h < N_HEADS; h += N_HEADS - 1) {
+    res &= check_scores("N-D", S_nd + h * head_s, Q + h * head_q, K + h * head_q, S_ref);
+  }
+
+  /* -------  Broadcasting: [batch][heads] queries against [heads] keys ------*/
+  setup_tensor_nd(&res_nd, S_broadcast, N_SEQ, N_SEQ, 2, batch_dims);
+  setup_tensor_nd(&left_nd, Q, N_SEQ, N_DIM, 2, batch_dims);
+  setup_tensor_nd(&right_nd, K, N_SEQ, N_DIM, 1, heads_dims);
+
+  SDKL_CHECK(sdkl_ext_mm_tensor_nd(platform_cpu, &res_nd, &left_nd, &right_nd));
+
+  for (int b = 0; b < N_BATCH; b++) {
+    for (int h = 0; h < N_HEADS; h += N_HEADS - 1) {
+      const float* S = S_broadcast + (b * N_HEADS + h) * head_s;
+      res &= check_scores("broadcast", S, Q + (b * N_HEADS + h) * head_q, K + h * head_q, S_ref);
+    }
+  }
+
+  /* -------  Invalid descriptors ------*/
+  // Keys with 3 heads do not broadcast to 16
+  right_nd.batch_dims[0] = 3;
+  res &= sdkl_ext_mm_tensor_nd_validate(&res_nd, &left_nd, &right_nd) == AEE_EBADPARM;
+  right_nd.batch_dims[0] = N_HEADS;
+
+  // Result batch items must not alias
+  res_nd.batch_strides[1] = 0;
+  res &= sdkl_ext_mm_tensor_nd(platform_cpu, &res_nd, &left_nd, &right_nd) == AEE_EBADPARM;
+  res_nd.batch_strides[1] = head_s;
+
+  // Last batch item out of bounds
+  left_nd.matrix.num_elements -= 1;
+  res &= sdkl_ext_tensor_nd_validate(&left_nd) == AEE_EBADPARM;
+  left_nd.matrix.num_elements += 1;
+
+  res &= sdkl_ext_mm_tensor_nd_validate(&res_nd, &left_nd, &right_nd) == AEE_SUCCESS;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  free(Q);
+  free(K);
+  free(S_head);
+  free(S_nd);
+  free(S_broadcast);
+  free(S_ref);
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,343 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW      32
+#define N_COL      1024
+#define N_INNER    2048
+#define GROUP_SIZE 64
+#define N_GROUPS   (N_INNER / GROUP_SIZE)
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+/*!
+  @brief
+  Parameter index of row `r` and group `g` for a quantization mode, as documented for sdkl_quant_params_t
+*/
+static size_t qidx(sdkl_quant_mode_e mode, size_t r, size_t g) {
+  switch (mode) {
+    case SDKL_QMODE_PER_CHANNEL:
+      return r;
+    case SDKL_QMODE_PER_GROUP:
+      return r * N_GROUPS + g;
+    default:
+      return 0;
+  }
+}
+
+// Dequantized matrix multiplication A = dequant(X) * dequant(W)^T
+__attribute__((noinline)) void matmul_quant_ref(
+  float* A,                       // A[N_ROW][N_COL]
+  const uint8_t* X,               // X[N_ROW][N_INNER]
+  const sdkl_quant_params_t* x_q, // activation quantization
+  const int8_t* W,                // W[N_COL][N_INNER]
+  const sdkl_quant_params_t* w_q  // weight quantization
+) {
+  for (size_t i = 0; i < N_ROW; i++) {
+    for (size_t j = 0; j < N_COL; j++) {
+      double acc = 0.;
+      for (size_t k = 0; k < N_INNER; k++) {
+        size_t g  = k / GROUP_SIZE;
+        size_t xi = qidx(x_q->mode, i, g);
+        size_t wi = qidx(w_q->mode, j, g);
+        double x  = x_q->scales[xi] * ((int32_t)X[i * N_INNER + k] - (x_q->zero_points ? x_q->zero_points[xi] : 0));
+        double w  = w_q->scales[wi] * ((int32_t)W[j * N_INNER + k] - (w_q->zero_points ? w_q->zero_points[wi] : 0));
+        acc += x * w;
+      }
+      A[i * N_COL + j] = (float)acc;
+    }
+  }
+}
+
+// Separate dequantization pass over int32 products, per-token activations and per-channel symmetric weights
+__attribute__((noinline)) void dequant_pass(
+  float* A,              // A[N_ROW][N_COL]
+  const int32_t* P,      // P[N_ROW][N_COL], int32 products
+  const int32_t* w_sums, // w_sums[N_COL]
+  const float* x_scales, // x_scales[N_ROW]
+  const int32_t* x_zero, // x_zero[N_ROW]
+  const float* w_scales  // w_scales[N_COL]
+) {
+  for (size_t i = 0; i < N_ROW; i++) {
+    for (size_t j = 0; j < N_COL; j++) {
+      A[i * N_COL + j] = x_scales[i] * w_scales[j] * (float)(P[i * N_COL + j] - x_zero[i] * w_sums[j]);
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares SDKL API result vs Standard C reference. Tolerates 0.1% error of the largest reference magnitude
+*/
+bool sdkl_vector_check_f32(size_t size, float* ref, float* vec) {
+  float max_ref = 0.f;
+  for (size_t i = 0; i < size; i++) {
+    max_ref = fmaxf(max_ref, fabsf(ref[i]));
+  }
+  for (size_t i = 0; i < size; i++) {
+    if (isnan(vec[i]) || isinf(vec[i]) || fabsf(ref[i] - vec[i]) > max_ref / 1000.f) {
+      printf("ERROR ref[%ld] = %f vec[%ld] = %f\n", (long)i, (float)ref[i], (long)i, (float)vec[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sdkl_vector_check_f16(size_t size, float* ref, _Float16* vec) {
+  float max_ref = 0.f;
+  for (size_t i = 0; i < size; i++) {
+    max_ref = fmaxf(max_ref, fabsf(ref[i]));
+  }
+  for (size_t i = 0; i < size; i++) {
+    if (isnan((float)vec[i]) || isinf((float)vec[i]) || fabsf(ref[i] - (float)vec[i]) > max_ref / 200.f) {
+      printf("ERROR ref[%ld] = %f vec[%ld] = %f\n", (long)i, (float)ref[i], (long)i, (float)vec[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+static void set_tensor_2d(sdkl_tensor_t* t, void* data, sdkl_tensor_dtype_e dtype, size_t dim0, size_t dim1) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = dim0;
+  t->dims[1]       = dim1;
+  t->num_elements  = dim0 * dim1;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = SDKL_LAYOUT_2D_ROW_MAJOR;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = dim1;
+  t->strides[1]    = 1;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_reference = 0;
+  bool res              = true;
+  int domain            = CDSP_DOMAIN_ID;
+
+  sdkl_tensor_platform_e platform_cpu = SDKL_PLATFORM_CPU;
+  sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_quant_params_t x_quant, w_quant;
+
+  size_t A_f32_size = N_ROW * N_COL * sizeof(float);
+  size_t A_f16_size = N_ROW * N_COL * sizeof(_Float16);
+  size_t X_size     = N_ROW * N_INNER * sizeof(uint8_t);
+  size_t W_size     = N_COL * N_INNER * sizeof(int8_t);
+
+  float* A_ref    = malloc(A_f32_size);
+  float* A_f32    = malloc(A_f32_size);
+  _Float16* A_f16 = malloc(A_f16_size);
+  int32_t* P_i32  = malloc(N_ROW * N_COL * sizeof(int32_t));
+  float* x_scales = malloc(N_ROW * sizeof(float));
+  int32_t* x_zero = malloc(N_ROW * sizeof(int32_t));
+  float* w_scales = malloc(N_COL * N_GROUPS * sizeof(float));
+  int32_t* w_zero = malloc(N_COL * N_GROUPS * sizeof(int32_t));
+  int32_t* w_sums = malloc(N_COL * sizeof(int32_t));
+  int8_t* W_i8    = malloc(W_size);
+
+  float* A_npu        = NULL;
+  _Float16* A_f16_npu = NULL;
+  uint8_t* X_npu      = NULL;
+  int8_t* W_npu       = NULL;
+
+  // Initialize SDKL
+  SDKL_CHECK(sdkl_npu_initialize(domain, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(domain, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(A_f32_size, (void**)&A_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_size, (void**)&X_npu));
+  SDKL_CHECK(sdkl_npu_alloc(W_size, (void**)&W_npu));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t i = 0; i < N_ROW * N_INNER; i++) {
+    X_npu[i] = (uint8_t)(rand() % 256);
+  }
+  for (size_t i = 0; i < N_COL * N_INNER; i++) {
+    W_i8[i] = (int8_t)(rand() % 256 - 128);
+  }
+  for (size_t i = 0; i < N_ROW; i++) {
+    x_scales[i] = 0.01f + 0.01f * ((float)rand() / (float)RAND_MAX);
+    x_zero[i]   = 100 + rand() % 56;
+  }
+  for (size_t i = 0; i < N_COL * N_GROUPS; i++) {
+    w_scales[i] = 0.001f + 0.001f * ((float)rand() / (float)RAND_MAX);
+    w_zero[i]   = rand() % 16 - 8;
+  }
+  for (size_t j = 0; j < N_COL; j++) {
+    w_sums[j] = 0;
+    for (size_t k = 0; k < N_INNER; k++) {
+      w_sums[j] += W_i8[j * N_INNER + k];
+    }
+  }
+
+  set_tensor_2d(&left_mat, X_npu, SDKL_DTYPE_U8, N_ROW, N_INNER);
+  set_tensor_2d(&right_mat, W_i8, SDKL_DTYPE_I8, N_INNER, N_COL);
+
+  /* -------  Per-token asymmetric activations, per-channel symmetric weights on the CPU engine ------*/
+  x_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_CHANNEL, 0, x_scales, x_zero, NULL};
+  w_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_CHANNEL, 0, w_scales, NULL, NULL};
+  matmul_quant_ref(A_ref, X_npu, &x_quant, W_i8, &w_quant);
+
+  // Unfused: int32 GEMM, then a separate dequantization pass
+  set_tensor_2d(&res_mat, P_i32, SDKL_DTYPE_I32, N_ROW, N_COL);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor(platform_cpu, &res_mat, &left_mat, &right_mat));
+  dequant_pass(A_f32, P_i32, w_sums, x_scales, x_zero, w_scales);
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("CPU engine int32 GEMM + separate dequantization pass runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_ref, A_f32);
+
+  // Fused
+  memset(A_f32, 0, A_f32_size);
+  set_tensor_2d(&res_mat, A_f32, SDKL_DTYPE_FP32, N_ROW, N_COL);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_quant(platform_cpu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("CPU engine GEMM with fused per-channel dequantization runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_ref, A_f32);
+
+  /* -------  Per-tensor asymmetric activations, per-group asymmetric weights on the CPU engine ------*/
+  x_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_TENSOR, 0, x_scales, x_zero, NULL};
+  w_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_GROUP, GROUP_SIZE, w_scales, w_zero, NULL};
+  matmul_quant_ref(A_ref, X_npu, &x_quant, W_i8, &w_quant);
+
+  set_tensor_2d(&res_mat, A_f16, SDKL_DTYPE_FP16, N_ROW, N_COL);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_quant(platform_cpu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("CPU engine GEMM with fused per-group (%d) dequantization runs %-.5lf s\n", GROUP_SIZE, time_reference);
+
+  res &= sdkl_vector_check_f16(N_ROW * N_COL, A_ref, A_f16);
+
+  /* -------  NPU, WH weights with precomputed sums ------*/
+  x_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_CHANNEL, 0, x_scales, x_zero, NULL};
+  w_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_CHANNEL, 0, w_scales, NULL, w_sums};
+  matmul_quant_ref(A_ref, X_npu, &x_quant, W_i8, &w_quant);
+
+  memcpy(W_npu, W_i8, W_size);
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_i8_inplace(N_COL, N_INNER, W_npu));
+  set_tensor_2d(&right_mat, W_npu, SDKL_DTYPE_I8, N_INNER, N_COL);
+  right_mat.layout = SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX;
+
+  set_tensor_2d(&res_mat, A_npu, SDKL_DTYPE_FP32, N_ROW, N_COL);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_quant(platform_npu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("NPU GEMM with per-channel dequantization, FP32 result, runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_ref, A_npu);
+
+  set_tensor_2d(&res_mat, A_f16_npu, SDKL_DTYPE_FP16, N_ROW, N_COL);
+
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_quant(platform_npu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf("NPU GEMM with per-channel dequantization, FP16 result, runs %-.5lf s\n", time_reference);
+
+  res &= sdkl_vector_check_f16(N_ROW * N_COL, A_ref, A_f16_npu);
+
+  /* -------  Unsupported and invalid parameters must be rejected ------*/
+  // Activation zero points with HMX weights require the weight sums
+  w_quant.sums = NULL;
+  res &= sdkl_ext_mm_tensor_quant(platform_npu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL) != 0;
+
+  // Per-group weights on the NPU
+  w_quant = (sdkl_quant_params_t){SDKL_QMODE_PER_GROUP, GROUP_SIZE, w_scales, NULL, NULL};
+  res &= sdkl_ext_mm_tensor_quant(platform_npu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL) != 0;
+
+  // Group size that does not divide the inner dimension
+  set_tensor_2d(&right_mat, W_i8, SDKL_DTYPE_I8, N_INNER, N_COL);
+  w_quant.group_size = 96;
+  res &= sdkl_ext_mm_tensor_quant(platform_cpu, &res_mat, &left_mat, &x_quant, &right_mat, &w_quant, NULL) != 0;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  free(A_ref);
+  free(A_f32);
+  free(A_f16);
+  free(P_i32);
+  free(x_scales);
+  free(x_zero);
+  free(w_scales);
+  free(w_zero);
+  free(w_sums);
+  free(W_i8);
+
+  SDKL_CHECK(sdkl_npu_free(A_npu));
+  SDKL_CHECK(sdkl_npu_free(A_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(X_npu));
+  SDKL_CHECK(sdkl_npu_free(W_npu));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_cpu_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(domain));
+
+  return res ? 0 : 1;
+}
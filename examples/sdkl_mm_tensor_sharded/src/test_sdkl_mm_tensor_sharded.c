@@ -0,0 +1,214 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW_PREFILL 256
+#define N_ROW_DECODE  8
+#define N_COL         1000 // Not a multiple of the shard alignment: the NPU1 column shard is shorter
+#define N_INNER       1024
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+_Float16* X_f16;       /* Activations X[N_ROW_PREFILL][N_INNER], the decode case uses the first rows */
+_Float16* W_f16;       /* Weights W[N_COL][N_INNER], row-major */
+_Float16* W_f16_npu;   /* Same weights in WH layout */
+_Float16* A_f16_one;   /* Results on NPU0 alone */
+_Float16* A_f16_shard; /* Results of the sharded call */
+
+/*!
+  @brief Fills a 2D FP16 tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(sdkl_tensor_t* t, void* data, size_t n_row, size_t n_col, sdkl_tensor_layout_e layout) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = SDKL_DTYPE_FP16;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+/*!
+  @brief
+  Runs `n_row` rows on NPU0 alone and sharded with `mode`, checks that the shards reassemble the NPU0 result and
+  that the expected split was used
+*/
+static bool run_case(
+  const char* name,
+  size_t n_row,
+  const _Float16* W,
+  sdkl_tensor_layout_e w_layout,
+  sdkl_shard_mode_e mode,
+  sdkl_shard_mode_e expected_mode,
+  uint64_t expected_split
+) {
+  struct timeval start, end;
+  double time_one, time_shard;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  sdkl_shard_info_t info;
+  size_t A_size = n_row * N_COL * sizeof(_Float16);
+  bool res      = true;
+
+  setup_tensor(&left_mat, X_f16, n_row, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR);
+  setup_tensor(&right_mat, (void*)W, N_COL, N_INNER, w_layout);
+
+  setup_tensor(&res_mat, A_f16_one, n_row, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR);
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_mm_tensor(SDKL_PLATFORM_NPU0, &res_mat, &left_mat, &right_mat));
+  gettimeofday(&end, NULL);
+  time_one = elapsed(start, end);
+
+  // Poison the result so that any element not written by a shard is detected
+  memset(A_f16_shard, 0xFF, A_size);
+  setup_tensor(&res_mat, A_f16_shard, n_row, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR);
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_ext_mm_tensor_sharded(&res_mat, &left_mat, &right_mat, mode, &info));
+  gettimeofday(&end, NULL);
+  time_shard = elapsed(start, end);
+
+  printf(
+    "%-24s NPU0 %-.5lf s, sharded %-.5lf s (%s, split at %llu), speedup %.2lfx\n",
+    name,
+    time_one,
+    time_shard,
+    info.mode == SDKL_SHARD_ROWS ? "rows" : info.mode == SDKL_SHARD_COLS ? "columns" : "none",
+    (unsigned long long)info.split,
+    time_one / time_shard
+  );
+
+  if (info.mode != expected_mode || info.split != expected_split) {
+    printf("ERROR %s: unexpected split\n", name);
+    res = false;
+  }
+  if (memcmp(A_f16_one, A_f16_shard, A_size) != 0) {
+    printf("ERROR %s: sharded results differ from NPU0 results\n", name);
+    res = false;
+  }
+
+  return res;
+}
+
+int main() {
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+
+  size_t X_f16_size = N_ROW_PREFILL * N_INNER * sizeof(_Float16);
+  size_t A_f16_size = N_ROW_PREFILL * N_COL * sizeof(_Float16);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL on both NPUs
+  SDKL_CHECK(sdkl_npu_initialize(SDKL_PLATFORM_NPU0, NULL, NULL));
+  SDKL_CHECK(sdkl_npu_initialize(SDKL_PLATFORM_NPU1, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(SDKL_PLATFORM_NPU0, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(X_f16_size, (void**)&X_f16));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_one));
+  SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_shard));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < N_ROW_PREFILL * N_INNER; k++) {
+    X_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX));
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  memcpy(W_f16_npu, W_f16, W_f16_size);
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+
+  // Prefill: rows split at the tile-aligned middle, HMX weights shared by both shards
+  res &= run_case(
+    "prefill, auto", N_ROW_PREFILL, W_f16_npu, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, SDKL_SHARD_AUTO, SDKL_SHARD_ROWS,
+    N_ROW_PREFILL / 2
+  );
+
+  // Decode: too few rows, row-major weights split by columns
+  res &= run_case(
+    "decode, auto", N_ROW_DECODE, W_f16, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_SHARD_AUTO, SDKL_SHARD_COLS, 512
+  );
+
+  // Decode with HMX weights: nothing can be split, runs on NPU0
+  res &= run_case(
+    "decode, HMX weights", N_ROW_DECODE, W_f16_npu, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, SDKL_SHARD_AUTO,
+    SDKL_SHARD_NONE, 0
+  );
+
+  // Prefill forced to column shards
+  res &= run_case(
+    "prefill, columns", N_ROW_PREFILL, W_f16, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_SHARD_COLS, SDKL_SHARD_COLS, 512
+  );
+
+  // HMX weights cannot be split by columns
+  setup_tensor(&left_mat, X_f16, N_ROW_PREFILL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR);
+  setup_tensor(&right_mat, W_f16_npu, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX);
+  setup_tensor(&res_mat, A_f16_shard, N_ROW_PREFILL, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR);
+  res &= sdkl_ext_mm_tensor_sharded(&res_mat, &left_mat, &right_mat, SDKL_SHARD_COLS, NULL) == AEE_EUNSUPPORTED;
+  res &= sdkl_ext_mm_tensor_sharded(&res_mat, &left_mat, &right_mat, SDKL_SHARD_INVALID, NULL) == AEE_EBADPARM;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_npu_free(X_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(A_f16_one));
+  SDKL_CHECK(sdkl_npu_free(A_f16_shard));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_queue_finalize(SDKL_PLATFORM_NPU1));
+  SDKL_CHECK(sdkl_npu_finalize(SDKL_PLATFORM_NPU1));
+  SDKL_CHECK(sdkl_npu_finalize(SDKL_PLATFORM_NPU0));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_REQUESTS  64
+#define N_ROW       16 // Decode-like number of rows
+#define N_COL       1024
+#define N_INNER     1024
+#define N_THREADS   4
+#define N_THREAD_IT 256
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+_Float16* X_f16;     /* Request input */
+_Float16* W_f16_npu; /* Weights in WH layout */
+_Float16* A_f16_ref; /* Result of the first request */
+
+int domain = CDSP_DOMAIN_ID;
+
+typedef int (*alloc_fn)(size_t size, void** buffer_ptr);
+typedef int (*free_fn)(void* buffer, size_t size);
+
+static int plain_free(void* buffer, size_t size) {
+  (void)size;
+  return sdkl_npu_free(buffer);
+}
+
+/*!
+  @brief
+  Runs `N_REQUESTS` requests, each with a temporary input and output buffer, and checks the results
+*/
+static bool run_requests(alloc_fn alloc, free_fn release) {
+  size_t X_size = N_ROW * N_INNER * sizeof(_Float16);
+  size_t A_size = N_ROW * N_COL * sizeof(_Float16);
+  bool res      = true;
+
+  for (int r = 0; r < N_REQUESTS; r++) {
+    _Float16 *X_tmp, *A_tmp;
+
+    SDKL_CHECK(alloc(X_size, (void**)&X_tmp));
+    SDKL_CHECK(alloc(A_size, (void**)&A_tmp));
+
+    memcpy(X_tmp, X_f16, X_size);
+    SDKL_CHECK(sdkl_npu_mm_f16f16_f16(domain, N_ROW, N_COL, N_INNER, A_tmp, X_tmp, W_f16_npu));
+    res &= memcmp(A_tmp, A_f16_ref, A_size) == 0;
+
+    SDKL_CHECK(release(A_tmp, A_size));
+    SDKL_CHECK(release(X_tmp, X_size));
+  }
+
+  return res;
+}
+
+/*!
+  @brief Allocates and frees buffers of varying sizes from the pool on a worker thread
+*/
+static void* pool_worker(void* arg) {
+  unsigned int seed = (unsigned int)(uintptr_t)arg;
+  bool* ok          = malloc(sizeof(bool));
+
+  *ok = true;
+  for (int i = 0; i < N_THREAD_IT; i++) {
+    size_t size = 1000 + (size_t)(rand_r(&seed) % (512 * 1024));
+    uint8_t* buf;
+
+    if (sdkl_npu_pool_alloc(size, (void**)&buf) != AEE_SUCCESS) {
+      *ok = false;
+      break;
+    }
+    memset(buf, i & 0xFF, size);
+    *ok &= buf[size - 1] == (uint8_t)(i & 0xFF);
+    *ok &= sdkl_npu_pool_free(buf, size) == AEE_SUCCESS;
+  }
+
+  return ok;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_plain, time_pool;
+  bool res = true;
+  sdkl_npu_pool_stats_t stats;
+  pthread_t threads[N_THREADS];
+
+  size_t X_f16_size = N_ROW * N_INNER * sizeof(_Float16);
+  size_t A_f16_size = N_ROW * N_COL * sizeof(_Float16);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(domain, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(domain, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(X_f16_size, (void**)&X_f16));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_f16_size, (void**)&A_f16_ref));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < N_ROW * N_INNER; k++) {
+    X_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX));
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16_npu[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+  SDKL_CHECK(sdkl_npu_mm_f16f16_f16(domain, N_ROW, N_COL, N_INNER, A_f16_ref, X_f16, W_f16_npu));
+
+  /* -------  Temporaries from sdkl_npu_alloc ------*/
+  gettimeofday(&start, NULL);
+  res &= run_requests(sdkl_npu_alloc, plain_free);
+  gettimeofday(&end, NULL);
+  time_plain = elapsed(start, end);
+
+  /* -------  Temporaries from the pool ------*/
+  gettimeofday(&start, NULL);
+  res &= run_requests(sdkl_npu_pool_alloc, sdkl_npu_pool_free);
+  gettimeofday(&end, NULL);
+  time_pool = elapsed(start, end);
+
+  SDKL_CHECK(sdkl_npu_pool_get_stats(&stats));
+  printf("%d requests with sdkl_npu_alloc: %-.5lf s\n", N_REQUESTS, time_plain);
+  printf("%d requests with the pool:       %-.5lf s\n", N_REQUESTS, time_pool);
+  printf("Speedup %.2lfx\n", time_plain / time_pool);
+  printf(
+    "Pool: %llu hits, %llu misses, %llu bytes held\n",
+    (unsigned long long)stats.hits,
+    (unsigned long long)stats.misses,
+    (unsigned long long)stats.bytes_held
+  );
+
+  // The input and output classes miss once each, every later request is served from the thread cache
+  res &= stats.misses == 2 && stats.hits == 2 * (N_REQUESTS - 1) && stats.bytes_in_use == 0;
+
+  /* -------  Concurrent threads ------*/
+  for (int t = 0; t < N_THREADS; t++) {
+    pthread_create(&threads[t], NULL, pool_worker, (void*)(uintptr_t)(t + 1));
+  }
+  for (int t = 0; t < N_THREADS; t++) {
+    void* ok;
+    pthread_join(threads[t], &ok);
+    res &= *(bool*)ok;
+    free(ok);
+  }
+
+  SDKL_CHECK(sdkl_npu_pool_get_stats(&stats));
+  printf(
+    "Pool after %d threads: %llu hits, %llu misses, %llu bytes held\n",
+    N_THREADS,
+    (unsigned long long)stats.hits,
+    (unsigned long long)stats.misses,
+    (unsigned long long)stats.bytes_held
+  );
+  res &= stats.bytes_in_use == 0;
+
+  // Exited threads returned their caches to the shared free list, so everything can be trimmed
+  SDKL_CHECK(sdkl_npu_pool_trim(0));
+  SDKL_CHECK(sdkl_npu_pool_get_stats(&stats));
+  res &= stats.bytes_held == 0;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_npu_free(X_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(A_f16_ref));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_npu_finalize(domain));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/dma-heap.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_LAYERS 16
+#define N_ROW    64
+#define N_COL    1024
+#define N_INNER  1024
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+uint8_t* arena;        /* Framework-owned activation arena */
+int arena_fd = -1;     /* DMA-BUF file descriptor of the arena, -1 if it fell back to sdkl_npu_alloc() */
+_Float16* W_f16_npu;   /* Shared weights in WH layout */
+_Float16* X_f16_sdkl;  /* Staging input of the copy path */
+_Float16* A_f16_sdkl;  /* Staging output of the copy path */
+_Float16* A_f16_copy;  /* Results of the copy path */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief
+  Allocates the framework arena from a DMA-BUF heap. Falls back to `sdkl_npu_alloc()` where no heap is available,
+  in which case the buffer is registered by address.
+*/
+static void* arena_alloc(size_t size, int* fd) {
+  const char* heaps[] = {"/dev/dma_heap/qcom,system", "/dev/dma_heap/system"};
+  void* p;
+
+  for (size_t h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++) {
+    struct dma_heap_allocation_data data = {.len = size, .fd_flags = O_RDWR | O_CLOEXEC};
+    int heap_fd                          = open(heaps[h], O_RDONLY | O_CLOEXEC);
+
+    if (heap_fd < 0) {
+      continue;
+    }
+    if (ioctl(heap_fd, DMA_HEAP_IOCTL_ALLOC, &data) < 0) {
+      close(heap_fd);
+      continue;
+    }
+    close(heap_fd);
+
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, (int)data.fd, 0);
+    if (p == MAP_FAILED) {
+      close((int)data.fd);
+      continue;
+    }
+    printf("Arena allocated from %s\n", heaps[h]);
+    *fd = (int)data.fd;
+    return p;
+  }
+
+  printf("No DMA-BUF heap available, arena allocated with sdkl_npu_alloc()\n");
+  *fd = -1;
+  return sdkl_npu_alloc(size, &p) == AEE_SUCCESS ? p : NULL;
+}
+
+static void arena_free(void* p, size_t size, int fd) {
+  if (fd >= 0) {
+    munmap(p, size);
+    close(fd);
+  } else {
+    sdkl_npu_free(p);
+  }
+}
+
+/*!
+  @brief Fills a 2D row-major FP16 tensor descriptor of the matrix at element `offset` of `data`.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t offset,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = offset + n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = SDKL_DTYPE_FP16;
+  t->data_offset   = offset;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_copy, time_registered;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat;
+  size_t copied_bytes = 0;
+
+  const size_t X_elems    = N_ROW * N_INNER;
+  const size_t A_elems    = N_ROW * N_COL;
+  const size_t layer      = X_elems + A_elems; // arena elements per layer: input, then output
+  const size_t arena_size = N_LAYERS * layer * sizeof(_Float16);
+  _Float16* act;
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  arena = arena_alloc(arena_size, &arena_fd);
+  if (arena == NULL) {
+    printf("ERROR allocating the arena\n");
+    return 1;
+  }
+  act = (_Float16*)arena;
+
+  SDKL_CHECK(sdkl_npu_alloc(N_COL * N_INNER * sizeof(_Float16), (void**)&W_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_elems * sizeof(_Float16), (void**)&X_f16_sdkl));
+  SDKL_CHECK(sdkl_npu_alloc(A_elems * sizeof(_Float16), (void**)&A_f16_sdkl));
+  A_f16_copy = malloc(N_LAYERS * A_elems * sizeof(_Float16));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    for (size_t k = 0; k < X_elems; k++) {
+      act[l * layer + k] = (_Float16)((float)rand() / (float)RAND_MAX);
+    }
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16_npu[k] = (_Float16)(((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+  setup_tensor(&right_mat, W_f16_npu, 0, N_INNER, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX);
+
+  /* -------  Copy path: arena -> sdkl buffers -> arena ------*/
+  setup_tensor(&res_mat, A_f16_sdkl, 0, N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR);
+  setup_tensor(&left_mat, X_f16_sdkl, 0, N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR);
+
+  gettimeofday(&start, NULL);
+  for (int l = 0; l < N_LAYERS; l++) {
+    memcpy(X_f16_sdkl, act + l * layer, X_elems * sizeof(_Float16));
+    SDKL_CHECK(sdkl_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat));
+    memcpy(act + l * layer + X_elems, A_f16_sdkl, A_elems * sizeof(_Float16));
+    copied_bytes += (X_elems + A_elems) * sizeof(_Float16);
+  }
+  gettimeofday(&end, NULL);
+  time_copy = elapsed(start, end);
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    memcpy(A_f16_copy + l * A_elems, act + l * layer + X_elems, A_elems * sizeof(_Float16));
+  }
+  for (int l = 0; l < N_LAYERS; l++) {
+    memset(act + l * layer + X_elems, 0, A_elems * sizeof(_Float16));
+  }
+
+  /* -------  Registered arena: tensors used in place ------*/
+  SDKL_CHECK(sdkl_npu_register_buffer(platform_npu, arena, arena_size, arena_fd));
+
+  gettimeofday(&start, NULL);
+  for (int l = 0; l < N_LAYERS; l++) {
+    setup_tensor(&res_mat, arena, l * layer + X_elems, N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR);
+    setup_tensor(&left_mat, arena, l * layer, N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR);
+    SDKL_CHECK(sdkl_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat));
+  }
+  gettimeofday(&end, NULL);
+  time_registered = elapsed(start, end);
+
+  printf("%d layers, copies through sdkl buffers: %-.5lf s, %zu bytes copied\n", N_LAYERS, time_copy, copied_bytes);
+  printf("%d layers, registered arena in place:   %-.5lf s, 0 bytes copied\n", N_LAYERS, time_registered);
+  printf("Speedup %.2lfx, %.1lf MB of memcpy eliminated\n", time_copy / time_registered, copied_bytes / 1e6);
+
+  for (int l = 0; l < N_LAYERS; l++) {
+    if (memcmp(A_f16_copy + l * A_elems, act + l * layer + X_elems, A_elems * sizeof(_Float16)) != 0) {
+      printf("ERROR layer %d results differ between the copy path and the registered arena\n", l);
+      res = false;
+    }
+  }
+
+  // Registering the same buffer again only counts; overlapping ranges are rejected
+  res &= sdkl_npu_register_buffer(platform_npu, arena, arena_size, arena_fd) == AEE_SUCCESS;
+  res &= sdkl_npu_register_buffer(platform_npu, arena + 4096, 4096, arena_fd) == AEE_EBADPARM;
+  res &= sdkl_npu_unregister_buffer(platform_npu, arena) == AEE_SUCCESS;
+  res &= sdkl_npu_unregister_buffer(platform_npu, arena) == AEE_SUCCESS;
+  res &= sdkl_npu_unregister_buffer(platform_npu, arena) == AEE_ENOSUCH;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  arena_free(arena, arena_size, arena_fd);
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(X_f16_sdkl));
+  SDKL_CHECK(sdkl_npu_free(A_f16_sdkl));
+  free(A_f16_copy);
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW     16
+#define N_COL     256
+#define N_INNER   512
+#define N_NPU     4 // synchronous NPU calls
+#define N_ASYNC   4 // asynchronous NPU calls
+#define N_WEIGHTS 4 // NPU calls through a weight handle
+#define N_CPU     8 // CPU engine calls
+
+#define N_NPU_TOTAL (N_NPU + N_ASYNC + N_WEIGHTS)
+
+#define MM_MACS  ((uint64_t)N_ROW * N_COL * N_INNER)
+#define MM_BYTES ((uint64_t)N_ROW * N_INNER * sizeof(float) + (uint64_t)N_COL * N_INNER * sizeof(_Float16) + \
+                  (uint64_t)N_ROW * N_COL * sizeof(float))
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+float* X_f32;         /* Activations X[N_ROW][N_INNER] */
+_Float16* W_f16;      /* Weights W[N_COL][N_INNER], row-major */
+_Float16* W_f16_npu;  /* Same weights in WH layout */
+float* A_f32;         /* Results */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static void print_stats(const char* name, const sdkl_stats_t* s) {
+  printf(
+    "%s: %llu matmuls, %llu MACs, %llu bytes, busy %llu us, wait %llu us, %llu maps in %llu us",
+    name,
+    (unsigned long long)s->n_matmuls,
+    (unsigned long long)s->n_macs,
+    (unsigned long long)s->bytes,
+    (unsigned long long)s->busy_us,
+    (unsigned long long)s->wait_us,
+    (unsigned long long)s->n_maps,
+    (unsigned long long)s->map_us
+  );
+  if (s->busy_us != 0) {
+    printf(", %.2f GMAC/s", (double)s->n_macs / (double)s->busy_us / 1000.);
+  }
+  printf("\n");
+}
+
+int main() {
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat, right_mat_npu;
+  sdkl_weights_t* weights;
+  sdkl_fence_t fences[N_ASYNC];
+  sdkl_stats_t npu_stats, cpu_stats;
+
+  size_t X_f32_size = N_ROW * N_INNER * sizeof(float);
+  size_t A_f32_size = N_ROW * N_COL * sizeof(float);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(X_f32_size, (void**)&X_f32));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_f32_size, (void**)&A_f32));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < N_ROW * N_INNER; k++) {
+    X_f32[k] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  memcpy(W_f16_npu, W_f16, W_f16_size);
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+
+  setup_tensor(&res_mat, A_f32, N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&left_mat, X_f32, N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&right_mat, W_f16, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  setup_tensor(&right_mat_npu, W_f16_npu, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, SDKL_DTYPE_FP16);
+
+  SDKL_CHECK(sdkl_weights_create(platform_npu, SDKL_DTYPE_FP16, N_COL, N_INNER, W_f16, &weights));
+
+  /* -------  Counted calls on every backend ------*/
+  SDKL_CHECK(sdkl_reset_stats(platform_npu));
+  SDKL_CHECK(sdkl_reset_stats(SDKL_PLATFORM_CPU));
+
+  for (int it = 0; it < N_NPU; it++) {
+    SDKL_CHECK(sdkl_ext_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat_npu));
+  }
+  for (int it = 0; it < N_ASYNC; it++) {
+    SDKL_CHECK(sdkl_mm_tensor_async(platform_npu, &res_mat, &left_mat, &right_mat_npu, &fences[it]));
+  }
+  for (int it = 0; it < N_ASYNC; it++) {
+    SDKL_CHECK(sdkl_fence_wait(&fences[it]));
+  }
+  for (int it = 0; it < N_WEIGHTS; it++) {
+    SDKL_CHECK(sdkl_weights_mm_f32f16_f32(weights, N_ROW, A_f32, X_f32));
+  }
+  for (int it = 0; it < N_CPU; it++) {
+    SDKL_CHECK(sdkl_cpu_mm_tensor(&res_mat, &left_mat, &right_mat));
+  }
+
+  SDKL_CHECK(sdkl_get_stats(platform_npu, &npu_stats));
+  SDKL_CHECK(sdkl_get_stats(SDKL_PLATFORM_CPU, &cpu_stats));
+  print_stats("NPU0", &npu_stats);
+  print_stats("CPU ", &cpu_stats);
+
+  if (npu_stats.n_matmuls != N_NPU_TOTAL || npu_stats.n_macs != N_NPU_TOTAL * MM_MACS ||
+      npu_stats.bytes < N_NPU_TOTAL * MM_BYTES) {
+    printf("ERROR unexpected NPU counters\n");
+    res = false;
+  }
+  if (cpu_stats.n_matmuls != N_CPU || cpu_stats.n_macs != N_CPU * MM_MACS || cpu_stats.bytes != N_CPU * MM_BYTES) {
+    printf("ERROR unexpected CPU counters\n");
+    res = false;
+  }
+
+  /* -------  FastRPC mappings of a weight handle ------*/
+  SDKL_CHECK(sdkl_weights_destroy(weights));
+  SDKL_CHECK(sdkl_get_stats(platform_npu, &npu_stats));
+  if (npu_stats.n_maps == 0) {
+    printf("ERROR no FastRPC mapping counted\n");
+    res = false;
+  }
+
+  /* -------  Reset ------*/
+  SDKL_CHECK(sdkl_reset_stats(platform_npu));
+  SDKL_CHECK(sdkl_reset_stats(SDKL_PLATFORM_CPU));
+  SDKL_CHECK(sdkl_get_stats(platform_npu, &npu_stats));
+  SDKL_CHECK(sdkl_get_stats(SDKL_PLATFORM_CPU, &cpu_stats));
+  if (npu_stats.n_matmuls != 0 || npu_stats.n_macs != 0 || npu_stats.busy_us != 0 || npu_stats.n_maps != 0 ||
+      cpu_stats.n_matmuls != 0 || cpu_stats.n_macs != 0 || cpu_stats.busy_us != 0 || cpu_stats.wait_us != 0) {
+    printf("ERROR counters not reset\n");
+    res = false;
+  }
+
+  // Argument checks
+  res &= sdkl_get_stats(platform_npu, NULL) == AEE_EBADPARM;
+  res &= sdkl_get_stats((sdkl_tensor_platform_e)-1, &npu_stats) == AEE_EBADPARM;
+  res &= sdkl_reset_stats((sdkl_tensor_platform_e)-1) == AEE_EBADPARM;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_npu_free(X_f32));
+  SDKL_CHECK(sdkl_npu_free(W_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(A_f32));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_queue_finalize(platform_npu));
+  SDKL_CHECK(sdkl_cpu_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
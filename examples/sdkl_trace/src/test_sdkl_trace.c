@@ -0,0 +1,252 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "AEEStdErr.h"
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW      16
+#define N_COL      512
+#define N_INNER    512
+#define N_ITER     200 // CPU calls timed with and without tracing
+#define N_EVENTS   65536
+#define TRACE_PATH "sdkl_trace.json"
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+/* Spans expected in the trace */
+static const char* expected_spans[] = {
+  "layer",          // application span
+  "weights_layout", // sdkl_weights_create()
+  "sdkl_mm_tensor", // NPU invocation
+  "queue_job",      // sdkl_mm_tensor_async()
+  "fence_wait",     // sdkl_fence_wait()
+  "cpu_gemm",       // CPU engine call
+  "cpu_pack",       // CPU engine phases, per tile
+  "cpu_kernel",
+  "cpu_store",
+};
+#define N_EXPECTED (sizeof(expected_spans) / sizeof(expected_spans[0]))
+
+float* X_f32;         /* Activations X[N_ROW][N_INNER] */
+_Float16* W_f16;      /* Weights W[N_COL][N_INNER], row-major */
+_Float16* W_f16_npu;  /* Same weights in WH layout */
+float* A_f32;         /* Results */
+float* A_f32_ref;     /* Results without tracing */
+
+sdkl_tensor_platform_e platform_npu = SDKL_PLATFORM_NPU0;
+
+/*!
+  @brief Fills a 2D tensor descriptor of a contiguous `n_row` x `n_col` matrix.
+*/
+void setup_tensor(
+  sdkl_tensor_t* t,
+  void* data,
+  size_t n_row,
+  size_t n_col,
+  sdkl_tensor_layout_e layout,
+  sdkl_tensor_dtype_e dtype
+) {
+  memset(t, 0, sizeof(*t));
+  t->data          = data;
+  t->ndims         = 2;
+  t->dims[0]       = n_row;
+  t->dims[1]       = n_col;
+  t->num_elements  = n_row * n_col;
+  t->is_continuous = 1;
+  t->quantization  = SDKL_QUANT_NONE;
+  t->layout        = layout;
+  t->data_dtype    = dtype;
+  t->data_offset   = 0;
+  t->strides[0]    = n_col;
+  t->strides[1]    = 1;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+/*!
+  @brief Times `N_ITER` CPU matrix multiplications.
+*/
+static double time_cpu_calls(sdkl_tensor_t* r, const sdkl_tensor_t* x, const sdkl_tensor_t* w) {
+  struct timeval start, end;
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITER; it++) {
+    SDKL_CHECK(sdkl_cpu_mm_tensor(r, x, w));
+  }
+  gettimeofday(&end, NULL);
+  return elapsed(start, end);
+}
+
+/*!
+  @brief Counts the spans named `name` in the JSON trace `json`.
+*/
+static int count_spans(const char* json, const char* name) {
+  char key[64];
+  int count = 0;
+
+  snprintf(key, sizeof(key), "{\"name\":\"%s\",", name);
+  for (const char* p = strstr(json, key); p != NULL; p = strstr(p + 1, key)) {
+    count++;
+  }
+  return count;
+}
+
+int main() {
+  double time_off, time_on;
+  bool res = true;
+  sdkl_tensor_t res_mat, left_mat, right_mat, right_mat_npu;
+  sdkl_weights_t* weights;
+  sdkl_fence_t fence;
+  uint64_t span;
+  char* json;
+  long json_size;
+  FILE* f;
+
+  size_t X_f32_size = N_ROW * N_INNER * sizeof(float);
+  size_t A_f32_size = N_ROW * N_COL * sizeof(float);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+
+  // Initialize SDKL NPU
+  SDKL_CHECK(sdkl_npu_initialize(platform_npu, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(platform_npu, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(X_f32_size, (void**)&X_f32));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_f32_size, (void**)&A_f32));
+  A_f32_ref = malloc(A_f32_size);
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t k = 0; k < N_ROW * N_INNER; k++) {
+    X_f32[k] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+  }
+  for (size_t k = 0; k < N_COL * N_INNER; k++) {
+    W_f16[k] = (_Float16)(((float)1.0f) * ((float)rand() / (float)RAND_MAX) - 0.5f);
+  }
+  memcpy(W_f16_npu, W_f16, W_f16_size);
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+
+  setup_tensor(&res_mat, A_f32, N_ROW, N_COL, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&left_mat, X_f32, N_ROW, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP32);
+  setup_tensor(&right_mat, W_f16, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR, SDKL_DTYPE_FP16);
+  setup_tensor(&right_mat_npu, W_f16_npu, N_COL, N_INNER, SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX, SDKL_DTYPE_FP16);
+
+  /* -------  Tracing stopped: the instrumentation points only test a flag ------*/
+  time_off = time_cpu_calls(&res_mat, &left_mat, &right_mat);
+  memcpy(A_f32_ref, A_f32, A_f32_size);
+
+  /* -------  Traced steps of a layer on every backend ------*/
+  SDKL_CHECK(sdkl_trace_start(N_EVENTS));
+  span = sdkl_trace_begin();
+
+  SDKL_CHECK(sdkl_weights_create(platform_npu, SDKL_DTYPE_FP16, N_COL, N_INNER, W_f16, &weights));
+  SDKL_CHECK(sdkl_ext_mm_tensor(platform_npu, &res_mat, &left_mat, &right_mat_npu));
+  SDKL_CHECK(sdkl_mm_tensor_async(platform_npu, &res_mat, &left_mat, &right_mat_npu, &fence));
+  SDKL_CHECK(sdkl_fence_wait(&fence));
+  SDKL_CHECK(sdkl_cpu_mm_tensor(&res_mat, &left_mat, &right_mat));
+
+  sdkl_trace_end("layer", "app", span);
+
+  time_on = time_cpu_calls(&res_mat, &left_mat, &right_mat);
+  SDKL_CHECK(sdkl_trace_stop());
+
+  printf("%d CPU calls, tracing stopped: %-.5lf s\n", N_ITER, time_off);
+  printf("%d CPU calls, tracing:         %-.5lf s\n", N_ITER, time_on);
+
+  if (memcmp(A_f32, A_f32_ref, A_f32_size) != 0) {
+    printf("ERROR results differ with tracing\n");
+    res = false;
+  }
+
+  /* -------  Export and check the spans ------*/
+  SDKL_CHECK(sdkl_trace_dump(TRACE_PATH));
+
+  f = fopen(TRACE_PATH, "rb");
+  if (f == NULL) {
+    printf("ERROR cannot read %s\n", TRACE_PATH);
+    exit(EXIT_FAILURE);
+  }
+  fseek(f, 0, SEEK_END);
+  json_size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  json = calloc(json_size + 1, 1);
+  if (fread(json, 1, json_size, f) != (size_t)json_size) {
+    res = false;
+  }
+  fclose(f);
+
+  printf("%s: %ld bytes\n", TRACE_PATH, json_size);
+  for (size_t s = 0; s < N_EXPECTED; s++) {
+    int count = count_spans(json, expected_spans[s]);
+
+    printf("  %-16s %5d spans\n", expected_spans[s], count);
+    if (count == 0) {
+      printf("ERROR no %s span\n", expected_spans[s]);
+      res = false;
+    }
+  }
+  res &= strncmp(json, "{\"displayTimeUnit\"", 18) == 0 && strstr(json, "\n]}\n") != NULL;
+  free(json);
+
+  // Argument checks
+  res &= sdkl_trace_start(0) == AEE_EBADPARM;
+  res &= sdkl_trace_dump(NULL) == AEE_EBADPARM;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_trace_finalize());
+  SDKL_CHECK(sdkl_weights_destroy(weights));
+  SDKL_CHECK(sdkl_npu_free(X_f32));
+  SDKL_CHECK(sdkl_npu_free(W_f16));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+  SDKL_CHECK(sdkl_npu_free(A_f32));
+  free(A_f32_ref);
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_queue_finalize(platform_npu));
+  SDKL_CHECK(sdkl_cpu_finalize());
+  SDKL_CHECK(sdkl_npu_finalize(platform_npu));
+
+  return res ? 0 : 1;
+}
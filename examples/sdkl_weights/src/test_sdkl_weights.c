@@ -0,0 +1,257 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "remote.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "sdkl.h"
+#include "sdkl_ext.h"
+
+/*!
+ @brief to get SDKL version string from  sdkl_npu_get_version()
+*/
+char version[SDKL_VERSION_STR_LEN];
+
+#define N_ROW   8 // Decode-like number of rows
+#define N_COL   3072
+#define N_INNER 8192
+#define N_ITERS 32 // Matmuls per decode loop
+
+/*!
+ @brief Utility macro to check SDKL returns 0 and, if an error occurred,
+        pretty-print the \ref error and exit on EXIT_FAILURE
+*/
+#define SDKL_CHECK(x) \
+  do { \
+    if ((x) != 0) { \
+      printf("Line = %d, nErr = %d\n", __LINE__, x); \
+      exit(EXIT_FAILURE); \
+    } \
+  } while (0)
+
+// Matrix multiplication A = X * W^T
+__attribute__((noinline)) void matmul_f32f16_f32(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  float* A,         // A[n_row][n_col]
+  const float* X,   // X[n_row][n_inner]
+  const _Float16* W // W[n_col][n_inner]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      float acc = 0.f;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += X[i * n_inner + k] * (float)W[j * n_inner + k];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+// Matrix multiplication A = X * W^T
+__attribute__((noinline)) void matmul_u8i8_i32(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  int32_t* A,       // A[n_row][n_col]
+  const uint8_t* X, // X[n_row][n_inner]
+  const int8_t* W   // W[n_col][n_inner]
+) {
+  for (size_t i = 0; i < n_row; i++) {
+    for (size_t j = 0; j < n_col; j++) {
+      int32_t acc = 0;
+      for (size_t k = 0; k < n_inner; k++) {
+        acc += (int32_t)X[i * n_inner + k] * (int32_t)W[j * n_inner + k];
+      }
+      A[i * n_col + j] = acc;
+    }
+  }
+}
+
+/*!
+  @brief
+  Compares SDKL API result vs Standard C reference. Tolerates 0.1% error
+*/
+bool sdkl_vector_check_f32(size_t size, float* ref, float* vec) {
+  bool res = true;
+  for (size_t i = 0; i < size; i++) {
+    float diff_0dot001percent = fabsf(ref[i] / (float)1000.0f);
+
+    if (isnan(vec[i]) || isinf(vec[i]) || fabsf(ref[i] - vec[i]) > diff_0dot001percent) {
+      res = false;
+      printf("ERROR ref[%ld] = %f vec[%ld] = %f\n", (long)i, (float)ref[i], (long)i, (float)vec[i]);
+      break;
+    }
+  }
+  return res;
+}
+
+/*!
+  @brief
+  Compares SDKL API i32 result vs Standard C reference. Requires exact match
+*/
+bool sdkl_vector_check_i32(size_t size, int32_t* ref, int32_t* vec) {
+  for (size_t i = 0; i < size; i++) {
+    if (ref[i] != vec[i]) {
+      printf("ERROR ref[%ld] = %d vec[%ld] = %d\n", (long)i, ref[i], (long)i, vec[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static double elapsed(struct timeval start, struct timeval end) {
+  long seconds, useconds;
+  seconds  = end.tv_sec - start.tv_sec;
+  useconds = end.tv_usec - start.tv_usec;
+  return (seconds) + useconds / 1000000.;
+}
+
+int main() {
+  struct timeval start, end;
+  double time_reference = 0;
+  bool res              = true;
+  int domain            = CDSP_DOMAIN_ID;
+
+  sdkl_weights_t* W_f16_handle = NULL;
+  sdkl_weights_t* W_i8_handle  = NULL;
+  sdkl_weights_info_t info;
+
+  size_t A_f32_size = N_ROW * N_COL * sizeof(float);
+  size_t A_i32_size = N_ROW * N_COL * sizeof(int32_t);
+  size_t X_f32_size = N_ROW * N_INNER * sizeof(float);
+  size_t X_u8_size  = N_ROW * N_INNER * sizeof(uint8_t);
+  size_t W_f16_size = N_COL * N_INNER * sizeof(_Float16);
+  size_t W_i8_size  = N_COL * N_INNER * sizeof(int8_t);
+
+  float* A_f32_ref    = malloc(A_f32_size);
+  int32_t* A_i32_ref  = malloc(A_i32_size);
+  _Float16* W_f16_cpu = malloc(W_f16_size);
+  int8_t* W_i8_cpu    = malloc(W_i8_size);
+
+  float* A_f32_npu    = NULL;
+  int32_t* A_i32_npu  = NULL;
+  float* X_f32_npu    = NULL;
+  uint8_t* X_u8_npu   = NULL;
+  _Float16* W_f16_npu = NULL; // Per-call path: raw WH buffer
+
+  // Initialize SDKL
+  SDKL_CHECK(sdkl_npu_initialize(domain, NULL, NULL));
+
+  SDKL_CHECK(sdkl_npu_get_version(domain, version));
+
+  printf("SDKL Version: %s\n", version);
+
+  SDKL_CHECK(sdkl_npu_alloc(A_f32_size, (void**)&A_f32_npu));
+  SDKL_CHECK(sdkl_npu_alloc(A_i32_size, (void**)&A_i32_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_f32_size, (void**)&X_f32_npu));
+  SDKL_CHECK(sdkl_npu_alloc(X_u8_size, (void**)&X_u8_npu));
+  SDKL_CHECK(sdkl_npu_alloc(W_f16_size, (void**)&W_f16_npu));
+
+  // Initialization by random values
+  srand(42); //(unsigned int)time(NULL));
+  printf("SDKL Test Start:\n");
+
+  for (size_t i = 0; i < N_ROW * N_INNER; i++) {
+    X_f32_npu[i] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+    X_u8_npu[i]  = (uint8_t)(rand() % 23);
+  }
+  for (size_t i = 0; i < N_COL * N_INNER; i++) {
+    W_f16_cpu[i] = ((float)1.0f) * ((float)rand() / (float)RAND_MAX);
+    W_i8_cpu[i]  = (int8_t)(rand() % 38) - 32;
+  }
+
+  matmul_f32f16_f32(N_ROW, N_COL, N_INNER, A_f32_ref, X_f32_npu, W_f16_cpu);
+  matmul_u8i8_i32(N_ROW, N_COL, N_INNER, A_i32_ref, X_u8_npu, W_i8_cpu);
+
+  /* -------  Per-call path: raw pointers ------*/
+  memcpy(W_f16_npu, W_f16_cpu, W_f16_size);
+  SDKL_CHECK(sdkl_cpu_rm_to_wh_f16_inplace(N_COL, N_INNER, W_f16_npu));
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITERS; it++) {
+    SDKL_CHECK(sdkl_npu_mm_f32f16_f32(domain, N_ROW, N_COL, N_INNER, A_f32_npu, X_f32_npu, W_f16_npu));
+  }
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf(
+    "Raw WH pointer, %d decode matmuls run %-.5lf s (%.5lf s/call)\n", N_ITERS, time_reference, time_reference / N_ITERS
+  );
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32_npu);
+
+  /* -------  Weight handle path ------*/
+  gettimeofday(&start, NULL);
+  SDKL_CHECK(sdkl_weights_create(domain, SDKL_DTYPE_FP16, N_COL, N_INNER, W_f16_cpu, &W_f16_handle));
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  SDKL_CHECK(sdkl_weights_get_info(W_f16_handle, &info));
+  printf(
+    "FP16 weight handle created in %-.5lf s, resident %zu bytes, mapped %u\n",
+    time_reference,
+    info.resident_bytes,
+    info.is_mapped
+  );
+
+  memset(A_f32_npu, 0, A_f32_size);
+
+  gettimeofday(&start, NULL);
+  for (int it = 0; it < N_ITERS; it++) {
+    SDKL_CHECK(sdkl_weights_mm_f32f16_f32(W_f16_handle, N_ROW, A_f32_npu, X_f32_npu));
+  }
+  gettimeofday(&end, NULL);
+
+  time_reference = elapsed(start, end);
+  printf(
+    "Weight handle, %d decode matmuls run %-.5lf s (%.5lf s/call)\n", N_ITERS, time_reference, time_reference / N_ITERS
+  );
+
+  res &= sdkl_vector_check_f32(N_ROW * N_COL, A_f32_ref, A_f32_npu);
+
+  /* -------  i8 weight handle ------*/
+  SDKL_CHECK(sdkl_weights_create(domain, SDKL_DTYPE_I8, N_COL, N_INNER, W_i8_cpu, &W_i8_handle));
+  SDKL_CHECK(sdkl_weights_get_info(W_i8_handle, &info));
+  printf("I8 weight handle resident %zu bytes, mapped %u\n", info.resident_bytes, info.is_mapped);
+
+  SDKL_CHECK(sdkl_weights_mm_u8i8_i32(W_i8_handle, N_ROW, A_i32_npu, X_u8_npu));
+
+  res &= sdkl_vector_check_i32(N_ROW * N_COL, A_i32_ref, A_i32_npu);
+
+  // A handle of another data type must be rejected
+  res &= sdkl_weights_mm_u8i8_i32(W_f16_handle, N_ROW, A_i32_npu, X_u8_npu) != 0;
+
+  if (res) {
+    printf("Test Passed\n");
+  } else {
+    printf("Test Failed\n");
+  }
+
+  // Cleanup
+  SDKL_CHECK(sdkl_weights_destroy(W_f16_handle));
+  SDKL_CHECK(sdkl_weights_destroy(W_i8_handle));
+
+  free(A_f32_ref);
+  free(A_i32_ref);
+  free(W_f16_cpu);
+  free(W_i8_cpu);
+
+  SDKL_CHECK(sdkl_npu_free(A_f32_npu));
+  SDKL_CHECK(sdkl_npu_free(A_i32_npu));
+  SDKL_CHECK(sdkl_npu_free(X_f32_npu));
+  SDKL_CHECK(sdkl_npu_free(X_u8_npu));
+  SDKL_CHECK(sdkl_npu_free(W_f16_npu));
+
+  // Finalize & cleanup SDKL
+  SDKL_CHECK(sdkl_npu_finalize(domain));
+
+  return res ? 0 : 1;
+}
@@ -0,0 +1,1108 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#ifndef __HEXKL_MACRO_EXT_H__
+#define __HEXKL_MACRO_EXT_H__
+
+#include <stdint.h>
+
+/*!
+  @file hexkl_macro_ext.h
+  @brief Defines constants, types, and functions extending the HexKL NPU Macro API.
+
+  The extensions are distributed as source (`src/hexkl_macro_ext/`) and are built on top of the
+  public `hexkl_micro.h` API. NPU programs compile the sources together with their own code and
+  link against `libhexkl_micro.a`.
+*/
+
+/*!
+  @defgroup HexKLNPUMacroExt HexKL NPU Macro API Extensions
+  @brief Source-level matrix multiplication functions built on the HexKL NPU Micro API.
+
+  Unlike the HexKL NPU Macro API, the functions take the VTCM region to work in as arguments
+  (see `hexkl_micro_hw_init()`), and the caller holds the HMX lock (see `hexkl_micro_hmx_lock()`).
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtEpilogue Fused Epilogues
+  @brief Defines element-wise operations applied to accumulator tiles before they leave VTCM.
+
+  An epilogue computes, for every element of the result,
+
+      A[i][j] = activation(acc[i][j] + bias[j]) + residual[i][j]
+
+  where each of the three operations is optional. It is applied to each 32x32 tile right after the
+  tile is read from the HMX accumulator into VTCM, so the result is written to DDR once.
+*/
+
+/*!
+  @ingroup NPUMacroExtEpilogue
+  @enum hexkl_activation_e
+  @brief Activation function of an epilogue.
+*/
+typedef enum {
+  /*!
+    @brief No activation.
+  */
+  HEXKL_ACT_NONE = 0,
+
+  /*!
+    @brief `max(x, 0)`.
+  */
+  HEXKL_ACT_RELU = 1,
+
+  /*!
+    @brief `x * sigmoid(x)`.
+  */
+  HEXKL_ACT_SILU = 2,
+
+  /*!
+    @brief GELU, tanh approximation.
+  */
+  HEXKL_ACT_GELU = 3,
+
+  /*!
+    @brief Invalid activation. Also used to indicate the number of valid values.
+  */
+  HEXKL_ACT_INVALID
+} hexkl_activation_e;
+
+/*!
+  @ingroup NPUMacroExtEpilogue
+  @struct hexkl_epilogue_t
+  @brief Describes the epilogue of a matrix multiplication.
+*/
+typedef struct {
+  /*!
+    @brief Optional FP32 bias of `n_col` entries, added to every row. NULL for none.
+  */
+  const float* bias;
+
+  /*!
+    @brief Activation applied after the bias.
+  */
+  hexkl_activation_e activation;
+
+  /*!
+    @brief Optional residual matrix added last: `n_row x n_col`, row-major, same data type as the result and
+           not overlapping it. NULL for none.
+  */
+  const void* residual;
+} hexkl_epilogue_t;
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtStats Performance Counters
+  @brief Defines cumulative counters of the matrix multiplications run on the NPU by the extensions.
+
+  The counters are always on: each call adds its totals once, from the timestamps taken at the boundaries of its
+  phases (three QTimer reads per 32-column output block). The structure is visible to host code so that NPU
+  programs can return it, e.g. through their FastRPC interface.
+*/
+
+/*!
+  @ingroup NPUMacroExtStats
+  @struct hexkl_macro_ext_stats_t
+  @brief Cumulative counters since start or the last `hexkl_macro_ext_reset_stats()`.
+*/
+typedef struct {
+  /*!
+    @brief Number of completed matrix multiplications. A multi-weight call counts one per weight matrix.
+  */
+  uint64_t n_matmuls;
+
+  /*!
+    @brief Number of multiply-accumulate operations, `n_row * n_col * n_inner` per matrix multiplication.
+  */
+  uint64_t n_macs;
+
+  /*!
+    @brief Bytes copied from DDR into VTCM: activation and weight tiles. Depends on the loop order, see
+           @ref NPUMacroExtSched.
+  */
+  uint64_t bytes_to_vtcm;
+
+  /*!
+    @brief Bytes of results stored from VTCM to DDR.
+  */
+  uint64_t bytes_from_vtcm;
+
+  /*!
+    @brief Time loading activation tiles into VTCM and converting them to AH layout, in microseconds.
+  */
+  uint64_t act_load_us;
+
+  /*!
+    @brief Time of the HMX multiplications, in microseconds. Includes loading and converting the weight tiles,
+           and the activation tiles with the output-stationary loop order, which alternate with the
+           multiplications per inner tile.
+  */
+  uint64_t hmx_us;
+
+  /*!
+    @brief Time reading the HMX accumulator out and converting it to row-major layout, in microseconds.
+  */
+  uint64_t acc_read_us;
+
+  /*!
+    @brief Time storing result tiles to DDR, epilogues included, in microseconds.
+  */
+  uint64_t store_us;
+
+  /*!
+    @brief Bytes read from and written to DDR directly by the few-row path (activations, weights and results),
+           which does not go through VTCM.
+  */
+  uint64_t bytes_streamed;
+
+  /*!
+    @brief Time of the few-row path, epilogues and stores included, in microseconds.
+  */
+  uint64_t gemv_us;
+
+  /*!
+    @brief Largest VTCM footprint of a matrix multiplication, in bytes: the high-water mark of its VTCM arena.
+  */
+  uint64_t vtcm_high_water;
+} hexkl_macro_ext_stats_t;
+
+/*!
+  @note
+  The functions declared below are intended for use exclusively by
+  NPU/Hexagon programmers.
+*/
+#ifdef __hexagon__
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtMatMul Matrix Multiplication Functions
+  @brief Defines FP16 matrix multiplication with row-major operands and optional epilogues.
+
+  Products of at most ::HEXKL_MACRO_EXT_GEMV_MAX_ROWS rows, as in token generation, are bound by the weight
+  bandwidth and would leave most of each 32-row activation tile as padding. They bypass HMX and VTCM: the weights
+  are streamed from DDR once, with L2 prefetching, and accumulated in FP32. Results then differ from the
+  HMX path by its FP16 accumulator rounding.
+*/
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief Largest number of rows computed by the few-row (GEMV) path instead of HMX.
+*/
+#define HEXKL_MACRO_EXT_GEMV_MAX_ROWS (8U)
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief
+  Performs matrix multiplication of FP16 activations by FP16 weights, producing FP16 results, followed by an
+  optional epilogue.
+
+  - `A`: output matrix, type FP16, row-major layout
+  - `X`: input matrix, type FP16, row-major layout
+  - `W`: weight matrix, type FP16, row-major layout `W[n_inner][n_col]`
+
+  @param[in]  vtcm_base  Pointer to the base of the VTCM region to work in.
+  @param[in]  vtcm_size  Size of the VTCM region in bytes.
+  @param[in]  n_row      Number of rows in matrix X and A.
+  @param[in]  n_col      Number of columns in matrix W and A. Must be a multiple of ::HEXKL_HMX_F16_BLOCK_N_COL.
+  @param[in]  n_inner    Shared dimension between X and W. Must be a multiple of ::HEXKL_HMX_F16_BLOCK_N_INNER.
+  @param[out] A          Pointer to the output matrix A.
+  @param[in]  X          Pointer to the input matrix X.
+  @param[in]  W          Pointer to the weight matrix W.
+  @param[in]  epilogue   Epilogue applied to the accumulator tiles, or NULL for none. The residual is FP16.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` for invalid dimensions or pointers.
+  - `AEE_ENOMEMORY` if the loop order set with `hexkl_macro_ext_set_mm_order()` does not fit in the VTCM region.
+    The few-row path uses no VTCM.
+  - Error codes of the HexKL NPU Micro API otherwise.
+ */
+int hexkl_macro_ext_mm_f16(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  _Float16* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+);
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief
+  Same as `hexkl_macro_ext_mm_f16()`, producing FP32 results. The residual of the epilogue is FP32.
+ */
+int hexkl_macro_ext_mm_f16f16_f32(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+);
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief
+  Same as `hexkl_macro_ext_mm_f16()`, with the rows of `X` `x_row_stride` elements apart.
+
+  `X` can be a window of a larger row-major buffer, e.g. columns `c0 .. c0 + n_inner` of a KV cache with
+  `x_row_stride` columns, passed as `X = buffer + c0`. The activation tiles are gathered row by row from DDR into
+  VTCM; no contiguous copy of `X` is made.
+
+  @param[in]  x_row_stride  Distance in elements between consecutive rows of `X`, at least `n_inner`.
+
+  @return
+  - `AEE_EBADPARM` if `x_row_stride` is less than `n_inner`, otherwise as `hexkl_macro_ext_mm_f16()`.
+ */
+int hexkl_macro_ext_mm_f16_strided(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  _Float16* restrict A,
+  const _Float16* restrict X,
+  uint32_t x_row_stride,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+);
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief
+  Same as `hexkl_macro_ext_mm_f16_strided()`, producing FP32 results. The residual of the epilogue is FP32.
+ */
+int hexkl_macro_ext_mm_f16f16_f32_strided(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  uint32_t x_row_stride,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+);
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @struct hexkl_mm_weight_t
+  @brief One weight matrix of a multi-weight matrix multiplication, with its own output and epilogue.
+*/
+typedef struct {
+  /*!
+    @brief Weight matrix, type FP16, row-major layout `W[n_inner][n_col]`.
+  */
+  const _Float16* W;
+
+  /*!
+    @brief Output matrix `A[n_row][n_col]`, row-major, FP16 or FP32 depending on the function.
+  */
+  void* A;
+
+  /*!
+    @brief Number of columns of `W` and `A`. Must be a multiple of ::HEXKL_HMX_F16_BLOCK_N_COL.
+  */
+  uint32_t n_col;
+
+  /*!
+    @brief Epilogue applied to this output, or NULL for none. The residual has the type of `A`.
+  */
+  const hexkl_epilogue_t* epilogue;
+} hexkl_mm_weight_t;
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief
+  Multiplies one FP16 activation matrix by several FP16 weight matrices, producing one FP16 result each, e.g. the
+  Q, K and V projections or the gate and up projections of a layer.
+
+  The activation tiles of each 32-row block are copied into VTCM and converted to AH layout once, then reused for
+  the column blocks of every weight matrix, instead of once per matrix as with separate `hexkl_macro_ext_mm_f16()`
+  calls. The loop orders of @ref NPUMacroExtSched treat the column blocks of all weight matrices as those of one
+  matrix. The results are the same as those of the separate calls.
+
+  @param[in]  vtcm_base  Pointer to the base of the VTCM region to work in.
+  @param[in]  vtcm_size  Size of the VTCM region in bytes.
+  @param[in]  n_row      Number of rows in matrix X and in every output.
+  @param[in]  n_inner    Shared dimension between X and the weights. Must be a multiple of
+                         ::HEXKL_HMX_F16_BLOCK_N_INNER.
+  @param[in]  X          Pointer to the input matrix X, type FP16, row-major layout.
+  @param[in]  weights    Weight matrices with their outputs and epilogues.
+  @param[in]  n_weights  Number of entries of `weights`, at least 1.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` for invalid dimensions or pointers in any entry, checked before any output is written.
+  - Otherwise as `hexkl_macro_ext_mm_f16()`.
+ */
+int hexkl_macro_ext_mm_f16_multi(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_inner,
+  const _Float16* restrict X,
+  const hexkl_mm_weight_t* weights,
+  uint32_t n_weights
+);
+
+/*!
+  @ingroup NPUMacroExtMatMul
+  @brief
+  Same as `hexkl_macro_ext_mm_f16_multi()`, producing FP32 results. The residuals of the epilogues are FP32.
+ */
+int hexkl_macro_ext_mm_f16f16_f32_multi(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_inner,
+  const _Float16* restrict X,
+  const hexkl_mm_weight_t* weights,
+  uint32_t n_weights
+);
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtSched Tile Scheduling
+  @brief Defines the order in which the HMX matrix multiplications visit the tiles of X and W.
+
+  With `R` blocks of 32 rows and `C` blocks of 32 columns (over all weight matrices of a multi-weight call), the
+  bytes copied from DDR to VTCM by each order are, for activations of `a` bytes and weights of `w` bytes:
+
+  - activation-stationary: `a + R * w`. The activation tiles of a row block stay in VTCM while the weight tiles of
+    every column block are converted to WH layout, one at a time.
+  - weight-stationary: `w + ceil(C / P) * a`. A panel of `P` column blocks of weight tiles is converted to WH layout
+    once and stays in VTCM while all row blocks sweep across it. `P` is as large as the VTCM region allows.
+  - output-stationary: `C * a + R * w`. Each output tile accumulates with a single activation tile and a single
+    weight tile in VTCM. Needs the least VTCM, whatever `n_inner`.
+
+  ::HEXKL_MM_ORDER_AUTO selects the order moving the fewest bytes among those fitting in the VTCM region, preferring
+  activation-stationary, then weight-stationary on ties. All orders accumulate the inner tiles in the same order, so
+  their results are identical. The few-row path does not use VTCM and ignores the order.
+*/
+
+/*!
+  @ingroup NPUMacroExtSched
+  @enum hexkl_mm_order_e
+  @brief Loop order of the HMX matrix multiplications.
+*/
+typedef enum {
+  /*!
+    @brief Selected per call from the shape and the VTCM size.
+  */
+  HEXKL_MM_ORDER_AUTO = 0,
+
+  /*!
+    @brief One activation tile and one weight tile at a time.
+  */
+  HEXKL_MM_ORDER_OUTPUT_STATIONARY = 1,
+
+  /*!
+    @brief Row of activation tiles resident, weight tiles converted per row block.
+  */
+  HEXKL_MM_ORDER_ACTIVATION_STATIONARY = 2,
+
+  /*!
+    @brief Panel of weight tiles resident, all row blocks swept across it.
+  */
+  HEXKL_MM_ORDER_WEIGHT_STATIONARY = 3,
+
+  /*!
+    @brief Invalid order. Also used to indicate the number of valid values.
+  */
+  HEXKL_MM_ORDER_INVALID
+} hexkl_mm_order_e;
+
+/*!
+  @ingroup NPUMacroExtSched
+  @brief
+  Sets the loop order of the following matrix multiplications of the process, ::HEXKL_MM_ORDER_AUTO by default.
+
+  @param[in] order  Loop order.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for an invalid order.
+ */
+int hexkl_macro_ext_set_mm_order(hexkl_mm_order_e order);
+
+/*!
+  @ingroup NPUMacroExtSched
+  @brief Returns the loop order set with `hexkl_macro_ext_set_mm_order()`.
+ */
+hexkl_mm_order_e hexkl_macro_ext_get_mm_order(void);
+
+/*!
+  @ingroup NPUMacroExtSched
+  @brief
+  Returns the loop order a matrix multiplication of the given shape uses with the current setting, and the bytes it
+  copies from DDR to VTCM, as counted in `hexkl_macro_ext_stats_t::bytes_to_vtcm`.
+
+  @param[in]  vtcm_size      Size of the VTCM region in bytes.
+  @param[in]  n_row          Number of rows in matrix X. Must be greater than ::HEXKL_MACRO_EXT_GEMV_MAX_ROWS.
+  @param[in]  n_col          Number of columns of all weight matrices together. Must be a multiple of
+                             ::HEXKL_HMX_F16_BLOCK_N_COL.
+  @param[in]  n_inner        Shared dimension between X and W. Must be a multiple of ::HEXKL_HMX_F16_BLOCK_N_INNER.
+  @param[out] order          Receives the loop order, never ::HEXKL_MM_ORDER_AUTO.
+  @param[out] bytes_to_vtcm  Receives the bytes copied from DDR to VTCM. May be NULL.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for invalid dimensions or if `order` is NULL.
+  - `AEE_ENOMEMORY` if the order set does not fit in the VTCM region, or none does with ::HEXKL_MM_ORDER_AUTO.
+    The matrix multiplications fail the same way.
+ */
+int hexkl_macro_ext_mm_select_order(
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  hexkl_mm_order_e* order,
+  uint64_t* bytes_to_vtcm
+);
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtVtcm VTCM Arena
+  @brief Defines an allocator of the VTCM offsets passed to the HexKL NPU Micro API.
+
+  An arena hands out offsets from the base of a VTCM region of a given size, e.g. the one returned by
+  `hexkl_micro_hw_init()`, aligned for the kind of data they hold. Activation, accumulator and staging tiles and
+  weight tiles are allocated upwards from the base; the HMX configuration is allocated downwards from the end, so the
+  tile panels stay contiguous and `hexkl_macro_ext_vtcm_available()` reports the largest panel that still fits.
+  Frames release every allocation made since they began, in LIFO order, and the arena keeps the high-water mark of
+  the bytes in use. The arena only computes offsets: it neither reads nor writes VTCM, and the base of the region
+  must be aligned to ::HEXKL_HMX_ACTIVATION_ALIGNMENT, as returned by `hexkl_micro_hw_init()`.
+
+  The matrix multiplications of the extensions lay out their own VTCM region with an arena. A caller keeping data
+  resident in VTCM across calls can allocate it from an arena and pass the rest of the region to them.
+*/
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @enum hexkl_vtcm_class_e
+  @brief Kind of data of a VTCM allocation, which sets its alignment and the end of the region it comes from.
+*/
+typedef enum {
+  /*!
+    @brief Activation, accumulator or staging tiles, aligned to ::HEXKL_HMX_ACTIVATION_ALIGNMENT.
+  */
+  HEXKL_VTCM_ACTIVATION = 0,
+
+  /*!
+    @brief Weight tiles, aligned to ::HEXKL_HMX_WEIGHTS_ALIGNMENT.
+  */
+  HEXKL_VTCM_WEIGHTS = 1,
+
+  /*!
+    @brief HMX configuration, aligned to ::HEXKL_HMX_CONFIG_ALIGNMENT, allocated from the end of the region.
+  */
+  HEXKL_VTCM_CONFIG = 2,
+
+  /*!
+    @brief Invalid class. Also used to indicate the number of valid values.
+  */
+  HEXKL_VTCM_INVALID
+} hexkl_vtcm_class_e;
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @struct hexkl_vtcm_arena_t
+  @brief State of an arena, owned by the caller. The fields are private; use the functions below.
+*/
+typedef struct {
+  /*!
+    @brief Size of the region in bytes.
+  */
+  uint32_t size;
+
+  /*!
+    @brief End of the allocations from the base.
+  */
+  uint32_t low;
+
+  /*!
+    @brief Start of the allocations from the end.
+  */
+  uint32_t high;
+
+  /*!
+    @brief Largest number of bytes in use.
+  */
+  uint32_t high_water;
+} hexkl_vtcm_arena_t;
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @struct hexkl_vtcm_frame_t
+  @brief State of an arena at the beginning of a frame.
+*/
+typedef struct {
+  /*!
+    @brief End of the allocations from the base.
+  */
+  uint32_t low;
+
+  /*!
+    @brief Start of the allocations from the end.
+  */
+  uint32_t high;
+} hexkl_vtcm_frame_t;
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @struct hexkl_vtcm_usage_t
+  @brief Occupancy of an arena.
+*/
+typedef struct {
+  /*!
+    @brief Size of the region in bytes.
+  */
+  uint32_t size;
+
+  /*!
+    @brief Bytes in use, alignment padding included.
+  */
+  uint32_t used;
+
+  /*!
+    @brief Largest value of `used` since `hexkl_macro_ext_vtcm_init()`.
+  */
+  uint32_t high_water;
+} hexkl_vtcm_usage_t;
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @brief Initializes an empty arena over a VTCM region of `vtcm_size` bytes.
+
+  @param[out] arena      Arena to initialize.
+  @param[in]  vtcm_size  Size of the VTCM region in bytes.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `arena` is NULL.
+ */
+int hexkl_macro_ext_vtcm_init(hexkl_vtcm_arena_t* arena, uint32_t vtcm_size);
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @brief Allocates `size` bytes of class `vtcm_class` and returns their offset from the base of the region.
+
+  @param[in,out] arena       Arena to allocate from.
+  @param[in]     vtcm_class  Kind of data, which sets the alignment of the offset.
+  @param[in]     size        Number of bytes, at least 1.
+  @param[out]    offset      Receives the offset, to pass to the HexKL NPU Micro API with the base of the region.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for a NULL pointer, an invalid class or a size of 0.
+  - `AEE_ENOMEMORY` if the allocation does not fit. The arena is left unchanged.
+ */
+int hexkl_macro_ext_vtcm_alloc(
+  hexkl_vtcm_arena_t* arena,
+  hexkl_vtcm_class_e vtcm_class,
+  uint32_t size,
+  uint32_t* offset
+);
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @brief Returns the largest size `hexkl_macro_ext_vtcm_alloc()` can allocate with class `vtcm_class`, or 0.
+
+  Kernels divide it by the size of a panel of tiles to find how many panels fit in the VTCM actually available.
+ */
+uint32_t hexkl_macro_ext_vtcm_available(const hexkl_vtcm_arena_t* arena, hexkl_vtcm_class_e vtcm_class);
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @brief Begins a frame, recording the allocations in use.
+
+  @param[in]  arena  Arena.
+  @param[out] frame  Receives the state to pass to `hexkl_macro_ext_vtcm_frame_end()`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL.
+ */
+int hexkl_macro_ext_vtcm_frame_begin(const hexkl_vtcm_arena_t* arena, hexkl_vtcm_frame_t* frame);
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @brief Ends a frame, releasing every allocation made since it began. Frames nest and end in reverse order.
+
+  @param[in,out] arena  Arena.
+  @param[in]     frame  State returned by `hexkl_macro_ext_vtcm_frame_begin()`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL, or if the frame ends after an enclosing frame did.
+ */
+int hexkl_macro_ext_vtcm_frame_end(hexkl_vtcm_arena_t* arena, const hexkl_vtcm_frame_t* frame);
+
+/*!
+  @ingroup NPUMacroExtVtcm
+  @brief Reads the occupancy of an arena.
+
+  @param[in]  arena  Arena.
+  @param[out] usage  Receives the size, the bytes in use and their high-water mark.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL.
+ */
+int hexkl_macro_ext_vtcm_get_usage(const hexkl_vtcm_arena_t* arena, hexkl_vtcm_usage_t* usage);
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtDma Asynchronous Tile Copies
+  @brief Defines DDR to VTCM copies run by the user DMA engine of the calling hardware thread.
+
+  The copy functions of the HexKL NPU Micro API are synchronous: the thread stalls on every DDR access of a tile.
+  A copy issued here returns at once with a token and proceeds in the background, so the next tile can stream into
+  VTCM while `hexkl_micro_hmx_mm_*()` runs on the current one. The copies are laid out as they are in DDR (flat,
+  row-major); the layout conversions of the micro API then run from VTCM to VTCM, e.g.
+  `hexkl_micro_hmx_rm_to_wh_f16()` with `vtcm_base + offset` as its input matrix and `hexkl_micro_hmx_rm_to_ah_f16()`.
+
+  A queue holds up to ::HEXKL_MACRO_EXT_DMA_DEPTH copies in flight as a chain of 2D DMA descriptors. The source is
+  read through the L2 cache, so it needs no cache maintenance. The user DMA engine belongs to the hardware thread:
+  a queue is used by one software thread, and all its copies are waited for before another queue issues copies on
+  the same thread.
+
+  The matrix multiplications of the extensions double-buffer their activation and weight tiles this way; see
+  `hexkl_macro_ext_set_mm_dma()`.
+*/
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief Largest number of copies in flight in a queue.
+*/
+#define HEXKL_MACRO_EXT_DMA_DEPTH (8U)
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief Largest row length, row stride and number of rows of a copy.
+*/
+#define HEXKL_MACRO_EXT_DMA_MAX (0xFFFFU)
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief Identifies a copy issued to a queue, to wait for.
+*/
+typedef uint32_t hexkl_dma_token_t;
+
+/*!
+  @ingroup NPUMacroExtDma
+  @struct hexkl_dma_queue_t
+  @brief Queue of copies, owned by the caller. The fields are private; use the functions below.
+*/
+typedef struct {
+  /*!
+    @brief Storage of the DMA descriptors, a ring indexed by token.
+  */
+  uint8_t desc[HEXKL_MACRO_EXT_DMA_DEPTH][64] __attribute__((aligned(64)));
+
+  /*!
+    @brief Last descriptor linked to the DMA chain, or NULL.
+  */
+  void* tail;
+
+  /*!
+    @brief Number of copies issued, the token of the next one.
+  */
+  uint32_t n_issued;
+} hexkl_dma_queue_t;
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief Initializes an empty queue.
+
+  @param[out] queue  Queue to initialize.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `queue` is NULL.
+ */
+int hexkl_macro_ext_dma_init(hexkl_dma_queue_t* queue);
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief
+  Starts copying `n_rows` rows of `row_bytes` bytes, `src_stride` bytes apart in DDR, to consecutive rows at
+  `vtcm_base + out_offset`, and returns without waiting.
+
+  E.g. a 32x32 FP16 tile of a row-major matrix with `n_col` columns is copied with `row_bytes = 64`,
+  `src_stride = 2 * n_col` and `n_rows = 32`. If the queue is full, waits for its oldest copy first. Neither the
+  source nor the destination may be modified or read until the copy has been waited for.
+
+  @param[in,out] queue       Queue to issue the copy to.
+  @param[in]     vtcm_base   Pointer to the base of the VTCM region.
+  @param[in]     out_offset  Byte offset of the destination from `vtcm_base`.
+  @param[in]     src         Source in DDR.
+  @param[in]     src_stride  Distance in bytes between consecutive source rows, at least `row_bytes`.
+  @param[in]     row_bytes   Bytes per row.
+  @param[in]     n_rows      Number of rows.
+  @param[out]    token       Receives the token of the copy.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for a NULL pointer, a length or count of 0, or one above ::HEXKL_MACRO_EXT_DMA_MAX.
+ */
+int hexkl_macro_ext_dma_copy_async(
+  hexkl_dma_queue_t* queue,
+  uint8_t* vtcm_base,
+  uint32_t out_offset,
+  const void* src,
+  uint32_t src_stride,
+  uint32_t row_bytes,
+  uint32_t n_rows,
+  hexkl_dma_token_t* token
+);
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief Waits until the copy of `token` has completed. Copies complete in the order they were issued.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `queue` is NULL or `token` was not issued to it.
+ */
+int hexkl_macro_ext_dma_wait(hexkl_dma_queue_t* queue, hexkl_dma_token_t token);
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief Waits until every copy issued to the queue has completed.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `queue` is NULL.
+ */
+int hexkl_macro_ext_dma_wait_all(hexkl_dma_queue_t* queue);
+
+/*!
+  @ingroup NPUMacroExtDma
+  @brief
+  Selects whether the following matrix multiplications of the process copy their tiles with the user DMA engine,
+  double-buffered, or with the synchronous copies of the micro API. DMA is used by default. Operands whose row stride
+  exceeds ::HEXKL_MACRO_EXT_DMA_MAX bytes are always copied synchronously. The results are the same either way.
+
+  @param[in] enable  Non-zero to use DMA.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int hexkl_macro_ext_set_mm_dma(int enable);
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtChain Accumulation Chains
+  @brief Defines HMX multiplications of a sequence of tile pairs into the accumulator in one call.
+
+  The inner loop of a matrix multiplication on the micro API calls `hexkl_micro_hmx_mm_*()` once per inner tile, and
+  every call checks its arguments. A chain takes the offsets of all the tile pairs of one accumulation, checks them
+  all before the first multiplication, so that an invalid chain leaves the accumulator untouched, and then issues the
+  multiplications back to back. The tile pairs are multiplied in array order: a chain accumulates exactly as the loop
+  it replaces.
+
+  As with the micro API, the accumulator is cleared with `hexkl_micro_hmx_acc_clear_*()` before the chain and read
+  with `hexkl_micro_hmx_acc_read_*()` after it; chains of the same data type may follow each other to accumulate
+  more tile pairs.
+*/
+
+/*!
+  @ingroup NPUMacroExtChain
+  @brief
+  Multiplies `n` pairs of 64x32 uint8 activation and 32x32 int8 weight tiles, adding the products into the int32
+  accumulator, as `hexkl_micro_hmx_mm_u8i8()` called for each pair in order.
+
+  @param[in] vtcm_base    Pointer to the base of the VTCM region.
+  @param[in] act_offsets  Byte offsets of the activation tiles from `vtcm_base`.
+  @param[in] wt_offsets   Byte offsets of the weight tiles from `vtcm_base`, in WH layout.
+  @param[in] n            Number of tile pairs.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for a NULL pointer, `n` of 0, or a tile not aligned to ::HEXKL_HMX_ACTIVATION_ALIGNMENT
+    (activation) or ::HEXKL_HMX_WEIGHTS_ALIGNMENT (weights); nothing is multiplied then.
+ */
+int hexkl_macro_ext_hmx_mm_u8i8_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n
+);
+
+/*!
+  @ingroup NPUMacroExtChain
+  @brief
+  Same as `hexkl_macro_ext_hmx_mm_u8i8_chain()` with packed int4 weight tiles, as `hexkl_micro_hmx_mm_u8i4()`.
+ */
+int hexkl_macro_ext_hmx_mm_u8i4_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n
+);
+
+/*!
+  @ingroup NPUMacroExtChain
+  @brief
+  Multiplies `n` pairs of 32x32 FP16 activation tiles (AH layout) and weight tiles (WH layout), adding the products
+  into the FP16 accumulator, as `hexkl_micro_hmx_mm_f16()` called for each pair in order.
+
+  @param[in] vtcm_base    Pointer to the base of the VTCM region.
+  @param[in] act_offsets  Byte offsets of the activation tiles from `vtcm_base`.
+  @param[in] wt_offsets   Byte offsets of the weight tiles from `vtcm_base`.
+  @param[in] n            Number of tile pairs.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for a NULL pointer, `n` of 0, or a misaligned tile; nothing is multiplied then.
+ */
+int hexkl_macro_ext_hmx_mm_f16_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n
+);
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtAcc Accumulator Slots
+  @brief Defines spills of the HMX accumulator to VTCM and reloads from it, to interleave several output tiles.
+
+  HMX has a single accumulator, so with the micro API an output tile is accumulated over all its inner tiles before
+  the next one starts. A slot in VTCM holds the accumulation of one output tile while the accumulator works on other
+  tiles: `hexkl_macro_ext_hmx_acc_restore_*()` resumes the accumulation of a slot, the HMX multiplications that
+  follow add to it, and `hexkl_macro_ext_hmx_acc_save_*()` spills it back. Schedulers can then split the inner
+  dimension (split-K), or keep a panel of weight tiles resident and rotate through the output tiles that use it.
+
+  The micro API has no operation loading the accumulator, so a restore rebuilds it with HMX:
+
+  - int32: restoring clears the accumulator and saving adds it to the partial sums of the slot. The slot and the
+    accumulator together hold the accumulation, and integer addition makes it the same as without interruption.
+  - FP16: restoring multiplies the FP16 values of the slot by an identity weight tile kept in the slot, which loads
+    them into the accumulator unchanged. Each save rounds the accumulator to FP16 as an accumulator read does, so the
+    result equals the uninterrupted accumulation whenever the accumulator holds FP16 values.
+
+  After the last save, the slot holds the result in the layout of `hexkl_micro_hmx_acc_read_int32()` or
+  `hexkl_micro_hmx_acc_read_f16()`, to be stored with the micro API copy or conversion functions. Slots are aligned
+  to ::HEXKL_HMX_ACTIVATION_ALIGNMENT.
+*/
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Size in bytes of an int32 slot, a 64x32 int32 accumulator tile.
+*/
+#define HEXKL_MACRO_EXT_ACC_SLOT_INT32_BYTES (64U * 32U * 4U)
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Size in bytes of an FP16 slot: a 32x32 FP16 accumulator tile in AH layout, then an identity weight tile.
+*/
+#define HEXKL_MACRO_EXT_ACC_SLOT_F16_BYTES (2U * 32U * 32U * 2U)
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Initializes an int32 slot to an accumulation of zero.
+
+  @param[in] vtcm_base    Pointer to the base of the VTCM region.
+  @param[in] slot_offset  Byte offset of the slot from `vtcm_base`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `vtcm_base` is NULL or the slot is misaligned.
+ */
+int hexkl_macro_ext_hmx_acc_slot_init_int32(uint8_t* vtcm_base, uint32_t slot_offset);
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Resumes the int32 accumulation of a slot: clears the accumulator, see above.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `vtcm_base` is NULL or the slot is misaligned.
+ */
+int hexkl_macro_ext_hmx_acc_restore_int32(uint8_t* vtcm_base, uint32_t slot_offset);
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief
+  Spills the int32 accumulator to a slot: adds it to the partial sums of the slot and clears it, so saving twice
+  adds it once. The accumulator is read out through `scratch_offset` with `hexkl_micro_hmx_acc_read_int32()`.
+
+  @param[in] vtcm_base       Pointer to the base of the VTCM region.
+  @param[in] config_offset   Byte offset of the HMX configuration set with `hexkl_micro_hmx_setup_acc_read_int32()`.
+  @param[in] slot_offset     Byte offset of the slot from `vtcm_base`.
+  @param[in] scratch_offset  Byte offset of ::HEXKL_MACRO_EXT_ACC_SLOT_INT32_BYTES bytes of scratch, aligned as a slot.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `vtcm_base` is NULL or the slot or scratch is misaligned.
+  - Errors of `hexkl_micro_hmx_acc_read_int32()`.
+ */
+int hexkl_macro_ext_hmx_acc_save_int32(
+  uint8_t* vtcm_base,
+  uint32_t config_offset,
+  uint32_t slot_offset,
+  uint32_t scratch_offset
+);
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Initializes an FP16 slot to an accumulation of zero and writes its identity weight tile.
+
+  @param[in] vtcm_base    Pointer to the base of the VTCM region.
+  @param[in] slot_offset  Byte offset of the slot from `vtcm_base`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `vtcm_base` is NULL or the slot is misaligned.
+ */
+int hexkl_macro_ext_hmx_acc_slot_init_f16(uint8_t* vtcm_base, uint32_t slot_offset);
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Resumes the FP16 accumulation of a slot: loads its values into the accumulator, see above.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `vtcm_base` is NULL or the slot is misaligned.
+  - Errors of `hexkl_micro_hmx_mm_f16()`.
+ */
+int hexkl_macro_ext_hmx_acc_restore_f16(uint8_t* vtcm_base, uint32_t slot_offset);
+
+/*!
+  @ingroup NPUMacroExtAcc
+  @brief Spills the FP16 accumulator to a slot with `hexkl_micro_hmx_acc_read_f16()`.
+
+  @param[in] vtcm_base      Pointer to the base of the VTCM region.
+  @param[in] config_offset  Byte offset of the HMX configuration set with `hexkl_micro_hmx_setup_acc_read_f16()`.
+  @param[in] slot_offset    Byte offset of the slot from `vtcm_base`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `vtcm_base` is NULL or the slot is misaligned.
+  - Errors of `hexkl_micro_hmx_acc_read_f16()`.
+ */
+int hexkl_macro_ext_hmx_acc_save_f16(uint8_t* vtcm_base, uint32_t config_offset, uint32_t slot_offset);
+
+/*!
+  @ingroup HexKLNPUMacroExt
+  @defgroup NPUMacroExtTrace Tracing
+  @brief Defines an opt-in recorder of timestamped spans on the NPU, exported in the Chrome trace JSON format.
+
+  When tracing is started, the matrix multiplication functions record one span per phase of each block: loading
+  a row of activation tiles from DDR into VTCM and converting it to AH layout, loading and converting the weight
+  tiles of a column block interleaved with the HMX multiplications, reading the accumulator out and converting it
+  to row-major layout, and storing the result tile to DDR. Programs add their own spans with
+  `hexkl_macro_ext_trace_begin()` and `hexkl_macro_ext_trace_end()`.
+
+  Spans are written to a ring buffer without locking. When it is full, the oldest spans are overwritten. Timestamps
+  come from the QTimer. When tracing is stopped, each instrumentation point costs one relaxed atomic load.
+*/
+
+/*!
+  @ingroup NPUMacroExtTrace
+  @brief Starts recording spans into a ring buffer of at least `n_events` spans, discarding earlier spans.
+
+  Must not be called while traced functions run on other threads.
+
+  @param[in] n_events  Capacity of the ring buffer in spans, rounded up to a power of two.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `n_events` is 0 or larger than 2^20.
+  - `AEE_ENOMEMORY` if the ring buffer could not be allocated.
+ */
+int hexkl_macro_ext_trace_start(uint32_t n_events);
+
+/*!
+  @ingroup NPUMacroExtTrace
+  @brief Stops recording spans. The recorded spans are kept until the next `hexkl_macro_ext_trace_start()`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int hexkl_macro_ext_trace_stop(void);
+
+/*!
+  @ingroup NPUMacroExtTrace
+  @brief Writes the recorded spans to a file in the Chrome trace JSON format, e.g. in the directory given to
+         the simulator with `--usefs`.
+
+  @param[in] path  Path of the file to write.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `path` is NULL.
+  - `AEE_EFAILED` if the file could not be written.
+ */
+int hexkl_macro_ext_trace_dump(const char* path);
+
+/*!
+  @ingroup NPUMacroExtTrace
+  @brief Stops recording and frees the ring buffer.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int hexkl_macro_ext_trace_finalize(void);
+
+/*!
+  @ingroup NPUMacroExtTrace
+  @brief Opens a span on the calling thread.
+
+  @return
+  Start timestamp of the span to pass to `hexkl_macro_ext_trace_end()`, or 0 if tracing is stopped.
+ */
+uint64_t hexkl_macro_ext_trace_begin(void);
+
+/*!
+  @ingroup NPUMacroExtTrace
+  @brief Closes a span opened by `hexkl_macro_ext_trace_begin()` and records it. Does nothing if `begin` is 0.
+
+  @param[in] name      Name of the span. Only the pointer is recorded, e.g. a string literal.
+  @param[in] category  Category of the span. Only the pointer is recorded.
+  @param[in] begin     Value returned by `hexkl_macro_ext_trace_begin()`.
+ */
+void hexkl_macro_ext_trace_end(const char* name, const char* category, uint64_t begin);
+
+/*!
+  @ingroup NPUMacroExtStats
+  @brief Reads the counters.
+
+  @param[out] stats  Receives the counters.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `stats` is NULL.
+ */
+int hexkl_macro_ext_get_stats(hexkl_macro_ext_stats_t* stats);
+
+/*!
+  @ingroup NPUMacroExtStats
+  @brief Resets the counters to 0.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int hexkl_macro_ext_reset_stats(void);
+
+#endif // __hexagon__
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif //__HEXKL_MACRO_EXT_H__
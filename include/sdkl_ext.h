@@ -0,0 +1,1874 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#ifndef __SDKL_EXT_H__
+#define __SDKL_EXT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdkl.h"
+
+/*!
+  @file sdkl_ext.h
+  @brief Defines constants, types, and functions extending the HexKL CPU Macro API.
+
+  The extensions are distributed as source (`src/sdkl_ext/`) and are built on top of the public
+  `sdkl.h` API. Applications compile the sources together with their own code and link against
+  `libsdkl.so` as usual.
+*/
+
+/*!
+  @defgroup HexKLCPUMacroExt HexKL CPU Macro API Extensions
+  @brief Source-level extensions of the HexKL CPU Macro API.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtCPU CPU Matrix Multiplication Engine
+  @brief Defines the multithreaded, cache-blocked GEMM engine used by the CPU platform.
+
+  The engine packs both operands into cache-sized panels and runs SIMD micro-kernels
+  (NEON on Arm, AVX2/FMA on x86 hosts, portable C otherwise) on a pool of worker threads.
+  By default the pool has one thread per big core; cores of the slowest cluster are left idle.
+  Float products of at most 8 rows, as in token generation, skip the packing: weight rows are
+  streamed once, with prefetching, and dotted with all activation rows.
+*/
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @def SDKL_CPU_MAX_THREADS
+  @brief Maximum number of threads in the CPU engine worker pool, including the calling thread.
+*/
+#define SDKL_CPU_MAX_THREADS (16U)
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @struct sdkl_cpu_config_t
+  @brief Configuration of the CPU matrix multiplication engine.
+*/
+typedef struct {
+  /*!
+    @brief Number of threads used by the engine, including the calling thread.
+
+    A value of zero selects one thread per big core, as detected from the maximum
+    core frequencies reported by `/sys/devices/system/cpu`. Values above
+    ::SDKL_CPU_MAX_THREADS are clamped.
+  */
+  uint32_t num_threads;
+
+  /*!
+    @brief Pins worker threads to the detected big cores when non-zero.
+  */
+  uint32_t pin_threads;
+} sdkl_cpu_config_t;
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief Initializes the CPU matrix multiplication engine.
+
+  Creates the worker pool. Calling this function is optional: the engine initializes itself
+  with the default configuration on first use. Calling it again after finalization
+  re-creates the pool with the new configuration.
+
+  @param[in] config Engine configuration. May be `NULL` to use the defaults.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADSTATE` if the engine is already initialized.
+  - `AEE_ENOMEMORY` if the worker pool could not be created.
+ */
+int sdkl_cpu_initialize(const sdkl_cpu_config_t* config);
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief Stops the worker pool and releases the packing buffers of the CPU engine.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int sdkl_cpu_finalize(void);
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief Returns the number of threads used by the CPU engine, including the calling thread.
+
+  Initializes the engine with the default configuration if needed.
+ */
+uint32_t sdkl_cpu_get_num_threads(void);
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief
+  Performs matrix multiplication of SDKL tensors on the CPU engine.
+
+  Computes `A = X * W^T` with:
+  - `result_tensor`: output `A`, shape `[N_ROW, N_COL]`, `SDKL_LAYOUT_2D_ROW_MAJOR`, row stride `strides[0]`.
+  - `left_tensor`: activations `X`, shape `[N_ROW, N_INNER]`, `SDKL_LAYOUT_2D_ROW_MAJOR` or
+    `SDKL_LAYOUT_2D_COL_MAJOR`, addressed through `strides[]`. Strided activations (`is_continuous = 0`, e.g. a
+    column window of a larger buffer) are read in place while packing; no contiguous copy is made.
+  - `right_tensor`: weights `W`, shape `[N_INNER, N_COL]`, contiguous. With `SDKL_LAYOUT_2D_ROW_MAJOR`
+    the weights are stored transposed (`W[N_COL][N_INNER]`), as for `sdkl_mm_tensor()`; with
+    `SDKL_LAYOUT_2D_COL_MAJOR` they are stored as `W[N_INNER][N_COL]`.
+
+  Supported data type combinations (left x right -> result):
+  - FP32 x FP16 -> FP32, FP32 x FP32 -> FP32
+  - FP16 x FP16 -> FP16 or FP32
+  - U8 x I8 -> I32
+
+  FP16 operands are widened to FP32 while packing, so accumulation is always performed in FP32
+  (or INT32 for U8 x I8).
+
+  @param[out] result_tensor  Pointer to the output tensor descriptor.
+  @param[in]  left_tensor    Pointer to the left-hand input tensor descriptor.
+  @param[in]  right_tensor   Pointer to the right-hand input tensor descriptor.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADCLASS` if a descriptor or data pointer is NULL.
+  - `AEE_EBADPARM` if shapes, strides, or bounds are inconsistent.
+  - `AEE_EUNSUPPORTED` for unsupported layouts or data type combinations.
+*/
+int sdkl_cpu_mm_tensor(
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor
+);
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief
+  Performs matrix multiplication of FP32 activations by FP16 weights on the CPU engine, producing FP32 results.
+
+  @param[in]  n_row      Number of rows in matrix X and A.
+  @param[in]  n_col      Number of columns in matrix A (rows of W).
+  @param[in]  n_inner    Shared dimension between X and W.
+  @param[out] A          Pointer to the output matrix `A[n_row][n_col]` (FP32, row-major layout).
+  @param[in]  X          Pointer to the input matrix `X[n_row][n_inner]` (FP32, row-major layout).
+  @param[in]  W          Pointer to the weight matrix `W[n_col][n_inner]` (FP16, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if a pointer is NULL or a dimension is zero.
+ */
+int sdkl_cpu_mm_f32f16_f32(size_t n_row, size_t n_col, size_t n_inner, float* A, const float* X, const _Float16* W);
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief
+  Performs matrix multiplication of FP16 activations by FP16 weights on the CPU engine, producing FP16 results.
+
+  @param[in]  n_row      Number of rows in matrix X and A.
+  @param[in]  n_col      Number of columns in matrix A (rows of W).
+  @param[in]  n_inner    Shared dimension between X and W.
+  @param[out] A          Pointer to the output matrix `A[n_row][n_col]` (FP16, row-major layout).
+  @param[in]  X          Pointer to the input matrix `X[n_row][n_inner]` (FP16, row-major layout).
+  @param[in]  W          Pointer to the weight matrix `W[n_col][n_inner]` (FP16, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if a pointer is NULL or a dimension is zero.
+ */
+int sdkl_cpu_mm_f16f16_f16(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  _Float16* A,
+  const _Float16* X,
+  const _Float16* W
+);
+
+/*!
+  @ingroup CPUMacroExtCPU
+  @brief
+  Performs matrix multiplication of ui8 activations by i8 weights on the CPU engine, producing i32 results.
+
+  @param[in]  n_row      Number of rows in matrix X and A.
+  @param[in]  n_col      Number of columns in matrix A (rows of W).
+  @param[in]  n_inner    Shared dimension between X and W.
+  @param[out] A          Pointer to the output matrix `A[n_row][n_col]` (i32, row-major layout).
+  @param[in]  X          Pointer to the input matrix `X[n_row][n_inner]` (ui8, row-major layout).
+  @param[in]  W          Pointer to the weight matrix `W[n_col][n_inner]` (i8, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if a pointer is NULL or a dimension is zero.
+ */
+int sdkl_cpu_mm_u8i8_i32(size_t n_row, size_t n_col, size_t n_inner, int32_t* A, const uint8_t* X, const int8_t* W);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtWeights Prepacked Weight Handles
+  @brief Defines persistent, NPU-resident weight handles for repeated matrix multiplications.
+
+  A weight handle is created once from row-major weights: the weights are copied to an `sdkl_npu_alloc()`
+  buffer, converted to the WH layout, and mapped on the DSP of the handle's domain until the handle is
+  destroyed. Matrix multiplications with the handle then skip layout conversion, buffer mapping and
+  weight validation.
+*/
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @struct sdkl_weights_t
+  @brief Opaque handle of NPU-resident weights in WH layout.
+*/
+typedef struct sdkl_weights sdkl_weights_t;
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @struct sdkl_weights_info_t
+  @brief Describes a weight handle.
+*/
+typedef struct {
+  /*!
+    @brief Compute DSP (CDSP) domain the weights are mapped on.
+  */
+  int domain;
+
+  /*!
+    @brief Data type of the weights: `SDKL_DTYPE_FP16`, `SDKL_DTYPE_I8` or `SDKL_DTYPE_I4`.
+  */
+  sdkl_tensor_dtype_e dtype;
+
+  /*!
+    @brief Number of weight rows, i.e. columns of the matmul output.
+  */
+  size_t n_col;
+
+  /*!
+    @brief Shared dimension of the matmul.
+  */
+  size_t n_inner;
+
+  /*!
+    @brief Size in bytes of the NPU-resident buffer holding the weights, including padding.
+  */
+  size_t resident_bytes;
+
+  /*!
+    @brief Non-zero if the buffer is persistently mapped on the DSP side.
+
+    When the FastRPC mapping cannot be created (e.g. older FastRPC drivers), the handle remains usable
+    and the buffer is mapped by FastRPC on each call, as for plain `sdkl_npu_alloc()` buffers.
+  */
+  uint32_t is_mapped;
+} sdkl_weights_info_t;
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief Creates an NPU-resident weight handle from row-major weights.
+
+  @param[in]  domain   Which compute DSP (CDSP) core the weights are prepared for. Must be initialized with
+                       `sdkl_npu_initialize()`.
+  @param[in]  dtype    Weight data type:
+                       - `SDKL_DTYPE_FP16`: `W` is `_Float16`.
+                       - `SDKL_DTYPE_I8`: `W` is `int8_t`.
+                       - `SDKL_DTYPE_I4`: `W` is `int8_t` holding one sign-extended i4 value per byte. Dimensions are
+                         padded to multiples of 32 with zeros.
+  @param[in]  n_col    Number of rows of `W`, i.e. columns of the matmul output.
+  @param[in]  n_inner  Number of columns of `W`, i.e. shared dimension of the matmul.
+  @param[in]  W        Pointer to the weights `W[n_col][n_inner]` in row-major layout. Not referenced after the call.
+  @param[out] weights  Receives the created handle.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL or a dimension is zero.
+  - `AEE_EUNSUPPORTED` for unsupported data types.
+  - `AEE_ENOMEMORY` or error codes of `sdkl_npu_alloc()` and the layout functions on failure.
+ */
+int sdkl_weights_create(
+  int domain,
+  sdkl_tensor_dtype_e dtype,
+  size_t n_col,
+  size_t n_inner,
+  const void* W,
+  sdkl_weights_t** weights
+);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief Unmaps and frees a weight handle.
+
+  Must be called before `sdkl_npu_finalize()` of the handle's domain.
+
+  @param[in] weights  Handle to destroy. May be NULL.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - Error codes of `sdkl_npu_free()` on failure.
+ */
+int sdkl_weights_destroy(sdkl_weights_t* weights);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief Retrieves the description of a weight handle, including its resident size.
+
+  @param[in]  weights  Weight handle.
+  @param[out] info     Receives the description.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL.
+ */
+int sdkl_weights_get_info(const sdkl_weights_t* weights, sdkl_weights_info_t* info);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief Fills a right-hand tensor descriptor referencing the weights of a handle.
+
+  The descriptor uses `SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX` and can be passed to `sdkl_mm_tensor()`
+  (or `sdkl_ext_mm_tensor()`) on the NPU platform of the handle's domain. It stays valid until the handle
+  is destroyed.
+
+  @param[in]  weights  Weight handle.
+  @param[out] tensor   Tensor descriptor to fill.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL.
+ */
+int sdkl_weights_to_tensor(const sdkl_weights_t* weights, sdkl_tensor_t* tensor);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief
+  Performs matrix multiplication of FP32 activations by FP16 handle weights, producing FP32 results.
+
+  Equivalent to `sdkl_npu_mm_f32f16_f32()` on the handle's domain and dimensions.
+
+  @param[in]  weights  FP16 weight handle.
+  @param[in]  n_row    Number of rows in matrix X and A.
+  @param[out] A        Pointer to the output matrix `A[n_row][n_col]` (FP32, row-major layout).
+  @param[in]  X        Pointer to the input matrix `X[n_row][n_inner]` (FP32, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if the handle does not hold FP16 weights.
+  - Error codes of `sdkl_npu_mm_f32f16_f32()` on failure.
+ */
+int sdkl_weights_mm_f32f16_f32(const sdkl_weights_t* weights, size_t n_row, float* A, const float* X);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief
+  Performs matrix multiplication of FP16 activations by FP16 handle weights, producing FP16 results.
+
+  Equivalent to `sdkl_npu_mm_f16f16_f16()` on the handle's domain and dimensions.
+
+  @param[in]  weights  FP16 weight handle.
+  @param[in]  n_row    Number of rows in matrix X and A.
+  @param[out] A        Pointer to the output matrix `A[n_row][n_col]` (FP16, row-major layout).
+  @param[in]  X        Pointer to the input matrix `X[n_row][n_inner]` (FP16, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if the handle does not hold FP16 weights.
+  - Error codes of `sdkl_npu_mm_f16f16_f16()` on failure.
+ */
+int sdkl_weights_mm_f16f16_f16(const sdkl_weights_t* weights, size_t n_row, _Float16* A, const _Float16* X);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief
+  Performs matrix multiplication of ui8 activations by i8 handle weights, producing i32 results.
+
+  Equivalent to `sdkl_npu_mm_u8i8_i32()` on the handle's domain and dimensions.
+
+  @param[in]  weights  i8 weight handle.
+  @param[in]  n_row    Number of rows in matrix X and A.
+  @param[out] A        Pointer to the output matrix `A[n_row][n_col]` (i32, row-major layout).
+  @param[in]  X        Pointer to the input matrix `X[n_row][n_inner]` (ui8, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if the handle does not hold i8 weights.
+  - Error codes of `sdkl_npu_mm_u8i8_i32()` on failure.
+ */
+int sdkl_weights_mm_u8i8_i32(const sdkl_weights_t* weights, size_t n_row, int32_t* A, const uint8_t* X);
+
+/*!
+  @ingroup CPUMacroExtWeights
+  @brief
+  Performs matrix multiplication of ui8 activations by i4 handle weights, producing i32 results.
+
+  Equivalent to `sdkl_npu_mm_u8i4_i32()` on the handle's domain and dimensions.
+
+  @param[in]  weights  i4 weight handle.
+  @param[in]  n_row    Number of rows in matrix X and A.
+  @param[out] A        Pointer to the output matrix `A[n_row][n_col]` (i32, row-major layout).
+  @param[in]  X        Pointer to the input matrix `X[n_row][n_inner]` (ui8, row-major layout).
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if the handle does not hold i4 weights.
+  - Error codes of `sdkl_npu_mm_u8i4_i32()` on failure.
+ */
+int sdkl_weights_mm_u8i4_i32(const sdkl_weights_t* weights, size_t n_row, int32_t* A, const uint8_t* X);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtMatMul Matrix Multiplication Functions
+  @brief Defines the extended tensor matrix multiplication entry point.
+*/
+
+/*!
+  @ingroup CPUMacroExtMatMul
+  @brief
+  Performs matrix multiplication using SDKL tensor descriptors, with the extended platform backends.
+
+  Behaves like `sdkl_mm_tensor()`. `SDKL_PLATFORM_CPU` is executed by the multithreaded CPU engine
+  (see `sdkl_cpu_mm_tensor()`); NPU platforms are forwarded to `sdkl_mm_tensor()`.
+
+  @param[in]  platform       Execution platform (CPU, NPU0, NPU1) for the operation.
+  @param[out] result_tensor  Pointer to the output tensor descriptor.
+  @param[in]  left_tensor    Pointer to the left-hand input tensor descriptor.
+  @param[in]  right_tensor   Pointer to the right-hand input tensor descriptor.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - Error codes from `AEEStdErr.h` (e.g., `AEE_EBADPARM`, `AEE_EUNSUPPORTED`) if validation or execution fails.
+*/
+int sdkl_ext_mm_tensor(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtAsync Asynchronous Execution
+  @brief Defines asynchronous matrix multiplication with completion fences.
+
+  Each platform (CPU, NPU0, NPU1) owns an in-order submission queue served by a dedicated worker thread,
+  so the calling thread can prepare the next operation while the previous one executes. At most
+  `depth` operations are in flight per queue; further submissions block until one completes.
+*/
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @def SDKL_QUEUE_MAX_DEPTH
+  @brief Maximum depth of a submission queue.
+*/
+#define SDKL_QUEUE_MAX_DEPTH (64U)
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @def SDKL_QUEUE_DEFAULT_DEPTH
+  @brief Depth of a submission queue that was not configured with `sdkl_queue_set_depth()`.
+*/
+#define SDKL_QUEUE_DEFAULT_DEPTH (4U)
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @def SDKL_FENCE_HISTORY
+  @brief Number of most recent operations per queue whose completion status can be retrieved from a fence.
+*/
+#define SDKL_FENCE_HISTORY (1024U)
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @struct sdkl_fence_t
+  @brief Identifies an operation submitted to a queue. Fences are plain values and may be copied freely.
+*/
+typedef struct {
+  /*!
+    @brief Platform whose queue the operation was submitted to.
+  */
+  sdkl_tensor_platform_e platform;
+
+  /*!
+    @brief Position of the operation in the queue, starting at 1.
+  */
+  uint64_t seq;
+} sdkl_fence_t;
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @brief Sets the maximum number of in-flight operations of a platform queue.
+
+  May be called at any time; a lower depth takes effect for the next submission.
+
+  @param[in] platform  Platform of the queue (CPU, NPU0, NPU1).
+  @param[in] depth     Number of in-flight operations, in `[1, SDKL_QUEUE_MAX_DEPTH]`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for an invalid platform or depth.
+ */
+int sdkl_queue_set_depth(sdkl_tensor_platform_e platform, uint32_t depth);
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @brief
+  Submits a matrix multiplication of SDKL tensors to the queue of `platform` and returns immediately.
+
+  Executes `sdkl_ext_mm_tensor()` on the queue's worker thread, after all operations previously submitted to the
+  same queue. The descriptors are copied; the tensor data must remain valid and the result data must not be
+  accessed until the fence has completed. Blocks while the queue holds `depth` in-flight operations.
+
+  @param[in]  platform       Execution platform (CPU, NPU0, NPU1).
+  @param[out] result_tensor  Pointer to the output tensor descriptor.
+  @param[in]  left_tensor    Pointer to the left-hand input tensor descriptor.
+  @param[in]  right_tensor   Pointer to the right-hand input tensor descriptor.
+  @param[out] fence          Receives the fence of the operation.
+
+  @return
+  - `AEE_SUCCESS` if the operation was queued. Execution errors are reported by `sdkl_fence_wait()`.
+  - `AEE_EBADPARM` for an invalid platform or NULL pointer.
+  - `AEE_EFAILED` if the worker thread could not be created.
+ */
+int sdkl_mm_tensor_async(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  sdkl_fence_t* fence
+);
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @brief Blocks until the operation of `fence` has completed and returns its status.
+
+  @param[in] fence  Fence returned by a submission.
+
+  @return
+  - Return code of the operation (`AEE_SUCCESS` on success).
+  - `AEE_EBADPARM` if the fence was not issued by the queue.
+  - `AEE_EEXPIRED` if the operation completed more than ::SDKL_FENCE_HISTORY operations ago.
+ */
+int sdkl_fence_wait(const sdkl_fence_t* fence);
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @brief Returns the status of the operation of `fence` without blocking.
+
+  @param[in] fence  Fence returned by a submission.
+
+  @return
+  - `AEE_EITEMBUSY` if the operation is queued or running.
+  - Otherwise the same values as `sdkl_fence_wait()`.
+ */
+int sdkl_fence_poll(const sdkl_fence_t* fence);
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @brief Blocks until all operations submitted to the queue of `platform` have completed.
+
+  @param[in] platform  Platform of the queue (CPU, NPU0, NPU1).
+
+  @return
+  - `AEE_SUCCESS` if all operations succeeded since the previous call.
+  - Otherwise the return code of the first failed operation since the previous call.
+ */
+int sdkl_queue_sync(sdkl_tensor_platform_e platform);
+
+/*!
+  @ingroup CPUMacroExtAsync
+  @brief Drains the queue of `platform` and stops its worker thread.
+
+  Must be called before `sdkl_npu_finalize()` of the corresponding domain. The queue restarts on the next
+  submission.
+
+  @param[in] platform  Platform of the queue (CPU, NPU0, NPU1).
+
+  @return
+  - Same values as `sdkl_queue_sync()`.
+ */
+int sdkl_queue_finalize(sdkl_tensor_platform_e platform);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtBatch Batched Execution
+  @brief Defines batched matrix multiplication of SDKL tensors.
+
+  A batch validates all descriptors before executing anything and then runs the matrix multiplications back to
+  back. On NPU platforms, every `sdkl_npu_alloc()` buffer referenced by more than one item (shared weights or
+  activations) is mapped on the DSP once for the whole batch, so FastRPC does not map it again on each call.
+*/
+
+/*!
+  @ingroup CPUMacroExtBatch
+  @struct sdkl_batch_timing_t
+  @brief Timing of a batch returned by `sdkl_mm_tensor_batched()`.
+*/
+typedef struct {
+  /*!
+    @brief Wall-clock time of the whole call, in microseconds.
+  */
+  uint64_t total_us;
+
+  /*!
+    @brief Time spent creating and releasing the batch mappings, in microseconds.
+  */
+  uint64_t map_us;
+
+  /*!
+    @brief Number of buffers mapped on the DSP for the duration of the batch.
+  */
+  uint32_t n_mapped;
+} sdkl_batch_timing_t;
+
+/*!
+  @ingroup CPUMacroExtBatch
+  @brief
+  Executes `n` matrix multiplications `results[i] = lefts[i] * rights[i]` on `platform`, in order.
+
+  The descriptors follow the rules of `sdkl_ext_mm_tensor()`. Items may share input buffers; a result buffer
+  must not be an input of a later item.
+
+  @param[in]  platform  Execution platform (CPU, NPU0, NPU1).
+  @param[in]  n         Number of items.
+  @param[out] results   Array of `n` output tensor descriptors.
+  @param[in]  lefts     Array of `n` left-hand input tensor descriptors.
+  @param[in]  rights    Array of `n` right-hand input tensor descriptors.
+  @param[out] item_us   Optional array of `n` entries receiving the execution time of each item, in microseconds
+                        (0 for items that were not executed).
+  @param[out] timing    Optional batch timing.
+
+  @return
+  - `AEE_SUCCESS` if all items succeeded.
+  - `AEE_EBADPARM`, `AEE_EUNSUPPORTED` if an argument or descriptor is invalid; no item is executed in that case.
+  - Otherwise the error code of the first failed item; the following items are not executed.
+ */
+int sdkl_mm_tensor_batched(
+  sdkl_tensor_platform_e platform,
+  size_t n,
+  sdkl_tensor_t* results,
+  const sdkl_tensor_t* lefts,
+  const sdkl_tensor_t* rights,
+  uint64_t* item_us,
+  sdkl_batch_timing_t* timing
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtGrouped Grouped Matrix Multiplication
+  @brief Defines grouped matrix multiplication for mixture-of-experts layers.
+
+  A grouped matrix multiplication runs one GEMM per group (expert) against the group's own WH weights. All groups
+  share `n_col` and `n_inner`; the rows of each group are a contiguous slice of one packed activation buffer `X` and
+  of one packed output buffer `A`, delimited by an offset array:
+
+      rows of group g = [offsets[g], offsets[g + 1])
+
+  Groups without rows are skipped. The packed buffers are mapped on the DSP once for all groups.
+*/
+
+/*!
+  @ingroup CPUMacroExtGrouped
+  @brief Performs a grouped FP16 matrix multiplication on the NPU.
+
+  For every group `g` with rows, computes `A[r] = X[r] * W[g]` for the rows `r` of the group, like
+  `sdkl_npu_mm_f16f16_f16()`.
+
+  @param[in]  domain    Which compute DSP (CDSP) core the SDKL library will interact with.
+  @param[in]  n_groups  Number of groups.
+  @param[in]  offsets   Array of `n_groups + 1` non-decreasing row offsets; `offsets[n_groups]` is the number of rows
+                        of `X` and `A`.
+  @param[in]  n_col     Number of columns of every weight matrix and of `A`.
+  @param[in]  n_inner   Shared dimension between `X` and the weights.
+  @param[out] A         Packed output matrix (FP16, row-major layout), allocated with `sdkl_npu_alloc()`.
+  @param[in]  X         Packed input matrix (FP16, row-major layout), allocated with `sdkl_npu_alloc()`.
+  @param[in]  W         Array of `n_groups` weight matrices (FP16, WH layout). Entries of groups without rows may be
+                        NULL.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` for invalid arguments; no group is executed in that case.
+  - Otherwise the error code of the first failed group; the following groups are not executed.
+ */
+int sdkl_grouped_mm_f16f16_f16(
+  int domain,
+  size_t n_groups,
+  const size_t* offsets,
+  size_t n_col,
+  size_t n_inner,
+  _Float16* A,
+  const _Float16* X,
+  const _Float16* const* W
+);
+
+/*!
+  @ingroup CPUMacroExtGrouped
+  @brief Performs a grouped ui8 x i4 matrix multiplication on the NPU.
+
+  Same as `sdkl_grouped_mm_f16f16_f16()` with the data types of `sdkl_npu_mm_u8i4_i32()`. The weights are prepared
+  by `sdkl_cpu_rm_to_wh_i4()`.
+
+  @param[in]  domain    Which compute DSP (CDSP) core the SDKL library will interact with.
+  @param[in]  n_groups  Number of groups.
+  @param[in]  offsets   Array of `n_groups + 1` non-decreasing row offsets.
+  @param[in]  n_col     Number of columns of every weight matrix and of `A`.
+  @param[in]  n_inner   Shared dimension between `X` and the weights.
+  @param[out] A         Packed output matrix (i32, row-major layout), allocated with `sdkl_npu_alloc()`.
+  @param[in]  X         Packed input matrix (ui8, row-major layout), allocated with `sdkl_npu_alloc()`.
+  @param[in]  W         Array of `n_groups` weight matrices (i4, WH layout). Entries of groups without rows may be
+                        NULL.
+
+  @return
+  - Same values as `sdkl_grouped_mm_f16f16_f16()`.
+ */
+int sdkl_grouped_mm_u8i4_i32(
+  int domain,
+  size_t n_groups,
+  const size_t* offsets,
+  size_t n_col,
+  size_t n_inner,
+  int32_t* A,
+  const uint8_t* X,
+  const uint8_t* const* W
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtEpilogue Fused Epilogues
+  @brief Defines element-wise operations applied to the result of a matrix multiplication before it is stored.
+
+  An epilogue computes, for every element of the result,
+
+      A[i][j] = activation(acc[i][j] + bias[j]) + residual[i][j]
+
+  where each of the three operations is optional. Epilogues are supported for FP32 and FP16 results in
+  `SDKL_LAYOUT_2D_ROW_MAJOR` layout.
+*/
+
+/*!
+  @ingroup CPUMacroExtEpilogue
+  @enum sdkl_activation_e
+  @brief Activation function of an epilogue.
+*/
+typedef enum {
+  /*!
+    @brief No activation.
+  */
+  SDKL_ACT_NONE = 0,
+
+  /*!
+    @brief `max(x, 0)`.
+  */
+  SDKL_ACT_RELU = 1,
+
+  /*!
+    @brief `x * sigmoid(x)`.
+  */
+  SDKL_ACT_SILU = 2,
+
+  /*!
+    @brief GELU, tanh approximation.
+  */
+  SDKL_ACT_GELU = 3,
+
+  /*!
+    @brief Invalid activation. Also used to indicate the number of valid values.
+  */
+  SDKL_ACT_INVALID
+} sdkl_activation_e;
+
+/*!
+  @ingroup CPUMacroExtEpilogue
+  @struct sdkl_epilogue_t
+  @brief Describes the epilogue of a matrix multiplication.
+*/
+typedef struct {
+  /*!
+    @brief Optional FP32 bias of `n_col` entries, added to every row. NULL for none.
+  */
+  const float* bias;
+
+  /*!
+    @brief Activation applied after the bias.
+  */
+  sdkl_activation_e activation;
+
+  /*!
+    @brief Optional residual tensor added last. Must be a 2D row-major FP32 or FP16 tensor with the
+           dimensions of the result and must not overlap it. NULL for none.
+  */
+  const sdkl_tensor_t* residual;
+} sdkl_epilogue_t;
+
+/*!
+  @ingroup CPUMacroExtEpilogue
+  @brief
+  Performs matrix multiplication of SDKL tensors followed by an epilogue.
+
+  On the CPU platform the epilogue is applied to each output tile of the GEMM engine while it is still in cache,
+  before it is converted and stored. On NPU platforms the result is computed by `sdkl_mm_tensor()` and the
+  epilogue runs as a single multithreaded pass over the result.
+
+  @param[in]  platform       Execution platform (CPU, NPU0, NPU1).
+  @param[out] result_tensor  Pointer to the output tensor descriptor (FP32 or FP16).
+  @param[in]  left_tensor    Pointer to the left-hand input tensor descriptor.
+  @param[in]  right_tensor   Pointer to the right-hand input tensor descriptor.
+  @param[in]  epilogue       Epilogue to apply, or NULL for none.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if the epilogue does not match the result.
+  - `AEE_EUNSUPPORTED` for an epilogue on an integer or non row-major result.
+  - Error codes of `sdkl_ext_mm_tensor()` otherwise.
+ */
+int sdkl_ext_mm_tensor_epilogue(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  const sdkl_epilogue_t* epilogue
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtQuant Quantized Matrix Multiplication
+  @brief Defines quantization parameters for ui8 x i8/i4 matrix multiplications with floating-point results.
+
+  `sdkl_tensor_quantization_e` and `sdkl_tensor_t` are part of the prebuilt library ABI and only describe
+  unquantized data (`SDKL_QUANT_NONE`), so the quantization parameters are passed alongside the tensors. A quantized
+  value `q` at row `r` and inner index `k` represents
+
+      real = scale(r, k) * (q - zero_point(r, k))
+
+  where `scale` and `zero_point` depend on the mode: one value for the whole tensor, one per row (per output channel
+  for weights), or one per row and group of `group_size` consecutive inner elements. Without zero points the
+  quantization is symmetric. The product is computed with integer accumulators and dequantized directly into the
+  FP32 or FP16 result.
+*/
+
+/*!
+  @ingroup CPUMacroExtQuant
+  @enum sdkl_quant_mode_e
+  @brief Granularity of quantization parameters.
+*/
+typedef enum {
+  /*!
+    @brief One scale and zero point for the whole tensor.
+  */
+  SDKL_QMODE_PER_TENSOR = 0,
+
+  /*!
+    @brief One scale and zero point per row: per token for activations, per output channel for weights.
+  */
+  SDKL_QMODE_PER_CHANNEL = 1,
+
+  /*!
+    @brief One scale and zero point per row and group of `group_size` inner elements. Weights only.
+  */
+  SDKL_QMODE_PER_GROUP = 2,
+
+  /*!
+    @brief Invalid mode. Also used to indicate the number of valid values.
+  */
+  SDKL_QMODE_INVALID
+} sdkl_quant_mode_e;
+
+/*!
+  @ingroup CPUMacroExtQuant
+  @struct sdkl_quant_params_t
+  @brief Quantization parameters of a ui8 activation or i8/i4 weight tensor.
+
+  Parameters are indexed by row `r` and group `g`: entry 0 for `SDKL_QMODE_PER_TENSOR`, entry `r` for
+  `SDKL_QMODE_PER_CHANNEL` and entry `r * (n_inner / group_size) + g` for `SDKL_QMODE_PER_GROUP`.
+*/
+typedef struct {
+  /*!
+    @brief Granularity of the parameters.
+  */
+  sdkl_quant_mode_e mode;
+
+  /*!
+    @brief Number of inner elements per group for `SDKL_QMODE_PER_GROUP`, typically 32, 64 or 128. Must be a
+           multiple of 32 that divides `n_inner`. Ignored by the other modes.
+  */
+  uint32_t group_size;
+
+  /*!
+    @brief FP32 scales.
+  */
+  const float* scales;
+
+  /*!
+    @brief Optional zero points, indexed like `scales`. NULL for symmetric quantization.
+  */
+  const int32_t* zero_points;
+
+  /*!
+    @brief Optional per-row sums of the quantized values along the inner dimension, for `SDKL_QMODE_PER_TENSOR` and
+           `SDKL_QMODE_PER_CHANNEL`. Only used on NPU platforms, where they are required if the other operand has
+           zero points and this tensor is in an HMX layout. Sums are computed from the data otherwise.
+  */
+  const int32_t* sums;
+} sdkl_quant_params_t;
+
+/*!
+  @ingroup CPUMacroExtQuant
+  @brief
+  Performs a quantized matrix multiplication of SDKL tensors with a floating-point result.
+
+  Computes `A = dequant(X) * dequant(W)^T` followed by an optional epilogue, where `X` is the ui8 left tensor and `W`
+  the i8 or i4 right tensor, described as for `sdkl_mm_tensor()` with `quantization = SDKL_QUANT_NONE`.
+
+  On the CPU platform the integer product of every output tile is dequantized inside the GEMM engine, once per group
+  for `SDKL_QMODE_PER_GROUP`, and the result is stored once. i4 weights are supported on NPU platforms only. On NPU
+  platforms the integer product is computed by `sdkl_mm_tensor()` and dequantized by a single multithreaded pass
+  together with the epilogue; an FP32 result buffer holds the int32 product in between, an FP16 result uses an
+  intermediate buffer. `SDKL_QMODE_PER_GROUP` is supported on the CPU platform only.
+
+  @param[in]  platform       Execution platform (CPU, NPU0, NPU1).
+  @param[out] result_tensor  Output tensor descriptor (FP32 or FP16, row-major layout).
+  @param[in]  left_tensor    Left-hand input tensor descriptor (ui8).
+  @param[in]  left_quant     Quantization of the left tensor: `SDKL_QMODE_PER_TENSOR` or `SDKL_QMODE_PER_CHANNEL`.
+  @param[in]  right_tensor   Right-hand input tensor descriptor (i8, or i4 on NPU platforms).
+  @param[in]  right_quant    Quantization of the right tensor; rows are the `n_col` output channels.
+  @param[in]  epilogue       Epilogue applied after dequantization, or NULL for none.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` for invalid tensors or quantization parameters.
+  - `AEE_EUNSUPPORTED` for unsupported data types, layouts or modes on the selected platform.
+  - `AEE_ENOMEMORY` if an intermediate buffer cannot be allocated.
+  - Error codes of `sdkl_mm_tensor()` otherwise.
+ */
+int sdkl_ext_mm_tensor_quant(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_quant_params_t* left_quant,
+  const sdkl_tensor_t* restrict right_tensor,
+  const sdkl_quant_params_t* right_quant,
+  const sdkl_epilogue_t* epilogue
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtND N-Dimensional Tensors
+  @brief Defines batched tensors with broadcasting for matrix multiplication.
+
+  `SDKL_TENSOR_MAX_NUM_OF_DIMS` and `sdkl_tensor_t` are part of the prebuilt library ABI. An N-dimensional tensor is
+  therefore described as a 2D `sdkl_tensor_t` matrix (the two innermost dimensions, as for `sdkl_mm_tensor()`)
+  repeated over up to `SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS - 2` outer batch dimensions, e.g. `[heads][seq][dim]`.
+
+  Batch dimensions are aligned from the innermost one, as in NumPy. An operand broadcasts along a batch dimension it
+  does not have, along a batch dimension of size 1, or along a dimension with a batch stride of 0.
+*/
+
+/*!
+  @ingroup CPUMacroExtND
+  @def SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS
+  @brief Maximum number of dimensions of an N-dimensional tensor, including the two matrix dimensions.
+*/
+#define SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS (4U)
+
+/*!
+  @ingroup CPUMacroExtND
+  @struct sdkl_tensor_nd_t
+  @brief N-dimensional tensor: a 2D matrix repeated over batch dimensions.
+
+  The matrix of batch index `(b_0, ..., b_{n-1})` is `matrix` with its `data_offset` increased by
+  `b_0 * batch_strides[0] + ... + b_{n-1} * batch_strides[n-1]`. `matrix.num_elements` covers the whole tensor.
+*/
+typedef struct {
+  /*!
+    @brief Matrix of batch index 0. Its `dims`, `strides`, `layout` and `data_dtype` apply to every batch item.
+  */
+  sdkl_tensor_t matrix;
+
+  /*!
+    @brief Number of batch dimensions, at most `SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS - 2`. 0 for a plain matrix.
+  */
+  uint8_t n_batch_dims;
+
+  /*!
+    @brief Sizes of the batch dimensions, outermost first.
+  */
+  uint64_t batch_dims[SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS - 2];
+
+  /*!
+    @brief Batch strides in elements, outermost first. 0 repeats the same matrix along the dimension.
+  */
+  uint64_t batch_strides[SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS - 2];
+} sdkl_tensor_nd_t;
+
+/*!
+  @ingroup CPUMacroExtND
+  @brief Validates an N-dimensional tensor descriptor.
+
+  Checks the batch dimensions and validates the first and the last batch item with `sdkl_tensor_validate()`.
+
+  @param[in] tensor  Tensor descriptor to validate.
+
+  @return
+  - `AEE_SUCCESS` if the tensor is valid.
+  - `AEE_EBADCLASS` if the tensor or its data pointer is NULL.
+  - `AEE_EBADPARM` if any field is invalid or inconsistent.
+ */
+int sdkl_ext_tensor_nd_validate(const sdkl_tensor_nd_t* tensor);
+
+/*!
+  @ingroup CPUMacroExtND
+  @brief Validates that two N-dimensional tensors can be multiplied into the result tensor.
+
+  Validates every tensor with `sdkl_ext_tensor_nd_validate()`, checks that the batch dimensions of the operands
+  broadcast to the batch dimensions of the result, that the result does not broadcast, and validates the matrices
+  with `sdkl_mm_tensor_validate()`.
+
+  @param[in] result_tensor  Output tensor descriptor.
+  @param[in] left_tensor    Left-hand input tensor descriptor.
+  @param[in] right_tensor   Right-hand input tensor descriptor.
+
+  @return
+  - `AEE_SUCCESS` if the tensors are valid and compatible.
+  - `AEE_EBADCLASS` if any tensor pointer is NULL.
+  - `AEE_EBADPARM` if batch dimensions, shapes or metadata are incompatible.
+ */
+int sdkl_ext_mm_tensor_nd_validate(
+  const sdkl_tensor_nd_t* restrict result_tensor,
+  const sdkl_tensor_nd_t* restrict left_tensor,
+  const sdkl_tensor_nd_t* restrict right_tensor
+);
+
+/*!
+  @ingroup CPUMacroExtND
+  @brief
+  Performs a batched matrix multiplication of N-dimensional tensors with broadcasting.
+
+  Computes the matrix product of every batch item, like `sdkl_ext_mm_tensor()`. On the CPU platform the tiles of all
+  batch items are distributed over the worker pool in a single dispatch. On NPU platforms the items run through
+  `sdkl_mm_tensor_batched()`, which validates them up front and maps the shared buffers once for the whole batch.
+
+  @param[in]  platform       Execution platform (CPU, NPU0, NPU1).
+  @param[out] result_tensor  Output tensor descriptor.
+  @param[in]  left_tensor    Left-hand input tensor descriptor.
+  @param[in]  right_tensor   Right-hand input tensor descriptor.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_ENOMEMORY` if the batch items cannot be allocated.
+  - Error codes of `sdkl_ext_mm_tensor_nd_validate()` and `sdkl_ext_mm_tensor()` otherwise.
+ */
+int sdkl_ext_mm_tensor_nd(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_nd_t* restrict result_tensor,
+  const sdkl_tensor_nd_t* restrict left_tensor,
+  const sdkl_tensor_nd_t* restrict right_tensor
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtBuffers Registered Buffers
+  @brief Defines the registration of caller-owned memory for zero-copy NPU input and output.
+
+  The `sdkl_npu_mm_*()` functions and `sdkl_mm_tensor()` only pass buffers to the NPU without a copy when FastRPC
+  knows their file descriptor, i.e. for `sdkl_npu_alloc()` buffers. A registered buffer, such as a framework
+  activation arena allocated from a DMA-BUF heap, is made known to FastRPC and mapped on the DSP once. Any tensor
+  inside it can then be passed to the NPU functions in place, without copies into and out of `sdkl_npu_alloc()`
+  buffers, and without a mapping per call.
+*/
+
+/*!
+  @ingroup CPUMacroExtBuffers
+  @brief Registers a caller-owned buffer with FastRPC and maps it on the DSP of `domain`.
+
+  Registering the same buffer again on the same domain only increments its registration count.
+
+  @param[in] domain  Which compute DSP (CDSP) core to map the buffer on. Must be initialized with
+                     `sdkl_npu_initialize()`.
+  @param[in] buffer  Start of the buffer in the address space of the process.
+  @param[in] size    Size of the buffer in bytes.
+  @param[in] fd      DMA-BUF (or ION) file descriptor backing `buffer`, or -1 for an `sdkl_npu_alloc()` buffer.
+                     The descriptor must stay open until the buffer is unregistered.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL, the size is zero or too large, or the buffer overlaps another registered
+    buffer of the domain.
+  - `AEE_EUNSUPPORTED` if `fd` is -1 and `buffer` is not an `sdkl_npu_alloc()` buffer. FastRPC can only share
+    file-descriptor backed memory with the DSP.
+  - `AEE_ENOMEMORY` or error codes of `fastrpc_mmap()` on failure.
+ */
+int sdkl_npu_register_buffer(int domain, void* buffer, size_t size, int fd);
+
+/*!
+  @ingroup CPUMacroExtBuffers
+  @brief Releases a registration of `sdkl_npu_register_buffer()`.
+
+  The buffer is unmapped from the DSP and forgotten by FastRPC when its last registration is released. Must be
+  called before `sdkl_npu_finalize()` of the domain and before the memory is freed.
+
+  @param[in] domain  Domain the buffer was registered on.
+  @param[in] buffer  Start of the buffer, as passed to `sdkl_npu_register_buffer()`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_ENOSUCH` if the buffer is not registered on the domain.
+  - Error codes of `fastrpc_munmap()` on failure.
+ */
+int sdkl_npu_unregister_buffer(int domain, void* buffer);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtPool Pooled NPU Buffers
+  @brief Defines a recycling allocator for temporary shared CPU-NPU buffers.
+
+  Every `sdkl_npu_alloc()` creates and maps a new shared buffer, which is costly for per-request temporaries. The
+  pool rounds requests up to power-of-two size classes from `SDKL_NPU_POOL_MIN_SIZE` to `SDKL_NPU_POOL_MAX_SIZE`
+  and keeps freed buffers for reuse: up to `SDKL_NPU_POOL_THREAD_CACHE` buffers per class in a lock-free cache of
+  the freeing thread, and any number in a shared free list. Larger requests are passed to `sdkl_npu_alloc()`
+  directly.
+
+  Pooled buffers are `sdkl_npu_alloc()` buffers and can be used wherever those are required. They are released
+  with `sdkl_npu_pool_trim()`, or to the shared free list when their thread exits.
+*/
+
+/*!
+  @ingroup CPUMacroExtPool
+  @def SDKL_NPU_POOL_MIN_SIZE
+  @brief Smallest size class in bytes.
+*/
+#define SDKL_NPU_POOL_MIN_SIZE (4096U)
+
+/*!
+  @ingroup CPUMacroExtPool
+  @def SDKL_NPU_POOL_MAX_SIZE
+  @brief Largest size class in bytes. Larger buffers are not pooled.
+*/
+#define SDKL_NPU_POOL_MAX_SIZE (64U * 1024U * 1024U)
+
+/*!
+  @ingroup CPUMacroExtPool
+  @def SDKL_NPU_POOL_THREAD_CACHE
+  @brief Number of free buffers per size class kept in the cache of each thread.
+*/
+#define SDKL_NPU_POOL_THREAD_CACHE (4U)
+
+/*!
+  @ingroup CPUMacroExtPool
+  @struct sdkl_npu_pool_stats_t
+  @brief Counters of the pool since the start of the process.
+*/
+typedef struct {
+  /*!
+    @brief Allocations served from a recycled buffer.
+  */
+  uint64_t hits;
+
+  /*!
+    @brief Allocations that called `sdkl_npu_alloc()`, including those larger than `SDKL_NPU_POOL_MAX_SIZE`.
+  */
+  uint64_t misses;
+
+  /*!
+    @brief Bytes of free buffers held by the pool, in thread caches and the shared free list.
+  */
+  uint64_t bytes_held;
+
+  /*!
+    @brief Bytes of buffers currently allocated from the pool, rounded up to their size class.
+  */
+  uint64_t bytes_in_use;
+} sdkl_npu_pool_stats_t;
+
+/*!
+  @ingroup CPUMacroExtPool
+  @brief Allocates a shared CPU-NPU buffer from the pool.
+
+  @param[in]  size        Size of the buffer in bytes.
+  @param[out] buffer_ptr  Receives the buffer address.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `buffer_ptr` is NULL or `size` is zero.
+  - Error codes of `sdkl_npu_alloc()` on failure.
+ */
+int sdkl_npu_pool_alloc(size_t size, void** buffer_ptr);
+
+/*!
+  @ingroup CPUMacroExtPool
+  @brief Returns a buffer to the pool.
+
+  @param[in] buffer  Buffer returned by `sdkl_npu_pool_alloc()`. May be NULL.
+  @param[in] size    Size passed to `sdkl_npu_pool_alloc()` for the buffer.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `buffer` is not NULL and `size` is zero.
+  - Error codes of `sdkl_npu_free()` for buffers that are not pooled.
+ */
+int sdkl_npu_pool_free(void* buffer, size_t size);
+
+/*!
+  @ingroup CPUMacroExtPool
+  @brief Frees pooled buffers until the pool holds at most `max_bytes_held` bytes.
+
+  Moves the cache of the calling thread to the shared free list first, then frees the largest buffers first.
+  Buffers in the caches of other threads are not released.
+
+  @param[in] max_bytes_held  Number of free bytes the pool may keep. 0 releases every releasable buffer.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - Error codes of `sdkl_npu_free()` on failure.
+ */
+int sdkl_npu_pool_trim(size_t max_bytes_held);
+
+/*!
+  @ingroup CPUMacroExtPool
+  @brief Returns the counters of the pool.
+
+  @param[out] stats  Receives the counters.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `stats` is NULL.
+ */
+int sdkl_npu_pool_get_stats(sdkl_npu_pool_stats_t* stats);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtShard Multi-NPU Sharding
+  @brief Defines matrix multiplications split across the NPU0 and NPU1 compute DSPs.
+
+  On parts with two CDSPs, one matrix multiplication is split into two shards that run concurrently, the first on
+  `SDKL_PLATFORM_NPU0` from the calling thread and the second on `SDKL_PLATFORM_NPU1` through its submission queue
+  (see `sdkl_mm_tensor_async()`). Both shards write their part of the same result tensor. Shard boundaries are
+  multiples of `SDKL_SHARD_ALIGN`.
+
+  - Row shards split the activations and the result; the weights are shared. The activations and the result must
+    use the `SDKL_LAYOUT_2D_ROW_MAJOR` or `SDKL_LAYOUT_2D_COL_MAJOR` layout.
+  - Column shards split the weights and the result; the activations are shared. The weights must be contiguous in
+    the `SDKL_LAYOUT_2D_ROW_MAJOR` layout (`W[N_COL][N_INNER]`) and the result row-major. The HMX weight layouts
+    cannot be split.
+*/
+
+/*!
+  @ingroup CPUMacroExtShard
+  @def SDKL_SHARD_ALIGN
+  @brief Granularity of shard boundaries, in rows or columns.
+*/
+#define SDKL_SHARD_ALIGN (32U)
+
+/*!
+  @ingroup CPUMacroExtShard
+  @def SDKL_SHARD_MIN_ROWS
+  @brief Number of rows from which `SDKL_SHARD_AUTO` prefers row shards over column shards.
+*/
+#define SDKL_SHARD_MIN_ROWS (64U)
+
+/*!
+  @ingroup CPUMacroExtShard
+  @enum sdkl_shard_mode_e
+  @brief How a matrix multiplication is split across the NPUs.
+*/
+typedef enum {
+  /*!
+    @brief Row shards from `SDKL_SHARD_MIN_ROWS` rows, otherwise column shards, otherwise row shards, whichever the
+           tensors allow. Runs unsplit on NPU0 if none does.
+  */
+  SDKL_SHARD_AUTO = 0,
+
+  /*!
+    @brief No split: runs on NPU0.
+  */
+  SDKL_SHARD_NONE = 1,
+
+  /*!
+    @brief Split the rows of the activations and the result.
+  */
+  SDKL_SHARD_ROWS = 2,
+
+  /*!
+    @brief Split the columns of the weights and the result.
+  */
+  SDKL_SHARD_COLS = 3,
+
+  /*!
+    @brief Invalid mode. Also used to indicate the number of valid values.
+  */
+  SDKL_SHARD_INVALID
+} sdkl_shard_mode_e;
+
+/*!
+  @ingroup CPUMacroExtShard
+  @struct sdkl_shard_info_t
+  @brief Describes how a sharded matrix multiplication was split.
+*/
+typedef struct {
+  /*!
+    @brief Mode used: `SDKL_SHARD_NONE`, `SDKL_SHARD_ROWS` or `SDKL_SHARD_COLS`.
+  */
+  sdkl_shard_mode_e mode;
+
+  /*!
+    @brief First row or column of the NPU1 shard. NPU0 computes the rows or columns before it. 0 if not split.
+  */
+  uint64_t split;
+} sdkl_shard_info_t;
+
+/*!
+  @ingroup CPUMacroExtShard
+  @brief
+  Performs matrix multiplication of SDKL tensors split across NPU0 and NPU1.
+
+  Takes the same tensors as `sdkl_mm_tensor()`. Both domains must be initialized with `sdkl_npu_initialize()`, and
+  `sdkl_queue_finalize(SDKL_PLATFORM_NPU1)` must be called before `sdkl_npu_finalize()` of NPU1. A dimension of at
+  most `SDKL_SHARD_ALIGN` is not split.
+
+  @param[out] result_tensor  Output tensor descriptor.
+  @param[in]  left_tensor    Left-hand input tensor descriptor.
+  @param[in]  right_tensor   Right-hand input tensor descriptor.
+  @param[in]  mode           Requested split.
+  @param[out] info           Receives the split that was used. May be NULL.
+
+  @return
+  - `AEE_SUCCESS` if both shards succeeded.
+  - `AEE_EBADPARM` for an invalid mode.
+  - `AEE_EUNSUPPORTED` if the requested split is not possible for the tensor layouts.
+  - Error codes of `sdkl_mm_tensor_validate()` and `sdkl_mm_tensor()` otherwise.
+ */
+int sdkl_ext_mm_tensor_sharded(
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  sdkl_shard_mode_e mode,
+  sdkl_shard_info_t* info
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtHetero Heterogeneous CPU and NPU Execution
+  @brief Defines matrix multiplications split between the CPU engine and an NPU.
+
+  The output columns are split in two: the NPU computes the first columns through its submission queue (see
+  `sdkl_mm_tensor_async()`) while the CPU engine computes the remaining ones on the calling thread and its worker
+  pool. Both write their part of the same result tensor.
+
+  A hetero handle keeps the fraction of columns given to the CPU. In adaptive mode each call measures the
+  throughput of both shards and moves the fraction towards the point where they finish together. The throughput
+  depends on the shape, so one handle should be used per shape (e.g. per layer).
+
+  The weights must be contiguous in the `SDKL_LAYOUT_2D_ROW_MAJOR` layout (`W[N_COL][N_INNER]`) and the result
+  row-major, since the HMX weight layouts cannot be split nor read by the CPU engine.
+*/
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @def SDKL_HETERO_ALIGN
+  @brief Granularity of the split, in columns.
+*/
+#define SDKL_HETERO_ALIGN (32U)
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @struct sdkl_hetero_t
+  @brief Opaque handle holding the split of a heterogeneous matrix multiplication.
+*/
+typedef struct sdkl_hetero sdkl_hetero_t;
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @struct sdkl_hetero_config_t
+  @brief Configuration of a hetero handle.
+*/
+typedef struct {
+  /*!
+    @brief NPU running its share of the columns: `SDKL_PLATFORM_NPU0` or `SDKL_PLATFORM_NPU1`.
+  */
+  sdkl_tensor_platform_e npu_platform;
+
+  /*!
+    @brief Fraction of the output columns computed by the CPU, in [0, 1]. Initial value in adaptive mode.
+  */
+  float cpu_fraction;
+
+  /*!
+    @brief Updates `cpu_fraction` after each call from the measured throughputs when non-zero.
+  */
+  uint32_t adaptive;
+} sdkl_hetero_config_t;
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @struct sdkl_hetero_info_t
+  @brief Describes the state of a hetero handle.
+*/
+typedef struct {
+  /*!
+    @brief Current fraction of the output columns computed by the CPU.
+  */
+  float cpu_fraction;
+
+  /*!
+    @brief First column computed by the CPU in the last call. The NPU computed the columns before it.
+  */
+  uint64_t split;
+
+  /*!
+    @brief Smoothed CPU throughput in output elements per microsecond, 0 until measured.
+  */
+  float cpu_rate;
+
+  /*!
+    @brief Smoothed NPU throughput in output elements per microsecond, 0 until measured.
+  */
+  float npu_rate;
+
+  /*!
+    @brief Wall time of the last call in microseconds.
+  */
+  uint64_t last_us;
+} sdkl_hetero_info_t;
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @brief Creates a hetero handle.
+
+  @param[in]  config  Handle configuration.
+  @param[out] hetero  Receives the created handle.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL, the platform is not an NPU or the fraction is outside [0, 1].
+  - `AEE_ENOMEMORY` if the handle could not be allocated.
+ */
+int sdkl_hetero_create(const sdkl_hetero_config_t* config, sdkl_hetero_t** hetero);
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @brief Frees a hetero handle.
+
+  @param[in] hetero  Handle to destroy. May be NULL.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int sdkl_hetero_destroy(sdkl_hetero_t* hetero);
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @brief Returns the current split and throughput estimates of a hetero handle.
+
+  @param[in]  hetero  Handle to query.
+  @param[out] info    Receives the state of the handle.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if a pointer is NULL.
+ */
+int sdkl_hetero_get_info(const sdkl_hetero_t* hetero, sdkl_hetero_info_t* info);
+
+/*!
+  @ingroup CPUMacroExtHetero
+  @brief
+  Performs matrix multiplication of SDKL tensors split between the CPU engine and an NPU.
+
+  Takes the same tensors as `sdkl_mm_tensor()`, with the data type combinations supported by both
+  `sdkl_cpu_mm_tensor()` and the NPU (e.g. FP32 x FP16 -> FP32 or FP16 x FP16 -> FP16). The NPU must be initialized
+  with `sdkl_npu_initialize()`, and `sdkl_queue_finalize()` of the NPU must be called before `sdkl_npu_finalize()`.
+  The split is rounded to a multiple of `SDKL_HETERO_ALIGN`, so a fraction near 0 or 1 runs on a single backend.
+
+  A handle must not be used by several threads at once.
+
+  @param[in]  hetero         Handle holding the split.
+  @param[out] result_tensor  Output tensor descriptor.
+  @param[in]  left_tensor    Left-hand input tensor descriptor.
+  @param[in]  right_tensor   Right-hand input tensor descriptor.
+
+  @return
+  - `AEE_SUCCESS` if both shards succeeded.
+  - `AEE_EBADPARM` if `hetero` is NULL.
+  - `AEE_EUNSUPPORTED` if the weights or the result cannot be split by columns.
+  - Error codes of `sdkl_mm_tensor_validate()`, `sdkl_cpu_mm_tensor()` and `sdkl_mm_tensor()` otherwise.
+ */
+int sdkl_ext_mm_tensor_hetero(
+  sdkl_hetero_t* hetero,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtAutotune Autotuning
+  @brief Defines a matrix multiplication that picks the fastest execution strategy per shape.
+
+  The first time a shape is seen, every applicable strategy is benchmarked on the call's own tensors and the fastest
+  one is recorded. Later calls with the same shape run the recorded strategy directly. A shape is identified by
+  `N_ROW`, `N_COL`, `N_INNER`, the data types, the weight layout, the NPU platform and the set of applicable
+  strategies.
+
+  Decisions can be persisted in a cache file: `sdkl_autotune_initialize()` loads the decisions of earlier runs, and
+  each new decision is appended to the file, so later process starts skip tuning. The file is plain text with one
+  decision per line and should be deleted when the device, the library or the extension sources change.
+*/
+
+/*!
+  @ingroup CPUMacroExtAutotune
+  @def SDKL_AUTOTUNE_REPS
+  @brief Number of timed runs per strategy when tuning, after one warm-up run. The fastest run counts.
+*/
+#define SDKL_AUTOTUNE_REPS (3U)
+
+/*!
+  @ingroup CPUMacroExtAutotune
+  @enum sdkl_autotune_strategy_e
+  @brief Execution strategies considered by the autotuner.
+*/
+typedef enum {
+  /*!
+    @brief CPU engine (`sdkl_cpu_mm_tensor()`). Applicable to the weight layouts and data types it supports.
+  */
+  SDKL_AUTOTUNE_CPU = 0,
+
+  /*!
+    @brief `sdkl_mm_tensor()` on the NPU with the given weights, laid out for HMX by the library on each call when
+           they are row-major.
+  */
+  SDKL_AUTOTUNE_NPU = 1,
+
+  /*!
+    @brief `sdkl_mm_tensor()` on the NPU with the pre-laid weights of an `sdkl_weights_t` handle. Applicable when a
+           handle is passed.
+  */
+  SDKL_AUTOTUNE_NPU_PRELAID = 2,
+
+  /*!
+    @brief Invalid strategy. Also used to indicate the number of valid values.
+  */
+  SDKL_AUTOTUNE_INVALID
+} sdkl_autotune_strategy_e;
+
+/*!
+  @ingroup CPUMacroExtAutotune
+  @struct sdkl_autotune_info_t
+  @brief Describes how an autotuned matrix multiplication was executed.
+*/
+typedef struct {
+  /*!
+    @brief Strategy recorded for the shape.
+  */
+  sdkl_autotune_strategy_e strategy;
+
+  /*!
+    @brief Non-zero if this call benchmarked the strategies.
+  */
+  uint32_t tuned;
+
+  /*!
+    @brief Fastest run of each strategy in microseconds when `tuned` is set, 0 for strategies that do not apply.
+  */
+  uint64_t us[SDKL_AUTOTUNE_INVALID];
+} sdkl_autotune_info_t;
+
+/*!
+  @ingroup CPUMacroExtAutotune
+  @brief Initializes the autotuner and loads the decisions of a cache file.
+
+  Meant to be called next to `sdkl_npu_initialize()`. Calling it is optional: without it, decisions are kept in
+  memory only. A missing file is created on the first decision; unreadable lines are ignored.
+
+  @param[in] cache_path  Path of the cache file. May be NULL to keep decisions in memory only.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADSTATE` if the autotuner is already initialized.
+  - `AEE_ENOMEMORY` if the decisions could not be stored.
+ */
+int sdkl_autotune_initialize(const char* cache_path);
+
+/*!
+  @ingroup CPUMacroExtAutotune
+  @brief Forgets the in-memory decisions. The cache file is kept.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int sdkl_autotune_finalize(void);
+
+/*!
+  @ingroup CPUMacroExtAutotune
+  @brief
+  Performs matrix multiplication of SDKL tensors with the fastest strategy for their shape.
+
+  Takes the same tensors as `sdkl_mm_tensor()`. When the shape is tuned, the result tensor is written by each
+  strategy in turn and holds the result of the last one; all of them compute the same product.
+
+  @param[in]  platform       NPU used by the NPU strategies: `SDKL_PLATFORM_NPU0` or `SDKL_PLATFORM_NPU1`.
+  @param[out] result_tensor  Output tensor descriptor.
+  @param[in]  left_tensor    Left-hand input tensor descriptor.
+  @param[in]  right_tensor   Right-hand input tensor descriptor.
+  @param[in]  prelaid        Handle holding the same weights as `right_tensor`, created on the domain of `platform`.
+                             May be NULL, in which case `SDKL_AUTOTUNE_NPU_PRELAID` does not apply.
+  @param[out] info           Receives the strategy used. May be NULL.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if the platform is not an NPU or the handle is for another domain.
+  - Error codes of `sdkl_mm_tensor_validate()` and of the executed strategy otherwise.
+ */
+int sdkl_ext_mm_tensor_autotune(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  const sdkl_weights_t* prelaid,
+  sdkl_autotune_info_t* info
+);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtPlan Matrix Multiplication Plans
+  @brief Defines matrix multiplications prepared once for a fixed shape and executed many times.
+
+  A plan is created from tensor descriptors and a platform. Validation and dispatch happen at creation:
+  - On `SDKL_PLATFORM_CPU`, the micro-kernel, the tiling and the per-thread packing scratch of the CPU engine are
+    selected and allocated.
+  - On an NPU, with `SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX` weights and contiguous row-major activations and result
+    without data offset, the plan calls the matching `sdkl_npu_mm_*()` kernel directly, skipping tensor
+    validation and dispatch in the library. Other NPU plans execute `sdkl_mm_tensor()` with the stored descriptors.
+
+  Executing a plan only binds the data pointers of the three tensors and runs the operation. The data offsets,
+  strides and dimensions of the descriptors given at creation apply to the bound buffers.
+*/
+
+/*!
+  @ingroup CPUMacroExtPlan
+  @struct sdkl_mm_plan_t
+  @brief Opaque handle of a prepared matrix multiplication.
+*/
+typedef struct sdkl_mm_plan sdkl_mm_plan_t;
+
+/*!
+  @ingroup CPUMacroExtPlan
+  @brief Creates a plan for matrix multiplications of the shape described by three tensor descriptors.
+
+  The data pointers of the descriptors are only used for validation.
+
+  @param[in]  platform       Execution platform (CPU, NPU0, NPU1). NPUs must be initialized.
+  @param[in]  result_tensor  Output tensor descriptor.
+  @param[in]  left_tensor    Left-hand input tensor descriptor.
+  @param[in]  right_tensor   Right-hand input tensor descriptor.
+  @param[out] plan           Receives the created plan.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `plan` is NULL or the platform is invalid.
+  - `AEE_ENOMEMORY` if the plan or the CPU scratch could not be allocated.
+  - Error codes of `sdkl_cpu_mm_tensor()` validation (CPU) or `sdkl_mm_tensor_validate()` (NPU) otherwise.
+ */
+int sdkl_mm_plan_create(
+  sdkl_tensor_platform_e platform,
+  const sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor,
+  sdkl_mm_plan_t** plan
+);
+
+/*!
+  @ingroup CPUMacroExtPlan
+  @brief Executes a plan on new data buffers.
+
+  The buffers must be at least as large as those of the descriptors given to `sdkl_mm_plan_create()`, and
+  allocated the same way (e.g. with `sdkl_npu_alloc()` for NPU plans). Execution does not modify the plan.
+
+  @param[in]  plan    Plan to execute.
+  @param[out] result  Data pointer of the result tensor.
+  @param[in]  left    Data pointer of the left-hand tensor.
+  @param[in]  right   Data pointer of the right-hand tensor.
+
+  @return
+  - `AEE_SUCCESS` on successful execution.
+  - `AEE_EBADPARM` if a pointer is NULL.
+  - Error codes of the executed operation otherwise.
+ */
+int sdkl_mm_plan_execute(const sdkl_mm_plan_t* plan, void* result, const void* left, const void* right);
+
+/*!
+  @ingroup CPUMacroExtPlan
+  @brief Frees a plan.
+
+  @param[in] plan  Plan to destroy. May be NULL.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int sdkl_mm_plan_destroy(sdkl_mm_plan_t* plan);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtTrace Tracing
+  @brief Defines an opt-in recorder of timestamped spans, exported in the Chrome trace JSON format.
+
+  When tracing is started, the extension functions record one span per phase of their work: CPU engine packing,
+  micro-kernels and stores per tile, NPU invocations (FastRPC marshaling and DSP execution, which happen inside the
+  library), FastRPC buffer mappings, weight layout conversions and queue jobs. Applications add their own spans with
+  `sdkl_trace_begin()` and `sdkl_trace_end()`.
+
+  Spans are written to a ring buffer without locking. When it is full, the oldest spans are overwritten. The dump
+  opens in `chrome://tracing` and in the Perfetto UI (https://ui.perfetto.dev), with one track per thread.
+
+  When tracing is stopped, each instrumentation point costs one relaxed atomic load.
+
+  The spans of the DSP phases (DDR to VTCM copies, layout conversions, HMX compute, accumulator read-out) are
+  recorded on the NPU by the HexKL NPU Macro API extensions, see `hexkl_macro_ext_trace_start()`.
+*/
+
+/*!
+  @ingroup CPUMacroExtTrace
+  @brief Starts recording spans into a ring buffer of at least `n_events` spans.
+
+  The spans recorded before are discarded. Must not be called while traced functions run on other threads.
+
+  @param[in] n_events  Capacity of the ring buffer in spans, rounded up to a power of two.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `n_events` is 0 or larger than 2^24.
+  - `AEE_ENOMEMORY` if the ring buffer could not be allocated.
+ */
+int sdkl_trace_start(uint32_t n_events);
+
+/*!
+  @ingroup CPUMacroExtTrace
+  @brief Stops recording spans. The recorded spans are kept until the next `sdkl_trace_start()`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int sdkl_trace_stop(void);
+
+/*!
+  @ingroup CPUMacroExtTrace
+  @brief Writes the recorded spans to a file in the Chrome trace JSON format.
+
+  Can be called while tracing, e.g. periodically; spans being written at that moment are skipped.
+
+  @param[in] path  Path of the file to write.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `path` is NULL.
+  - `AEE_EFAILED` if the file could not be written.
+ */
+int sdkl_trace_dump(const char* path);
+
+/*!
+  @ingroup CPUMacroExtTrace
+  @brief Stops recording and frees the ring buffer. Must not be called while traced functions run on other threads.
+
+  @return
+  - `AEE_SUCCESS` on success.
+ */
+int sdkl_trace_finalize(void);
+
+/*!
+  @ingroup CPUMacroExtTrace
+  @brief Opens a span on the calling thread.
+
+  @return
+  Start timestamp of the span to pass to `sdkl_trace_end()`, or 0 if tracing is stopped.
+ */
+uint64_t sdkl_trace_begin(void);
+
+/*!
+  @ingroup CPUMacroExtTrace
+  @brief Closes a span opened by `sdkl_trace_begin()` on the same thread and records it.
+
+  Only the pointers to `name` and `category` are recorded, so they must stay valid until the dump, e.g. string
+  literals. Does nothing if `begin` is 0.
+
+  @param[in] name      Name of the span.
+  @param[in] category  Category of the span, used to filter spans in the viewers.
+  @param[in] begin     Value returned by `sdkl_trace_begin()`.
+ */
+void sdkl_trace_end(const char* name, const char* category, uint64_t begin);
+
+/*!
+  @ingroup HexKLCPUMacroExt
+  @defgroup CPUMacroExtStats Performance Counters
+  @brief Defines cumulative counters of the matrix multiplications run through the extensions, per platform.
+
+  The counters are always on. Each matrix multiplication call updates them with a few relaxed atomic additions,
+  and the times come from the timestamps taken around the call, so they can be left on in production.
+
+  NPU times are measured on the host around the library calls and include FastRPC marshaling and DSP execution.
+  The DSP-side breakdown (bytes moved between DDR and VTCM, HMX time) is counted on the NPU by the HexKL NPU Macro
+  API extensions, see `hexkl_macro_ext_get_stats()`.
+*/
+
+/*!
+  @ingroup CPUMacroExtStats
+  @struct sdkl_stats_t
+  @brief Cumulative counters of one platform since start or the last `sdkl_reset_stats()`.
+*/
+typedef struct {
+  /*!
+    @brief Number of matrix multiplications. Each item of a batch or group counts as one.
+  */
+  uint64_t n_matmuls;
+
+  /*!
+    @brief Number of multiply-accumulate operations, `N_ROW * N_COL * N_INNER` per matrix multiplication. The
+           number of FLOPs is twice this value.
+  */
+  uint64_t n_macs;
+
+  /*!
+    @brief Bytes of the operands and results of the matrix multiplications, each counted once per call.
+  */
+  uint64_t bytes;
+
+  /*!
+    @brief Wall time of the matrix multiplication calls in microseconds: CPU engine runs, or NPU invocations
+           including FastRPC marshaling and DSP execution.
+  */
+  uint64_t busy_us;
+
+  /*!
+    @brief Time callers were blocked in microseconds: on the CPU worker pool while it ran another call, or on a
+           full NPU submission queue.
+  */
+  uint64_t wait_us;
+
+  /*!
+    @brief Number of FastRPC buffer mappings and unmappings made by the extensions (NPU only).
+  */
+  uint64_t n_maps;
+
+  /*!
+    @brief Time spent in FastRPC buffer mappings and unmappings in microseconds (NPU only).
+  */
+  uint64_t map_us;
+} sdkl_stats_t;
+
+/*!
+  @ingroup CPUMacroExtStats
+  @brief Reads the counters of a platform.
+
+  @param[in]  platform  Platform to read: `SDKL_PLATFORM_CPU`, `SDKL_PLATFORM_NPU0` or `SDKL_PLATFORM_NPU1`.
+  @param[out] stats     Receives the counters.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if `stats` is NULL or the platform is invalid.
+ */
+int sdkl_get_stats(sdkl_tensor_platform_e platform, sdkl_stats_t* stats);
+
+/*!
+  @ingroup CPUMacroExtStats
+  @brief Resets the counters of a platform to 0.
+
+  @param[in] platform  Platform to reset: `SDKL_PLATFORM_CPU`, `SDKL_PLATFORM_NPU0` or `SDKL_PLATFORM_NPU1`.
+
+  @return
+  - `AEE_SUCCESS` on success.
+  - `AEE_EBADPARM` if the platform is invalid.
+ */
+int sdkl_reset_stats(sdkl_tensor_platform_e platform);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif //__SDKL_EXT_H__
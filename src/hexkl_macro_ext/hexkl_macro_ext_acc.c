@@ -0,0 +1,103 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  Accumulator slots. The micro API only clears and reads the accumulator, so an int32 slot keeps partial sums that
+  saves add the accumulator to, and an FP16 slot keeps its values in AH layout, reloaded by multiplying them by the
+  identity weight tile stored after them.
+*/
+
+#define HEXKL_EXT_ACC_INT32_N (HEXKL_MACRO_EXT_ACC_SLOT_INT32_BYTES / sizeof(int32_t))
+
+static int slot_aligned(const uint8_t* vtcm_base, uint32_t offset) {
+  return vtcm_base != NULL && (uintptr_t)(vtcm_base + offset) % HEXKL_HMX_ACTIVATION_ALIGNMENT == 0;
+}
+
+int hexkl_macro_ext_hmx_acc_slot_init_int32(uint8_t* vtcm_base, uint32_t slot_offset) {
+  if (!slot_aligned(vtcm_base, slot_offset)) {
+    return AEE_EBADPARM;
+  }
+
+  memset(vtcm_base + slot_offset, 0, HEXKL_MACRO_EXT_ACC_SLOT_INT32_BYTES);
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_hmx_acc_restore_int32(uint8_t* vtcm_base, uint32_t slot_offset) {
+  if (!slot_aligned(vtcm_base, slot_offset)) {
+    return AEE_EBADPARM;
+  }
+
+  // The slot keeps the partial sums; the accumulator restarts from zero and is added to them when saved
+  hexkl_micro_hmx_acc_clear_int32();
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_hmx_acc_save_int32(
+  uint8_t* vtcm_base,
+  uint32_t config_offset,
+  uint32_t slot_offset,
+  uint32_t scratch_offset
+) {
+  uint32_t* slot;
+  const uint32_t* acc;
+
+  if (!slot_aligned(vtcm_base, slot_offset) || !slot_aligned(vtcm_base, scratch_offset)) {
+    return AEE_EBADPARM;
+  }
+
+  HEXKL_EXT_CHECK(hexkl_micro_hmx_acc_read_int32(vtcm_base, config_offset, scratch_offset));
+  hexkl_micro_hmx_acc_clear_int32();
+
+  // Unsigned, to wrap around as the accumulator does rather than overflow
+  slot = (uint32_t*)(vtcm_base + slot_offset);
+  acc  = (const uint32_t*)(vtcm_base + scratch_offset);
+  for (uint32_t i = 0; i < HEXKL_EXT_ACC_INT32_N; i++) {
+    slot[i] += acc[i];
+  }
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_hmx_acc_slot_init_f16(uint8_t* vtcm_base, uint32_t slot_offset) {
+  _Float16 identity[HEXKL_HMX_F16_BLOCK_N_INNER * HEXKL_HMX_F16_BLOCK_N_COL];
+
+  if (!slot_aligned(vtcm_base, slot_offset)) {
+    return AEE_EBADPARM;
+  }
+
+  memset(identity, 0, sizeof(identity));
+  for (uint32_t i = 0; i < HEXKL_HMX_F16_BLOCK_N_COL; i++) {
+    identity[i * HEXKL_HMX_F16_BLOCK_N_COL + i] = (_Float16)1.f;
+  }
+  memset(vtcm_base + slot_offset, 0, HEXKL_EXT_F16_TILE_BYTES);
+
+  return hexkl_micro_hmx_rm_to_wh_f16(
+    vtcm_base, slot_offset + HEXKL_EXT_F16_TILE_BYTES, identity, 0, 0, HEXKL_HMX_F16_BLOCK_N_COL
+  );
+}
+
+int hexkl_macro_ext_hmx_acc_restore_f16(uint8_t* vtcm_base, uint32_t slot_offset) {
+  if (!slot_aligned(vtcm_base, slot_offset)) {
+    return AEE_EBADPARM;
+  }
+
+  // Values times identity: every product is exact and every other term is zero
+  hexkl_micro_hmx_acc_clear_f16();
+  return hexkl_micro_hmx_mm_f16(vtcm_base, slot_offset, slot_offset + HEXKL_EXT_F16_TILE_BYTES);
+}
+
+int hexkl_macro_ext_hmx_acc_save_f16(uint8_t* vtcm_base, uint32_t config_offset, uint32_t slot_offset) {
+  if (!slot_aligned(vtcm_base, slot_offset)) {
+    return AEE_EBADPARM;
+  }
+
+  return hexkl_micro_hmx_acc_read_f16(vtcm_base, config_offset, slot_offset);
+}
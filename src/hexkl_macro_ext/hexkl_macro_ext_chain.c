@@ -0,0 +1,69 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  Accumulation chains: the tile pairs of a chain are all checked first, then handed to the micro API multiplication
+  one after the other without any other work in between.
+*/
+
+typedef int (*hexkl_ext_hmx_mm_t)(uint8_t* vtcm_base, uint32_t activation_offset, uint32_t weight_offset);
+
+static int mm_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n,
+  hexkl_ext_hmx_mm_t mm
+) {
+  uint32_t misaligned = 0;
+
+  if (vtcm_base == NULL || act_offsets == NULL || wt_offsets == NULL || n == 0) {
+    return AEE_EBADPARM;
+  }
+  // One branch for the whole chain rather than two per tile pair
+  for (uint32_t i = 0; i < n; i++) {
+    misaligned |= (uint32_t)((uintptr_t)(vtcm_base + act_offsets[i]) % HEXKL_HMX_ACTIVATION_ALIGNMENT);
+    misaligned |= (uint32_t)((uintptr_t)(vtcm_base + wt_offsets[i]) % HEXKL_HMX_WEIGHTS_ALIGNMENT);
+  }
+  if (misaligned != 0) {
+    return AEE_EBADPARM;
+  }
+
+  for (uint32_t i = 0; i < n; i++) {
+    HEXKL_EXT_CHECK(mm(vtcm_base, act_offsets[i], wt_offsets[i]));
+  }
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_hmx_mm_u8i8_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n
+) {
+  return mm_chain(vtcm_base, act_offsets, wt_offsets, n, hexkl_micro_hmx_mm_u8i8);
+}
+
+int hexkl_macro_ext_hmx_mm_u8i4_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n
+) {
+  return mm_chain(vtcm_base, act_offsets, wt_offsets, n, hexkl_micro_hmx_mm_u8i4);
+}
+
+int hexkl_macro_ext_hmx_mm_f16_chain(
+  uint8_t* vtcm_base,
+  const uint32_t* act_offsets,
+  const uint32_t* wt_offsets,
+  uint32_t n
+) {
+  return mm_chain(vtcm_base, act_offsets, wt_offsets, n, hexkl_micro_hmx_mm_f16);
+}
@@ -0,0 +1,118 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  Asynchronous DDR to VTCM copies on the user DMA engine. Each copy is one 2D descriptor, appended with dmlink to the
+  chain the engine is processing (or started with dmstart when the queue has none linked yet). Descriptors live in
+  a ring of HEXKL_MACRO_EXT_DMA_DEPTH slots indexed by token; a slot is reused only after its copy has completed, so
+  the tokens of copies older than the ring are complete by construction.
+*/
+
+_Static_assert(sizeof(hexkl_ext_dma_desc_2d_t) <= sizeof(((hexkl_dma_queue_t*)0)->desc[0]), "descriptor storage");
+
+static volatile hexkl_ext_dma_desc_2d_t* slot(hexkl_dma_queue_t* queue, hexkl_dma_token_t token) {
+  return (volatile hexkl_ext_dma_desc_2d_t*)queue->desc[token % HEXKL_MACRO_EXT_DMA_DEPTH];
+}
+
+/* Spins until the engine has completed the copy of `token`. */
+static void wait_desc(hexkl_dma_queue_t* queue, hexkl_dma_token_t token) {
+  volatile hexkl_ext_dma_desc_2d_t* desc = slot(queue, token);
+
+  while (desc->dstate != HEXKL_EXT_DMA_DESC_DONE) {
+    Q6_R_dmpoll();
+  }
+}
+
+int hexkl_macro_ext_dma_init(hexkl_dma_queue_t* queue) {
+  if (queue == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  memset(queue->desc, 0, sizeof(queue->desc));
+  queue->tail     = NULL;
+  queue->n_issued = 0;
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_dma_copy_async(
+  hexkl_dma_queue_t* queue,
+  uint8_t* vtcm_base,
+  uint32_t out_offset,
+  const void* src,
+  uint32_t src_stride,
+  uint32_t row_bytes,
+  uint32_t n_rows,
+  hexkl_dma_token_t* token
+) {
+  hexkl_ext_dma_desc_2d_t* desc;
+
+  if (queue == NULL || vtcm_base == NULL || src == NULL || token == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (row_bytes == 0 || n_rows == 0 || src_stride < row_bytes || src_stride > HEXKL_MACRO_EXT_DMA_MAX ||
+      n_rows > HEXKL_MACRO_EXT_DMA_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  // Recycle the slot of the copy issued HEXKL_MACRO_EXT_DMA_DEPTH copies ago
+  if (queue->n_issued >= HEXKL_MACRO_EXT_DMA_DEPTH) {
+    wait_desc(queue, queue->n_issued);
+  }
+
+  desc = (hexkl_ext_dma_desc_2d_t*)queue->desc[queue->n_issued % HEXKL_MACRO_EXT_DMA_DEPTH];
+  memset(desc, 0, sizeof(*desc));
+  desc->desctype  = HEXKL_EXT_DMA_DESC_2D;
+  desc->dstbypass = 1; // VTCM is not cached
+  desc->srcbypass = 0; // read through L2, coherent with the writes of the DSP
+  desc->src       = src;
+  desc->dst       = vtcm_base + out_offset;
+  desc->roiwidth  = (uint16_t)row_bytes;
+  desc->roiheight = (uint16_t)n_rows;
+  desc->srcstride = (uint16_t)src_stride;
+  desc->dststride = (uint16_t)row_bytes;
+
+  // The descriptor must be written before the engine can fetch it
+  __asm__ __volatile__("" ::: "memory");
+  if (queue->tail == NULL) {
+    Q6_dmstart_A(desc);
+  } else {
+    Q6_dmlink_AA(queue->tail, desc);
+  }
+  queue->tail = desc;
+  *token      = queue->n_issued++;
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_dma_wait(hexkl_dma_queue_t* queue, hexkl_dma_token_t token) {
+  if (queue == NULL || token >= queue->n_issued) {
+    return AEE_EBADPARM;
+  }
+
+  // Older slots have been recycled, which required their copies to complete
+  if (queue->n_issued - token <= HEXKL_MACRO_EXT_DMA_DEPTH) {
+    wait_desc(queue, token);
+  }
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_dma_wait_all(hexkl_dma_queue_t* queue) {
+  if (queue == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  // Copies complete in order: the last one completes last
+  if (queue->n_issued != 0) {
+    wait_desc(queue, queue->n_issued - 1);
+  }
+
+  return AEE_SUCCESS;
+}
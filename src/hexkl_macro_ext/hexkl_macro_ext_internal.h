@@ -0,0 +1,151 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#ifndef __HEXKL_MACRO_EXT_INTERNAL_H__
+#define __HEXKL_MACRO_EXT_INTERNAL_H__
+
+#include "HAP_perf.h"
+#include "hexagon_protos.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "hexkl_macro_ext.h"
+#include "hexkl_micro.h"
+
+/*
+  Internal declarations shared by the hexkl_macro_ext translation units. Not part of the public API.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size in bytes of a 32x32 FP16 tile. */
+#define HEXKL_EXT_F16_TILE_BYTES (HEXKL_HMX_F16_BLOCK_N_ROW * HEXKL_HMX_F16_BLOCK_N_COL * sizeof(_Float16))
+
+#define HEXKL_EXT_ALIGN_UP(x, a)   (((x) + ((a) - 1)) / (a) * (a))
+#define HEXKL_EXT_ALIGN_DOWN(x, a) ((x) / (a) * (a))
+#define HEXKL_EXT_MIN(a, b)        ((a) < (b) ? (a) : (b))
+
+/* Returns from the calling function if `x` does not evaluate to AEE_SUCCESS. */
+#define HEXKL_EXT_CHECK(x) \
+  do { \
+    int _ret = (x); \
+    if (_ret != AEE_SUCCESS) { \
+      return _ret; \
+    } \
+  } while (0)
+
+static inline float hexkl_ext_activate(float x, hexkl_activation_e activation) {
+  switch (activation) {
+    case HEXKL_ACT_RELU:
+      return x > 0.f ? x : 0.f;
+    case HEXKL_ACT_SILU:
+      return x / (1.f + expf(-x));
+    case HEXKL_ACT_GELU:
+      return 0.5f * x * (1.f + tanhf(0.7978845608f * (x + 0.044715f * x * x * x)));
+    default:
+      return x;
+  }
+}
+
+/*
+  Stores a 32x32 FP16 tile in flat row-major layout at `vtcm_base + tile_offset` to rows `row0 ..` and columns
+  `col0 .. col0 + 32` of the `n_row x n_col` row-major matrix `A`, applying `epilogue`. `A` and the residual are FP32
+  if `out_f32` is set, FP16 otherwise.
+*/
+void hexkl_ext_store_tile_epilogue(
+  const uint8_t* vtcm_base,
+  uint32_t tile_offset,
+  void* A,
+  int out_f32,
+  uint32_t row0,
+  uint32_t col0,
+  uint32_t n_row,
+  uint32_t n_col,
+  const hexkl_epilogue_t* epilogue
+);
+
+/* Current QTimer count, 19.2 MHz ticks. */
+static inline uint64_t hexkl_ext_now(void) {
+  return HAP_perf_get_qtimer_count();
+}
+
+/* Largest row stride, width and height of an l2fetch box. */
+#define HEXKL_EXT_L2FETCH_MAX (0xFFFFU)
+
+/*
+  Starts fetching `height` rows of `width` bytes, `stride` bytes apart, from `addr` into L2 without waiting for them.
+  All three must be at most HEXKL_EXT_L2FETCH_MAX.
+*/
+static inline void hexkl_ext_l2fetch(const void* addr, uint32_t stride, uint32_t width, uint32_t height) {
+  uint64_t control = ((uint64_t)stride << 32) | ((uint64_t)width << 16) | height;
+  Q6_l2fetch_AP((void*)addr, control);
+}
+
+/* Type and state values of user DMA descriptors. */
+#define HEXKL_EXT_DMA_DESC_2D   (1U)
+#define HEXKL_EXT_DMA_DESC_DONE (1U)
+
+/*
+  2D descriptor of the user DMA engine: `roiheight` rows of `roiwidth` bytes, `srcstride` and `dststride` bytes apart.
+  The engine sets `dstate` when the transfer has completed. Kept in the storage of hexkl_dma_queue_t.
+*/
+typedef struct {
+  void* next;
+  uint32_t length : 24;
+  uint32_t desctype : 2;
+  uint32_t dstcomp : 1;
+  uint32_t srccomp : 1;
+  uint32_t dstbypass : 1;
+  uint32_t srcbypass : 1;
+  uint32_t order : 1;
+  uint32_t dstate : 1;
+  const void* src;
+  void* dst;
+  uint32_t allocation : 28;
+  uint32_t padding : 4;
+  uint16_t roiwidth;
+  uint16_t roiheight;
+  uint16_t srcstride;
+  uint16_t dststride;
+  uint16_t srcwidthoffset;
+  uint16_t dstwidthoffset;
+} hexkl_ext_dma_desc_2d_t;
+
+/* Non-zero while spans are recorded (hexkl_macro_ext_trace.c). */
+extern atomic_int hexkl_ext_trace_enabled;
+
+/* Records the span of QTimer ticks `begin .. end`. */
+void hexkl_ext_trace_record(const char* name, const char* category, uint64_t begin, uint64_t end);
+
+/* Records the span `begin .. end` if tracing, at the cost of one relaxed load otherwise. */
+static inline void hexkl_ext_trace_span(const char* name, const char* category, uint64_t begin, uint64_t end) {
+  if (atomic_load_explicit(&hexkl_ext_trace_enabled, memory_order_relaxed)) {
+    hexkl_ext_trace_record(name, category, begin, end);
+  }
+}
+
+/* Totals of one matrix multiplication call, added to the cumulative counters once per call. */
+typedef struct {
+  uint64_t n_matmuls;
+  uint64_t n_macs;
+  uint64_t bytes_to_vtcm;
+  uint64_t bytes_from_vtcm;
+  uint64_t act_load_ticks;
+  uint64_t hmx_ticks;
+  uint64_t acc_read_ticks;
+  uint64_t store_ticks;
+  uint64_t bytes_streamed;
+  uint64_t gemv_ticks;
+  uint64_t vtcm_bytes; // VTCM footprint, kept as a maximum rather than added
+} hexkl_ext_mm_counters_t;
+
+/* Adds the matrix multiplications of one call with totals `counters` (hexkl_macro_ext_stats.c). */
+void hexkl_ext_stats_add_mm(const hexkl_ext_mm_counters_t* counters);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif //__HEXKL_MACRO_EXT_INTERNAL_H__
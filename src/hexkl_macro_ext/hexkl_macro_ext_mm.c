@@ -0,0 +1,867 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  FP16 matrix multiplication on the micro API.
+
+  Activation tiles are converted to AH layout and weight tiles to WH layout in VTCM, multiplied into the HMX
+  accumulator over the inner dimension, and each 32x32 accumulator tile is read into VTCM, converted to flat row-major
+  layout and stored, either with the micro API copy functions or, when an epilogue is given, element-wise with the
+  epilogue applied. Rows of a strided X (a window of a larger buffer) are gathered from DDR straight into the staging
+  tile. The loop order decides which tiles stay in VTCM (see hexkl_mm_order_e):
+
+    activation-stationary  for every row block: load its row of activation tiles, then for every column block
+                           convert its weight tiles one at a time into a single slot
+    weight-stationary      for every panel of column blocks: for every row block: load its row of activation tiles,
+                           then for every column block of the panel multiply by its weight tiles, converted into their
+                           own slots during the first row block only, and issued as accumulation chains afterwards
+    output-stationary      for every row block: for every column block: load each activation tile and convert each
+                           weight tile into a single slot
+
+  The column blocks of all weight matrices of a multi-weight call form one sequence, so a weight panel can span them.
+  All orders accumulate the inner tiles in the same order and produce identical results.
+
+  Unless disabled with hexkl_macro_ext_set_mm_dma(), activation and weight tiles are copied from DDR by the user DMA
+  engine into flat double buffers, and converted from there: the copy of inner tile kt + 1 is in flight while tile kt
+  is converted and multiplied. Operands whose row stride exceeds a DMA descriptor take the synchronous copies.
+
+  VTCM layout, allocated from a VTCM arena (offsets in 2 KB tiles, K = n_ktiles, P = column blocks per weight panel,
+  as many as the rest of the region holds, D = 4 with DMA and 0 without):
+    [0, K)              activation tiles of the current row block, AH layout (1 tile when output-stationary)
+    K                   flat staging tile (activation loads and accumulator read-out)
+    K + 1               accumulator tile, AH layout
+    [K + 2, K + 2 + D)  flat DMA buffers: 2 activation tiles, then 2 weight tiles
+    [K + 2 + D, ..)     weight tiles, WH layout: P * K when weight-stationary, 1 otherwise
+    end of region       HMX configuration
+
+  Products of at most HEXKL_MACRO_EXT_GEMV_MAX_ROWS rows (token generation) would leave most of every 32-row
+  activation tile as padding while still converting each weight tile to WH layout, so they bypass HMX and VTCM: each
+  64-column block of W is streamed from DDR once, one 128-byte L2 line per inner row, prefetched with l2fetch a
+  batch of rows ahead, and multiplied in vectorizable loops into FP32 accumulators for all rows.
+*/
+
+#define HEXKL_EXT_GEMV_N_COL    (64U) // columns per block, one 128-byte line of FP16 weights per inner row
+#define HEXKL_EXT_GEMV_PREFETCH (16U) // inner rows of the weight block fetched ahead
+#define HEXKL_EXT_CHAIN_N       (32U) // tile pairs per accumulation chain over a resident weight panel
+
+/* Loop order set with hexkl_macro_ext_set_mm_order(). */
+static atomic_int g_mm_order = HEXKL_MM_ORDER_AUTO;
+
+/* Non-zero to copy tiles with DMA, set with hexkl_macro_ext_set_mm_dma(). */
+static atomic_int g_mm_dma = 1;
+
+typedef struct {
+  hexkl_mm_order_e order; // never HEXKL_MM_ORDER_AUTO
+  uint32_t n_ktiles;
+  uint32_t n_panel;       // column blocks per sweep of the row blocks, all unless weight-stationary
+  uint64_t bytes_to_vtcm; // predicted, as counted by mm_f16_multi()
+  uint32_t vtcm_bytes;    // high-water mark of the VTCM arena
+  int dma;                // tiles copied with DMA into the double buffers
+  uint32_t act_offset;
+  uint32_t stage_offset;
+  uint32_t acc_offset;
+  uint32_t weight_offset;
+  uint32_t dma_offset; // activation double buffer, then weight double buffer, flat layout
+  uint32_t config_offset;
+} hexkl_ext_mm_vtcm_t;
+
+/*
+  Lays out VTCM for `order` with an arena and predicts its DDR to VTCM bytes, for `n_row` rows, `n_col` columns over
+  all weight matrices and `n_inner`, with DMA double buffers if `dma` is set. Weight-stationary panels take as many
+  column blocks as the rest of the region holds. Returns AEE_ENOMEMORY if the order does not fit.
+*/
+static int plan_order(
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  hexkl_mm_order_e order,
+  int dma,
+  hexkl_ext_mm_vtcm_t* plan
+) {
+  uint32_t n_rblocks = (n_row + HEXKL_HMX_F16_BLOCK_N_ROW - 1) / HEXKL_HMX_F16_BLOCK_N_ROW;
+  uint32_t n_cblocks = n_col / HEXKL_HMX_F16_BLOCK_N_COL;
+  uint64_t act_bytes = (uint64_t)n_row * n_inner * sizeof(_Float16);
+  uint64_t w_bytes   = (uint64_t)n_col * n_inner * sizeof(_Float16);
+  uint32_t n_act, panel_bytes;
+  hexkl_vtcm_arena_t arena;
+
+  plan->order    = order;
+  plan->dma      = dma;
+  plan->n_ktiles = n_inner / HEXKL_HMX_F16_BLOCK_N_INNER;
+  plan->n_panel  = n_cblocks;
+  n_act          = order == HEXKL_MM_ORDER_OUTPUT_STATIONARY ? 1 : plan->n_ktiles;
+  panel_bytes    = plan->n_ktiles * HEXKL_EXT_F16_TILE_BYTES;
+
+  hexkl_macro_ext_vtcm_init(&arena, vtcm_size);
+  HEXKL_EXT_CHECK(
+    hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_CONFIG, hexkl_micro_hmx_config_size(), &plan->config_offset)
+  );
+  HEXKL_EXT_CHECK(hexkl_macro_ext_vtcm_alloc(
+    &arena, HEXKL_VTCM_ACTIVATION, n_act * HEXKL_HMX_ACTIVATION_ALIGNMENT, &plan->act_offset
+  ));
+  HEXKL_EXT_CHECK(
+    hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, HEXKL_EXT_F16_TILE_BYTES, &plan->stage_offset)
+  );
+  HEXKL_EXT_CHECK(
+    hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, HEXKL_EXT_F16_TILE_BYTES, &plan->acc_offset)
+  );
+  if (dma) {
+    HEXKL_EXT_CHECK(
+      hexkl_macro_ext_vtcm_alloc(&arena, HEXKL_VTCM_ACTIVATION, 4 * HEXKL_EXT_F16_TILE_BYTES, &plan->dma_offset)
+    );
+  }
+
+  switch (order) {
+    case HEXKL_MM_ORDER_OUTPUT_STATIONARY:
+      plan->bytes_to_vtcm = n_cblocks * act_bytes + n_rblocks * w_bytes;
+      break;
+    case HEXKL_MM_ORDER_WEIGHT_STATIONARY:
+      plan->n_panel = hexkl_macro_ext_vtcm_available(&arena, HEXKL_VTCM_WEIGHTS) / panel_bytes;
+      plan->n_panel = HEXKL_EXT_MIN(n_cblocks, plan->n_panel);
+      if (plan->n_panel == 0) {
+        return AEE_ENOMEMORY;
+      }
+      plan->bytes_to_vtcm = w_bytes + (uint64_t)((n_cblocks + plan->n_panel - 1) / plan->n_panel) * act_bytes;
+      break;
+    default:
+      plan->bytes_to_vtcm = act_bytes + n_rblocks * w_bytes;
+      break;
+  }
+
+  // One weight tile, or the panels of weight-stationary column blocks, each n_ktiles tiles
+  HEXKL_EXT_CHECK(hexkl_macro_ext_vtcm_alloc(
+    &arena,
+    HEXKL_VTCM_WEIGHTS,
+    order == HEXKL_MM_ORDER_WEIGHT_STATIONARY ? plan->n_panel * panel_bytes : HEXKL_EXT_F16_TILE_BYTES,
+    &plan->weight_offset
+  ));
+  plan->vtcm_bytes = arena.high_water;
+
+  return AEE_SUCCESS;
+}
+
+/* Plans the order set with hexkl_macro_ext_set_mm_order(), or the feasible order moving the fewest bytes. */
+static int plan_vtcm(uint32_t vtcm_size, uint32_t n_row, uint32_t n_col, uint32_t n_inner, hexkl_ext_mm_vtcm_t* plan) {
+  static const hexkl_mm_order_e candidates[] = {
+    HEXKL_MM_ORDER_ACTIVATION_STATIONARY, HEXKL_MM_ORDER_WEIGHT_STATIONARY, HEXKL_MM_ORDER_OUTPUT_STATIONARY
+  };
+  hexkl_mm_order_e order = (hexkl_mm_order_e)atomic_load_explicit(&g_mm_order, memory_order_relaxed);
+  int dma                = atomic_load_explicit(&g_mm_dma, memory_order_relaxed);
+  hexkl_ext_mm_vtcm_t candidate;
+  int ret = AEE_ENOMEMORY;
+
+  if (order != HEXKL_MM_ORDER_AUTO) {
+    return plan_order(vtcm_size, n_row, n_col, n_inner, order, dma, plan);
+  }
+  for (uint32_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+    if (plan_order(vtcm_size, n_row, n_col, n_inner, candidates[i], dma, &candidate) != AEE_SUCCESS) {
+      continue;
+    }
+    if (ret != AEE_SUCCESS || candidate.bytes_to_vtcm < plan->bytes_to_vtcm) {
+      *plan = candidate;
+      ret   = AEE_SUCCESS;
+    }
+  }
+
+  return ret;
+}
+
+/*
+  Applies `epilogue` to the FP32 values `v` of row `row`, columns `col0 .. col0 + n`, and stores them to the
+  `n_col`-column row-major matrix `A`, FP32 if `out_f32` is set, FP16 otherwise. `epilogue` may be NULL.
+*/
+static void store_row_epilogue(
+  float* v,
+  void* A,
+  int out_f32,
+  uint32_t row,
+  uint32_t col0,
+  uint32_t n,
+  uint32_t n_col,
+  const hexkl_epilogue_t* epilogue
+) {
+  size_t out_idx    = (size_t)row * n_col + col0;
+  const void* resid = NULL;
+  const float* bias = NULL;
+
+  if (epilogue != NULL) {
+    bias  = epilogue->bias != NULL ? epilogue->bias + col0 : NULL;
+    resid = epilogue->residual;
+    if (bias != NULL) {
+      for (uint32_t c = 0; c < n; c++) {
+        v[c] += bias[c];
+      }
+    }
+    if (epilogue->activation != HEXKL_ACT_NONE) {
+      for (uint32_t c = 0; c < n; c++) {
+        v[c] = hexkl_ext_activate(v[c], epilogue->activation);
+      }
+    }
+  }
+
+  if (out_f32) {
+    const float* res = resid != NULL ? (const float*)resid + out_idx : NULL;
+    float* out       = (float*)A + out_idx;
+    for (uint32_t c = 0; c < n; c++) {
+      out[c] = res != NULL ? v[c] + res[c] : v[c];
+    }
+  } else {
+    const _Float16* res = resid != NULL ? (const _Float16*)resid + out_idx : NULL;
+    _Float16* out       = (_Float16*)A + out_idx;
+    for (uint32_t c = 0; c < n; c++) {
+      out[c] = (_Float16)(res != NULL ? v[c] + (float)res[c] : v[c]);
+    }
+  }
+}
+
+void hexkl_ext_store_tile_epilogue(
+  const uint8_t* vtcm_base,
+  uint32_t tile_offset,
+  void* A,
+  int out_f32,
+  uint32_t row0,
+  uint32_t col0,
+  uint32_t n_row,
+  uint32_t n_col,
+  const hexkl_epilogue_t* epilogue
+) {
+  const _Float16* tile = (const _Float16*)(vtcm_base + tile_offset);
+  uint32_t rows        = HEXKL_EXT_MIN(HEXKL_HMX_F16_BLOCK_N_ROW, n_row - row0);
+
+  for (uint32_t r = 0; r < rows; r++) {
+    float v[HEXKL_HMX_F16_BLOCK_N_COL];
+
+    for (uint32_t c = 0; c < HEXKL_HMX_F16_BLOCK_N_COL; c++) {
+      v[c] = (float)tile[r * HEXKL_HMX_F16_BLOCK_N_COL + c];
+    }
+    store_row_epilogue(v, A, out_f32, row0 + r, col0, HEXKL_HMX_F16_BLOCK_N_COL, n_col, epilogue);
+  }
+}
+
+/*
+  Gathers the 32x32 tile at rows `row0 ..` and columns `col0 .. col0 + 32` of the `n_row`-row matrix `X`, whose rows
+  are `x_row_stride` elements apart, into flat row-major layout at `vtcm_base + tile_offset`. Rows past `n_row` are
+  zero-filled.
+*/
+static void gather_tile_f16(
+  uint8_t* vtcm_base,
+  uint32_t tile_offset,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  uint32_t row0,
+  uint32_t col0,
+  uint32_t n_row
+) {
+  _Float16* tile = (_Float16*)(vtcm_base + tile_offset);
+  uint32_t rows  = HEXKL_EXT_MIN(HEXKL_HMX_F16_BLOCK_N_ROW, n_row - row0);
+  size_t row_len = HEXKL_HMX_F16_BLOCK_N_INNER * sizeof(_Float16);
+
+  for (uint32_t r = 0; r < rows; r++) {
+    memcpy(tile + r * HEXKL_HMX_F16_BLOCK_N_INNER, X + (size_t)(row0 + r) * x_row_stride + col0, row_len);
+  }
+  if (rows < HEXKL_HMX_F16_BLOCK_N_ROW) {
+    memset(tile + rows * HEXKL_HMX_F16_BLOCK_N_INNER, 0, (HEXKL_HMX_F16_BLOCK_N_ROW - rows) * row_len);
+  }
+}
+
+/* Few-row path of mm_f16(), see the comment at the top of the file. */
+static void mm_f16_gemv(
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  void* A,
+  int out_f32,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  const _Float16* W,
+  const hexkl_epilogue_t* epilogue
+) {
+  uint32_t w_stride = n_col * sizeof(_Float16);
+  int prefetch      = w_stride <= HEXKL_EXT_L2FETCH_MAX;
+  uint64_t t0       = hexkl_ext_now();
+  uint64_t t1;
+
+  for (uint32_t col = 0; col < n_col; col += HEXKL_EXT_GEMV_N_COL) {
+    uint32_t cols  = HEXKL_EXT_MIN(HEXKL_EXT_GEMV_N_COL, n_col - col);
+    uint32_t width = cols * sizeof(_Float16);
+    float acc[HEXKL_MACRO_EXT_GEMV_MAX_ROWS][HEXKL_EXT_GEMV_N_COL];
+
+    memset(acc, 0, sizeof(acc));
+    if (prefetch) {
+      hexkl_ext_l2fetch(W + col, w_stride, width, HEXKL_EXT_MIN(HEXKL_EXT_GEMV_PREFETCH, n_inner));
+    }
+
+    for (uint32_t k = 0; k < n_inner; k++) {
+      const _Float16* w = W + (size_t)k * n_col + col;
+      float wf[HEXKL_EXT_GEMV_N_COL];
+
+      // Request the next batch of rows while this one, already requested, is consumed
+      if (prefetch && k % HEXKL_EXT_GEMV_PREFETCH == 0 && k + HEXKL_EXT_GEMV_PREFETCH < n_inner) {
+        uint32_t rows = HEXKL_EXT_MIN(HEXKL_EXT_GEMV_PREFETCH, n_inner - k - HEXKL_EXT_GEMV_PREFETCH);
+        hexkl_ext_l2fetch(w + (size_t)HEXKL_EXT_GEMV_PREFETCH * n_col, w_stride, width, rows);
+      }
+
+      for (uint32_t c = 0; c < cols; c++) {
+        wf[c] = (float)w[c];
+      }
+      for (uint32_t r = 0; r < n_row; r++) {
+        float x = (float)X[(size_t)r * x_row_stride + k];
+        for (uint32_t c = 0; c < cols; c++) {
+          acc[r][c] += x * wf[c];
+        }
+      }
+    }
+
+    for (uint32_t r = 0; r < n_row; r++) {
+      store_row_epilogue(acc[r], A, out_f32, r, col, cols, n_col, epilogue);
+    }
+
+    t1 = hexkl_ext_now();
+    hexkl_ext_trace_span("gemv", "hvx", t0, t1);
+    t0 = t1;
+  }
+}
+
+/* DMA copies of one call into the double buffers of the plan, see fetch_act_tile() and fetch_weight_tile(). */
+typedef struct {
+  hexkl_dma_queue_t queue;
+  int act;                            // activation tiles copied with DMA
+  hexkl_dma_token_t act_token[2];     // per activation buffer, the copy filling it
+  hexkl_dma_token_t weight_token[2];  // per weight buffer, the copy filling it
+} hexkl_ext_mm_dma_t;
+
+static uint32_t dma_act_buffer(const hexkl_ext_mm_vtcm_t* plan, uint32_t kt) {
+  return plan->dma_offset + (kt % 2) * HEXKL_EXT_F16_TILE_BYTES;
+}
+
+static uint32_t dma_weight_buffer(const hexkl_ext_mm_vtcm_t* plan, uint32_t kt) {
+  return plan->dma_offset + (2 + kt % 2) * HEXKL_EXT_F16_TILE_BYTES;
+}
+
+/* Starts the copy of the activation tile at row block `row` and inner tile `kt` of X into its DMA buffer. */
+static int fetch_act_tile(
+  hexkl_ext_mm_dma_t* dma,
+  uint8_t* vtcm_base,
+  const hexkl_ext_mm_vtcm_t* plan,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  uint32_t n_row,
+  uint32_t row,
+  uint32_t kt
+) {
+  uint32_t rows = HEXKL_EXT_MIN(HEXKL_HMX_F16_BLOCK_N_ROW, n_row - row);
+
+  return hexkl_macro_ext_dma_copy_async(
+    &dma->queue, vtcm_base, dma_act_buffer(plan, kt), X + (size_t)row * x_row_stride + kt * HEXKL_HMX_F16_BLOCK_N_INNER,
+    x_row_stride * sizeof(_Float16), HEXKL_HMX_F16_BLOCK_N_INNER * sizeof(_Float16), rows, &dma->act_token[kt % 2]
+  );
+}
+
+/*
+  Loads the activation tile at row block `row` and inner tile `kt` of X into AH layout at `vtcm_base + tile_offset`:
+  from its DMA buffer once the copy started by fetch_act_tile() completes, or through the staging tile without DMA.
+*/
+static int load_act_tile(
+  hexkl_ext_mm_dma_t* dma,
+  uint8_t* vtcm_base,
+  const hexkl_ext_mm_vtcm_t* plan,
+  uint32_t tile_offset,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  uint32_t n_row,
+  uint32_t n_inner,
+  uint32_t row,
+  uint32_t kt
+) {
+  if (dma->act) {
+    uint32_t buffer = dma_act_buffer(plan, kt);
+    uint32_t rows   = HEXKL_EXT_MIN(HEXKL_HMX_F16_BLOCK_N_ROW, n_row - row);
+    size_t row_len  = HEXKL_HMX_F16_BLOCK_N_INNER * sizeof(_Float16);
+
+    HEXKL_EXT_CHECK(hexkl_macro_ext_dma_wait(&dma->queue, dma->act_token[kt % 2]));
+    if (rows < HEXKL_HMX_F16_BLOCK_N_ROW) {
+      memset(vtcm_base + buffer + rows * row_len, 0, (HEXKL_HMX_F16_BLOCK_N_ROW - rows) * row_len);
+    }
+    return hexkl_micro_hmx_rm_to_ah_f16(vtcm_base, tile_offset, buffer);
+  }
+
+  if (x_row_stride == n_inner) {
+    HEXKL_EXT_CHECK(hexkl_micro_hmx_copy_submatrix_to_f16(
+      vtcm_base, plan->stage_offset, X, row / HEXKL_HMX_F16_BLOCK_N_ROW, kt, n_row, n_inner
+    ));
+  } else {
+    gather_tile_f16(vtcm_base, plan->stage_offset, X, x_row_stride, row, kt * HEXKL_HMX_F16_BLOCK_N_INNER, n_row);
+  }
+  return hexkl_micro_hmx_rm_to_ah_f16(vtcm_base, tile_offset, plan->stage_offset);
+}
+
+/* Starts the copy of the weight tile at inner tile `kt` and column tile `tile_col` of `W` into its DMA buffer. */
+static int fetch_weight_tile(
+  hexkl_ext_mm_dma_t* dma,
+  uint8_t* vtcm_base,
+  const hexkl_ext_mm_vtcm_t* plan,
+  const _Float16* W,
+  uint32_t n_col,
+  uint32_t kt,
+  uint32_t tile_col
+) {
+  const _Float16* src = W + (size_t)kt * HEXKL_HMX_F16_BLOCK_N_INNER * n_col + tile_col * HEXKL_HMX_F16_BLOCK_N_COL;
+
+  return hexkl_macro_ext_dma_copy_async(
+    &dma->queue, vtcm_base, dma_weight_buffer(plan, kt), src, n_col * sizeof(_Float16),
+    HEXKL_HMX_F16_BLOCK_N_COL * sizeof(_Float16), HEXKL_HMX_F16_BLOCK_N_INNER, &dma->weight_token[kt % 2]
+  );
+}
+
+/*
+  Converts the weight tile at inner tile `kt` and column tile `tile_col` of `W` into WH layout at
+  `vtcm_base + tile_offset`: from its DMA buffer if `from_dma`, once the copy started by fetch_weight_tile()
+  completes, or straight from DDR otherwise.
+*/
+static int load_weight_tile(
+  hexkl_ext_mm_dma_t* dma,
+  uint8_t* vtcm_base,
+  const hexkl_ext_mm_vtcm_t* plan,
+  uint32_t tile_offset,
+  const _Float16* W,
+  uint32_t n_col,
+  uint32_t kt,
+  uint32_t tile_col,
+  int from_dma
+) {
+  if (from_dma) {
+    const _Float16* buffer = (const _Float16*)(vtcm_base + dma_weight_buffer(plan, kt));
+
+    HEXKL_EXT_CHECK(hexkl_macro_ext_dma_wait(&dma->queue, dma->weight_token[kt % 2]));
+    return hexkl_micro_hmx_rm_to_wh_f16(vtcm_base, tile_offset, buffer, 0, 0, HEXKL_HMX_F16_BLOCK_N_COL);
+  }
+  return hexkl_micro_hmx_rm_to_wh_f16(vtcm_base, tile_offset, W, kt, tile_col, n_col);
+}
+
+/* Finds the weight matrix `*w` and its first column `*col` of column block `cb` of all weight matrices. */
+static void locate_col_block(const hexkl_mm_weight_t* weights, uint32_t cb, uint32_t* w, uint32_t* col) {
+  uint32_t col0 = cb * HEXKL_HMX_F16_BLOCK_N_COL;
+  uint32_t i    = 0;
+
+  while (col0 >= weights[i].n_col) {
+    col0 -= weights[i].n_col;
+    i++;
+  }
+  *w   = i;
+  *col = col0;
+}
+
+/*
+  Multiplies the row of activation tiles by the weight tiles of one column block of a resident panel at
+  `panel_offset`, in chains of up to HEXKL_EXT_CHAIN_N tile pairs.
+*/
+static int mm_resident_f16(uint8_t* vtcm_base, const hexkl_ext_mm_vtcm_t* plan, uint32_t panel_offset) {
+  uint32_t act_offsets[HEXKL_EXT_CHAIN_N];
+  uint32_t wt_offsets[HEXKL_EXT_CHAIN_N];
+
+  for (uint32_t kt0 = 0; kt0 < plan->n_ktiles; kt0 += HEXKL_EXT_CHAIN_N) {
+    uint32_t n = HEXKL_EXT_MIN(HEXKL_EXT_CHAIN_N, plan->n_ktiles - kt0);
+
+    for (uint32_t i = 0; i < n; i++) {
+      act_offsets[i] = plan->act_offset + (kt0 + i) * HEXKL_HMX_ACTIVATION_ALIGNMENT;
+      wt_offsets[i]  = panel_offset + (kt0 + i) * HEXKL_EXT_F16_TILE_BYTES;
+    }
+    HEXKL_EXT_CHECK(hexkl_macro_ext_hmx_mm_f16_chain(vtcm_base, act_offsets, wt_offsets, n));
+  }
+
+  return AEE_SUCCESS;
+}
+
+/*
+  Loop nest of mm_f16_multi() for `plan`, adding to `counters` and ending its trace spans at `*t_end`. With DMA, the
+  copy of the next inner tile is in flight while the current one is converted and multiplied; copies may still be in
+  flight when this returns early on an error.
+*/
+static int mm_f16_tiles(
+  uint8_t* vtcm_base,
+  const hexkl_ext_mm_vtcm_t* plan,
+  hexkl_ext_mm_dma_t* dma,
+  uint32_t n_row,
+  uint32_t n_inner,
+  int out_f32,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  const hexkl_mm_weight_t* weights,
+  uint32_t n_cblocks,
+  hexkl_ext_mm_counters_t* counters,
+  uint64_t* t_end
+) {
+  size_t out_size = out_f32 ? sizeof(float) : sizeof(_Float16);
+  int os          = plan->order == HEXKL_MM_ORDER_OUTPUT_STATIONARY;
+  int ws          = plan->order == HEXKL_MM_ORDER_WEIGHT_STATIONARY;
+  uint64_t t0     = *t_end;
+  uint64_t t1;
+
+  // Each phase starts at the timestamp ending the previous one, which feeds both the spans and the counters
+  for (uint32_t cb0 = 0; cb0 < n_cblocks; cb0 += plan->n_panel) {
+    uint32_t cb1 = HEXKL_EXT_MIN(cb0 + plan->n_panel, n_cblocks);
+
+    for (uint32_t row = 0; row < n_row; row += HEXKL_HMX_F16_BLOCK_N_ROW) {
+      uint32_t tile_row = row / HEXKL_HMX_F16_BLOCK_N_ROW;
+      uint32_t rows     = HEXKL_EXT_MIN(HEXKL_HMX_F16_BLOCK_N_ROW, n_row - row);
+      // Weight-stationary panels are converted during the first row block and reused by the others
+      int load_weights  = !ws || row == 0;
+
+      // Load the row of activation tiles once for all column blocks of the panel
+      if (!os) {
+        if (dma->act) {
+          HEXKL_EXT_CHECK(fetch_act_tile(dma, vtcm_base, plan, X, x_row_stride, n_row, row, 0));
+        }
+        for (uint32_t kt = 0; kt < plan->n_ktiles; kt++) {
+          if (dma->act && kt + 1 < plan->n_ktiles) {
+            HEXKL_EXT_CHECK(fetch_act_tile(dma, vtcm_base, plan, X, x_row_stride, n_row, row, kt + 1));
+          }
+          HEXKL_EXT_CHECK(load_act_tile(
+            dma, vtcm_base, plan, plan->act_offset + kt * HEXKL_HMX_ACTIVATION_ALIGNMENT, X, x_row_stride, n_row,
+            n_inner, row, kt
+          ));
+        }
+        t1 = hexkl_ext_now();
+        hexkl_ext_trace_span("act_load", "copy", t0, t1);
+        counters->act_load_ticks += t1 - t0;
+        counters->bytes_to_vtcm += (uint64_t)rows * n_inner * sizeof(_Float16);
+        t0 = t1;
+      }
+
+      for (uint32_t cb = cb0; cb < cb1; cb++) {
+        uint32_t w, col, tile_col, n_col, panel_offset;
+        const hexkl_mm_weight_t* wt;
+        int weight_dma;
+
+        locate_col_block(weights, cb, &w, &col);
+        wt           = &weights[w];
+        n_col        = wt->n_col;
+        tile_col     = col / HEXKL_HMX_F16_BLOCK_N_COL;
+        panel_offset = plan->weight_offset + (ws ? (cb - cb0) * plan->n_ktiles * HEXKL_EXT_F16_TILE_BYTES : 0);
+        weight_dma   = load_weights && plan->dma && n_col * sizeof(_Float16) <= HEXKL_MACRO_EXT_DMA_MAX;
+
+        // Activation loads (output-stationary), weight tile conversions and HMX multiplications alternate per
+        // inner tile and share one span
+        hexkl_micro_hmx_acc_clear_f16();
+        if (!os && !load_weights) {
+          // All tiles resident: issue the accumulation as chains of tile pairs
+          HEXKL_EXT_CHECK(mm_resident_f16(vtcm_base, plan, panel_offset));
+        }
+        if (os && dma->act) {
+          HEXKL_EXT_CHECK(fetch_act_tile(dma, vtcm_base, plan, X, x_row_stride, n_row, row, 0));
+        }
+        if (weight_dma) {
+          HEXKL_EXT_CHECK(fetch_weight_tile(dma, vtcm_base, plan, wt->W, n_col, 0, tile_col));
+        }
+        for (uint32_t kt = 0; kt < plan->n_ktiles && (os || load_weights); kt++) {
+          uint32_t act_tile    = plan->act_offset + (os ? 0 : kt * HEXKL_HMX_ACTIVATION_ALIGNMENT);
+          uint32_t weight_tile = panel_offset + (ws ? kt * HEXKL_EXT_F16_TILE_BYTES : 0);
+
+          // Start the copies of the next inner tile before converting this one
+          if (kt + 1 < plan->n_ktiles) {
+            if (os && dma->act) {
+              HEXKL_EXT_CHECK(fetch_act_tile(dma, vtcm_base, plan, X, x_row_stride, n_row, row, kt + 1));
+            }
+            if (weight_dma) {
+              HEXKL_EXT_CHECK(fetch_weight_tile(dma, vtcm_base, plan, wt->W, n_col, kt + 1, tile_col));
+            }
+          }
+          if (os) {
+            HEXKL_EXT_CHECK(load_act_tile(dma, vtcm_base, plan, act_tile, X, x_row_stride, n_row, n_inner, row, kt));
+          }
+          if (load_weights) {
+            HEXKL_EXT_CHECK(
+              load_weight_tile(dma, vtcm_base, plan, weight_tile, wt->W, n_col, kt, tile_col, weight_dma)
+            );
+          }
+          HEXKL_EXT_CHECK(hexkl_micro_hmx_mm_f16(vtcm_base, act_tile, weight_tile));
+        }
+        t1 = hexkl_ext_now();
+        hexkl_ext_trace_span("weight_load_hmx", "hmx", t0, t1);
+        counters->hmx_ticks += t1 - t0;
+        if (load_weights) {
+          counters->bytes_to_vtcm += (uint64_t)plan->n_ktiles * HEXKL_EXT_F16_TILE_BYTES;
+        }
+        if (os) {
+          counters->bytes_to_vtcm += (uint64_t)rows * n_inner * sizeof(_Float16);
+        }
+        t0 = t1;
+
+        HEXKL_EXT_CHECK(hexkl_micro_hmx_acc_read_f16(vtcm_base, plan->config_offset, plan->acc_offset));
+        HEXKL_EXT_CHECK(hexkl_micro_hmx_ah_to_rm_f16(vtcm_base, plan->stage_offset, plan->acc_offset));
+        t1 = hexkl_ext_now();
+        hexkl_ext_trace_span("acc_read", "hmx", t0, t1);
+        counters->acc_read_ticks += t1 - t0;
+        t0 = t1;
+
+        if (wt->epilogue != NULL) {
+          hexkl_ext_store_tile_epilogue(
+            vtcm_base, plan->stage_offset, wt->A, out_f32, row, col, n_row, n_col, wt->epilogue
+          );
+        } else if (out_f32) {
+          HEXKL_EXT_CHECK(hexkl_micro_hmx_copy_f16_to_f32_submatrix(
+            vtcm_base, plan->stage_offset, (float*)wt->A, tile_row, tile_col, n_row, n_col
+          ));
+        } else {
+          HEXKL_EXT_CHECK(hexkl_micro_hmx_copy_f16_to_submatrix(
+            vtcm_base, plan->stage_offset, (_Float16*)wt->A, tile_row, tile_col, n_row, n_col
+          ));
+        }
+        t1 = hexkl_ext_now();
+        hexkl_ext_trace_span("store", "copy", t0, t1);
+        counters->store_ticks += t1 - t0;
+        counters->bytes_from_vtcm += (uint64_t)rows * HEXKL_HMX_F16_BLOCK_N_COL * out_size;
+        t0 = t1;
+      }
+    }
+  }
+  *t_end = t0;
+
+  return AEE_SUCCESS;
+}
+
+/*
+  Multiplies X by every weight matrix of `weights`, in the loop order of the plan. The activation tiles of each 32-row
+  block are loaded into VTCM once (once per weight panel when weight-stationary, never when output-stationary) and
+  reused for the column blocks of all weight matrices, so fused projections (Q/K/V, gate/up) pay for the activation
+  copies and AH conversions once.
+*/
+static int mm_f16_multi(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_inner,
+  int out_f32,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  const hexkl_mm_weight_t* weights,
+  uint32_t n_weights,
+  const char* call_name
+) {
+  hexkl_ext_mm_vtcm_t plan;
+  hexkl_ext_mm_dma_t dma;
+  hexkl_ext_mm_counters_t counters = {0};
+  size_t out_size                  = out_f32 ? sizeof(float) : sizeof(_Float16);
+  uint64_t n_cols                  = 0;
+  uint64_t t_call, t0;
+  int err;
+
+  if (vtcm_base == NULL || X == NULL || weights == NULL || n_weights == 0) {
+    return AEE_EBADPARM;
+  }
+  if (n_row == 0 || n_inner == 0 || n_inner % HEXKL_HMX_F16_BLOCK_N_INNER != 0 || x_row_stride < n_inner) {
+    return AEE_EBADPARM;
+  }
+  for (uint32_t w = 0; w < n_weights; w++) {
+    const hexkl_mm_weight_t* wt = &weights[w];
+
+    if (wt->A == NULL || wt->W == NULL || wt->n_col == 0 || wt->n_col % HEXKL_HMX_F16_BLOCK_N_COL != 0) {
+      return AEE_EBADPARM;
+    }
+    if (wt->epilogue != NULL && wt->epilogue->activation >= HEXKL_ACT_INVALID) {
+      return AEE_EBADPARM;
+    }
+    n_cols += wt->n_col;
+  }
+  if (n_cols > UINT32_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  counters.n_matmuls = n_weights;
+  counters.n_macs    = (uint64_t)n_row * n_cols * n_inner;
+
+  if (n_row <= HEXKL_MACRO_EXT_GEMV_MAX_ROWS) {
+    t_call = hexkl_ext_now();
+    for (uint32_t w = 0; w < n_weights; w++) {
+      const hexkl_mm_weight_t* wt = &weights[w];
+      mm_f16_gemv(n_row, wt->n_col, n_inner, wt->A, out_f32, X, x_row_stride, wt->W, wt->epilogue);
+    }
+    t0 = hexkl_ext_now();
+    hexkl_ext_trace_span(call_name, "call", t_call, t0);
+
+    counters.gemv_ticks     = t0 - t_call;
+    counters.bytes_streamed = (uint64_t)n_weights * n_row * n_inner * sizeof(_Float16) +
+                              n_inner * n_cols * sizeof(_Float16) + n_row * n_cols * out_size;
+    hexkl_ext_stats_add_mm(&counters);
+    return AEE_SUCCESS;
+  }
+
+  HEXKL_EXT_CHECK(plan_vtcm(vtcm_size, n_row, (uint32_t)n_cols, n_inner, &plan));
+  HEXKL_EXT_CHECK(hexkl_micro_hmx_setup_acc_read_f16(vtcm_base, plan.config_offset));
+  HEXKL_EXT_CHECK(hexkl_macro_ext_dma_init(&dma.queue));
+  counters.vtcm_bytes = plan.vtcm_bytes;
+  // Activation rows too far apart for a descriptor stride are gathered synchronously
+  dma.act = plan.dma && x_row_stride * sizeof(_Float16) <= HEXKL_MACRO_EXT_DMA_MAX;
+
+  t_call = t0 = hexkl_ext_now();
+  err = mm_f16_tiles(
+    vtcm_base, &plan, &dma, n_row, n_inner, out_f32, X, x_row_stride, weights,
+    (uint32_t)(n_cols / HEXKL_HMX_F16_BLOCK_N_COL), &counters, &t0
+  );
+  // No copy may still write to VTCM once the caller gets it back
+  hexkl_macro_ext_dma_wait_all(&dma.queue);
+  HEXKL_EXT_CHECK(err);
+  hexkl_ext_trace_span(call_name, "call", t_call, t0);
+
+  hexkl_ext_stats_add_mm(&counters);
+
+  return AEE_SUCCESS;
+}
+
+static int mm_f16(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  void* A,
+  int out_f32,
+  const _Float16* X,
+  uint32_t x_row_stride,
+  const _Float16* W,
+  const hexkl_epilogue_t* epilogue
+) {
+  hexkl_mm_weight_t weight = {.W = W, .A = A, .n_col = n_col, .epilogue = epilogue};
+
+  return mm_f16_multi(
+    vtcm_base, vtcm_size, n_row, n_inner, out_f32, X, x_row_stride, &weight, 1, "hexkl_macro_ext_mm_f16"
+  );
+}
+
+int hexkl_macro_ext_mm_f16(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  _Float16* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+) {
+  return mm_f16(vtcm_base, vtcm_size, n_row, n_col, n_inner, A, 0, X, n_inner, W, epilogue);
+}
+
+int hexkl_macro_ext_mm_f16f16_f32(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+) {
+  return mm_f16(vtcm_base, vtcm_size, n_row, n_col, n_inner, A, 1, X, n_inner, W, epilogue);
+}
+
+int hexkl_macro_ext_mm_f16_strided(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  _Float16* restrict A,
+  const _Float16* restrict X,
+  uint32_t x_row_stride,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+) {
+  return mm_f16(vtcm_base, vtcm_size, n_row, n_col, n_inner, A, 0, X, x_row_stride, W, epilogue);
+}
+
+int hexkl_macro_ext_mm_f16f16_f32_strided(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  float* restrict A,
+  const _Float16* restrict X,
+  uint32_t x_row_stride,
+  const _Float16* restrict W,
+  const hexkl_epilogue_t* epilogue
+) {
+  return mm_f16(vtcm_base, vtcm_size, n_row, n_col, n_inner, A, 1, X, x_row_stride, W, epilogue);
+}
+
+int hexkl_macro_ext_mm_f16_multi(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_inner,
+  const _Float16* restrict X,
+  const hexkl_mm_weight_t* weights,
+  uint32_t n_weights
+) {
+  return mm_f16_multi(
+    vtcm_base, vtcm_size, n_row, n_inner, 0, X, n_inner, weights, n_weights, "hexkl_macro_ext_mm_f16_multi"
+  );
+}
+
+int hexkl_macro_ext_mm_f16f16_f32_multi(
+  uint8_t* vtcm_base,
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_inner,
+  const _Float16* restrict X,
+  const hexkl_mm_weight_t* weights,
+  uint32_t n_weights
+) {
+  return mm_f16_multi(
+    vtcm_base, vtcm_size, n_row, n_inner, 1, X, n_inner, weights, n_weights, "hexkl_macro_ext_mm_f16_multi"
+  );
+}
+
+int hexkl_macro_ext_set_mm_order(hexkl_mm_order_e order) {
+  if ((uint32_t)order >= HEXKL_MM_ORDER_INVALID) {
+    return AEE_EBADPARM;
+  }
+  atomic_store_explicit(&g_mm_order, order, memory_order_relaxed);
+  return AEE_SUCCESS;
+}
+
+hexkl_mm_order_e hexkl_macro_ext_get_mm_order(void) {
+  return (hexkl_mm_order_e)atomic_load_explicit(&g_mm_order, memory_order_relaxed);
+}
+
+int hexkl_macro_ext_mm_select_order(
+  uint32_t vtcm_size,
+  uint32_t n_row,
+  uint32_t n_col,
+  uint32_t n_inner,
+  hexkl_mm_order_e* order,
+  uint64_t* bytes_to_vtcm
+) {
+  hexkl_ext_mm_vtcm_t plan;
+
+  if (order == NULL || n_row <= HEXKL_MACRO_EXT_GEMV_MAX_ROWS) {
+    return AEE_EBADPARM;
+  }
+  if (n_col == 0 || n_col % HEXKL_HMX_F16_BLOCK_N_COL != 0 || n_inner == 0 ||
+      n_inner % HEXKL_HMX_F16_BLOCK_N_INNER != 0) {
+    return AEE_EBADPARM;
+  }
+
+  HEXKL_EXT_CHECK(plan_vtcm(vtcm_size, n_row, n_col, n_inner, &plan));
+  *order = plan.order;
+  if (bytes_to_vtcm != NULL) {
+    *bytes_to_vtcm = plan.bytes_to_vtcm;
+  }
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_set_mm_dma(int enable) {
+  atomic_store_explicit(&g_mm_dma, enable != 0, memory_order_relaxed);
+  return AEE_SUCCESS;
+}
@@ -0,0 +1,95 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  Cumulative counters of the hexkl_macro_ext matrix multiplications, updated with relaxed atomic additions (a maximum
+  for the VTCM high-water mark) once per call. Times are kept in QTimer ticks (19.2 MHz) and reported in microseconds.
+*/
+
+#define HEXKL_EXT_QTIMER_MHZ_X10 (192U)
+
+static struct {
+  atomic_uint_fast64_t n_matmuls;
+  atomic_uint_fast64_t n_macs;
+  atomic_uint_fast64_t bytes_to_vtcm;
+  atomic_uint_fast64_t bytes_from_vtcm;
+  atomic_uint_fast64_t act_load_ticks;
+  atomic_uint_fast64_t hmx_ticks;
+  atomic_uint_fast64_t acc_read_ticks;
+  atomic_uint_fast64_t store_ticks;
+  atomic_uint_fast64_t bytes_streamed;
+  atomic_uint_fast64_t gemv_ticks;
+  atomic_uint_fast64_t vtcm_high_water;
+} g_stats;
+
+static void add(atomic_uint_fast64_t* counter, uint64_t value) {
+  atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static void update_max(atomic_uint_fast64_t* counter, uint64_t value) {
+  uint_fast64_t current = atomic_load_explicit(counter, memory_order_relaxed);
+
+  while (current < value &&
+         !atomic_compare_exchange_weak_explicit(counter, &current, value, memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+static uint64_t load_us(atomic_uint_fast64_t* ticks) {
+  return atomic_load_explicit(ticks, memory_order_relaxed) * 10 / HEXKL_EXT_QTIMER_MHZ_X10;
+}
+
+void hexkl_ext_stats_add_mm(const hexkl_ext_mm_counters_t* counters) {
+  add(&g_stats.n_matmuls, counters->n_matmuls);
+  add(&g_stats.n_macs, counters->n_macs);
+  add(&g_stats.bytes_to_vtcm, counters->bytes_to_vtcm);
+  add(&g_stats.bytes_from_vtcm, counters->bytes_from_vtcm);
+  add(&g_stats.act_load_ticks, counters->act_load_ticks);
+  add(&g_stats.hmx_ticks, counters->hmx_ticks);
+  add(&g_stats.acc_read_ticks, counters->acc_read_ticks);
+  add(&g_stats.store_ticks, counters->store_ticks);
+  add(&g_stats.bytes_streamed, counters->bytes_streamed);
+  add(&g_stats.gemv_ticks, counters->gemv_ticks);
+  update_max(&g_stats.vtcm_high_water, counters->vtcm_bytes);
+}
+
+int hexkl_macro_ext_get_stats(hexkl_macro_ext_stats_t* stats) {
+  if (stats == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  stats->n_matmuls       = atomic_load_explicit(&g_stats.n_matmuls, memory_order_relaxed);
+  stats->n_macs          = atomic_load_explicit(&g_stats.n_macs, memory_order_relaxed);
+  stats->bytes_to_vtcm   = atomic_load_explicit(&g_stats.bytes_to_vtcm, memory_order_relaxed);
+  stats->bytes_from_vtcm = atomic_load_explicit(&g_stats.bytes_from_vtcm, memory_order_relaxed);
+  stats->act_load_us     = load_us(&g_stats.act_load_ticks);
+  stats->hmx_us          = load_us(&g_stats.hmx_ticks);
+  stats->acc_read_us     = load_us(&g_stats.acc_read_ticks);
+  stats->store_us        = load_us(&g_stats.store_ticks);
+  stats->bytes_streamed  = atomic_load_explicit(&g_stats.bytes_streamed, memory_order_relaxed);
+  stats->gemv_us         = load_us(&g_stats.gemv_ticks);
+  stats->vtcm_high_water = atomic_load_explicit(&g_stats.vtcm_high_water, memory_order_relaxed);
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_reset_stats(void) {
+  atomic_store(&g_stats.n_matmuls, 0);
+  atomic_store(&g_stats.n_macs, 0);
+  atomic_store(&g_stats.bytes_to_vtcm, 0);
+  atomic_store(&g_stats.bytes_from_vtcm, 0);
+  atomic_store(&g_stats.act_load_ticks, 0);
+  atomic_store(&g_stats.hmx_ticks, 0);
+  atomic_store(&g_stats.acc_read_ticks, 0);
+  atomic_store(&g_stats.store_ticks, 0);
+  atomic_store(&g_stats.bytes_streamed, 0);
+  atomic_store(&g_stats.gemv_ticks, 0);
+  atomic_store(&g_stats.vtcm_high_water, 0);
+
+  return AEE_SUCCESS;
+}
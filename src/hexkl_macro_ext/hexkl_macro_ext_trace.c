@@ -0,0 +1,189 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "HAP_perf.h"
+#include "qurt.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  Span recorder on the NPU, same scheme as the sdkl_ext one: writers claim a slot with one atomic increment of the
+  head and publish the span through the slot's sequence number; the dump skips slots that were overwritten or are
+  being written.
+
+  Timestamps are QTimer ticks (19.2 MHz), converted to nanoseconds when dumped.
+*/
+
+#define HEXKL_EXT_TRACE_MAX_EVENTS (1U << 20)
+#define HEXKL_EXT_QTIMER_MHZ_X10   (192U)
+
+typedef struct {
+  atomic_uint_fast64_t seq;
+  const char* name;
+  const char* category;
+  uint64_t ts;
+  uint64_t dur;
+  uint32_t tid;
+} hexkl_ext_trace_slot_t;
+
+atomic_int hexkl_ext_trace_enabled;
+
+static struct {
+  hexkl_ext_trace_slot_t* slots;
+  uint64_t mask;
+  atomic_uint_fast64_t head;
+} g_trace;
+
+int hexkl_macro_ext_trace_start(uint32_t n_events) {
+  uint64_t capacity = 1;
+
+  if (n_events == 0 || n_events > HEXKL_EXT_TRACE_MAX_EVENTS) {
+    return AEE_EBADPARM;
+  }
+  while (capacity < n_events) {
+    capacity <<= 1;
+  }
+
+  atomic_store(&hexkl_ext_trace_enabled, 0);
+  free(g_trace.slots);
+  g_trace.slots = calloc(capacity, sizeof(hexkl_ext_trace_slot_t));
+  if (g_trace.slots == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  g_trace.mask = capacity - 1;
+  atomic_store(&g_trace.head, 0);
+  atomic_store(&hexkl_ext_trace_enabled, 1);
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_trace_stop(void) {
+  atomic_store(&hexkl_ext_trace_enabled, 0);
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_trace_finalize(void) {
+  atomic_store(&hexkl_ext_trace_enabled, 0);
+  free(g_trace.slots);
+  g_trace.slots = NULL;
+  atomic_store(&g_trace.head, 0);
+  return AEE_SUCCESS;
+}
+
+uint64_t hexkl_macro_ext_trace_begin(void) {
+  return atomic_load_explicit(&hexkl_ext_trace_enabled, memory_order_relaxed) ? HAP_perf_get_qtimer_count() : 0;
+}
+
+void hexkl_ext_trace_record(const char* name, const char* category, uint64_t begin, uint64_t end) {
+  uint64_t idx;
+  hexkl_ext_trace_slot_t* slot;
+
+  idx  = atomic_fetch_add_explicit(&g_trace.head, 1, memory_order_relaxed);
+  slot = &g_trace.slots[idx & g_trace.mask];
+
+  atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  slot->name     = name;
+  slot->category = category;
+  slot->ts       = begin;
+  slot->dur      = end - begin;
+  slot->tid      = (uint32_t)qurt_thread_get_id();
+  atomic_store_explicit(&slot->seq, idx + 1, memory_order_release);
+}
+
+void hexkl_macro_ext_trace_end(const char* name, const char* category, uint64_t begin) {
+  uint64_t end = HAP_perf_get_qtimer_count();
+
+  if (begin == 0 || !atomic_load_explicit(&hexkl_ext_trace_enabled, memory_order_relaxed)) {
+    return;
+  }
+  hexkl_ext_trace_record(name, category, begin, end);
+}
+
+/* Writes `s` as a JSON string. */
+static void write_string(FILE* f, const char* s) {
+  fputc('"', f);
+  for (; *s != '\0'; s++) {
+    if (*s == '"' || *s == '\\') {
+      fputc('\\', f);
+      fputc(*s, f);
+    } else if ((unsigned char)*s < 0x20) {
+      fprintf(f, "\\u%04x", (unsigned)*s);
+    } else {
+      fputc(*s, f);
+    }
+  }
+  fputc('"', f);
+}
+
+/* Writes `ticks` QTimer ticks as microseconds with three decimals. */
+static void write_us(FILE* f, uint64_t ticks) {
+  uint64_t ns = ticks * 10000 / HEXKL_EXT_QTIMER_MHZ_X10;
+
+  fprintf(f, "%llu.%03u", (unsigned long long)(ns / 1000), (unsigned)(ns % 1000));
+}
+
+int hexkl_macro_ext_trace_dump(const char* path) {
+  uint64_t head, first;
+  int ret;
+  FILE* f;
+
+  if (path == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  f = fopen(path, "w");
+  if (f == NULL) {
+    return AEE_EFAILED;
+  }
+
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"hexkl NPU\"}}");
+
+  if (g_trace.slots != NULL) {
+    head  = atomic_load(&g_trace.head);
+    first = head > g_trace.mask + 1 ? head - (g_trace.mask + 1) : 0;
+
+    for (uint64_t idx = first; idx < head; idx++) {
+      hexkl_ext_trace_slot_t* slot = &g_trace.slots[idx & g_trace.mask];
+      const char *name, *category;
+      uint64_t ts, dur;
+      uint32_t tid;
+
+      if (atomic_load_explicit(&slot->seq, memory_order_acquire) != idx + 1) {
+        continue;
+      }
+      name     = slot->name;
+      category = slot->category;
+      ts       = slot->ts;
+      dur      = slot->dur;
+      tid      = slot->tid;
+      atomic_thread_fence(memory_order_acquire);
+      if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != idx + 1) {
+        continue;
+      }
+
+      fprintf(f, ",\n{\"name\":");
+      write_string(f, name);
+      fprintf(f, ",\"cat\":");
+      write_string(f, category);
+      fprintf(f, ",\"ph\":\"X\",\"ts\":");
+      write_us(f, ts);
+      fprintf(f, ",\"dur\":");
+      write_us(f, dur);
+      fprintf(f, ",\"pid\":0,\"tid\":%u}", tid);
+    }
+  }
+
+  fprintf(f, "\n]}\n");
+  ret = ferror(f) ? AEE_EFAILED : AEE_SUCCESS;
+  if (fclose(f) != 0) {
+    ret = AEE_EFAILED;
+  }
+
+  return ret;
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hexkl_macro_ext_internal.h"
+
+/*
+  VTCM arena: a two-ended bump allocator of offsets. Tiles are allocated upwards from `low`, the HMX configuration
+  downwards from `high`; the free space is `low .. high`. A frame is a copy of both ends, restored when it ends.
+*/
+
+static const uint32_t g_class_alignment[HEXKL_VTCM_INVALID] = {
+  HEXKL_HMX_ACTIVATION_ALIGNMENT, // HEXKL_VTCM_ACTIVATION
+  HEXKL_HMX_WEIGHTS_ALIGNMENT,    // HEXKL_VTCM_WEIGHTS
+  HEXKL_HMX_CONFIG_ALIGNMENT,     // HEXKL_VTCM_CONFIG
+};
+
+int hexkl_macro_ext_vtcm_init(hexkl_vtcm_arena_t* arena, uint32_t vtcm_size) {
+  if (arena == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  arena->size       = vtcm_size;
+  arena->low        = 0;
+  arena->high       = vtcm_size;
+  arena->high_water = 0;
+
+  return AEE_SUCCESS;
+}
+
+uint32_t hexkl_macro_ext_vtcm_available(const hexkl_vtcm_arena_t* arena, hexkl_vtcm_class_e vtcm_class) {
+  uint64_t start;
+
+  if (arena == NULL || (uint32_t)vtcm_class >= HEXKL_VTCM_INVALID) {
+    return 0;
+  }
+
+  // From either end, the largest allocation is the free space past the first aligned offset above `low`
+  start = HEXKL_EXT_ALIGN_UP((uint64_t)arena->low, g_class_alignment[vtcm_class]);
+  return start < arena->high ? arena->high - (uint32_t)start : 0;
+}
+
+int hexkl_macro_ext_vtcm_alloc(
+  hexkl_vtcm_arena_t* arena,
+  hexkl_vtcm_class_e vtcm_class,
+  uint32_t size,
+  uint32_t* offset
+) {
+  uint32_t align, used;
+
+  if (arena == NULL || offset == NULL || (uint32_t)vtcm_class >= HEXKL_VTCM_INVALID || size == 0) {
+    return AEE_EBADPARM;
+  }
+  if (size > hexkl_macro_ext_vtcm_available(arena, vtcm_class)) {
+    return AEE_ENOMEMORY;
+  }
+
+  align = g_class_alignment[vtcm_class];
+  if (vtcm_class == HEXKL_VTCM_CONFIG) {
+    arena->high = HEXKL_EXT_ALIGN_DOWN(arena->high - size, align);
+    *offset     = arena->high;
+  } else {
+    *offset    = HEXKL_EXT_ALIGN_UP(arena->low, align);
+    arena->low = *offset + size;
+  }
+
+  used = arena->low + (arena->size - arena->high);
+  if (used > arena->high_water) {
+    arena->high_water = used;
+  }
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_vtcm_frame_begin(const hexkl_vtcm_arena_t* arena, hexkl_vtcm_frame_t* frame) {
+  if (arena == NULL || frame == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  frame->low  = arena->low;
+  frame->high = arena->high;
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_vtcm_frame_end(hexkl_vtcm_arena_t* arena, const hexkl_vtcm_frame_t* frame) {
+  if (arena == NULL || frame == NULL) {
+    return AEE_EBADPARM;
+  }
+  // An enclosing frame already ended and released allocations this one was made after
+  if (frame->low > arena->low || frame->high < arena->high) {
+    return AEE_EBADPARM;
+  }
+
+  arena->low  = frame->low;
+  arena->high = frame->high;
+
+  return AEE_SUCCESS;
+}
+
+int hexkl_macro_ext_vtcm_get_usage(const hexkl_vtcm_arena_t* arena, hexkl_vtcm_usage_t* usage) {
+  if (arena == NULL || usage == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  usage->size       = arena->size;
+  usage->used       = arena->low + (arena->size - arena->high);
+  usage->high_water = arena->high_water;
+
+  return AEE_SUCCESS;
+}
@@ -0,0 +1,332 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Per-shape strategy selection.
+
+  Decisions are kept in an array searched linearly: a model has a few dozen distinct shapes at most. Strategies are
+  benchmarked without holding the lock; if two threads tune the same shape at once, the first decision is kept.
+  Each new decision is appended to the cache file as one line of decimal fields.
+*/
+
+#define SDKL_AUTOTUNE_FILE_HEADER \
+  "# sdkl_autotune v1: n_row n_col n_inner x_dtype w_dtype r_dtype w_layout platform strategies strategy\n"
+
+typedef struct {
+  uint64_t n_row;
+  uint64_t n_col;
+  uint64_t n_inner;
+  uint32_t x_dtype;
+  uint32_t w_dtype;
+  uint32_t r_dtype;
+  uint32_t w_layout;
+  uint32_t platform;
+  uint32_t strategies; // bit mask of the applicable strategies
+} sdkl_autotune_key_t;
+
+typedef struct {
+  sdkl_autotune_key_t key;
+  sdkl_autotune_strategy_e strategy;
+} sdkl_autotune_entry_t;
+
+static struct {
+  pthread_mutex_t lock;
+  uint32_t initialized;
+  char* path; // cache file, NULL if decisions are kept in memory only
+  sdkl_autotune_entry_t* entries;
+  size_t n_entries;
+  size_t capacity;
+} g_autotune = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/* Returns the decision for `key`, or NULL. Called with the lock held. */
+static const sdkl_autotune_entry_t* find_entry(const sdkl_autotune_key_t* key) {
+  for (size_t e = 0; e < g_autotune.n_entries; e++) {
+    if (memcmp(&g_autotune.entries[e].key, key, sizeof(*key)) == 0) {
+      return &g_autotune.entries[e];
+    }
+  }
+  return NULL;
+}
+
+/* Records a decision in memory. Called with the lock held. */
+static int add_entry(const sdkl_autotune_key_t* key, sdkl_autotune_strategy_e strategy) {
+  if (g_autotune.n_entries == g_autotune.capacity) {
+    size_t capacity                = g_autotune.capacity ? 2 * g_autotune.capacity : 16;
+    sdkl_autotune_entry_t* entries = realloc(g_autotune.entries, capacity * sizeof(*entries));
+
+    if (entries == NULL) {
+      return AEE_ENOMEMORY;
+    }
+    g_autotune.entries  = entries;
+    g_autotune.capacity = capacity;
+  }
+
+  g_autotune.entries[g_autotune.n_entries].key      = *key;
+  g_autotune.entries[g_autotune.n_entries].strategy = strategy;
+  g_autotune.n_entries++;
+  return AEE_SUCCESS;
+}
+
+/* Appends a decision to the cache file, if any. Failures only lose persistence. Called with the lock held. */
+static void append_entry(const sdkl_autotune_key_t* key, sdkl_autotune_strategy_e strategy) {
+  FILE* f;
+
+  if (g_autotune.path == NULL || (f = fopen(g_autotune.path, "a")) == NULL) {
+    return;
+  }
+  if (ftell(f) == 0) {
+    fputs(SDKL_AUTOTUNE_FILE_HEADER, f);
+  }
+  fprintf(
+    f,
+    "%llu %llu %llu %u %u %u %u %u %u %u\n",
+    (unsigned long long)key->n_row,
+    (unsigned long long)key->n_col,
+    (unsigned long long)key->n_inner,
+    key->x_dtype,
+    key->w_dtype,
+    key->r_dtype,
+    key->w_layout,
+    key->platform,
+    key->strategies,
+    (unsigned int)strategy
+  );
+  fclose(f);
+}
+
+/* Parses one line of the cache file. Returns 0 for comments and malformed lines. */
+static int parse_entry(const char* line, sdkl_autotune_key_t* key, sdkl_autotune_strategy_e* strategy) {
+  unsigned long long n_row, n_col, n_inner;
+  unsigned int s;
+
+  memset(key, 0, sizeof(*key));
+  if (sscanf(
+        line,
+        "%llu %llu %llu %u %u %u %u %u %u %u",
+        &n_row,
+        &n_col,
+        &n_inner,
+        &key->x_dtype,
+        &key->w_dtype,
+        &key->r_dtype,
+        &key->w_layout,
+        &key->platform,
+        &key->strategies,
+        &s
+      ) != 10 ||
+      s >= SDKL_AUTOTUNE_INVALID || !(key->strategies & (1U << s))) {
+    return 0;
+  }
+
+  key->n_row   = n_row;
+  key->n_col   = n_col;
+  key->n_inner = n_inner;
+  *strategy    = (sdkl_autotune_strategy_e)s;
+  return 1;
+}
+
+int sdkl_autotune_initialize(const char* cache_path) {
+  sdkl_autotune_key_t key;
+  sdkl_autotune_strategy_e strategy;
+  char line[256];
+  FILE* f;
+  int ret = AEE_SUCCESS;
+
+  pthread_mutex_lock(&g_autotune.lock);
+  if (g_autotune.initialized) {
+    pthread_mutex_unlock(&g_autotune.lock);
+    return AEE_EBADSTATE;
+  }
+
+  if (cache_path != NULL) {
+    g_autotune.path = strdup(cache_path);
+    if (g_autotune.path == NULL) {
+      pthread_mutex_unlock(&g_autotune.lock);
+      return AEE_ENOMEMORY;
+    }
+
+    f = fopen(cache_path, "r");
+    if (f != NULL) {
+      while (ret == AEE_SUCCESS && fgets(line, sizeof(line), f) != NULL) {
+        if (parse_entry(line, &key, &strategy) && find_entry(&key) == NULL) {
+          ret = add_entry(&key, strategy);
+        }
+      }
+      fclose(f);
+    }
+  }
+
+  g_autotune.initialized = 1;
+  pthread_mutex_unlock(&g_autotune.lock);
+
+  return ret;
+}
+
+int sdkl_autotune_finalize(void) {
+  pthread_mutex_lock(&g_autotune.lock);
+  free(g_autotune.entries);
+  free(g_autotune.path);
+  g_autotune.entries     = NULL;
+  g_autotune.path        = NULL;
+  g_autotune.n_entries   = 0;
+  g_autotune.capacity    = 0;
+  g_autotune.initialized = 0;
+  pthread_mutex_unlock(&g_autotune.lock);
+
+  return AEE_SUCCESS;
+}
+
+static int run_strategy(
+  sdkl_autotune_strategy_e strategy,
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor,
+  const sdkl_tensor_t* prelaid_tensor
+) {
+  switch (strategy) {
+    case SDKL_AUTOTUNE_CPU:
+      return sdkl_cpu_mm_tensor(result_tensor, left_tensor, right_tensor);
+    case SDKL_AUTOTUNE_NPU:
+      return sdkl_ext_mm_tensor(platform, result_tensor, left_tensor, right_tensor);
+    default:
+      return sdkl_ext_mm_tensor(platform, result_tensor, left_tensor, prelaid_tensor);
+  }
+}
+
+/*
+  Benchmarks the strategies of `key->strategies` and returns the fastest in `best`, with the fastest run of each in
+  us[]. Strategies failing their warm-up run are skipped; returns the last failure if all of them fail.
+*/
+static int tune(
+  const sdkl_autotune_key_t* key,
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor,
+  const sdkl_tensor_t* prelaid_tensor,
+  sdkl_autotune_strategy_e* best,
+  uint64_t us[SDKL_AUTOTUNE_INVALID]
+) {
+  int ret = AEE_EUNSUPPORTED;
+
+  *best = SDKL_AUTOTUNE_INVALID;
+  for (int s = 0; s < (int)SDKL_AUTOTUNE_INVALID; s++) {
+    sdkl_autotune_strategy_e strategy = (sdkl_autotune_strategy_e)s;
+    uint64_t fastest                  = UINT64_MAX;
+    int run_ret;
+
+    us[s] = 0;
+    if (!(key->strategies & (1U << s))) {
+      continue;
+    }
+
+    run_ret = run_strategy(strategy, platform, result_tensor, left_tensor, right_tensor, prelaid_tensor);
+    for (uint32_t rep = 0; run_ret == AEE_SUCCESS && rep < SDKL_AUTOTUNE_REPS; rep++) {
+      uint64_t start = sdkl_ext_time_us();
+
+      run_ret = run_strategy(strategy, platform, result_tensor, left_tensor, right_tensor, prelaid_tensor);
+      fastest = SDKL_EXT_MIN(fastest, sdkl_ext_time_us() - start);
+    }
+    if (run_ret != AEE_SUCCESS) {
+      ret = run_ret;
+      continue;
+    }
+
+    us[s] = SDKL_EXT_MAX(fastest, 1);
+    if (*best == SDKL_AUTOTUNE_INVALID || us[s] < us[*best]) {
+      *best = strategy;
+    }
+  }
+
+  return *best != SDKL_AUTOTUNE_INVALID ? AEE_SUCCESS : ret;
+}
+
+int sdkl_ext_mm_tensor_autotune(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  const sdkl_weights_t* prelaid,
+  sdkl_autotune_info_t* info
+) {
+  const sdkl_autotune_entry_t* entry;
+  sdkl_autotune_strategy_e strategy;
+  sdkl_autotune_key_t key;
+  sdkl_cpu_gemm_args_t args;
+  sdkl_tensor_t prelaid_tensor;
+  uint64_t us[SDKL_AUTOTUNE_INVALID] = {0};
+  uint32_t tuned                     = 0;
+  int ret;
+
+  if (platform != SDKL_PLATFORM_NPU0 && platform != SDKL_PLATFORM_NPU1) {
+    return AEE_EBADPARM;
+  }
+  ret = sdkl_mm_tensor_validate(result_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  memset(&key, 0, sizeof(key));
+  key.n_row      = result_tensor->dims[0];
+  key.n_col      = result_tensor->dims[1];
+  key.n_inner    = left_tensor->dims[1];
+  key.x_dtype    = left_tensor->data_dtype;
+  key.w_dtype    = right_tensor->data_dtype;
+  key.r_dtype    = result_tensor->data_dtype;
+  key.w_layout   = right_tensor->layout;
+  key.platform   = platform;
+  key.strategies = 1U << SDKL_AUTOTUNE_NPU;
+
+  if (sdkl_cpu_gemm_args_from_tensors(&args, result_tensor, left_tensor, right_tensor) == AEE_SUCCESS) {
+    key.strategies |= 1U << SDKL_AUTOTUNE_CPU;
+  }
+  if (prelaid != NULL) {
+    sdkl_weights_info_t weights_info;
+
+    if (sdkl_weights_get_info(prelaid, &weights_info) != AEE_SUCCESS || weights_info.domain != (int)platform) {
+      return AEE_EBADPARM;
+    }
+    sdkl_weights_to_tensor(prelaid, &prelaid_tensor);
+    key.strategies |= 1U << SDKL_AUTOTUNE_NPU_PRELAID;
+  }
+
+  pthread_mutex_lock(&g_autotune.lock);
+  entry    = find_entry(&key);
+  strategy = entry != NULL ? entry->strategy : SDKL_AUTOTUNE_INVALID;
+  pthread_mutex_unlock(&g_autotune.lock);
+
+  if (strategy != SDKL_AUTOTUNE_INVALID) {
+    ret = run_strategy(strategy, platform, result_tensor, left_tensor, right_tensor, &prelaid_tensor);
+  } else if ((key.strategies & (key.strategies - 1)) == 0) {
+    // A single strategy applies, nothing to tune
+    strategy = SDKL_AUTOTUNE_NPU;
+    ret      = run_strategy(strategy, platform, result_tensor, left_tensor, right_tensor, &prelaid_tensor);
+  } else {
+    ret = tune(&key, platform, result_tensor, left_tensor, right_tensor, &prelaid_tensor, &strategy, us);
+    if (ret == AEE_SUCCESS) {
+      tuned = 1;
+      pthread_mutex_lock(&g_autotune.lock);
+      if (find_entry(&key) == NULL && add_entry(&key, strategy) == AEE_SUCCESS) {
+        append_entry(&key, strategy);
+      }
+      pthread_mutex_unlock(&g_autotune.lock);
+    }
+  }
+
+  if (info != NULL) {
+    info->strategy = strategy;
+    info->tuned    = tuned;
+    memcpy(info->us, us, sizeof(us));
+  }
+
+  return ret;
+}
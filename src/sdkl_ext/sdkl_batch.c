@@ -0,0 +1,177 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  libsdkl issues one FastRPC invocation per sdkl_mm_tensor() call and the skeleton cannot be extended, so a batch
+  cannot be folded into a single remote call. What a batch can amortize on the host is the per-call work around
+  the invocation: descriptors are validated once up front, and buffers shared by several items are mapped on the
+  DSP once instead of on every invocation.
+*/
+
+typedef struct {
+  void* data;
+  size_t size;   // bytes referenced from `data`
+  uint32_t refs; // number of tensors referencing the buffer
+  int fd;        // -1 if not mapped
+} sdkl_batch_buffer_t;
+
+static size_t tensor_bytes(const sdkl_tensor_t* t) {
+  uint64_t n_elem = t->data_offset + t->num_elements;
+  size_t size     = sdkl_ext_dtype_size(t->data_dtype);
+
+  if (t->num_elements == 0) {
+    return 0;
+  }
+  if (t->data_dtype == SDKL_DTYPE_I4) {
+    return (size_t)((n_elem + 1) / 2);
+  }
+  return (size_t)(n_elem * size);
+}
+
+static int validate_item(
+  sdkl_tensor_platform_e platform,
+  const sdkl_tensor_t* r,
+  const sdkl_tensor_t* x,
+  const sdkl_tensor_t* w
+) {
+  if (platform == SDKL_PLATFORM_CPU) {
+    sdkl_cpu_gemm_args_t args;
+    return sdkl_cpu_gemm_args_from_tensors(&args, r, x, w);
+  }
+
+  // The NPU implementation performs the full validation; reject what would fail in the middle of the batch
+  if (r->data == NULL || x->data == NULL || w->data == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (r->ndims != 2 || x->ndims != 2 || w->ndims != 2) {
+    return AEE_EBADPARM;
+  }
+
+  uint64_t m = r->dims[0], n = r->dims[1], k = x->dims[1];
+  if (m == 0 || n == 0 || k == 0 || x->dims[0] != m) {
+    return AEE_EBADPARM;
+  }
+  if (!((w->dims[0] == k && w->dims[1] == n) || (w->dims[0] == n && w->dims[1] == k))) {
+    return AEE_EBADPARM;
+  }
+
+  return AEE_SUCCESS;
+}
+
+/* Adds the buffer of `t` to `bufs`, merging references to the same base address. */
+static void add_buffer(sdkl_batch_buffer_t* bufs, size_t* n_bufs, const sdkl_tensor_t* t) {
+  size_t size = tensor_bytes(t);
+
+  for (size_t b = 0; b < *n_bufs; b++) {
+    if (bufs[b].data == t->data) {
+      bufs[b].size = SDKL_EXT_MAX(bufs[b].size, size);
+      bufs[b].refs++;
+      return;
+    }
+  }
+
+  bufs[*n_bufs].data = t->data;
+  bufs[*n_bufs].size = size;
+  bufs[*n_bufs].refs = 1;
+  bufs[*n_bufs].fd   = -1;
+  (*n_bufs)++;
+}
+
+int sdkl_mm_tensor_batched(
+  sdkl_tensor_platform_e platform,
+  size_t n,
+  sdkl_tensor_t* results,
+  const sdkl_tensor_t* lefts,
+  const sdkl_tensor_t* rights,
+  uint64_t* item_us,
+  sdkl_batch_timing_t* timing
+) {
+  uint64_t t_start          = sdkl_ext_time_us();
+  uint64_t map_us           = 0;
+  uint32_t n_mapped         = 0;
+  sdkl_batch_buffer_t* bufs = NULL;
+  size_t n_bufs             = 0;
+  int ret                   = AEE_SUCCESS;
+
+  if (n == 0 || results == NULL || lefts == NULL || rights == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (platform != SDKL_PLATFORM_CPU && platform != SDKL_PLATFORM_NPU0 && platform != SDKL_PLATFORM_NPU1) {
+    return AEE_EBADPARM;
+  }
+
+  if (item_us != NULL) {
+    memset(item_us, 0, n * sizeof(*item_us));
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    ret = validate_item(platform, &results[i], &lefts[i], &rights[i]);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+  }
+
+  // Map shared buffers for the duration of the batch. Buffers used once gain nothing from an explicit mapping.
+  if (platform != SDKL_PLATFORM_CPU && n > 1) {
+    bufs = malloc(3 * n * sizeof(*bufs));
+    if (bufs != NULL) {
+      uint64_t t_map = sdkl_ext_time_us();
+
+      for (size_t i = 0; i < n; i++) {
+        add_buffer(bufs, &n_bufs, &results[i]);
+        add_buffer(bufs, &n_bufs, &lefts[i]);
+        add_buffer(bufs, &n_bufs, &rights[i]);
+      }
+      for (size_t b = 0; b < n_bufs; b++) {
+        if (bufs[b].refs < 2 || bufs[b].size == 0) {
+          continue;
+        }
+        // A failed mapping is not fatal: FastRPC then maps the buffer on each call
+        if (sdkl_ext_npu_map((int)platform, bufs[b].data, bufs[b].size, &bufs[b].fd) != AEE_SUCCESS) {
+          bufs[b].fd = -1;
+        } else if (bufs[b].fd >= 0) {
+          n_mapped++;
+        }
+      }
+      map_us += sdkl_ext_time_us() - t_map;
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    uint64_t t_item = sdkl_ext_time_us();
+
+    ret = sdkl_ext_mm_tensor(platform, &results[i], &lefts[i], &rights[i]);
+    if (item_us != NULL) {
+      item_us[i] = sdkl_ext_time_us() - t_item;
+    }
+    if (ret != AEE_SUCCESS) {
+      break;
+    }
+  }
+
+  if (bufs != NULL) {
+    uint64_t t_unmap = sdkl_ext_time_us();
+
+    for (size_t b = 0; b < n_bufs; b++) {
+      if (bufs[b].fd >= 0) {
+        sdkl_ext_npu_unmap((int)platform, bufs[b].fd, bufs[b].data, bufs[b].size);
+      }
+    }
+    free(bufs);
+    map_us += sdkl_ext_time_us() - t_unmap;
+  }
+
+  if (timing != NULL) {
+    timing->total_us = sdkl_ext_time_us() - t_start;
+    timing->map_us   = map_us;
+    timing->n_mapped = n_mapped;
+  }
+
+  return ret;
+}
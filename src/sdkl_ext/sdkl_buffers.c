@@ -0,0 +1,139 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include "rpcmem.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Registry of caller-owned buffers.
+
+  remote_register_buf() tells FastRPC the file descriptor behind an address range, so invocations passing pointers
+  into the range share the memory with the DSP instead of copying it. The range is also mapped on the DSP with
+  fastrpc_mmap() for as long as it is registered, so invocations skip the per-call mapping.
+*/
+
+typedef struct sdkl_registered_buffer {
+  struct sdkl_registered_buffer* next;
+  int domain;
+  uint8_t* buffer;
+  size_t size;
+  int fd;
+  uint32_t refs;
+} sdkl_registered_buffer_t;
+
+static pthread_mutex_t g_registry_lock        = PTHREAD_MUTEX_INITIALIZER;
+static sdkl_registered_buffer_t* g_registered = NULL;
+
+/* Returns the registration of `domain` overlapping `buffer .. buffer + size`, or NULL. Called with the lock held. */
+static sdkl_registered_buffer_t* find_overlap(int domain, const uint8_t* buffer, size_t size) {
+  for (sdkl_registered_buffer_t* r = g_registered; r != NULL; r = r->next) {
+    if (r->domain == domain && buffer < r->buffer + r->size && r->buffer < buffer + size) {
+      return r;
+    }
+  }
+  return NULL;
+}
+
+int sdkl_ext_npu_is_registered(int domain, const void* buffer, size_t size) {
+  const uint8_t* p = (const uint8_t*)buffer;
+  sdkl_registered_buffer_t* r;
+  int found;
+
+  pthread_mutex_lock(&g_registry_lock);
+  r     = find_overlap(domain, p, size);
+  found = r != NULL && p >= r->buffer && p + size <= r->buffer + r->size;
+  pthread_mutex_unlock(&g_registry_lock);
+
+  return found;
+}
+
+int sdkl_npu_register_buffer(int domain, void* buffer, size_t size, int fd) {
+  sdkl_registered_buffer_t* r;
+  int ret;
+
+  if (buffer == NULL || size == 0 || size > INT_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  if (fd < 0) {
+    // Only rpcmem (sdkl_npu_alloc) buffers have a file descriptor known to the library
+    fd = rpcmem_to_fd(buffer);
+    if (fd < 0) {
+      return AEE_EUNSUPPORTED;
+    }
+  }
+
+  pthread_mutex_lock(&g_registry_lock);
+
+  r = find_overlap(domain, buffer, size);
+  if (r != NULL) {
+    ret = AEE_EBADPARM;
+    if (r->buffer == buffer && r->size == size && r->fd == fd) {
+      r->refs++;
+      ret = AEE_SUCCESS;
+    }
+    pthread_mutex_unlock(&g_registry_lock);
+    return ret;
+  }
+
+  r = malloc(sizeof(*r));
+  if (r == NULL) {
+    pthread_mutex_unlock(&g_registry_lock);
+    return AEE_ENOMEMORY;
+  }
+
+  remote_register_buf(buffer, (int)size, fd);
+  ret = fastrpc_mmap(domain, fd, buffer, 0, size, FASTRPC_MAP_FD);
+  if (ret != AEE_SUCCESS) {
+    remote_register_buf(buffer, (int)size, -1);
+    pthread_mutex_unlock(&g_registry_lock);
+    free(r);
+    return ret;
+  }
+
+  r->domain    = domain;
+  r->buffer    = buffer;
+  r->size      = size;
+  r->fd        = fd;
+  r->refs      = 1;
+  r->next      = g_registered;
+  g_registered = r;
+
+  pthread_mutex_unlock(&g_registry_lock);
+  return AEE_SUCCESS;
+}
+
+int sdkl_npu_unregister_buffer(int domain, void* buffer) {
+  sdkl_registered_buffer_t** link;
+  sdkl_registered_buffer_t* r = NULL;
+  int ret                     = AEE_SUCCESS;
+
+  pthread_mutex_lock(&g_registry_lock);
+
+  for (link = &g_registered; *link != NULL; link = &(*link)->next) {
+    if ((*link)->domain == domain && (*link)->buffer == buffer) {
+      r = *link;
+      break;
+    }
+  }
+  if (r == NULL) {
+    pthread_mutex_unlock(&g_registry_lock);
+    return AEE_ENOSUCH;
+  }
+
+  if (--r->refs == 0) {
+    *link = r->next;
+    ret   = fastrpc_munmap(domain, r->fd, r->buffer, r->size);
+    remote_register_buf(r->buffer, (int)r->size, -1);
+    free(r);
+  }
+
+  pthread_mutex_unlock(&g_registry_lock);
+  return ret;
+}
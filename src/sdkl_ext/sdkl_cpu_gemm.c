@@ -0,0 +1,1065 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Cache-blocked GEMM for the CPU platform: A = X * W^T.
+
+  The output is split into MC x NC tiles, one pool task per tile. Each task walks the inner
+  dimension in KC blocks; for every block it packs X into MR-row panels and W into NR-column
+  panels (k-major, zero padded), then runs the MR x NR micro-kernel over all panel pairs,
+  accumulating into a per-thread FP32/INT32 tile. The tile is converted to the output type once,
+  after the last block, so FP16 outputs are rounded only once. An epilogue, if any, is applied to
+  the FP32 tile right before that conversion. Quantized U8 x I8 products are dequantized from the
+  INT32 tile into an FP32 tile at the end of every quantization group.
+
+  Micro-kernels:
+  - NEON:   FP32 8x8 (vfmaq_laneq_f32); U8xI8 8x8 with USDOT when built with +i8mm.
+  - AVX2:   FP32 6x16 (FMA); U8xI8 4x16 with VPMADDWD on operands widened to int16.
+  - C:      4x4 fallbacks for both.
+  FP16 operands are widened to FP32 while packing.
+
+  Float products of at most SDKL_CPU_GEMV_MAX_ROWS rows (token generation) take a GEMV path instead: packing W and
+  padding X to MR rows would cost as much as the product itself, which is bound by the weight bandwidth. Each task
+  owns NC output columns and streams their weight rows once, unpacked, prefetching a few rows ahead, and dots every
+  row with all activation rows, kept as FP32 in L1 one KC block at a time.
+*/
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SDKL_CPU_F32_MR (8U)
+#define SDKL_CPU_F32_NR (8U)
+#elif defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define SDKL_CPU_F32_MR (6U)
+#define SDKL_CPU_F32_NR (16U)
+#else
+#define SDKL_CPU_F32_MR (4U)
+#define SDKL_CPU_F32_NR (4U)
+#endif
+
+#if defined(__ARM_NEON) && defined(__ARM_FEATURE_MATMUL_INT8)
+#define SDKL_CPU_I8_MR (8U)
+#define SDKL_CPU_I8_NR (8U)
+#define SDKL_CPU_I8_KU (4U) // k values interleaved per packed group, stored as bytes
+typedef uint8_t sdkl_cpu_i8_pack_t;
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define SDKL_CPU_I8_MR (4U)
+#define SDKL_CPU_I8_NR (16U)
+#define SDKL_CPU_I8_KU (2U) // k values interleaved per packed group, stored as int16
+typedef int16_t sdkl_cpu_i8_pack_t;
+#else
+#define SDKL_CPU_I8_MR (4U)
+#define SDKL_CPU_I8_NR (4U)
+#define SDKL_CPU_I8_KU (2U)
+typedef int16_t sdkl_cpu_i8_pack_t;
+#endif
+
+// Blocking parameters. KC must be a multiple of every KU, NC a multiple of every NR.
+#define SDKL_CPU_KC (256U)
+#define SDKL_CPU_NC (128U)
+#define SDKL_CPU_MC (64U)
+
+// GEMV path: largest row count it takes, and how many weight rows ahead of the current one are prefetched
+#define SDKL_CPU_GEMV_MAX_ROWS (8U)
+#define SDKL_CPU_GEMV_PREFETCH (4U)
+
+typedef struct {
+  const sdkl_cpu_gemm_args_t* args; // batch items, all of the same shape
+  size_t mc;                        // rows per task, multiple of MR
+  size_t n_ntiles;                  // number of NC-wide column tiles
+  size_t n_item_tasks;              // number of tasks per batch item
+  atomic_int error;
+} sdkl_cpu_gemm_job_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+  FP32 micro-kernels: c[MR][ldc] += ap[kc][MR] * bp[kc][NR]
+---------------------------------------------------------------------------------------------------------------------*/
+
+#if defined(__ARM_NEON)
+
+#define SDKL_CPU_F32_ROW(r, a, lane) \
+  c##r##0 = vfmaq_laneq_f32(c##r##0, b0, a, lane); \
+  c##r##1 = vfmaq_laneq_f32(c##r##1, b1, a, lane)
+
+static void kernel_f32(size_t kc, const float* restrict ap, const float* restrict bp, float* restrict c, size_t ldc) {
+  float32x4_t c00 = vld1q_f32(c + 0 * ldc), c01 = vld1q_f32(c + 0 * ldc + 4);
+  float32x4_t c10 = vld1q_f32(c + 1 * ldc), c11 = vld1q_f32(c + 1 * ldc + 4);
+  float32x4_t c20 = vld1q_f32(c + 2 * ldc), c21 = vld1q_f32(c + 2 * ldc + 4);
+  float32x4_t c30 = vld1q_f32(c + 3 * ldc), c31 = vld1q_f32(c + 3 * ldc + 4);
+  float32x4_t c40 = vld1q_f32(c + 4 * ldc), c41 = vld1q_f32(c + 4 * ldc + 4);
+  float32x4_t c50 = vld1q_f32(c + 5 * ldc), c51 = vld1q_f32(c + 5 * ldc + 4);
+  float32x4_t c60 = vld1q_f32(c + 6 * ldc), c61 = vld1q_f32(c + 6 * ldc + 4);
+  float32x4_t c70 = vld1q_f32(c + 7 * ldc), c71 = vld1q_f32(c + 7 * ldc + 4);
+
+  for (size_t k = 0; k < kc; k++) {
+    float32x4_t b0 = vld1q_f32(bp);
+    float32x4_t b1 = vld1q_f32(bp + 4);
+    float32x4_t a0 = vld1q_f32(ap);
+    float32x4_t a1 = vld1q_f32(ap + 4);
+
+    SDKL_CPU_F32_ROW(0, a0, 0);
+    SDKL_CPU_F32_ROW(1, a0, 1);
+    SDKL_CPU_F32_ROW(2, a0, 2);
+    SDKL_CPU_F32_ROW(3, a0, 3);
+    SDKL_CPU_F32_ROW(4, a1, 0);
+    SDKL_CPU_F32_ROW(5, a1, 1);
+    SDKL_CPU_F32_ROW(6, a1, 2);
+    SDKL_CPU_F32_ROW(7, a1, 3);
+
+    ap += SDKL_CPU_F32_MR;
+    bp += SDKL_CPU_F32_NR;
+  }
+
+  vst1q_f32(c + 0 * ldc, c00), vst1q_f32(c + 0 * ldc + 4, c01);
+  vst1q_f32(c + 1 * ldc, c10), vst1q_f32(c + 1 * ldc + 4, c11);
+  vst1q_f32(c + 2 * ldc, c20), vst1q_f32(c + 2 * ldc + 4, c21);
+  vst1q_f32(c + 3 * ldc, c30), vst1q_f32(c + 3 * ldc + 4, c31);
+  vst1q_f32(c + 4 * ldc, c40), vst1q_f32(c + 4 * ldc + 4, c41);
+  vst1q_f32(c + 5 * ldc, c50), vst1q_f32(c + 5 * ldc + 4, c51);
+  vst1q_f32(c + 6 * ldc, c60), vst1q_f32(c + 6 * ldc + 4, c61);
+  vst1q_f32(c + 7 * ldc, c70), vst1q_f32(c + 7 * ldc + 4, c71);
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+static void kernel_f32(size_t kc, const float* restrict ap, const float* restrict bp, float* restrict c, size_t ldc) {
+  __m256 acc[SDKL_CPU_F32_MR][2];
+
+  for (size_t r = 0; r < SDKL_CPU_F32_MR; r++) {
+    acc[r][0] = _mm256_loadu_ps(c + r * ldc);
+    acc[r][1] = _mm256_loadu_ps(c + r * ldc + 8);
+  }
+
+  for (size_t k = 0; k < kc; k++) {
+    __m256 b0 = _mm256_loadu_ps(bp);
+    __m256 b1 = _mm256_loadu_ps(bp + 8);
+    for (size_t r = 0; r < SDKL_CPU_F32_MR; r++) {
+      __m256 a  = _mm256_broadcast_ss(ap + r);
+      acc[r][0] = _mm256_fmadd_ps(a, b0, acc[r][0]);
+      acc[r][1] = _mm256_fmadd_ps(a, b1, acc[r][1]);
+    }
+    ap += SDKL_CPU_F32_MR;
+    bp += SDKL_CPU_F32_NR;
+  }
+
+  for (size_t r = 0; r < SDKL_CPU_F32_MR; r++) {
+    _mm256_storeu_ps(c + r * ldc, acc[r][0]);
+    _mm256_storeu_ps(c + r * ldc + 8, acc[r][1]);
+  }
+}
+
+#else
+
+static void kernel_f32(size_t kc, const float* restrict ap, const float* restrict bp, float* restrict c, size_t ldc) {
+  float acc[SDKL_CPU_F32_MR][SDKL_CPU_F32_NR] = {0};
+
+  for (size_t k = 0; k < kc; k++) {
+    for (size_t r = 0; r < SDKL_CPU_F32_MR; r++) {
+      for (size_t j = 0; j < SDKL_CPU_F32_NR; j++) {
+        acc[r][j] += ap[r] * bp[j];
+      }
+    }
+    ap += SDKL_CPU_F32_MR;
+    bp += SDKL_CPU_F32_NR;
+  }
+
+  for (size_t r = 0; r < SDKL_CPU_F32_MR; r++) {
+    for (size_t j = 0; j < SDKL_CPU_F32_NR; j++) {
+      c[r * ldc + j] += acc[r][j];
+    }
+  }
+}
+
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------
+  U8 x I8 micro-kernels: c[MR][ldc] += ap[kc/KU][MR][KU] * bp[kc/KU][NR][KU]
+---------------------------------------------------------------------------------------------------------------------*/
+
+#if defined(__ARM_NEON) && defined(__ARM_FEATURE_MATMUL_INT8)
+
+static void kernel_i8(
+  size_t kc,
+  const sdkl_cpu_i8_pack_t* restrict ap,
+  const sdkl_cpu_i8_pack_t* restrict bp,
+  int32_t* restrict c,
+  size_t ldc
+) {
+  int32x4_t acc[SDKL_CPU_I8_MR][2];
+
+  for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+    acc[r][0] = vld1q_s32(c + r * ldc);
+    acc[r][1] = vld1q_s32(c + r * ldc + 4);
+  }
+
+  for (size_t k = 0; k < kc; k += SDKL_CPU_I8_KU) {
+    int8x16_t b0 = vld1q_s8((const int8_t*)bp);
+    int8x16_t b1 = vld1q_s8((const int8_t*)bp + 16);
+    for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+      uint32_t a_r;
+      memcpy(&a_r, ap + r * SDKL_CPU_I8_KU, sizeof(a_r));
+      uint8x16_t a = vreinterpretq_u8_u32(vdupq_n_u32(a_r));
+      acc[r][0]    = vusdotq_s32(acc[r][0], a, b0);
+      acc[r][1]    = vusdotq_s32(acc[r][1], a, b1);
+    }
+    ap += SDKL_CPU_I8_MR * SDKL_CPU_I8_KU;
+    bp += SDKL_CPU_I8_NR * SDKL_CPU_I8_KU;
+  }
+
+  for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+    vst1q_s32(c + r * ldc, acc[r][0]);
+    vst1q_s32(c + r * ldc + 4, acc[r][1]);
+  }
+}
+
+#elif defined(__AVX2__)
+
+static void kernel_i8(
+  size_t kc,
+  const sdkl_cpu_i8_pack_t* restrict ap,
+  const sdkl_cpu_i8_pack_t* restrict bp,
+  int32_t* restrict c,
+  size_t ldc
+) {
+  __m256i acc[SDKL_CPU_I8_MR][2];
+
+  for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+    acc[r][0] = _mm256_loadu_si256((const __m256i*)(c + r * ldc));
+    acc[r][1] = _mm256_loadu_si256((const __m256i*)(c + r * ldc + 8));
+  }
+
+  for (size_t k = 0; k < kc; k += SDKL_CPU_I8_KU) {
+    __m256i b0 = _mm256_loadu_si256((const __m256i*)bp);
+    __m256i b1 = _mm256_loadu_si256((const __m256i*)(bp + 16));
+    for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+      int32_t a_r;
+      memcpy(&a_r, ap + r * SDKL_CPU_I8_KU, sizeof(a_r));
+      __m256i a = _mm256_set1_epi32(a_r);
+      acc[r][0] = _mm256_add_epi32(acc[r][0], _mm256_madd_epi16(a, b0));
+      acc[r][1] = _mm256_add_epi32(acc[r][1], _mm256_madd_epi16(a, b1));
+    }
+    ap += SDKL_CPU_I8_MR * SDKL_CPU_I8_KU;
+    bp += SDKL_CPU_I8_NR * SDKL_CPU_I8_KU;
+  }
+
+  for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+    _mm256_storeu_si256((__m256i*)(c + r * ldc), acc[r][0]);
+    _mm256_storeu_si256((__m256i*)(c + r * ldc + 8), acc[r][1]);
+  }
+}
+
+#else
+
+static void kernel_i8(
+  size_t kc,
+  const sdkl_cpu_i8_pack_t* restrict ap,
+  const sdkl_cpu_i8_pack_t* restrict bp,
+  int32_t* restrict c,
+  size_t ldc
+) {
+  int32_t acc[SDKL_CPU_I8_MR][SDKL_CPU_I8_NR] = {0};
+
+  for (size_t k = 0; k < kc; k += SDKL_CPU_I8_KU) {
+    for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+      for (size_t j = 0; j < SDKL_CPU_I8_NR; j++) {
+        for (size_t u = 0; u < SDKL_CPU_I8_KU; u++) {
+          acc[r][j] += (int32_t)ap[r * SDKL_CPU_I8_KU + u] * (int32_t)bp[j * SDKL_CPU_I8_KU + u];
+        }
+      }
+    }
+    ap += SDKL_CPU_I8_MR * SDKL_CPU_I8_KU;
+    bp += SDKL_CPU_I8_NR * SDKL_CPU_I8_KU;
+  }
+
+  for (size_t r = 0; r < SDKL_CPU_I8_MR; r++) {
+    for (size_t j = 0; j < SDKL_CPU_I8_NR; j++) {
+      c[r * ldc + j] += acc[r][j];
+    }
+  }
+}
+
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Packing
+---------------------------------------------------------------------------------------------------------------------*/
+
+/*
+  Packs `R` rows [r0, r0 + r_valid) x [k0, k0 + kc) of a matrix M(r, k) = src[r * rs + k * cs] into
+  dst[k][R] as FP32. Rows beyond `r_valid` are zero filled.
+*/
+static void pack_panel_f32(
+  float* restrict dst,
+  size_t R,
+  const void* src,
+  sdkl_tensor_dtype_e dtype,
+  size_t rs,
+  size_t cs,
+  size_t r0,
+  size_t r_valid,
+  size_t k0,
+  size_t kc
+) {
+  for (size_t r = 0; r < R; r++) {
+    float* d = dst + r;
+    if (r >= r_valid) {
+      for (size_t k = 0; k < kc; k++) {
+        d[k * R] = 0.0f;
+      }
+    } else if (dtype == SDKL_DTYPE_FP32) {
+      const float* s = (const float*)src + (r0 + r) * rs + k0 * cs;
+      for (size_t k = 0; k < kc; k++) {
+        d[k * R] = s[k * cs];
+      }
+    } else {
+      const _Float16* s = (const _Float16*)src + (r0 + r) * rs + k0 * cs;
+      for (size_t k = 0; k < kc; k++) {
+        d[k * R] = (float)s[k * cs];
+      }
+    }
+  }
+}
+
+/*
+  Packs `R` rows of an 8-bit matrix into dst[kc_pad / KU][R][KU]. `is_signed` selects the
+  interpretation of the source bytes. Padding rows and the k tail up to `kc_pad` are zero filled.
+*/
+static void pack_panel_i8(
+  sdkl_cpu_i8_pack_t* restrict dst,
+  size_t R,
+  const void* src,
+  bool is_signed,
+  size_t rs,
+  size_t cs,
+  size_t r0,
+  size_t r_valid,
+  size_t k0,
+  size_t kc,
+  size_t kc_pad
+) {
+  for (size_t r = 0; r < R; r++) {
+    sdkl_cpu_i8_pack_t* d = dst + r * SDKL_CPU_I8_KU;
+    size_t k              = 0;
+
+    if (r < r_valid) {
+      const uint8_t* s = (const uint8_t*)src + (r0 + r) * rs + k0 * cs;
+      for (; k < kc; k++) {
+        size_t idx = (k / SDKL_CPU_I8_KU) * R * SDKL_CPU_I8_KU + k % SDKL_CPU_I8_KU;
+        d[idx]     = is_signed ? (sdkl_cpu_i8_pack_t)(int8_t)s[k * cs] : (sdkl_cpu_i8_pack_t)s[k * cs];
+      }
+    }
+    for (; k < kc_pad; k++) {
+      d[(k / SDKL_CPU_I8_KU) * R * SDKL_CPU_I8_KU + k % SDKL_CPU_I8_KU] = 0;
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Tasks
+---------------------------------------------------------------------------------------------------------------------*/
+
+static void store_tile_f32(
+  const sdkl_cpu_gemm_args_t* args,
+  float* ct,
+  size_t i0,
+  size_t mc,
+  size_t j0,
+  size_t nc
+) {
+  for (size_t i = 0; i < mc; i++) {
+    float* src = ct + i * SDKL_CPU_NC;
+    if (args->epilogue != NULL) {
+      sdkl_cpu_epilogue_apply(args->epilogue, src, i0 + i, j0, nc);
+    }
+    if (args->a_dtype == SDKL_DTYPE_FP32) {
+      float* dst = (float*)args->a + (i0 + i) * args->a_rs + j0;
+      memcpy(dst, src, nc * sizeof(float));
+    } else {
+      _Float16* dst = (_Float16*)args->a + (i0 + i) * args->a_rs + j0;
+      for (size_t j = 0; j < nc; j++) {
+        dst[j] = (_Float16)src[j];
+      }
+    }
+  }
+}
+
+static void gemm_f32_task(void* ctx, uint32_t task, uint32_t thread_idx) {
+  sdkl_cpu_gemm_job_t* job         = (sdkl_cpu_gemm_job_t*)ctx;
+  const sdkl_cpu_gemm_args_t* args = job->args + task / job->n_item_tasks;
+  size_t tile                      = task % job->n_item_tasks;
+  size_t mt                        = tile / job->n_ntiles;
+  size_t nt                        = tile % job->n_ntiles;
+  size_t i0                        = mt * job->mc;
+  size_t j0                        = nt * SDKL_CPU_NC;
+  size_t mc                        = SDKL_EXT_MIN(job->mc, args->m - i0);
+  size_t nc                        = SDKL_EXT_MIN(SDKL_CPU_NC, args->n - j0);
+  size_t m_panels                  = (mc + SDKL_CPU_F32_MR - 1) / SDKL_CPU_F32_MR;
+  size_t n_panels                  = (nc + SDKL_CPU_F32_NR - 1) / SDKL_CPU_F32_NR;
+  size_t ap_size                   = job->mc * SDKL_CPU_KC;
+  size_t bp_size                   = SDKL_CPU_KC * SDKL_CPU_NC;
+  size_t ct_size                   = job->mc * SDKL_CPU_NC;
+
+  float* ap = (float*)sdkl_cpu_pool_scratch(thread_idx, (ap_size + bp_size + ct_size) * sizeof(float));
+  if (ap == NULL) {
+    atomic_store(&job->error, AEE_ENOMEMORY);
+    return;
+  }
+  float* bp = ap + ap_size;
+  float* ct = bp + bp_size;
+
+  memset(ct, 0, m_panels * SDKL_CPU_F32_MR * SDKL_CPU_NC * sizeof(float));
+
+  for (size_t k0 = 0; k0 < args->k; k0 += SDKL_CPU_KC) {
+    size_t kc     = SDKL_EXT_MIN(SDKL_CPU_KC, args->k - k0);
+    uint64_t span = sdkl_ext_trace_begin();
+
+    for (size_t p = 0; p < m_panels; p++) {
+      size_t r0 = i0 + p * SDKL_CPU_F32_MR;
+      pack_panel_f32(
+        ap + p * kc * SDKL_CPU_F32_MR,
+        SDKL_CPU_F32_MR,
+        args->x,
+        args->x_dtype,
+        args->x_rs,
+        args->x_cs,
+        r0,
+        SDKL_EXT_MIN(SDKL_CPU_F32_MR, i0 + mc - r0),
+        k0,
+        kc
+      );
+    }
+    for (size_t p = 0; p < n_panels; p++) {
+      size_t r0 = j0 + p * SDKL_CPU_F32_NR;
+      pack_panel_f32(
+        bp + p * kc * SDKL_CPU_F32_NR,
+        SDKL_CPU_F32_NR,
+        args->w,
+        args->w_dtype,
+        args->w_rs,
+        args->w_cs,
+        r0,
+        SDKL_EXT_MIN(SDKL_CPU_F32_NR, j0 + nc - r0),
+        k0,
+        kc
+      );
+    }
+    sdkl_ext_trace_end("cpu_pack", "cpu", span);
+
+    // Keep one W panel in L1 while streaming all X panels of the tile from L2
+    span = sdkl_ext_trace_begin();
+    for (size_t np = 0; np < n_panels; np++) {
+      for (size_t mp = 0; mp < m_panels; mp++) {
+        kernel_f32(
+          kc,
+          ap + mp * kc * SDKL_CPU_F32_MR,
+          bp + np * kc * SDKL_CPU_F32_NR,
+          ct + mp * SDKL_CPU_F32_MR * SDKL_CPU_NC + np * SDKL_CPU_F32_NR,
+          SDKL_CPU_NC
+        );
+      }
+    }
+    sdkl_ext_trace_end("cpu_kernel", "cpu", span);
+  }
+
+  uint64_t span = sdkl_ext_trace_begin();
+  store_tile_f32(args, ct, i0, mc, j0, nc);
+  sdkl_ext_trace_end("cpu_store", "cpu", span);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+  GEMV: sums[r] = xp[r][0 .. kc) . w[0 .. kc) for r < m, xp rows SDKL_CPU_KC apart
+---------------------------------------------------------------------------------------------------------------------*/
+
+#if defined(__ARM_NEON)
+
+static void dot_rows_f32(size_t m, size_t kc, const float* restrict xp, const float* restrict w, float* restrict sums) {
+  float32x4_t acc[SDKL_CPU_GEMV_MAX_ROWS];
+  size_t k = 0;
+
+  for (size_t r = 0; r < m; r++) {
+    acc[r] = vdupq_n_f32(0.0f);
+  }
+  for (; k + 4 <= kc; k += 4) {
+    float32x4_t wv = vld1q_f32(w + k);
+    for (size_t r = 0; r < m; r++) {
+      acc[r] = vfmaq_f32(acc[r], vld1q_f32(xp + r * SDKL_CPU_KC + k), wv);
+    }
+  }
+  for (size_t r = 0; r < m; r++) {
+    sums[r] = vaddvq_f32(acc[r]);
+    for (size_t kt = k; kt < kc; kt++) {
+      sums[r] += xp[r * SDKL_CPU_KC + kt] * w[kt];
+    }
+  }
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+static void dot_rows_f32(size_t m, size_t kc, const float* restrict xp, const float* restrict w, float* restrict sums) {
+  __m256 acc[SDKL_CPU_GEMV_MAX_ROWS];
+  size_t k = 0;
+
+  for (size_t r = 0; r < m; r++) {
+    acc[r] = _mm256_setzero_ps();
+  }
+  for (; k + 8 <= kc; k += 8) {
+    __m256 wv = _mm256_loadu_ps(w + k);
+    for (size_t r = 0; r < m; r++) {
+      acc[r] = _mm256_fmadd_ps(_mm256_loadu_ps(xp + r * SDKL_CPU_KC + k), wv, acc[r]);
+    }
+  }
+  for (size_t r = 0; r < m; r++) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc[r]), _mm256_extractf128_ps(acc[r], 1));
+    s        = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s        = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    sums[r]  = _mm_cvtss_f32(s);
+    for (size_t kt = k; kt < kc; kt++) {
+      sums[r] += xp[r * SDKL_CPU_KC + kt] * w[kt];
+    }
+  }
+}
+
+#else
+
+static void dot_rows_f32(size_t m, size_t kc, const float* restrict xp, const float* restrict w, float* restrict sums) {
+  for (size_t r = 0; r < m; r++) {
+    float acc = 0.0f;
+    for (size_t k = 0; k < kc; k++) {
+      acc += xp[r * SDKL_CPU_KC + k] * w[k];
+    }
+    sums[r] = acc;
+  }
+}
+
+#endif
+
+static void widen_f16(float* restrict dst, const _Float16* restrict src, size_t n) {
+  size_t k = 0;
+
+#if defined(__ARM_NEON) && defined(__ARM_FP16_FORMAT_IEEE)
+  for (; k + 4 <= n; k += 4) {
+    vst1q_f32(dst + k, vcvt_f32_f16(vld1_f16((const __fp16*)(src + k))));
+  }
+#elif defined(__AVX2__) && defined(__F16C__)
+  for (; k + 8 <= n; k += 8) {
+    _mm256_storeu_ps(dst + k, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + k))));
+  }
+#endif
+  for (; k < n; k++) {
+    dst[k] = (float)src[k];
+  }
+}
+
+/* Weight rows are contiguous (`w_cs` is 1); each one is read once per KC block. */
+static void gemv_f32_task(void* ctx, uint32_t task, uint32_t thread_idx) {
+  sdkl_cpu_gemm_job_t* job         = (sdkl_cpu_gemm_job_t*)ctx;
+  const sdkl_cpu_gemm_args_t* args = job->args + task / job->n_item_tasks;
+  size_t j0                        = (task % job->n_item_tasks) * SDKL_CPU_NC;
+  size_t m                         = args->m;
+  size_t nc                        = SDKL_EXT_MIN(SDKL_CPU_NC, args->n - j0);
+  size_t w_size                    = sdkl_ext_dtype_size(args->w_dtype);
+  size_t xp_size                   = SDKL_CPU_GEMV_MAX_ROWS * SDKL_CPU_KC;
+  size_t ct_size                   = SDKL_CPU_GEMV_MAX_ROWS * SDKL_CPU_NC;
+
+  float* xp = (float*)sdkl_cpu_pool_scratch(thread_idx, (xp_size + SDKL_CPU_KC + ct_size) * sizeof(float));
+  if (xp == NULL) {
+    atomic_store(&job->error, AEE_ENOMEMORY);
+    return;
+  }
+  float* wf = xp + xp_size;
+  float* ct = wf + SDKL_CPU_KC;
+
+  memset(ct, 0, m * SDKL_CPU_NC * sizeof(float));
+
+  for (size_t k0 = 0; k0 < args->k; k0 += SDKL_CPU_KC) {
+    size_t kc     = SDKL_EXT_MIN(SDKL_CPU_KC, args->k - k0);
+    uint64_t span = sdkl_ext_trace_begin();
+
+    for (size_t r = 0; r < m; r++) {
+      pack_panel_f32(xp + r * SDKL_CPU_KC, 1, args->x, args->x_dtype, args->x_rs, args->x_cs, r, 1, k0, kc);
+    }
+    sdkl_ext_trace_end("cpu_pack", "cpu", span);
+
+    span = sdkl_ext_trace_begin();
+    for (size_t j = 0; j < nc; j++) {
+      const uint8_t* w_row = (const uint8_t*)args->w + ((j0 + j) * args->w_rs + k0) * w_size;
+      const float* wv      = (const float*)w_row;
+      float sums[SDKL_CPU_GEMV_MAX_ROWS];
+
+      if (j + SDKL_CPU_GEMV_PREFETCH < nc) {
+        const uint8_t* ahead = w_row + SDKL_CPU_GEMV_PREFETCH * args->w_rs * w_size;
+        for (size_t b = 0; b < kc * w_size; b += 64) {
+          __builtin_prefetch(ahead + b, 0, 0);
+        }
+      }
+      if (args->w_dtype == SDKL_DTYPE_FP16) {
+        widen_f16(wf, (const _Float16*)w_row, kc);
+        wv = wf;
+      }
+
+      dot_rows_f32(m, kc, xp, wv, sums);
+      for (size_t r = 0; r < m; r++) {
+        ct[r * SDKL_CPU_NC + j] += sums[r];
+      }
+    }
+    sdkl_ext_trace_end("cpu_kernel", "cpu", span);
+  }
+
+  uint64_t span = sdkl_ext_trace_begin();
+  store_tile_f32(args, ct, 0, m, j0, nc);
+  sdkl_ext_trace_end("cpu_store", "cpu", span);
+}
+
+/*
+  Dequantizes the int32 tile `ct` of the inner range [k0, k1), group `g`, into the FP32 tile `cf`. Sums of the
+  quantized operands over the range are computed here, only for the zero points in use.
+*/
+static void dequant_tile_i8(
+  const sdkl_cpu_gemm_args_t* args,
+  float* cf,
+  const int32_t* ct,
+  int32_t* w_sums,
+  size_t i0,
+  size_t mc,
+  size_t j0,
+  size_t nc,
+  size_t k0,
+  size_t k1
+) {
+  const sdkl_cpu_quant_t* q = args->quant;
+  size_t g                  = k0 / q->group_size;
+
+  if (q->x_zero_points != NULL) {
+    for (size_t j = 0; j < nc; j++) {
+      const int8_t* w = (const int8_t*)args->w + (j0 + j) * args->w_rs;
+      int32_t sum     = 0;
+      for (size_t k = k0; k < k1; k++) {
+        sum += w[k * args->w_cs];
+      }
+      w_sums[j] = sum;
+    }
+  }
+
+  for (size_t i = 0; i < mc; i++) {
+    int32_t x_sum = 0;
+    if (q->w_zero_points != NULL) {
+      const uint8_t* x = (const uint8_t*)args->x + (i0 + i) * args->x_rs;
+      for (size_t k = k0; k < k1; k++) {
+        x_sum += x[k * args->x_cs];
+      }
+    }
+    sdkl_cpu_quant_accumulate(q, cf + i * SDKL_CPU_NC, ct + i * SDKL_CPU_NC, i0 + i, j0, nc, g, x_sum, w_sums);
+  }
+}
+
+static void gemm_i8_task(void* ctx, uint32_t task, uint32_t thread_idx) {
+  sdkl_cpu_gemm_job_t* job         = (sdkl_cpu_gemm_job_t*)ctx;
+  const sdkl_cpu_gemm_args_t* args = job->args + task / job->n_item_tasks;
+  size_t tile                      = task % job->n_item_tasks;
+  size_t mt                        = tile / job->n_ntiles;
+  size_t nt                        = tile % job->n_ntiles;
+  size_t i0                        = mt * job->mc;
+  size_t j0                        = nt * SDKL_CPU_NC;
+  size_t mc                        = SDKL_EXT_MIN(job->mc, args->m - i0);
+  size_t nc                        = SDKL_EXT_MIN(SDKL_CPU_NC, args->n - j0);
+  size_t m_panels                  = (mc + SDKL_CPU_I8_MR - 1) / SDKL_CPU_I8_MR;
+  size_t n_panels                  = (nc + SDKL_CPU_I8_NR - 1) / SDKL_CPU_I8_NR;
+  size_t ap_size                   = job->mc * SDKL_CPU_KC * sizeof(sdkl_cpu_i8_pack_t);
+  size_t bp_size                   = SDKL_CPU_KC * SDKL_CPU_NC * sizeof(sdkl_cpu_i8_pack_t);
+  size_t ct_size                   = job->mc * SDKL_CPU_NC * sizeof(int32_t);
+  size_t cf_size                   = args->quant != NULL ? job->mc * SDKL_CPU_NC * sizeof(float) : 0;
+  size_t ws_size                   = args->quant != NULL ? SDKL_CPU_NC * sizeof(int32_t) : 0;
+  size_t group_size                = args->quant != NULL ? args->quant->group_size : args->k;
+
+  uint8_t* scratch = (uint8_t*)sdkl_cpu_pool_scratch(thread_idx, ap_size + bp_size + ct_size + cf_size + ws_size);
+  if (scratch == NULL) {
+    atomic_store(&job->error, AEE_ENOMEMORY);
+    return;
+  }
+  int32_t* ct            = (int32_t*)scratch;
+  sdkl_cpu_i8_pack_t* ap = (sdkl_cpu_i8_pack_t*)(scratch + ct_size);
+  sdkl_cpu_i8_pack_t* bp = (sdkl_cpu_i8_pack_t*)(scratch + ct_size + ap_size);
+  float* cf              = (float*)(scratch + ct_size + ap_size + bp_size);
+  int32_t* w_sums        = (int32_t*)(scratch + ct_size + ap_size + bp_size + cf_size);
+
+  memset(ct, 0, m_panels * SDKL_CPU_I8_MR * SDKL_CPU_NC * sizeof(int32_t));
+  if (args->quant != NULL) {
+    memset(cf, 0, mc * SDKL_CPU_NC * sizeof(float));
+  }
+
+  for (size_t k0 = 0; k0 < args->k; k0 += SDKL_CPU_KC) {
+    size_t kc     = SDKL_EXT_MIN(SDKL_CPU_KC, args->k - k0);
+    size_t kc_pad = SDKL_EXT_ALIGN_UP(kc, SDKL_CPU_I8_KU);
+    uint64_t span = sdkl_ext_trace_begin();
+
+    for (size_t p = 0; p < m_panels; p++) {
+      size_t r0 = i0 + p * SDKL_CPU_I8_MR;
+      pack_panel_i8(
+        ap + p * kc_pad * SDKL_CPU_I8_MR,
+        SDKL_CPU_I8_MR,
+        args->x,
+        false,
+        args->x_rs,
+        args->x_cs,
+        r0,
+        SDKL_EXT_MIN(SDKL_CPU_I8_MR, i0 + mc - r0),
+        k0,
+        kc,
+        kc_pad
+      );
+    }
+    for (size_t p = 0; p < n_panels; p++) {
+      size_t r0 = j0 + p * SDKL_CPU_I8_NR;
+      pack_panel_i8(
+        bp + p * kc_pad * SDKL_CPU_I8_NR,
+        SDKL_CPU_I8_NR,
+        args->w,
+        true,
+        args->w_rs,
+        args->w_cs,
+        r0,
+        SDKL_EXT_MIN(SDKL_CPU_I8_NR, j0 + nc - r0),
+        k0,
+        kc,
+        kc_pad
+      );
+    }
+    sdkl_ext_trace_end("cpu_pack", "cpu", span);
+
+    // Split the block at group boundaries; group sizes are multiples of KU, so every part starts on a packed group
+    span = sdkl_ext_trace_begin();
+    for (size_t s0 = k0; s0 < k0 + kc;) {
+      size_t s1  = SDKL_EXT_MIN(k0 + kc, (s0 / group_size + 1) * group_size);
+      size_t off = s0 - k0;
+      size_t len = (s1 == k0 + kc) ? kc_pad - off : s1 - s0;
+
+      for (size_t np = 0; np < n_panels; np++) {
+        for (size_t mp = 0; mp < m_panels; mp++) {
+          kernel_i8(
+            len,
+            ap + mp * kc_pad * SDKL_CPU_I8_MR + off * SDKL_CPU_I8_MR,
+            bp + np * kc_pad * SDKL_CPU_I8_NR + off * SDKL_CPU_I8_NR,
+            ct + mp * SDKL_CPU_I8_MR * SDKL_CPU_NC + np * SDKL_CPU_I8_NR,
+            SDKL_CPU_NC
+          );
+        }
+      }
+
+      if (args->quant != NULL && s1 % group_size == 0) {
+        dequant_tile_i8(args, cf, ct, w_sums, i0, mc, j0, nc, s1 - group_size, s1);
+        memset(ct, 0, m_panels * SDKL_CPU_I8_MR * SDKL_CPU_NC * sizeof(int32_t));
+      }
+      s0 = s1;
+    }
+    sdkl_ext_trace_end("cpu_kernel", "cpu", span);
+  }
+
+  uint64_t span = sdkl_ext_trace_begin();
+  if (args->quant != NULL) {
+    store_tile_f32(args, cf, i0, mc, j0, nc);
+  } else {
+    for (size_t i = 0; i < mc; i++) {
+      int32_t* dst = (int32_t*)args->a + (i0 + i) * args->a_rs + j0;
+      memcpy(dst, ct + i * SDKL_CPU_NC, nc * sizeof(int32_t));
+    }
+  }
+  sdkl_ext_trace_end("cpu_store", "cpu", span);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Drivers
+---------------------------------------------------------------------------------------------------------------------*/
+
+static bool is_float_type(sdkl_tensor_dtype_e dtype) {
+  return dtype == SDKL_DTYPE_FP32 || dtype == SDKL_DTYPE_FP16;
+}
+
+static sdkl_cpu_task_fn select_task(const sdkl_cpu_gemm_args_t* args, size_t* mr) {
+  if (is_float_type(args->x_dtype) && is_float_type(args->w_dtype) && is_float_type(args->a_dtype)) {
+    if (args->m <= SDKL_CPU_GEMV_MAX_ROWS && args->w_cs == 1) {
+      *mr = SDKL_CPU_GEMV_MAX_ROWS;
+      return gemv_f32_task;
+    }
+    *mr = SDKL_CPU_F32_MR;
+    return gemm_f32_task;
+  }
+  if (args->x_dtype == SDKL_DTYPE_U8 && args->w_dtype == SDKL_DTYPE_I8 &&
+      (args->quant != NULL ? is_float_type(args->a_dtype) : args->a_dtype == SDKL_DTYPE_I32)) {
+    *mr = SDKL_CPU_I8_MR;
+    return gemm_i8_task;
+  }
+  return NULL;
+}
+
+int sdkl_cpu_gemm_schedule(sdkl_cpu_gemm_schedule_t* schedule, const sdkl_cpu_gemm_args_t* args) {
+  size_t mr, n_mtiles;
+
+  if (schedule == NULL || args == NULL || args->m == 0 || args->n == 0 || args->k == 0) {
+    return AEE_EBADPARM;
+  }
+
+  schedule->fn = select_task(args, &mr);
+  if (schedule->fn == NULL) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  schedule->m            = args->m;
+  schedule->n            = args->n;
+  schedule->mc           = SDKL_EXT_ALIGN_UP(SDKL_CPU_MC, mr);
+  schedule->n_ntiles     = (args->n + SDKL_CPU_NC - 1) / SDKL_CPU_NC;
+  n_mtiles               = (args->m + schedule->mc - 1) / schedule->mc;
+  schedule->n_item_tasks = n_mtiles * schedule->n_ntiles;
+
+  // Per-thread scratch of the task functions: packed X and W panels, then the output tile
+  if (schedule->fn == gemv_f32_task) {
+    schedule->scratch_size =
+      (SDKL_CPU_GEMV_MAX_ROWS * (SDKL_CPU_KC + SDKL_CPU_NC) + SDKL_CPU_KC) * sizeof(float);
+  } else if (schedule->fn == gemm_f32_task) {
+    schedule->scratch_size = (schedule->mc * SDKL_CPU_KC + SDKL_CPU_KC * SDKL_CPU_NC + schedule->mc * SDKL_CPU_NC) *
+                             sizeof(float);
+  } else {
+    schedule->scratch_size = (schedule->mc + SDKL_CPU_NC) * SDKL_CPU_KC * sizeof(sdkl_cpu_i8_pack_t) +
+                             schedule->mc * SDKL_CPU_NC * sizeof(int32_t);
+    if (args->quant != NULL) {
+      schedule->scratch_size += schedule->mc * SDKL_CPU_NC * sizeof(float) + SDKL_CPU_NC * sizeof(int32_t);
+    }
+  }
+
+  return AEE_SUCCESS;
+}
+
+int sdkl_cpu_gemm_run(const sdkl_cpu_gemm_schedule_t* schedule, const sdkl_cpu_gemm_args_t* args, size_t n_items) {
+  sdkl_cpu_gemm_job_t job;
+  uint64_t span, start;
+  uint64_t macs = 0, bytes = 0;
+  int ret;
+
+  if (schedule->n_item_tasks > UINT32_MAX / n_items) {
+    return AEE_EBADPARM;
+  }
+
+  job.args         = args;
+  job.mc           = schedule->mc;
+  job.n_ntiles     = schedule->n_ntiles;
+  job.n_item_tasks = schedule->n_item_tasks;
+  atomic_init(&job.error, AEE_SUCCESS);
+
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = sdkl_cpu_pool_run((uint32_t)(job.n_item_tasks * n_items), schedule->fn, &job);
+  sdkl_ext_trace_end("cpu_gemm", "cpu", span);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+  ret = atomic_load(&job.error);
+
+  if (ret == AEE_SUCCESS) {
+    for (size_t i = 0; i < n_items; i++) {
+      const sdkl_cpu_gemm_args_t* a = &args[i];
+
+      macs  += (uint64_t)a->m * a->n * a->k;
+      bytes += (uint64_t)(a->m * a->k) * sdkl_ext_dtype_size(a->x_dtype) +
+               (uint64_t)(a->n * a->k) * sdkl_ext_dtype_size(a->w_dtype) +
+               (uint64_t)(a->m * a->n) * sdkl_ext_dtype_size(a->a_dtype);
+    }
+    sdkl_ext_stats_add_mm(SDKL_PLATFORM_CPU, n_items, macs, bytes, sdkl_ext_time_ns() - start);
+  }
+
+  return ret;
+}
+
+int sdkl_cpu_gemm_batch(const sdkl_cpu_gemm_args_t* args, size_t n_items) {
+  sdkl_cpu_gemm_schedule_t schedule;
+  int ret;
+
+  if (args == NULL || n_items == 0) {
+    return AEE_EBADPARM;
+  }
+
+  ret = sdkl_cpu_gemm_schedule(&schedule, args);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+  for (size_t b = 0; b < n_items; b++) {
+    const sdkl_cpu_gemm_args_t* a = &args[b];
+    size_t item_mr;
+
+    if (a->x == NULL || a->w == NULL || a->a == NULL || a->m == 0 || a->n == 0 || a->k == 0) {
+      return AEE_EBADPARM;
+    }
+    if (a->m != args->m || a->n != args->n) {
+      return AEE_EBADPARM;
+    }
+    if (select_task(a, &item_mr) != schedule.fn) {
+      return AEE_EUNSUPPORTED;
+    }
+  }
+
+  return sdkl_cpu_gemm_run(&schedule, args, n_items);
+}
+
+int sdkl_cpu_gemm(const sdkl_cpu_gemm_args_t* args) {
+  return sdkl_cpu_gemm_batch(args, 1);
+}
+
+static int check_bounds(const sdkl_tensor_t* t, size_t rs, size_t cs, size_t rows, size_t cols) {
+  uint64_t last = t->data_offset + (uint64_t)(rows - 1) * rs + (uint64_t)(cols - 1) * cs;
+  return (last < t->num_elements) ? AEE_SUCCESS : AEE_EBADPARM;
+}
+
+int sdkl_cpu_gemm_args_from_tensors(
+  sdkl_cpu_gemm_args_t* args,
+  const sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor
+) {
+  const sdkl_tensor_t* r = result_tensor;
+  const sdkl_tensor_t* x = left_tensor;
+  const sdkl_tensor_t* w = right_tensor;
+
+  if (args == NULL || r == NULL || x == NULL || w == NULL) {
+    return AEE_EBADCLASS;
+  }
+  if (r->data == NULL || x->data == NULL || w->data == NULL) {
+    return AEE_EBADCLASS;
+  }
+  if (r->ndims != 2 || x->ndims != 2 || w->ndims != 2) {
+    return AEE_EBADPARM;
+  }
+  if (r->quantization != SDKL_QUANT_NONE || x->quantization != SDKL_QUANT_NONE ||
+      w->quantization != SDKL_QUANT_NONE) {
+    return AEE_EUNSUPPORTED;
+  }
+  if (r->layout != SDKL_LAYOUT_2D_ROW_MAJOR) {
+    return AEE_EUNSUPPORTED;
+  }
+  if (x->layout != SDKL_LAYOUT_2D_ROW_MAJOR && x->layout != SDKL_LAYOUT_2D_COL_MAJOR) {
+    return AEE_EUNSUPPORTED;
+  }
+  if ((w->layout != SDKL_LAYOUT_2D_ROW_MAJOR && w->layout != SDKL_LAYOUT_2D_COL_MAJOR) || !w->is_continuous) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  args->m = r->dims[0];
+  args->n = r->dims[1];
+  args->k = x->dims[1];
+
+  if (args->m == 0 || args->n == 0 || args->k == 0 || x->dims[0] != args->m) {
+    return AEE_EBADPARM;
+  }
+  if (!((w->dims[0] == args->k && w->dims[1] == args->n) || (w->dims[0] == args->n && w->dims[1] == args->k))) {
+    return AEE_EBADPARM;
+  }
+  if (r->strides[1] != 1 || r->strides[0] < args->n || x->strides[0] == 0 || x->strides[1] == 0) {
+    return AEE_EBADPARM;
+  }
+
+  size_t r_size = sdkl_ext_dtype_size(r->data_dtype);
+  size_t x_size = sdkl_ext_dtype_size(x->data_dtype);
+  size_t w_size = sdkl_ext_dtype_size(w->data_dtype);
+  if (r_size == 0 || x_size == 0 || w_size == 0) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  args->x_rs = x->strides[0];
+  args->x_cs = x->strides[1];
+  args->a_rs = r->strides[0];
+  if (w->layout == SDKL_LAYOUT_2D_ROW_MAJOR) {
+    // Transposed weights: W[n_col][n_inner]
+    args->w_rs = args->k;
+    args->w_cs = 1;
+  } else {
+    // W[n_inner][n_col]
+    args->w_rs = 1;
+    args->w_cs = args->n;
+  }
+
+  if (check_bounds(x, args->x_rs, args->x_cs, args->m, args->k) != AEE_SUCCESS ||
+      check_bounds(w, args->w_rs, args->w_cs, args->n, args->k) != AEE_SUCCESS ||
+      check_bounds(r, args->a_rs, 1, args->m, args->n) != AEE_SUCCESS) {
+    return AEE_EBADPARM;
+  }
+
+  args->x        = (const uint8_t*)x->data + x->data_offset * x_size;
+  args->w        = (const uint8_t*)w->data + w->data_offset * w_size;
+  args->a        = (uint8_t*)r->data + r->data_offset * r_size;
+  args->x_dtype  = x->data_dtype;
+  args->w_dtype  = w->data_dtype;
+  args->a_dtype  = r->data_dtype;
+  args->epilogue = NULL;
+  args->quant    = NULL;
+
+  return AEE_SUCCESS;
+}
+
+int sdkl_cpu_mm_tensor(
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor
+) {
+  sdkl_cpu_gemm_args_t args;
+  int ret = sdkl_cpu_gemm_args_from_tensors(&args, result_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  return sdkl_cpu_gemm(&args);
+}
+
+static int cpu_mm_contiguous(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  void* A,
+  sdkl_tensor_dtype_e a_dtype,
+  const void* X,
+  sdkl_tensor_dtype_e x_dtype,
+  const void* W,
+  sdkl_tensor_dtype_e w_dtype
+) {
+  sdkl_cpu_gemm_args_t args = {
+    .m       = n_row,
+    .n       = n_col,
+    .k       = n_inner,
+    .x       = X,
+    .x_rs    = n_inner,
+    .x_cs    = 1,
+    .x_dtype = x_dtype,
+    .w       = W,
+    .w_rs    = n_inner,
+    .w_cs    = 1,
+    .w_dtype = w_dtype,
+    .a       = A,
+    .a_rs    = n_col,
+    .a_dtype = a_dtype,
+  };
+
+  return sdkl_cpu_gemm(&args);
+}
+
+int sdkl_cpu_mm_f32f16_f32(size_t n_row, size_t n_col, size_t n_inner, float* A, const float* X, const _Float16* W) {
+  return cpu_mm_contiguous(n_row, n_col, n_inner, A, SDKL_DTYPE_FP32, X, SDKL_DTYPE_FP32, W, SDKL_DTYPE_FP16);
+}
+
+int sdkl_cpu_mm_f16f16_f16(
+  size_t n_row,
+  size_t n_col,
+  size_t n_inner,
+  _Float16* A,
+  const _Float16* X,
+  const _Float16* W
+) {
+  return cpu_mm_contiguous(n_row, n_col, n_inner, A, SDKL_DTYPE_FP16, X, SDKL_DTYPE_FP16, W, SDKL_DTYPE_FP16);
+}
+
+int sdkl_cpu_mm_u8i8_i32(size_t n_row, size_t n_col, size_t n_inner, int32_t* A, const uint8_t* X, const int8_t* W) {
+  return cpu_mm_contiguous(n_row, n_col, n_inner, A, SDKL_DTYPE_I32, X, SDKL_DTYPE_U8, W, SDKL_DTYPE_I8);
+}
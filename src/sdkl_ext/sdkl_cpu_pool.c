@@ -0,0 +1,320 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Persistent worker pool of the CPU engine.
+
+  Workers sleep on a condition variable between jobs. A job is a range of task indices that the
+  calling thread and the workers consume through an atomic counter, so uneven tasks balance
+  themselves. Only one job runs at a time; concurrent callers of sdkl_cpu_pool_run() queue on
+  `run_lock`.
+*/
+
+#define SDKL_CPU_SCRATCH_ALIGNMENT (64U)
+
+typedef struct {
+  void* ptr;
+  size_t size;
+} sdkl_cpu_scratch_t;
+
+typedef struct {
+  pthread_mutex_t run_lock;
+  pthread_mutex_t lock;
+  pthread_cond_t job_cond;
+  pthread_cond_t done_cond;
+  pthread_t workers[SDKL_CPU_MAX_THREADS];
+  uint32_t num_threads;
+  uint32_t initialized;
+  uint32_t shutdown;
+  uint64_t job_id;
+  uint32_t active_workers;
+  sdkl_cpu_task_fn fn;
+  void* ctx;
+  uint32_t n_tasks;
+  atomic_uint next_task;
+  cpu_set_t big_cores;
+  uint32_t pin_threads;
+  sdkl_cpu_scratch_t scratch[SDKL_CPU_MAX_THREADS];
+} sdkl_cpu_pool_t;
+
+static sdkl_cpu_pool_t g_pool = {
+  .run_lock  = PTHREAD_MUTEX_INITIALIZER,
+  .lock      = PTHREAD_MUTEX_INITIALIZER,
+  .job_cond  = PTHREAD_COND_INITIALIZER,
+  .done_cond = PTHREAD_COND_INITIALIZER,
+};
+
+static unsigned long read_max_freq(uint32_t cpu) {
+  char path[96];
+  unsigned long freq = 0;
+  FILE* f;
+
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq", cpu);
+  f = fopen(path, "r");
+  if (f == NULL) {
+    return 0;
+  }
+  if (fscanf(f, "%lu", &freq) != 1) {
+    freq = 0;
+  }
+  fclose(f);
+  return freq;
+}
+
+/*
+  Big cores are all cores except those of the lowest-frequency cluster. On homogeneous systems,
+  or when cpufreq is not readable, every online core is considered big.
+*/
+static uint32_t detect_big_cores(cpu_set_t* set) {
+  long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned long freq[CPU_SETSIZE];
+  unsigned long min_freq = ~0UL;
+  unsigned long max_freq = 0;
+  uint32_t count         = 0;
+
+  CPU_ZERO(set);
+  if (n_cpus <= 0) {
+    n_cpus = 1;
+  }
+  if (n_cpus > CPU_SETSIZE) {
+    n_cpus = CPU_SETSIZE;
+  }
+
+  for (long cpu = 0; cpu < n_cpus; cpu++) {
+    freq[cpu] = read_max_freq((uint32_t)cpu);
+    if (freq[cpu] != 0 && freq[cpu] < min_freq) {
+      min_freq = freq[cpu];
+    }
+    if (freq[cpu] > max_freq) {
+      max_freq = freq[cpu];
+    }
+  }
+
+  for (long cpu = 0; cpu < n_cpus; cpu++) {
+    if (max_freq == 0 || min_freq == max_freq || freq[cpu] > min_freq) {
+      CPU_SET(cpu, set);
+      count++;
+    }
+  }
+
+  return count;
+}
+
+static void* worker_main(void* arg) {
+  uint32_t thread_idx = (uint32_t)(uintptr_t)arg;
+  uint64_t seen_job   = 0;
+
+  if (g_pool.pin_threads) {
+    sched_setaffinity(0, sizeof(g_pool.big_cores), &g_pool.big_cores);
+  }
+
+  pthread_mutex_lock(&g_pool.lock);
+  for (;;) {
+    while (!g_pool.shutdown && g_pool.job_id == seen_job) {
+      pthread_cond_wait(&g_pool.job_cond, &g_pool.lock);
+    }
+    if (g_pool.shutdown) {
+      break;
+    }
+    seen_job            = g_pool.job_id;
+    sdkl_cpu_task_fn fn = g_pool.fn;
+    void* ctx           = g_pool.ctx;
+    uint32_t n_tasks    = g_pool.n_tasks;
+    pthread_mutex_unlock(&g_pool.lock);
+
+    for (uint32_t task = atomic_fetch_add(&g_pool.next_task, 1); task < n_tasks;
+         task = atomic_fetch_add(&g_pool.next_task, 1)) {
+      fn(ctx, task, thread_idx);
+    }
+
+    pthread_mutex_lock(&g_pool.lock);
+    if (--g_pool.active_workers == 0) {
+      pthread_cond_signal(&g_pool.done_cond);
+    }
+  }
+  pthread_mutex_unlock(&g_pool.lock);
+
+  return NULL;
+}
+
+static int pool_start(const sdkl_cpu_config_t* config) {
+  uint32_t n_big       = detect_big_cores(&g_pool.big_cores);
+  uint32_t num_threads = (config != NULL && config->num_threads != 0) ? config->num_threads : n_big;
+
+  if (num_threads == 0) {
+    num_threads = 1;
+  }
+  if (num_threads > SDKL_CPU_MAX_THREADS) {
+    num_threads = SDKL_CPU_MAX_THREADS;
+  }
+
+  g_pool.pin_threads    = (config != NULL) ? config->pin_threads : 1;
+  g_pool.shutdown       = 0;
+  g_pool.job_id         = 0;
+  g_pool.active_workers = 0;
+  g_pool.num_threads    = 1;
+
+  for (uint32_t t = 1; t < num_threads; t++) {
+    if (pthread_create(&g_pool.workers[t], NULL, worker_main, (void*)(uintptr_t)t) != 0) {
+      break;
+    }
+    g_pool.num_threads++;
+  }
+
+  g_pool.initialized = 1;
+  return AEE_SUCCESS;
+}
+
+static void pool_stop(void) {
+  pthread_mutex_lock(&g_pool.lock);
+  g_pool.shutdown = 1;
+  pthread_cond_broadcast(&g_pool.job_cond);
+  pthread_mutex_unlock(&g_pool.lock);
+
+  for (uint32_t t = 1; t < g_pool.num_threads; t++) {
+    pthread_join(g_pool.workers[t], NULL);
+  }
+
+  for (uint32_t t = 0; t < SDKL_CPU_MAX_THREADS; t++) {
+    free(g_pool.scratch[t].ptr);
+    g_pool.scratch[t].ptr  = NULL;
+    g_pool.scratch[t].size = 0;
+  }
+
+  g_pool.num_threads = 0;
+  g_pool.initialized = 0;
+}
+
+int sdkl_cpu_initialize(const sdkl_cpu_config_t* config) {
+  int ret;
+
+  pthread_mutex_lock(&g_pool.run_lock);
+  ret = g_pool.initialized ? AEE_EBADSTATE : pool_start(config);
+  pthread_mutex_unlock(&g_pool.run_lock);
+
+  return ret;
+}
+
+int sdkl_cpu_finalize(void) {
+  pthread_mutex_lock(&g_pool.run_lock);
+  if (g_pool.initialized) {
+    pool_stop();
+  }
+  pthread_mutex_unlock(&g_pool.run_lock);
+
+  return AEE_SUCCESS;
+}
+
+uint32_t sdkl_cpu_get_num_threads(void) {
+  uint32_t num_threads;
+
+  pthread_mutex_lock(&g_pool.run_lock);
+  if (!g_pool.initialized) {
+    pool_start(NULL);
+  }
+  num_threads = g_pool.num_threads;
+  pthread_mutex_unlock(&g_pool.run_lock);
+
+  return num_threads;
+}
+
+void* sdkl_cpu_pool_scratch(uint32_t thread_idx, size_t size) {
+  sdkl_cpu_scratch_t* s = &g_pool.scratch[thread_idx];
+
+  if (s->size < size) {
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, SDKL_CPU_SCRATCH_ALIGNMENT, size) != 0) {
+      return NULL;
+    }
+    free(s->ptr);
+    s->ptr  = ptr;
+    s->size = size;
+  }
+
+  return s->ptr;
+}
+
+int sdkl_cpu_pool_reserve(size_t size) {
+  int ret = AEE_SUCCESS;
+
+  pthread_mutex_lock(&g_pool.run_lock);
+  if (!g_pool.initialized) {
+    pool_start(NULL);
+  }
+  for (uint32_t t = 0; t < g_pool.num_threads; t++) {
+    if (sdkl_cpu_pool_scratch(t, size) == NULL) {
+      ret = AEE_ENOMEMORY;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&g_pool.run_lock);
+
+  return ret;
+}
+
+int sdkl_cpu_pool_run(uint32_t n_tasks, sdkl_cpu_task_fn fn, void* ctx) {
+  if (fn == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (n_tasks == 0) {
+    return AEE_SUCCESS;
+  }
+
+  // Time only contended acquisitions, the common case costs one try-lock
+  if (pthread_mutex_trylock(&g_pool.run_lock) != 0) {
+    uint64_t start = sdkl_ext_time_ns();
+    pthread_mutex_lock(&g_pool.run_lock);
+    sdkl_ext_stats_add_wait(SDKL_PLATFORM_CPU, sdkl_ext_time_ns() - start);
+  }
+  if (!g_pool.initialized) {
+    pool_start(NULL);
+  }
+
+  if (g_pool.num_threads == 1 || n_tasks == 1) {
+    for (uint32_t task = 0; task < n_tasks; task++) {
+      fn(ctx, task, 0);
+    }
+    pthread_mutex_unlock(&g_pool.run_lock);
+    return AEE_SUCCESS;
+  }
+
+  pthread_mutex_lock(&g_pool.lock);
+  g_pool.fn             = fn;
+  g_pool.ctx            = ctx;
+  g_pool.n_tasks        = n_tasks;
+  g_pool.active_workers = g_pool.num_threads - 1;
+  atomic_store(&g_pool.next_task, 0);
+  g_pool.job_id++;
+  pthread_cond_broadcast(&g_pool.job_cond);
+  pthread_mutex_unlock(&g_pool.lock);
+
+  // The calling thread works on the job as thread 0
+  for (uint32_t task = atomic_fetch_add(&g_pool.next_task, 1); task < n_tasks;
+       task = atomic_fetch_add(&g_pool.next_task, 1)) {
+    fn(ctx, task, 0);
+  }
+
+  pthread_mutex_lock(&g_pool.lock);
+  while (g_pool.active_workers != 0) {
+    pthread_cond_wait(&g_pool.done_cond, &g_pool.lock);
+  }
+  pthread_mutex_unlock(&g_pool.lock);
+
+  pthread_mutex_unlock(&g_pool.run_lock);
+  return AEE_SUCCESS;
+}
@@ -0,0 +1,217 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "sdkl_ext_internal.h"
+
+#define SDKL_EPILOGUE_ROWS_PER_TASK (16U)
+
+static inline float activate(float x, sdkl_activation_e activation) {
+  switch (activation) {
+    case SDKL_ACT_RELU:
+      return x > 0.f ? x : 0.f;
+    case SDKL_ACT_SILU:
+      return x / (1.f + expf(-x));
+    case SDKL_ACT_GELU:
+      return 0.5f * x * (1.f + tanhf(0.7978845608f * (x + 0.044715f * x * x * x)));
+    default:
+      return x;
+  }
+}
+
+static bool is_empty(const sdkl_epilogue_t* epilogue) {
+  return epilogue == NULL ||
+         (epilogue->bias == NULL && epilogue->activation == SDKL_ACT_NONE && epilogue->residual == NULL);
+}
+
+int sdkl_cpu_epilogue_resolve(
+  sdkl_cpu_epilogue_t* resolved,
+  const sdkl_epilogue_t* epilogue,
+  const sdkl_tensor_t* result_tensor
+) {
+  const sdkl_tensor_t* r   = result_tensor;
+  const sdkl_tensor_t* res = epilogue->residual;
+
+  if (epilogue->activation >= SDKL_ACT_INVALID) {
+    return AEE_EBADPARM;
+  }
+  if (r->data_dtype != SDKL_DTYPE_FP32 && r->data_dtype != SDKL_DTYPE_FP16) {
+    return AEE_EUNSUPPORTED;
+  }
+  if (r->layout != SDKL_LAYOUT_2D_ROW_MAJOR || r->strides[1] != 1) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  resolved->bias           = epilogue->bias;
+  resolved->activation     = epilogue->activation;
+  resolved->residual       = NULL;
+  resolved->residual_rs    = 0;
+  resolved->residual_dtype = SDKL_DTYPE_FP32;
+
+  if (res != NULL) {
+    if (res->data == NULL || res->ndims != 2 || res->layout != SDKL_LAYOUT_2D_ROW_MAJOR) {
+      return AEE_EBADPARM;
+    }
+    if (res->data_dtype != SDKL_DTYPE_FP32 && res->data_dtype != SDKL_DTYPE_FP16) {
+      return AEE_EBADPARM;
+    }
+    if (res->dims[0] != r->dims[0] || res->dims[1] != r->dims[1] || res->strides[1] != 1 ||
+        res->strides[0] < res->dims[1]) {
+      return AEE_EBADPARM;
+    }
+    if (res->data_offset + (res->dims[0] - 1) * res->strides[0] + res->dims[1] > res->num_elements) {
+      return AEE_EBADPARM;
+    }
+
+    resolved->residual       = (const uint8_t*)res->data + res->data_offset * sdkl_ext_dtype_size(res->data_dtype);
+    resolved->residual_rs    = res->strides[0];
+    resolved->residual_dtype = res->data_dtype;
+  }
+
+  return AEE_SUCCESS;
+}
+
+void sdkl_cpu_epilogue_apply(const sdkl_cpu_epilogue_t* epilogue, float* v, size_t i, size_t j0, size_t n) {
+  if (epilogue->bias != NULL) {
+    const float* bias = epilogue->bias + j0;
+    for (size_t j = 0; j < n; j++) {
+      v[j] += bias[j];
+    }
+  }
+
+  if (epilogue->activation != SDKL_ACT_NONE) {
+    for (size_t j = 0; j < n; j++) {
+      v[j] = activate(v[j], epilogue->activation);
+    }
+  }
+
+  if (epilogue->residual != NULL) {
+    if (epilogue->residual_dtype == SDKL_DTYPE_FP32) {
+      const float* res = (const float*)epilogue->residual + i * epilogue->residual_rs + j0;
+      for (size_t j = 0; j < n; j++) {
+        v[j] += res[j];
+      }
+    } else {
+      const _Float16* res = (const _Float16*)epilogue->residual + i * epilogue->residual_rs + j0;
+      for (size_t j = 0; j < n; j++) {
+        v[j] += (float)res[j];
+      }
+    }
+  }
+}
+
+/*
+  Post-pass used when the matrix multiplication itself cannot be fused (NPU platforms): every pool task loads a
+  block of result rows into FP32 scratch, applies the epilogue and stores the block back.
+*/
+typedef struct {
+  const sdkl_cpu_epilogue_t* epilogue;
+  void* a;
+  size_t a_rs;
+  sdkl_tensor_dtype_e a_dtype;
+  size_t m;
+  size_t n;
+  atomic_int error;
+} sdkl_epilogue_job_t;
+
+static void epilogue_task(void* ctx, uint32_t task, uint32_t thread_idx) {
+  sdkl_epilogue_job_t* job = (sdkl_epilogue_job_t*)ctx;
+  size_t i0                = (size_t)task * SDKL_EPILOGUE_ROWS_PER_TASK;
+  size_t i1                = SDKL_EXT_MIN(i0 + SDKL_EPILOGUE_ROWS_PER_TASK, job->m);
+
+  float* v = (float*)sdkl_cpu_pool_scratch(thread_idx, job->n * sizeof(float));
+  if (v == NULL) {
+    atomic_store(&job->error, AEE_ENOMEMORY);
+    return;
+  }
+
+  for (size_t i = i0; i < i1; i++) {
+    if (job->a_dtype == SDKL_DTYPE_FP32) {
+      float* row = (float*)job->a + i * job->a_rs;
+      sdkl_cpu_epilogue_apply(job->epilogue, row, i, 0, job->n);
+    } else {
+      _Float16* row = (_Float16*)job->a + i * job->a_rs;
+      for (size_t j = 0; j < job->n; j++) {
+        v[j] = (float)row[j];
+      }
+      sdkl_cpu_epilogue_apply(job->epilogue, v, i, 0, job->n);
+      for (size_t j = 0; j < job->n; j++) {
+        row[j] = (_Float16)v[j];
+      }
+    }
+  }
+}
+
+static int run_epilogue_pass(const sdkl_cpu_epilogue_t* epilogue, const sdkl_tensor_t* r) {
+  sdkl_epilogue_job_t job;
+  size_t n_tasks = (r->dims[0] + SDKL_EPILOGUE_ROWS_PER_TASK - 1) / SDKL_EPILOGUE_ROWS_PER_TASK;
+  uint64_t span;
+  int ret;
+
+  if (n_tasks > UINT32_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  job.epilogue = epilogue;
+  job.a        = (uint8_t*)r->data + r->data_offset * sdkl_ext_dtype_size(r->data_dtype);
+  job.a_rs     = r->strides[0];
+  job.a_dtype  = r->data_dtype;
+  job.m        = r->dims[0];
+  job.n        = r->dims[1];
+  atomic_init(&job.error, AEE_SUCCESS);
+
+  span = sdkl_ext_trace_begin();
+  ret  = sdkl_cpu_pool_run((uint32_t)n_tasks, epilogue_task, &job);
+  sdkl_ext_trace_end("epilogue", "cpu", span);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  return atomic_load(&job.error);
+}
+
+int sdkl_ext_mm_tensor_epilogue(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  const sdkl_epilogue_t* epilogue
+) {
+  sdkl_cpu_epilogue_t resolved;
+  int ret;
+
+  if (is_empty(epilogue)) {
+    return sdkl_ext_mm_tensor(platform, result_tensor, left_tensor, right_tensor);
+  }
+  if (result_tensor == NULL || result_tensor->data == NULL || result_tensor->ndims != 2) {
+    return AEE_EBADPARM;
+  }
+
+  ret = sdkl_cpu_epilogue_resolve(&resolved, epilogue, result_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  if (platform == SDKL_PLATFORM_CPU) {
+    sdkl_cpu_gemm_args_t args;
+
+    ret = sdkl_cpu_gemm_args_from_tensors(&args, result_tensor, left_tensor, right_tensor);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+    args.epilogue = &resolved;
+
+    return sdkl_cpu_gemm(&args);
+  }
+
+  ret = sdkl_ext_mm_tensor(platform, result_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  return run_epilogue_pass(&resolved, result_tensor);
+}
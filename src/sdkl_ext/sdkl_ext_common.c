@@ -0,0 +1,79 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include "rpcmem.h"
+#include <time.h>
+
+#include "sdkl_ext_internal.h"
+
+uint64_t sdkl_ext_time_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+uint64_t sdkl_ext_time_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+size_t sdkl_ext_dtype_size(sdkl_tensor_dtype_e dtype) {
+  switch (dtype) {
+    case SDKL_DTYPE_I8:
+    case SDKL_DTYPE_U8:
+      return 1;
+    case SDKL_DTYPE_FP16:
+      return 2;
+    case SDKL_DTYPE_I32:
+    case SDKL_DTYPE_FP32:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+int sdkl_ext_npu_map(int domain, void* buffer, size_t size, int* fd) {
+  uint64_t span, start;
+  int buffer_fd;
+  int ret;
+
+  if (buffer == NULL || size == 0 || fd == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  // Registered buffers stay mapped until they are unregistered
+  if (sdkl_ext_npu_is_registered(domain, buffer, size)) {
+    *fd = -1;
+    return AEE_SUCCESS;
+  }
+
+  // Only rpcmem (sdkl_npu_alloc) buffers have a file descriptor
+  buffer_fd = rpcmem_to_fd(buffer);
+  if (buffer_fd < 0) {
+    return AEE_EBADPARM;
+  }
+
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = fastrpc_mmap(domain, buffer_fd, buffer, 0, size, FASTRPC_MAP_FD);
+  sdkl_ext_stats_add_map(domain, sdkl_ext_time_ns() - start);
+  sdkl_ext_trace_end("fastrpc_mmap", "fastrpc", span);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  *fd = buffer_fd;
+  return AEE_SUCCESS;
+}
+
+int sdkl_ext_npu_unmap(int domain, int fd, void* buffer, size_t size) {
+  uint64_t span  = sdkl_ext_trace_begin();
+  uint64_t start = sdkl_ext_time_ns();
+  int ret        = fastrpc_munmap(domain, fd, buffer, size);
+
+  sdkl_ext_stats_add_map(domain, sdkl_ext_time_ns() - start);
+  sdkl_ext_trace_end("fastrpc_munmap", "fastrpc", span);
+  return ret;
+}
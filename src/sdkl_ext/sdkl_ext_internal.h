@@ -0,0 +1,294 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#ifndef __SDKL_EXT_INTERNAL_H__
+#define __SDKL_EXT_INTERNAL_H__
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdkl_ext.h"
+
+/*
+  Internal declarations shared by the sdkl_ext translation units. Not part of the public API.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SDKL_EXT_ALIGN_UP(x, a) (((x) + ((a) - 1)) / (a) * (a))
+#define SDKL_EXT_MIN(a, b)      ((a) < (b) ? (a) : (b))
+#define SDKL_EXT_MAX(a, b)      ((a) > (b) ? (a) : (b))
+
+/* Returns a monotonic timestamp in microseconds. */
+uint64_t sdkl_ext_time_us(void);
+
+/* Returns a monotonic timestamp in nanoseconds. */
+uint64_t sdkl_ext_time_ns(void);
+
+/* Returns the size in bytes of one element of `dtype`, or 0 for sub-byte and invalid types. */
+size_t sdkl_ext_dtype_size(sdkl_tensor_dtype_e dtype);
+
+/*
+  Maps an `sdkl_npu_alloc()` buffer on the DSP of `domain` until sdkl_ext_npu_unmap(). FastRPC reuses the mapping
+  for every invocation that passes the buffer, instead of mapping it per call. Returns the buffer file descriptor,
+  or -1 without mapping when the range lies in a buffer registered with sdkl_npu_register_buffer(), which is
+  already mapped.
+*/
+int sdkl_ext_npu_map(int domain, void* buffer, size_t size, int* fd);
+
+/* Releases a mapping created by sdkl_ext_npu_map(). */
+int sdkl_ext_npu_unmap(int domain, int fd, void* buffer, size_t size);
+
+/* Returns non-zero if `buffer .. buffer + size` lies in a buffer registered on `domain` (sdkl_buffers.c). */
+int sdkl_ext_npu_is_registered(int domain, const void* buffer, size_t size);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  CPU worker pool (sdkl_cpu_pool.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/* Task callback. `thread_idx` is in [0, sdkl_cpu_get_num_threads()); index 0 is the calling thread. */
+typedef void (*sdkl_cpu_task_fn)(void* ctx, uint32_t task_idx, uint32_t thread_idx);
+
+/* Runs `n_tasks` tasks on the pool and returns when all of them completed. Concurrent callers are serialized. */
+int sdkl_cpu_pool_run(uint32_t n_tasks, sdkl_cpu_task_fn fn, void* ctx);
+
+/* Returns a per-thread scratch buffer of at least `size` bytes, 64-byte aligned. Valid inside a task only. */
+void* sdkl_cpu_pool_scratch(uint32_t thread_idx, size_t size);
+
+/* Grows the scratch buffers of all threads to at least `size` bytes, so that tasks do not allocate. */
+int sdkl_cpu_pool_reserve(size_t size);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Epilogues (sdkl_epilogue.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/* Epilogue resolved against a result tensor. Residual element (i, j) is residual[i * residual_rs + j]. */
+typedef struct {
+  const float* bias;
+  sdkl_activation_e activation;
+  const void* residual;
+  size_t residual_rs;
+  sdkl_tensor_dtype_e residual_dtype;
+} sdkl_cpu_epilogue_t;
+
+/* Checks `epilogue` against `result_tensor` and resolves it. */
+int sdkl_cpu_epilogue_resolve(
+  sdkl_cpu_epilogue_t* resolved,
+  const sdkl_epilogue_t* epilogue,
+  const sdkl_tensor_t* result_tensor
+);
+
+/* Applies the epilogue in place to `v[0 .. n)`, the FP32 values of result row `i`, columns `j0 .. j0 + n). */
+void sdkl_cpu_epilogue_apply(const sdkl_cpu_epilogue_t* epilogue, float* v, size_t i, size_t j0, size_t n);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Quantization (sdkl_quant.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/*
+  Quantization parameters resolved against an inner dimension. The parameter of activation row `i` is at index
+  i * x_rs, the parameter of weight row `j` and group `g` at index j * w_rs + g * w_gs.
+*/
+typedef struct {
+  size_t group_size; // inner elements per group, the whole inner dimension unless per-group
+  const float* x_scales;
+  const int32_t* x_zero_points; // NULL for symmetric
+  size_t x_rs;
+  const float* w_scales;
+  const int32_t* w_zero_points; // NULL for symmetric
+  size_t w_rs;
+  size_t w_gs;
+} sdkl_cpu_quant_t;
+
+/* Checks the quantization parameters of a GEMM with inner dimension `k` and resolves them. */
+int sdkl_cpu_quant_resolve(
+  sdkl_cpu_quant_t* resolved,
+  const sdkl_quant_params_t* x_quant,
+  const sdkl_quant_params_t* w_quant,
+  size_t k
+);
+
+/*
+  Dequantizes the int32 products acc[0 .. n) of group `g`, result row `i`, columns `j0 .. j0 + n), and adds them to
+  v[0 .. n). `x_sum` is the sum of the quantized activations of row `i` over the group, used with weight zero
+  points; `w_sums[0 .. n)` are the sums of the quantized weights over the group, used with activation zero points.
+*/
+void sdkl_cpu_quant_accumulate(
+  const sdkl_cpu_quant_t* quant,
+  float* v,
+  const int32_t* acc,
+  size_t i,
+  size_t j0,
+  size_t n,
+  size_t g,
+  int32_t x_sum,
+  const int32_t* w_sums
+);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  CPU GEMM driver (sdkl_cpu_gemm.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/*
+  Describes A = X * W^T where
+    X(i, k) = x[i * x_rs + k * x_cs]   i < m, k < k
+    W(j, k) = w[j * w_rs + k * w_cs]   j < n
+    A(i, j) = a[i * a_rs + j]
+  Strides are in elements of the respective data types.
+*/
+typedef struct {
+  size_t m;
+  size_t n;
+  size_t k;
+  const void* x;
+  size_t x_rs;
+  size_t x_cs;
+  sdkl_tensor_dtype_e x_dtype;
+  const void* w;
+  size_t w_rs;
+  size_t w_cs;
+  sdkl_tensor_dtype_e w_dtype;
+  void* a;
+  size_t a_rs;
+  sdkl_tensor_dtype_e a_dtype;
+  const sdkl_cpu_epilogue_t* epilogue; // applied to float results before they are stored, NULL for none
+  const sdkl_cpu_quant_t* quant;       // dequantizes U8 x I8 products into a float result, NULL for none
+} sdkl_cpu_gemm_args_t;
+
+/* Runs the GEMM described by `args` on the CPU engine. */
+int sdkl_cpu_gemm(const sdkl_cpu_gemm_args_t* args);
+
+/*
+  Runs `n_items` GEMMs of the same shape and data types on the CPU engine, with the tiles of all items in one pool
+  dispatch.
+*/
+int sdkl_cpu_gemm_batch(const sdkl_cpu_gemm_args_t* args, size_t n_items);
+
+/* Dispatch and tiling of a GEMM shape, computed once by sdkl_cpu_gemm_schedule(). */
+typedef struct {
+  sdkl_cpu_task_fn fn;
+  size_t m;
+  size_t n;
+  size_t mc;           // rows per task
+  size_t n_ntiles;     // column tiles per item
+  size_t n_item_tasks; // tasks per item
+  size_t scratch_size; // bytes of per-thread scratch used by the tasks
+} sdkl_cpu_gemm_schedule_t;
+
+/* Selects the task function and the tiling for the shape and data types of `args`. */
+int sdkl_cpu_gemm_schedule(sdkl_cpu_gemm_schedule_t* schedule, const sdkl_cpu_gemm_args_t* args);
+
+/*
+  Runs `n_items` GEMMs with a schedule computed for their shape and data types. Does not check `args` against the
+  schedule.
+*/
+int sdkl_cpu_gemm_run(const sdkl_cpu_gemm_schedule_t* schedule, const sdkl_cpu_gemm_args_t* args, size_t n_items);
+
+/* Fills `args` from tensor descriptors, checking shapes, layouts and bounds. */
+int sdkl_cpu_gemm_args_from_tensors(
+  sdkl_cpu_gemm_args_t* args,
+  const sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor
+);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Tensor slices (sdkl_shard.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/*
+  Returns non-zero if the rows of `t` can be sliced: `SDKL_LAYOUT_2D_ROW_MAJOR` or `SDKL_LAYOUT_2D_COL_MAJOR`,
+  addressed through `strides[]`.
+*/
+int sdkl_ext_can_slice_rows(const sdkl_tensor_t* t);
+
+/*
+  Returns non-zero if the columns of the result `r` and the weights `w` can be sliced: row-major result with unit
+  column stride and contiguous `SDKL_LAYOUT_2D_ROW_MAJOR` weights `W[n_col][n_inner]`.
+*/
+int sdkl_ext_can_slice_cols(const sdkl_tensor_t* r, const sdkl_tensor_t* w);
+
+/* Fills `slice` with rows `i0 .. i0 + n` of `t`. Requires sdkl_ext_can_slice_rows(t). */
+void sdkl_ext_slice_rows(sdkl_tensor_t* slice, const sdkl_tensor_t* t, uint64_t i0, uint64_t n);
+
+/*
+  Fills `r_slice` and `w_slice` with columns `j0 .. j0 + n` of the result `r` and the weights `w` of a matrix
+  multiplication with inner dimension `n_inner`. Requires sdkl_ext_can_slice_cols(r, w).
+*/
+void sdkl_ext_slice_cols(
+  sdkl_tensor_t* r_slice,
+  sdkl_tensor_t* w_slice,
+  const sdkl_tensor_t* r,
+  const sdkl_tensor_t* w,
+  uint64_t n_inner,
+  uint64_t j0,
+  uint64_t n
+);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Submission queues (sdkl_queue.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+typedef struct sdkl_queue_job sdkl_queue_job_t;
+
+/* Operation executed by a queue worker. Receives a copy of the submitted job. */
+typedef int (*sdkl_queue_job_fn)(const sdkl_queue_job_t* job);
+
+struct sdkl_queue_job {
+  sdkl_queue_job_fn fn;
+  sdkl_tensor_platform_e platform; // selects the queue
+  sdkl_tensor_t tensors[3];        // copied descriptors, usage defined by `fn`
+  void* ctx;                       // caller-owned context, must outlive the operation
+};
+
+/* Queues `job` on the queue of job->platform. Blocks while the queue is full. */
+int sdkl_queue_submit(const sdkl_queue_job_t* job, sdkl_fence_t* fence);
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Tracing (sdkl_trace.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/* Non-zero while spans are recorded. */
+extern atomic_int sdkl_ext_trace_enabled;
+
+/* Same as sdkl_trace_begin(), inlined so that an instrumentation point costs one relaxed load when not tracing. */
+static inline uint64_t sdkl_ext_trace_begin(void) {
+  return atomic_load_explicit(&sdkl_ext_trace_enabled, memory_order_relaxed) ? sdkl_trace_begin() : 0;
+}
+
+/* Same as sdkl_trace_end(), without the call when the span was not opened. */
+static inline void sdkl_ext_trace_end(const char* name, const char* category, uint64_t begin) {
+  if (begin != 0) {
+    sdkl_trace_end(name, category, begin);
+  }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+  Performance counters (sdkl_stats.c)
+---------------------------------------------------------------------------------------------------------------------*/
+
+/* Adds `n_matmuls` matrix multiplications run on `platform` in `ns` nanoseconds. */
+void sdkl_ext_stats_add_mm(int platform, uint64_t n_matmuls, uint64_t n_macs, uint64_t bytes, uint64_t ns);
+
+/* Same as sdkl_ext_stats_add_mm() for one matrix multiplication of 2D tensors. */
+void sdkl_ext_stats_add_tensor_mm(
+  int platform,
+  const sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor,
+  uint64_t ns
+);
+
+/* Adds `ns` nanoseconds a caller was blocked on `platform`. */
+void sdkl_ext_stats_add_wait(int platform, uint64_t ns);
+
+/* Adds one FastRPC mapping or unmapping on `domain` that took `ns` nanoseconds. */
+void sdkl_ext_stats_add_map(int domain, uint64_t ns);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif //__SDKL_EXT_INTERNAL_H__
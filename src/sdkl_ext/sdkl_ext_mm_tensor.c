@@ -0,0 +1,31 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+
+#include "sdkl_ext_internal.h"
+
+int sdkl_ext_mm_tensor(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor
+) {
+  uint64_t span, start;
+  int ret;
+
+  if (platform == SDKL_PLATFORM_CPU) {
+    return sdkl_cpu_mm_tensor(result_tensor, left_tensor, right_tensor);
+  }
+
+  // FastRPC marshaling and DSP execution happen inside the library and share one span
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = sdkl_mm_tensor(platform, result_tensor, left_tensor, right_tensor);
+  if (ret == AEE_SUCCESS) {
+    sdkl_ext_stats_add_tensor_mm(platform, result_tensor, left_tensor, right_tensor, sdkl_ext_time_ns() - start);
+  }
+  sdkl_ext_trace_end("sdkl_mm_tensor", "npu", span);
+
+  return ret;
+}
@@ -0,0 +1,184 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <limits.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Grouped GEMM over packed activations. libsdkl has no multi-GEMM remote entry point, so the groups are issued as
+  consecutive sdkl_npu_mm_* calls on row slices of the packed buffers. The packed X and A buffers are mapped once
+  for all groups, which leaves the per-group cost at one FastRPC invocation for the group's weights.
+*/
+
+typedef struct {
+  int domain;
+  size_t n_groups;
+  const size_t* offsets;
+  size_t n_col;
+  size_t n_inner;
+  void* A;
+  const void* X;
+  const void* const* W;
+  sdkl_tensor_dtype_e w_dtype;
+  size_t a_size; // bytes per element
+  size_t x_size;
+} sdkl_grouped_args_t;
+
+static int validate_groups(const sdkl_grouped_args_t* g, uint32_t* n_active) {
+  if (g->n_groups == 0 || g->offsets == NULL || g->A == NULL || g->X == NULL || g->W == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (g->n_col == 0 || g->n_inner == 0 || g->n_col > INT_MAX || g->n_inner > INT_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  *n_active = 0;
+  for (size_t e = 0; e < g->n_groups; e++) {
+    size_t n_row = g->offsets[e + 1] - g->offsets[e];
+
+    if (g->offsets[e + 1] < g->offsets[e] || n_row > INT_MAX) {
+      return AEE_EBADPARM;
+    }
+    if (n_row > 0) {
+      if (g->W[e] == NULL) {
+        return AEE_EBADPARM;
+      }
+      (*n_active)++;
+    }
+  }
+
+  return AEE_SUCCESS;
+}
+
+static int run_group(const sdkl_grouped_args_t* g, size_t e) {
+  size_t row     = g->offsets[e];
+  size_t n_row   = g->offsets[e + 1] - row;
+  char* A        = (char*)g->A + row * g->n_col * g->a_size;
+  const char* X  = (const char*)g->X + row * g->n_inner * g->x_size;
+  uint64_t start = sdkl_ext_time_ns();
+  uint64_t w_bytes;
+  int ret;
+
+  if (g->w_dtype == SDKL_DTYPE_FP16) {
+    w_bytes = g->n_col * g->n_inner * sizeof(_Float16);
+    ret     = sdkl_npu_mm_f16f16_f16(
+      g->domain, (int)n_row, (int)g->n_col, (int)g->n_inner, (_Float16*)A, (const _Float16*)X,
+      (const _Float16*)g->W[e]
+    );
+  } else {
+    w_bytes = (g->n_col * g->n_inner + 1) / 2;
+    ret     = sdkl_npu_mm_u8i4_i32(
+      g->domain, n_row, g->n_col, g->n_inner, (int32_t*)A, (const uint8_t*)X, (const uint8_t*)g->W[e]
+    );
+  }
+
+  if (ret == AEE_SUCCESS) {
+    sdkl_ext_stats_add_mm(
+      g->domain,
+      1,
+      (uint64_t)n_row * g->n_col * g->n_inner,
+      w_bytes + n_row * (g->n_inner * g->x_size + g->n_col * g->a_size),
+      sdkl_ext_time_ns() - start
+    );
+  }
+  return ret;
+}
+
+static int grouped_mm(const sdkl_grouped_args_t* g) {
+  uint32_t n_active;
+  int fd_x = -1, fd_a = -1;
+  size_t n_rows, x_bytes, a_bytes;
+  int ret;
+
+  ret = validate_groups(g, &n_active);
+  if (ret != AEE_SUCCESS || n_active == 0) {
+    return ret;
+  }
+
+  n_rows  = g->offsets[g->n_groups] - g->offsets[0];
+  x_bytes = (g->offsets[0] + n_rows) * g->n_inner * g->x_size;
+  a_bytes = (g->offsets[0] + n_rows) * g->n_col * g->a_size;
+
+  // A single active group gains nothing from an explicit mapping. Failed mappings are not fatal.
+  if (n_active > 1) {
+    if (sdkl_ext_npu_map(g->domain, (void*)g->X, x_bytes, &fd_x) != AEE_SUCCESS) {
+      fd_x = -1;
+    }
+    if (sdkl_ext_npu_map(g->domain, g->A, a_bytes, &fd_a) != AEE_SUCCESS) {
+      fd_a = -1;
+    }
+  }
+
+  for (size_t e = 0; e < g->n_groups && ret == AEE_SUCCESS; e++) {
+    if (g->offsets[e + 1] > g->offsets[e]) {
+      uint64_t span = sdkl_ext_trace_begin();
+      ret           = run_group(g, e);
+      sdkl_ext_trace_end("grouped_mm_group", "npu", span);
+    }
+  }
+
+  if (fd_x >= 0) {
+    sdkl_ext_npu_unmap(g->domain, fd_x, (void*)g->X, x_bytes);
+  }
+  if (fd_a >= 0) {
+    sdkl_ext_npu_unmap(g->domain, fd_a, g->A, a_bytes);
+  }
+
+  return ret;
+}
+
+int sdkl_grouped_mm_f16f16_f16(
+  int domain,
+  size_t n_groups,
+  const size_t* offsets,
+  size_t n_col,
+  size_t n_inner,
+  _Float16* A,
+  const _Float16* X,
+  const _Float16* const* W
+) {
+  sdkl_grouped_args_t g = {
+    .domain   = domain,
+    .n_groups = n_groups,
+    .offsets  = offsets,
+    .n_col    = n_col,
+    .n_inner  = n_inner,
+    .A        = A,
+    .X        = X,
+    .W        = (const void* const*)W,
+    .w_dtype  = SDKL_DTYPE_FP16,
+    .a_size   = sizeof(_Float16),
+    .x_size   = sizeof(_Float16),
+  };
+
+  return grouped_mm(&g);
+}
+
+int sdkl_grouped_mm_u8i4_i32(
+  int domain,
+  size_t n_groups,
+  const size_t* offsets,
+  size_t n_col,
+  size_t n_inner,
+  int32_t* A,
+  const uint8_t* X,
+  const uint8_t* const* W
+) {
+  sdkl_grouped_args_t g = {
+    .domain   = domain,
+    .n_groups = n_groups,
+    .offsets  = offsets,
+    .n_col    = n_col,
+    .n_inner  = n_inner,
+    .A        = A,
+    .X        = X,
+    .W        = (const void* const*)W,
+    .w_dtype  = SDKL_DTYPE_I4,
+    .a_size   = sizeof(int32_t),
+    .x_size   = sizeof(uint8_t),
+  };
+
+  return grouped_mm(&g);
+}
@@ -0,0 +1,177 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Matrix multiplication split by output columns between an NPU and the CPU engine.
+
+  The NPU shard (first columns) is submitted to the NPU queue, then the CPU shard (remaining columns) runs on the
+  calling thread. Each shard is timed on the thread that executes it; the throughputs, in output elements per
+  microsecond, are smoothed over calls and the CPU fraction is set to cpu_rate / (cpu_rate + npu_rate), at which
+  both shards take the same time.
+*/
+
+#define SDKL_HETERO_SMOOTHING (0.5f) // weight of the newest throughput measurement
+
+struct sdkl_hetero {
+  sdkl_tensor_platform_e npu_platform;
+  uint32_t adaptive;
+  float cpu_fraction;
+  float cpu_rate; // output elements per microsecond, 0 until measured
+  float npu_rate;
+  uint64_t split;
+  uint64_t last_us;
+};
+
+int sdkl_hetero_create(const sdkl_hetero_config_t* config, sdkl_hetero_t** hetero) {
+  sdkl_hetero_t* h;
+
+  if (config == NULL || hetero == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (config->npu_platform != SDKL_PLATFORM_NPU0 && config->npu_platform != SDKL_PLATFORM_NPU1) {
+    return AEE_EBADPARM;
+  }
+  if (!(config->cpu_fraction >= 0.0f && config->cpu_fraction <= 1.0f)) {
+    return AEE_EBADPARM;
+  }
+
+  h = calloc(1, sizeof(*h));
+  if (h == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  h->npu_platform = config->npu_platform;
+  h->adaptive     = config->adaptive;
+  h->cpu_fraction = config->cpu_fraction;
+
+  *hetero = h;
+  return AEE_SUCCESS;
+}
+
+int sdkl_hetero_destroy(sdkl_hetero_t* hetero) {
+  free(hetero);
+  return AEE_SUCCESS;
+}
+
+int sdkl_hetero_get_info(const sdkl_hetero_t* hetero, sdkl_hetero_info_t* info) {
+  if (hetero == NULL || info == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  info->cpu_fraction = hetero->cpu_fraction;
+  info->split        = hetero->split;
+  info->cpu_rate     = hetero->cpu_rate;
+  info->npu_rate     = hetero->npu_rate;
+  info->last_us      = hetero->last_us;
+  return AEE_SUCCESS;
+}
+
+/* Returns the first CPU column of `n_col` columns, rounded to SDKL_HETERO_ALIGN. */
+static uint64_t split_point(const sdkl_hetero_t* h, uint64_t n_col) {
+  uint64_t split = (uint64_t)((1.0 - h->cpu_fraction) * (double)n_col + 0.5);
+
+  split = SDKL_EXT_MIN((split + SDKL_HETERO_ALIGN / 2) / SDKL_HETERO_ALIGN * SDKL_HETERO_ALIGN, n_col);
+
+  // Both backends get columns until both throughputs are measured
+  if (h->adaptive && (h->cpu_rate == 0.0f || h->npu_rate == 0.0f) && n_col > SDKL_HETERO_ALIGN) {
+    split = SDKL_EXT_MAX(split, SDKL_HETERO_ALIGN);
+    split = SDKL_EXT_MIN(split, (n_col - 1) / SDKL_HETERO_ALIGN * SDKL_HETERO_ALIGN);
+  }
+  return split;
+}
+
+static float smooth(float rate, float sample) {
+  return rate == 0.0f ? sample : rate + SDKL_HETERO_SMOOTHING * (sample - rate);
+}
+
+/* Runs the NPU shard on the NPU queue and stores its duration in job->ctx. */
+static int run_npu_shard(const sdkl_queue_job_t* job) {
+  sdkl_tensor_t result = job->tensors[0];
+  uint64_t start       = sdkl_ext_time_us();
+  int ret;
+
+  ret                  = sdkl_ext_mm_tensor(job->platform, &result, &job->tensors[1], &job->tensors[2]);
+  *(uint64_t*)job->ctx = sdkl_ext_time_us() - start;
+  return ret;
+}
+
+int sdkl_ext_mm_tensor_hetero(
+  sdkl_hetero_t* hetero,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor
+) {
+  sdkl_tensor_t r_cpu, w_cpu;
+  sdkl_queue_job_t job;
+  sdkl_fence_t fence;
+  uint64_t n_row, n_col, n_inner, split, start;
+  uint64_t cpu_us = 0, npu_us = 0;
+  int ret, ret_npu = AEE_SUCCESS;
+
+  if (hetero == NULL) {
+    return AEE_EBADPARM;
+  }
+  ret = sdkl_mm_tensor_validate(result_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+  if (!sdkl_ext_can_slice_cols(result_tensor, right_tensor)) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  n_row   = result_tensor->dims[0];
+  n_col   = result_tensor->dims[1];
+  n_inner = left_tensor->dims[1];
+  split   = split_point(hetero, n_col);
+  start   = sdkl_ext_time_us();
+
+  if (split > 0) {
+    memset(&job, 0, sizeof(job));
+    job.fn         = run_npu_shard;
+    job.platform   = hetero->npu_platform;
+    job.tensors[1] = *left_tensor;
+    job.ctx        = &npu_us;
+    sdkl_ext_slice_cols(&job.tensors[0], &job.tensors[2], result_tensor, right_tensor, n_inner, 0, split);
+
+    ret = sdkl_queue_submit(&job, &fence);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+  }
+
+  if (split < n_col) {
+    sdkl_ext_slice_cols(&r_cpu, &w_cpu, result_tensor, right_tensor, n_inner, split, n_col - split);
+    ret    = sdkl_cpu_mm_tensor(&r_cpu, left_tensor, &w_cpu);
+    cpu_us = sdkl_ext_time_us() - start;
+  }
+
+  if (split > 0) {
+    ret_npu = sdkl_fence_wait(&fence);
+  }
+  hetero->last_us = sdkl_ext_time_us() - start;
+  hetero->split   = split;
+
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+  if (ret_npu != AEE_SUCCESS) {
+    return ret_npu;
+  }
+
+  if (split > 0 && npu_us > 0) {
+    hetero->npu_rate = smooth(hetero->npu_rate, (float)(n_row * split) / (float)npu_us);
+  }
+  if (split < n_col && cpu_us > 0) {
+    hetero->cpu_rate = smooth(hetero->cpu_rate, (float)(n_row * (n_col - split)) / (float)cpu_us);
+  }
+  if (hetero->adaptive && hetero->cpu_rate > 0.0f && hetero->npu_rate > 0.0f) {
+    hetero->cpu_fraction = hetero->cpu_rate / (hetero->cpu_rate + hetero->npu_rate);
+  }
+
+  return AEE_SUCCESS;
+}
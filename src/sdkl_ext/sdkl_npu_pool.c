@@ -0,0 +1,216 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Size-class pool of sdkl_npu_alloc() buffers.
+
+  Class c holds buffers of SDKL_NPU_POOL_MIN_SIZE << c bytes. Free buffers are kept in a per-thread cache of
+  SDKL_NPU_POOL_THREAD_CACHE buffers per class, accessed without locking, and overflow into a shared free list
+  linked through the first bytes of the free buffers themselves. A thread's cache is moved to the shared free list
+  when the thread exits.
+*/
+
+#define SDKL_NPU_POOL_MIN_SHIFT (12U)
+#define SDKL_NPU_POOL_N_CLASSES (15U) // 4 KB .. 64 MB
+
+typedef struct sdkl_npu_pool_block {
+  struct sdkl_npu_pool_block* next;
+} sdkl_npu_pool_block_t;
+
+typedef struct {
+  void* bufs[SDKL_NPU_POOL_N_CLASSES][SDKL_NPU_POOL_THREAD_CACHE];
+  uint32_t counts[SDKL_NPU_POOL_N_CLASSES];
+} sdkl_npu_pool_cache_t;
+
+static struct {
+  pthread_mutex_t lock;
+  sdkl_npu_pool_block_t* free_lists[SDKL_NPU_POOL_N_CLASSES];
+  atomic_uint_fast64_t hits;
+  atomic_uint_fast64_t misses;
+  atomic_uint_fast64_t bytes_held;
+  atomic_uint_fast64_t bytes_in_use;
+} g_npu_pool = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static pthread_once_t g_cache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_cache_key;
+static __thread sdkl_npu_pool_cache_t* t_cache;
+
+/* Returns the size class of `size`, or -1 if it is larger than SDKL_NPU_POOL_MAX_SIZE. */
+static int size_class(size_t size) {
+  for (uint32_t c = 0; c < SDKL_NPU_POOL_N_CLASSES; c++) {
+    if (size <= ((size_t)1 << (SDKL_NPU_POOL_MIN_SHIFT + c))) {
+      return (int)c;
+    }
+  }
+  return -1;
+}
+
+static size_t class_size(int c) {
+  return (size_t)1 << (SDKL_NPU_POOL_MIN_SHIFT + c);
+}
+
+/* Pushes `buffer` on the shared free list of class `c`. Called with the lock held. */
+static void push_shared(int c, void* buffer) {
+  sdkl_npu_pool_block_t* block = (sdkl_npu_pool_block_t*)buffer;
+
+  block->next             = g_npu_pool.free_lists[c];
+  g_npu_pool.free_lists[c] = block;
+}
+
+/* Moves the buffers of `cache` to the shared free lists. */
+static void flush_cache(sdkl_npu_pool_cache_t* cache) {
+  pthread_mutex_lock(&g_npu_pool.lock);
+  for (int c = 0; c < (int)SDKL_NPU_POOL_N_CLASSES; c++) {
+    while (cache->counts[c] > 0) {
+      push_shared(c, cache->bufs[c][--cache->counts[c]]);
+    }
+  }
+  pthread_mutex_unlock(&g_npu_pool.lock);
+}
+
+static void cache_destructor(void* cache) {
+  flush_cache((sdkl_npu_pool_cache_t*)cache);
+  free(cache);
+}
+
+static void create_cache_key(void) {
+  pthread_key_create(&g_cache_key, cache_destructor);
+}
+
+/* Returns the cache of the calling thread, or NULL if it cannot be created. */
+static sdkl_npu_pool_cache_t* get_cache(void) {
+  if (t_cache == NULL) {
+    pthread_once(&g_cache_once, create_cache_key);
+    t_cache = calloc(1, sizeof(*t_cache));
+    if (t_cache != NULL && pthread_setspecific(g_cache_key, t_cache) != 0) {
+      free(t_cache);
+      t_cache = NULL;
+    }
+  }
+  return t_cache;
+}
+
+int sdkl_npu_pool_alloc(size_t size, void** buffer_ptr) {
+  sdkl_npu_pool_cache_t* cache;
+  void* buffer = NULL;
+  int c;
+  int ret;
+
+  if (buffer_ptr == NULL || size == 0) {
+    return AEE_EBADPARM;
+  }
+
+  c = size_class(size);
+  if (c < 0) {
+    atomic_fetch_add(&g_npu_pool.misses, 1);
+    ret = sdkl_npu_alloc(size, buffer_ptr);
+    if (ret == AEE_SUCCESS) {
+      atomic_fetch_add(&g_npu_pool.bytes_in_use, size);
+    }
+    return ret;
+  }
+
+  cache = get_cache();
+  if (cache != NULL && cache->counts[c] > 0) {
+    buffer = cache->bufs[c][--cache->counts[c]];
+  } else {
+    pthread_mutex_lock(&g_npu_pool.lock);
+    if (g_npu_pool.free_lists[c] != NULL) {
+      buffer                   = g_npu_pool.free_lists[c];
+      g_npu_pool.free_lists[c] = g_npu_pool.free_lists[c]->next;
+    }
+    pthread_mutex_unlock(&g_npu_pool.lock);
+  }
+
+  if (buffer != NULL) {
+    atomic_fetch_add(&g_npu_pool.hits, 1);
+    atomic_fetch_sub(&g_npu_pool.bytes_held, class_size(c));
+  } else {
+    atomic_fetch_add(&g_npu_pool.misses, 1);
+    ret = sdkl_npu_alloc(class_size(c), &buffer);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+  }
+
+  atomic_fetch_add(&g_npu_pool.bytes_in_use, class_size(c));
+  *buffer_ptr = buffer;
+  return AEE_SUCCESS;
+}
+
+int sdkl_npu_pool_free(void* buffer, size_t size) {
+  sdkl_npu_pool_cache_t* cache;
+  int c;
+
+  if (buffer == NULL) {
+    return AEE_SUCCESS;
+  }
+  if (size == 0) {
+    return AEE_EBADPARM;
+  }
+
+  c = size_class(size);
+  if (c < 0) {
+    atomic_fetch_sub(&g_npu_pool.bytes_in_use, size);
+    return sdkl_npu_free(buffer);
+  }
+
+  atomic_fetch_sub(&g_npu_pool.bytes_in_use, class_size(c));
+  atomic_fetch_add(&g_npu_pool.bytes_held, class_size(c));
+
+  cache = get_cache();
+  if (cache != NULL && cache->counts[c] < SDKL_NPU_POOL_THREAD_CACHE) {
+    cache->bufs[c][cache->counts[c]++] = buffer;
+    return AEE_SUCCESS;
+  }
+
+  pthread_mutex_lock(&g_npu_pool.lock);
+  push_shared(c, buffer);
+  pthread_mutex_unlock(&g_npu_pool.lock);
+  return AEE_SUCCESS;
+}
+
+int sdkl_npu_pool_trim(size_t max_bytes_held) {
+  int ret = AEE_SUCCESS;
+
+  if (t_cache != NULL) {
+    flush_cache(t_cache);
+  }
+
+  pthread_mutex_lock(&g_npu_pool.lock);
+  for (int c = (int)SDKL_NPU_POOL_N_CLASSES - 1; c >= 0; c--) {
+    while (g_npu_pool.free_lists[c] != NULL && atomic_load(&g_npu_pool.bytes_held) > max_bytes_held) {
+      sdkl_npu_pool_block_t* block = g_npu_pool.free_lists[c];
+      int free_ret;
+
+      g_npu_pool.free_lists[c] = block->next;
+      atomic_fetch_sub(&g_npu_pool.bytes_held, class_size(c));
+      free_ret = sdkl_npu_free(block);
+      if (free_ret != AEE_SUCCESS && ret == AEE_SUCCESS) {
+        ret = free_ret;
+      }
+    }
+  }
+  pthread_mutex_unlock(&g_npu_pool.lock);
+
+  return ret;
+}
+
+int sdkl_npu_pool_get_stats(sdkl_npu_pool_stats_t* stats) {
+  if (stats == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  stats->hits         = atomic_load(&g_npu_pool.hits);
+  stats->misses       = atomic_load(&g_npu_pool.misses);
+  stats->bytes_held   = atomic_load(&g_npu_pool.bytes_held);
+  stats->bytes_in_use = atomic_load(&g_npu_pool.bytes_in_use);
+  return AEE_SUCCESS;
+}
@@ -0,0 +1,193 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Matrix multiplication plans.
+
+  Everything derived from the descriptors is computed at creation. Data pointers enter only at execution, through
+  the byte offsets of the tensors' data in their buffers.
+*/
+
+typedef enum {
+  SDKL_PLAN_CPU,        // CPU engine with a precomputed schedule
+  SDKL_PLAN_NPU_DIRECT, // sdkl_npu_mm_*() kernel selected at creation
+  SDKL_PLAN_NPU_TENSOR  // sdkl_mm_tensor() with the stored descriptors
+} sdkl_plan_kind_e;
+
+typedef enum {
+  SDKL_PLAN_F32F16_F32,
+  SDKL_PLAN_F16F16_F16,
+  SDKL_PLAN_U8I8_I32,
+  SDKL_PLAN_U8I4_I32
+} sdkl_plan_kernel_e;
+
+struct sdkl_mm_plan {
+  sdkl_plan_kind_e kind;
+  sdkl_tensor_platform_e platform;
+  size_t offsets[3];                 // byte offsets of the result, left and right data in their buffers
+  sdkl_cpu_gemm_schedule_t schedule; // SDKL_PLAN_CPU
+  sdkl_cpu_gemm_args_t args;         // SDKL_PLAN_CPU, data pointers bound at execution
+  sdkl_plan_kernel_e kernel;         // SDKL_PLAN_NPU_DIRECT
+  int n_row;
+  int n_col;
+  int n_inner;
+  sdkl_tensor_t tensors[3];          // SDKL_PLAN_NPU_TENSOR, data pointers bound at execution
+};
+
+static size_t data_offset_bytes(const sdkl_tensor_t* t) {
+  return (size_t)t->data_offset * sdkl_ext_dtype_size(t->data_dtype);
+}
+
+/* Selects the sdkl_npu_mm_*() kernel equivalent to sdkl_mm_tensor() on the tensors. Returns 0 if there is none. */
+static int select_npu_kernel(
+  sdkl_plan_kernel_e* kernel,
+  const sdkl_tensor_t* r,
+  const sdkl_tensor_t* x,
+  const sdkl_tensor_t* w
+) {
+  if (w->layout != SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX || x->layout != SDKL_LAYOUT_2D_ROW_MAJOR ||
+      r->layout != SDKL_LAYOUT_2D_ROW_MAJOR) {
+    return 0;
+  }
+  if (!x->is_continuous || !r->is_continuous || x->data_offset != 0 || r->data_offset != 0 || w->data_offset != 0) {
+    return 0;
+  }
+  if (r->dims[0] > INT_MAX || r->dims[1] > INT_MAX || x->dims[1] > INT_MAX) {
+    return 0;
+  }
+
+  if (x->data_dtype == SDKL_DTYPE_FP32 && w->data_dtype == SDKL_DTYPE_FP16 && r->data_dtype == SDKL_DTYPE_FP32) {
+    *kernel = SDKL_PLAN_F32F16_F32;
+  } else if (x->data_dtype == SDKL_DTYPE_FP16 && w->data_dtype == SDKL_DTYPE_FP16 &&
+             r->data_dtype == SDKL_DTYPE_FP16) {
+    *kernel = SDKL_PLAN_F16F16_F16;
+  } else if (x->data_dtype == SDKL_DTYPE_U8 && w->data_dtype == SDKL_DTYPE_I8 && r->data_dtype == SDKL_DTYPE_I32) {
+    *kernel = SDKL_PLAN_U8I8_I32;
+  } else if (x->data_dtype == SDKL_DTYPE_U8 && w->data_dtype == SDKL_DTYPE_I4 && r->data_dtype == SDKL_DTYPE_I32) {
+    *kernel = SDKL_PLAN_U8I4_I32;
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+int sdkl_mm_plan_create(
+  sdkl_tensor_platform_e platform,
+  const sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor,
+  sdkl_mm_plan_t** plan
+) {
+  sdkl_mm_plan_t* p;
+  int ret;
+
+  if (plan == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (platform != SDKL_PLATFORM_CPU && platform != SDKL_PLATFORM_NPU0 && platform != SDKL_PLATFORM_NPU1) {
+    return AEE_EBADPARM;
+  }
+
+  p = calloc(1, sizeof(*p));
+  if (p == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  p->platform = platform;
+
+  if (platform == SDKL_PLATFORM_CPU) {
+    p->kind = SDKL_PLAN_CPU;
+    ret     = sdkl_cpu_gemm_args_from_tensors(&p->args, result_tensor, left_tensor, right_tensor);
+    if (ret == AEE_SUCCESS) {
+      ret = sdkl_cpu_gemm_schedule(&p->schedule, &p->args);
+    }
+    if (ret == AEE_SUCCESS) {
+      ret = sdkl_cpu_pool_reserve(p->schedule.scratch_size);
+    }
+  } else {
+    ret = sdkl_mm_tensor_validate(result_tensor, left_tensor, right_tensor);
+    if (ret == AEE_SUCCESS) {
+      p->kind = select_npu_kernel(&p->kernel, result_tensor, left_tensor, right_tensor) ? SDKL_PLAN_NPU_DIRECT
+                                                                                          : SDKL_PLAN_NPU_TENSOR;
+      p->n_row      = (int)result_tensor->dims[0];
+      p->n_col      = (int)result_tensor->dims[1];
+      p->n_inner    = (int)left_tensor->dims[1];
+      p->tensors[0] = *result_tensor;
+      p->tensors[1] = *left_tensor;
+      p->tensors[2] = *right_tensor;
+    }
+  }
+  if (ret != AEE_SUCCESS) {
+    free(p);
+    return ret;
+  }
+
+  p->offsets[0] = data_offset_bytes(result_tensor);
+  p->offsets[1] = data_offset_bytes(left_tensor);
+  p->offsets[2] = data_offset_bytes(right_tensor);
+
+  *plan = p;
+  return AEE_SUCCESS;
+}
+
+static int execute_npu_direct(const sdkl_mm_plan_t* p, void* A, const void* X, const void* W) {
+  switch (p->kernel) {
+    case SDKL_PLAN_F32F16_F32:
+      return sdkl_npu_mm_f32f16_f32(p->platform, p->n_row, p->n_col, p->n_inner, A, X, W);
+    case SDKL_PLAN_F16F16_F16:
+      return sdkl_npu_mm_f16f16_f16(p->platform, p->n_row, p->n_col, p->n_inner, A, X, W);
+    case SDKL_PLAN_U8I8_I32:
+      return sdkl_npu_mm_u8i8_i32(p->platform, p->n_row, p->n_col, p->n_inner, A, X, W);
+    default:
+      return sdkl_npu_mm_u8i4_i32(p->platform, p->n_row, p->n_col, p->n_inner, A, X, W);
+  }
+}
+
+int sdkl_mm_plan_execute(const sdkl_mm_plan_t* plan, void* result, const void* left, const void* right) {
+  if (plan == NULL || result == NULL || left == NULL || right == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  switch (plan->kind) {
+    case SDKL_PLAN_CPU: {
+      sdkl_cpu_gemm_args_t args = plan->args;
+
+      args.a = (uint8_t*)result + plan->offsets[0];
+      args.x = (const uint8_t*)left + plan->offsets[1];
+      args.w = (const uint8_t*)right + plan->offsets[2];
+      return sdkl_cpu_gemm_run(&plan->schedule, &args, 1);
+    }
+    case SDKL_PLAN_NPU_DIRECT: {
+      uint64_t span  = sdkl_ext_trace_begin();
+      uint64_t start = sdkl_ext_time_ns();
+      int ret        = execute_npu_direct(plan, result, left, right);
+
+      if (ret == AEE_SUCCESS) {
+        sdkl_ext_stats_add_tensor_mm(
+          plan->platform, &plan->tensors[0], &plan->tensors[1], &plan->tensors[2], sdkl_ext_time_ns() - start
+        );
+      }
+      sdkl_ext_trace_end("sdkl_mm_plan_execute", "npu", span);
+      return ret;
+    }
+    default: {
+      sdkl_tensor_t tensors[3] = {plan->tensors[0], plan->tensors[1], plan->tensors[2]};
+
+      tensors[0].data = result;
+      tensors[1].data = (void*)left;
+      tensors[2].data = (void*)right;
+      return sdkl_ext_mm_tensor(plan->platform, &tensors[0], &tensors[1], &tensors[2]);
+    }
+  }
+}
+
+int sdkl_mm_plan_destroy(sdkl_mm_plan_t* plan) {
+  free(plan);
+  return AEE_SUCCESS;
+}
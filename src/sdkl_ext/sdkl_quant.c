@@ -0,0 +1,346 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "sdkl_ext_internal.h"
+
+#define SDKL_QUANT_ROWS_PER_TASK   (16U)
+#define SDKL_QUANT_GROUP_ALIGNMENT (32U)
+
+int sdkl_cpu_quant_resolve(
+  sdkl_cpu_quant_t* resolved,
+  const sdkl_quant_params_t* x_quant,
+  const sdkl_quant_params_t* w_quant,
+  size_t k
+) {
+  if (x_quant == NULL || w_quant == NULL || x_quant->scales == NULL || w_quant->scales == NULL || k == 0) {
+    return AEE_EBADPARM;
+  }
+  if (x_quant->mode >= SDKL_QMODE_INVALID || w_quant->mode >= SDKL_QMODE_INVALID) {
+    return AEE_EBADPARM;
+  }
+  if (x_quant->mode == SDKL_QMODE_PER_GROUP) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  resolved->group_size    = k;
+  resolved->x_scales      = x_quant->scales;
+  resolved->x_zero_points = x_quant->zero_points;
+  resolved->x_rs          = x_quant->mode == SDKL_QMODE_PER_CHANNEL ? 1 : 0;
+  resolved->w_scales      = w_quant->scales;
+  resolved->w_zero_points = w_quant->zero_points;
+  resolved->w_rs          = w_quant->mode == SDKL_QMODE_PER_CHANNEL ? 1 : 0;
+  resolved->w_gs          = 0;
+
+  if (w_quant->mode == SDKL_QMODE_PER_GROUP) {
+    size_t group_size = w_quant->group_size;
+    if (group_size == 0 || group_size % SDKL_QUANT_GROUP_ALIGNMENT != 0 || k % group_size != 0) {
+      return AEE_EBADPARM;
+    }
+    resolved->group_size = group_size;
+    resolved->w_rs       = k / group_size;
+    resolved->w_gs       = 1;
+  }
+
+  return AEE_SUCCESS;
+}
+
+void sdkl_cpu_quant_accumulate(
+  const sdkl_cpu_quant_t* quant,
+  float* v,
+  const int32_t* acc,
+  size_t i,
+  size_t j0,
+  size_t n,
+  size_t g,
+  int32_t x_sum,
+  const int32_t* w_sums
+) {
+  const float* w_scales = quant->w_scales + j0 * quant->w_rs + g * quant->w_gs;
+  float x_scale         = quant->x_scales[i * quant->x_rs];
+  int64_t x_zero        = quant->x_zero_points != NULL ? quant->x_zero_points[i * quant->x_rs] : 0;
+  size_t rs             = quant->w_rs;
+
+  if (x_zero == 0 && quant->w_zero_points == NULL) {
+    for (size_t j = 0; j < n; j++) {
+      v[j] += x_scale * w_scales[j * rs] * (float)acc[j];
+    }
+    return;
+  }
+
+  // sum((x - zx) * (w - zw)) = acc - zx * sum(w) - zw * sum(x) + group_size * zx * zw
+  const int32_t* w_zeros = quant->w_zero_points != NULL ? quant->w_zero_points + j0 * rs + g * quant->w_gs : NULL;
+  for (size_t j = 0; j < n; j++) {
+    int64_t t = acc[j];
+    if (x_zero != 0) {
+      t -= x_zero * w_sums[j];
+    }
+    if (w_zeros != NULL) {
+      t += (int64_t)w_zeros[j * rs] * ((int64_t)quant->group_size * x_zero - x_sum);
+    }
+    v[j] += x_scale * w_scales[j * rs] * (float)t;
+  }
+}
+
+/*
+  Sums of the quantized values of every row of `t` along the inner dimension. The data of a row-major or
+  column-major tensor is read directly; `given` is required for HMX layouts.
+*/
+static int row_sums(const sdkl_tensor_t* t, size_t rows, size_t k, bool is_rhs, const int32_t* given, int32_t** sums) {
+  size_t rs, cs;
+
+  *sums = malloc(rows * sizeof(int32_t));
+  if (*sums == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  if (given != NULL) {
+    for (size_t r = 0; r < rows; r++) {
+      (*sums)[r] = given[r];
+    }
+    return AEE_SUCCESS;
+  }
+
+  if (t->data_dtype == SDKL_DTYPE_I4) {
+    return AEE_EBADPARM;
+  }
+  if (t->layout != SDKL_LAYOUT_2D_ROW_MAJOR && t->layout != SDKL_LAYOUT_2D_COL_MAJOR) {
+    return AEE_EBADPARM;
+  }
+  if (!is_rhs) {
+    rs = t->strides[0];
+    cs = t->strides[1];
+  } else if (t->layout == SDKL_LAYOUT_2D_ROW_MAJOR) {
+    rs = k; // transposed weights W[n_col][n_inner], as in sdkl_cpu_gemm_args_from_tensors()
+    cs = 1;
+  } else {
+    rs = 1;
+    cs = rows;
+  }
+
+  const uint8_t* base = (const uint8_t*)t->data + t->data_offset;
+  for (size_t r = 0; r < rows; r++) {
+    int32_t sum = 0;
+    for (size_t q = 0; q < k; q++) {
+      uint8_t b = base[r * rs + q * cs];
+      sum += t->data_dtype == SDKL_DTYPE_I8 ? (int32_t)(int8_t)b : (int32_t)b;
+    }
+    (*sums)[r] = sum;
+  }
+
+  return AEE_SUCCESS;
+}
+
+/*
+  Dequantization pass used on NPU platforms: every pool task converts a block of int32 result rows, applies the
+  epilogue and stores the block in the result type.
+*/
+typedef struct {
+  const sdkl_cpu_quant_t* quant;
+  const sdkl_cpu_epilogue_t* epilogue;
+  const int32_t* acc;
+  size_t acc_rs;
+  void* a;
+  size_t a_rs;
+  sdkl_tensor_dtype_e a_dtype;
+  const int32_t* x_sums;
+  const int32_t* w_sums;
+  size_t m;
+  size_t n;
+  atomic_int error;
+} sdkl_quant_job_t;
+
+static void dequant_task(void* ctx, uint32_t task, uint32_t thread_idx) {
+  sdkl_quant_job_t* job = (sdkl_quant_job_t*)ctx;
+  size_t i0             = (size_t)task * SDKL_QUANT_ROWS_PER_TASK;
+  size_t i1             = SDKL_EXT_MIN(i0 + SDKL_QUANT_ROWS_PER_TASK, job->m);
+
+  float* v = (float*)sdkl_cpu_pool_scratch(thread_idx, job->n * sizeof(float));
+  if (v == NULL) {
+    atomic_store(&job->error, AEE_ENOMEMORY);
+    return;
+  }
+
+  for (size_t i = i0; i < i1; i++) {
+    int32_t x_sum = job->x_sums != NULL ? job->x_sums[i] : 0;
+
+    for (size_t j = 0; j < job->n; j++) {
+      v[j] = 0.f;
+    }
+    sdkl_cpu_quant_accumulate(job->quant, v, job->acc + i * job->acc_rs, i, 0, job->n, 0, x_sum, job->w_sums);
+    if (job->epilogue != NULL) {
+      sdkl_cpu_epilogue_apply(job->epilogue, v, i, 0, job->n);
+    }
+
+    if (job->a_dtype == SDKL_DTYPE_FP32) {
+      float* row = (float*)job->a + i * job->a_rs;
+      for (size_t j = 0; j < job->n; j++) {
+        row[j] = v[j];
+      }
+    } else {
+      _Float16* row = (_Float16*)job->a + i * job->a_rs;
+      for (size_t j = 0; j < job->n; j++) {
+        row[j] = (_Float16)v[j];
+      }
+    }
+  }
+}
+
+static int npu_mm_tensor_quant(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_quant_params_t* left_quant,
+  const sdkl_tensor_t* right_tensor,
+  const sdkl_quant_params_t* right_quant,
+  const sdkl_cpu_quant_t* quant,
+  const sdkl_cpu_epilogue_t* epilogue
+) {
+  const sdkl_tensor_t* r = result_tensor;
+  size_t m               = r->dims[0];
+  size_t n               = r->dims[1];
+  size_t k               = left_tensor->dims[1];
+  size_t n_tasks         = (m + SDKL_QUANT_ROWS_PER_TASK - 1) / SDKL_QUANT_ROWS_PER_TASK;
+  sdkl_tensor_t acc_tensor;
+  sdkl_quant_job_t job;
+  uint64_t span;
+  int32_t* x_sums = NULL;
+  int32_t* w_sums = NULL;
+  int32_t* acc    = NULL;
+  int ret         = AEE_SUCCESS;
+
+  if (quant->group_size != k) {
+    return AEE_EUNSUPPORTED;
+  }
+  if (n_tasks > UINT32_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  // FP32 results hold the int32 products in place; FP16 results need an intermediate buffer
+  acc_tensor            = *r;
+  acc_tensor.data_dtype = SDKL_DTYPE_I32;
+  if (r->data_dtype == SDKL_DTYPE_FP16) {
+    ret = sdkl_npu_alloc(m * n * sizeof(int32_t), (void**)&acc);
+    if (ret != AEE_SUCCESS) {
+      ret = AEE_ENOMEMORY;
+      goto bail;
+    }
+    acc_tensor.data          = acc;
+    acc_tensor.data_offset   = 0;
+    acc_tensor.num_elements  = m * n;
+    acc_tensor.strides[0]    = n;
+    acc_tensor.is_continuous = 1;
+  }
+
+  ret = sdkl_ext_mm_tensor(platform, &acc_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    goto bail;
+  }
+
+  // The sums read the operands, which sdkl_mm_tensor() has validated
+  if (quant->w_zero_points != NULL) {
+    ret = row_sums(left_tensor, m, k, false, left_quant->sums, &x_sums);
+  }
+  if (ret == AEE_SUCCESS && quant->x_zero_points != NULL) {
+    ret = row_sums(right_tensor, n, k, true, right_quant->sums, &w_sums);
+  }
+  if (ret != AEE_SUCCESS) {
+    goto bail;
+  }
+
+  job.quant    = quant;
+  job.epilogue = epilogue;
+  job.acc      = (const int32_t*)acc_tensor.data + acc_tensor.data_offset;
+  job.acc_rs   = acc_tensor.strides[0];
+  job.a        = (uint8_t*)r->data + r->data_offset * sdkl_ext_dtype_size(r->data_dtype);
+  job.a_rs     = r->strides[0];
+  job.a_dtype  = r->data_dtype;
+  job.x_sums   = x_sums;
+  job.w_sums   = w_sums;
+  job.m        = m;
+  job.n        = n;
+  atomic_init(&job.error, AEE_SUCCESS);
+
+  span = sdkl_ext_trace_begin();
+  ret  = sdkl_cpu_pool_run((uint32_t)n_tasks, dequant_task, &job);
+  sdkl_ext_trace_end("dequant", "cpu", span);
+  if (ret == AEE_SUCCESS) {
+    ret = atomic_load(&job.error);
+  }
+
+bail:
+  if (acc != NULL) {
+    sdkl_npu_free(acc);
+  }
+  free(x_sums);
+  free(w_sums);
+  return ret;
+}
+
+int sdkl_ext_mm_tensor_quant(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_quant_params_t* left_quant,
+  const sdkl_tensor_t* restrict right_tensor,
+  const sdkl_quant_params_t* right_quant,
+  const sdkl_epilogue_t* epilogue
+) {
+  const sdkl_tensor_t* r = result_tensor;
+  const sdkl_tensor_t* x = left_tensor;
+  const sdkl_tensor_t* w = right_tensor;
+  sdkl_cpu_epilogue_t resolved_epilogue;
+  sdkl_cpu_epilogue_t* ep = NULL;
+  sdkl_cpu_quant_t quant;
+  int ret;
+
+  if (r == NULL || x == NULL || w == NULL || r->data == NULL || x->data == NULL || w->data == NULL) {
+    return AEE_EBADPARM;
+  }
+  if (r->ndims != 2 || x->ndims != 2 || w->ndims != 2 || r->dims[0] != x->dims[0] || r->dims[0] == 0 ||
+      r->dims[1] == 0) {
+    return AEE_EBADPARM;
+  }
+  if (r->data_dtype != SDKL_DTYPE_FP32 && r->data_dtype != SDKL_DTYPE_FP16) {
+    return AEE_EUNSUPPORTED;
+  }
+  if (r->layout != SDKL_LAYOUT_2D_ROW_MAJOR || r->strides[1] != 1 || r->strides[0] < r->dims[1]) {
+    return AEE_EUNSUPPORTED;
+  }
+  if (x->data_dtype != SDKL_DTYPE_U8 || (w->data_dtype != SDKL_DTYPE_I8 && w->data_dtype != SDKL_DTYPE_I4)) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  ret = sdkl_cpu_quant_resolve(&quant, left_quant, right_quant, x->dims[1]);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+  if (epilogue != NULL) {
+    ret = sdkl_cpu_epilogue_resolve(&resolved_epilogue, epilogue, r);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+    ep = &resolved_epilogue;
+  }
+
+  if (platform == SDKL_PLATFORM_CPU) {
+    sdkl_cpu_gemm_args_t args;
+
+    if (w->data_dtype != SDKL_DTYPE_I8) {
+      return AEE_EUNSUPPORTED;
+    }
+    ret = sdkl_cpu_gemm_args_from_tensors(&args, r, x, w);
+    if (ret != AEE_SUCCESS) {
+      return ret;
+    }
+    args.quant    = &quant;
+    args.epilogue = ep;
+
+    return sdkl_cpu_gemm(&args);
+  }
+
+  return npu_mm_tensor_quant(platform, result_tensor, x, left_quant, w, right_quant, &quant, ep);
+}
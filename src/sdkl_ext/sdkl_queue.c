@@ -0,0 +1,264 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <pthread.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  In-order submission queues, one per platform.
+
+  Operations live in a ring of SDKL_QUEUE_MAX_DEPTH slots indexed by sequence number. A single worker thread
+  per queue executes them in submission order. Completion statuses are kept for the last SDKL_FENCE_HISTORY
+  sequence numbers so fences stay plain values.
+*/
+
+#define SDKL_QUEUE_COUNT (3U)
+
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t work_cond; // new operation or shutdown
+  pthread_cond_t done_cond; // operation completed
+  pthread_t worker;
+  sdkl_tensor_platform_e platform;
+  uint32_t started;
+  uint32_t shutdown;
+  uint32_t depth;
+  uint64_t submitted; // sequence number of the last submitted operation
+  uint64_t completed; // sequence number of the last completed operation
+  int first_error;    // first failure since the last sync
+  sdkl_queue_job_t jobs[SDKL_QUEUE_MAX_DEPTH];
+  int status[SDKL_FENCE_HISTORY];
+} sdkl_queue_t;
+
+#define SDKL_QUEUE_INITIALIZER(p) \
+  { \
+    .lock = PTHREAD_MUTEX_INITIALIZER, .work_cond = PTHREAD_COND_INITIALIZER, \
+    .done_cond = PTHREAD_COND_INITIALIZER, .platform = (p), \
+  }
+
+static sdkl_queue_t g_queues[SDKL_QUEUE_COUNT] = {
+  SDKL_QUEUE_INITIALIZER(SDKL_PLATFORM_CPU),
+  SDKL_QUEUE_INITIALIZER(SDKL_PLATFORM_NPU0),
+  SDKL_QUEUE_INITIALIZER(SDKL_PLATFORM_NPU1),
+};
+
+static sdkl_queue_t* get_queue(sdkl_tensor_platform_e platform) {
+  for (uint32_t q = 0; q < SDKL_QUEUE_COUNT; q++) {
+    if (g_queues[q].platform == platform) {
+      return &g_queues[q];
+    }
+  }
+  return NULL;
+}
+
+static void* queue_worker_main(void* arg) {
+  sdkl_queue_t* q = (sdkl_queue_t*)arg;
+
+  pthread_mutex_lock(&q->lock);
+  for (;;) {
+    while (q->completed == q->submitted && !q->shutdown) {
+      pthread_cond_wait(&q->work_cond, &q->lock);
+    }
+    if (q->completed == q->submitted) {
+      break; // shutdown with an empty queue
+    }
+
+    uint64_t seq         = q->completed + 1;
+    sdkl_queue_job_t job = q->jobs[seq % SDKL_QUEUE_MAX_DEPTH];
+    pthread_mutex_unlock(&q->lock);
+
+    uint64_t span = sdkl_ext_trace_begin();
+    int ret       = job.fn(&job);
+    sdkl_ext_trace_end("queue_job", "queue", span);
+
+    pthread_mutex_lock(&q->lock);
+    q->status[seq % SDKL_FENCE_HISTORY] = ret;
+    if (ret != AEE_SUCCESS && q->first_error == AEE_SUCCESS) {
+      q->first_error = ret;
+    }
+    q->completed = seq;
+    pthread_cond_broadcast(&q->done_cond);
+  }
+  pthread_mutex_unlock(&q->lock);
+
+  return NULL;
+}
+
+int sdkl_queue_submit(const sdkl_queue_job_t* job, sdkl_fence_t* fence) {
+  sdkl_queue_t* q = get_queue(job->platform);
+  uint64_t seq;
+
+  if (q == NULL || job->fn == NULL || fence == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  pthread_mutex_lock(&q->lock);
+  if (!q->started) {
+    q->shutdown = 0;
+    if (pthread_create(&q->worker, NULL, queue_worker_main, q) != 0) {
+      pthread_mutex_unlock(&q->lock);
+      return AEE_EFAILED;
+    }
+    q->started = 1;
+  }
+
+  uint32_t depth = q->depth ? q->depth : SDKL_QUEUE_DEFAULT_DEPTH;
+  if (q->submitted - q->completed >= depth) {
+    uint64_t start = sdkl_ext_time_ns();
+    while (q->submitted - q->completed >= depth) {
+      pthread_cond_wait(&q->done_cond, &q->lock);
+    }
+    sdkl_ext_stats_add_wait(job->platform, sdkl_ext_time_ns() - start);
+  }
+
+  seq                                 = q->submitted + 1;
+  q->jobs[seq % SDKL_QUEUE_MAX_DEPTH] = *job;
+  q->submitted                        = seq;
+  pthread_cond_signal(&q->work_cond);
+  pthread_mutex_unlock(&q->lock);
+
+  fence->platform = job->platform;
+  fence->seq      = seq;
+  return AEE_SUCCESS;
+}
+
+int sdkl_queue_set_depth(sdkl_tensor_platform_e platform, uint32_t depth) {
+  sdkl_queue_t* q = get_queue(platform);
+
+  if (q == NULL || depth == 0 || depth > SDKL_QUEUE_MAX_DEPTH) {
+    return AEE_EBADPARM;
+  }
+
+  pthread_mutex_lock(&q->lock);
+  q->depth = depth;
+  pthread_mutex_unlock(&q->lock);
+
+  return AEE_SUCCESS;
+}
+
+static int fence_status(sdkl_queue_t* q, uint64_t seq) {
+  if (q->completed - seq >= SDKL_FENCE_HISTORY) {
+    return AEE_EEXPIRED;
+  }
+  return q->status[seq % SDKL_FENCE_HISTORY];
+}
+
+int sdkl_fence_wait(const sdkl_fence_t* fence) {
+  sdkl_queue_t* q;
+  int ret;
+
+  if (fence == NULL || (q = get_queue(fence->platform)) == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  pthread_mutex_lock(&q->lock);
+  if (fence->seq == 0 || fence->seq > q->submitted) {
+    ret = AEE_EBADPARM;
+  } else {
+    uint64_t span = sdkl_ext_trace_begin();
+    while (q->completed < fence->seq) {
+      pthread_cond_wait(&q->done_cond, &q->lock);
+    }
+    sdkl_ext_trace_end("fence_wait", "queue", span);
+    ret = fence_status(q, fence->seq);
+  }
+  pthread_mutex_unlock(&q->lock);
+
+  return ret;
+}
+
+int sdkl_fence_poll(const sdkl_fence_t* fence) {
+  sdkl_queue_t* q;
+  int ret;
+
+  if (fence == NULL || (q = get_queue(fence->platform)) == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  pthread_mutex_lock(&q->lock);
+  if (fence->seq == 0 || fence->seq > q->submitted) {
+    ret = AEE_EBADPARM;
+  } else if (q->completed < fence->seq) {
+    ret = AEE_EITEMBUSY;
+  } else {
+    ret = fence_status(q, fence->seq);
+  }
+  pthread_mutex_unlock(&q->lock);
+
+  return ret;
+}
+
+int sdkl_queue_sync(sdkl_tensor_platform_e platform) {
+  sdkl_queue_t* q = get_queue(platform);
+  int ret;
+
+  if (q == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  pthread_mutex_lock(&q->lock);
+  while (q->completed < q->submitted) {
+    pthread_cond_wait(&q->done_cond, &q->lock);
+  }
+  ret            = q->first_error;
+  q->first_error = AEE_SUCCESS;
+  pthread_mutex_unlock(&q->lock);
+
+  return ret;
+}
+
+int sdkl_queue_finalize(sdkl_tensor_platform_e platform) {
+  sdkl_queue_t* q = get_queue(platform);
+  int ret;
+
+  if (q == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  ret = sdkl_queue_sync(platform);
+
+  pthread_mutex_lock(&q->lock);
+  if (q->started) {
+    q->shutdown = 1;
+    pthread_cond_signal(&q->work_cond);
+    pthread_mutex_unlock(&q->lock);
+    pthread_join(q->worker, NULL);
+    pthread_mutex_lock(&q->lock);
+    q->started = 0;
+  }
+  pthread_mutex_unlock(&q->lock);
+
+  return ret;
+}
+
+static int run_mm_tensor(const sdkl_queue_job_t* job) {
+  sdkl_tensor_t result = job->tensors[0];
+
+  return sdkl_ext_mm_tensor(job->platform, &result, &job->tensors[1], &job->tensors[2]);
+}
+
+int sdkl_mm_tensor_async(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  sdkl_fence_t* fence
+) {
+  sdkl_queue_job_t job;
+
+  if (result_tensor == NULL || left_tensor == NULL || right_tensor == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  memset(&job, 0, sizeof(job));
+  job.fn         = run_mm_tensor;
+  job.platform   = platform;
+  job.tensors[0] = *result_tensor;
+  job.tensors[1] = *left_tensor;
+  job.tensors[2] = *right_tensor;
+
+  return sdkl_queue_submit(&job, fence);
+}
@@ -0,0 +1,144 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Sharding of one matrix multiplication across NPU0 and NPU1.
+
+  Shards are described by slices of the caller's tensors: the same data buffers with a larger `data_offset` and a
+  smaller row or column count. The NPU1 shard is submitted to the NPU1 queue first, then the NPU0 shard runs on the
+  calling thread, so both DSPs execute concurrently.
+*/
+
+int sdkl_ext_can_slice_rows(const sdkl_tensor_t* t) {
+  return t->layout == SDKL_LAYOUT_2D_ROW_MAJOR || t->layout == SDKL_LAYOUT_2D_COL_MAJOR;
+}
+
+int sdkl_ext_can_slice_cols(const sdkl_tensor_t* r, const sdkl_tensor_t* w) {
+  return r->layout == SDKL_LAYOUT_2D_ROW_MAJOR && r->strides[1] == 1 && w->layout == SDKL_LAYOUT_2D_ROW_MAJOR &&
+         w->is_continuous;
+}
+
+void sdkl_ext_slice_rows(sdkl_tensor_t* slice, const sdkl_tensor_t* t, uint64_t i0, uint64_t n) {
+  *slice = *t;
+  slice->data_offset += i0 * t->strides[0];
+  slice->dims[0] = n;
+}
+
+void sdkl_ext_slice_cols(
+  sdkl_tensor_t* r_slice,
+  sdkl_tensor_t* w_slice,
+  const sdkl_tensor_t* r,
+  const sdkl_tensor_t* w,
+  uint64_t n_inner,
+  uint64_t j0,
+  uint64_t n
+) {
+  *r_slice = *r;
+  r_slice->data_offset += j0;
+  r_slice->dims[1]       = n;
+  r_slice->is_continuous = r->is_continuous && r->strides[0] == n;
+
+  // Weights are stored W[n_col][n_inner] whichever way their dimensions are listed
+  *w_slice = *w;
+  w_slice->data_offset += j0 * n_inner;
+  if (w->dims[1] == n_inner) {
+    w_slice->dims[0] = n;
+  } else {
+    w_slice->dims[1] = n;
+  }
+}
+
+/* Returns the first index of the second shard of `n` rows or columns, or 0 if `n` is too small to split. */
+static uint64_t split_point(uint64_t n) {
+  uint64_t split = SDKL_EXT_ALIGN_UP((n + 1) / 2, SDKL_SHARD_ALIGN);
+  return split < n ? split : 0;
+}
+
+int sdkl_ext_mm_tensor_sharded(
+  sdkl_tensor_t* restrict result_tensor,
+  const sdkl_tensor_t* restrict left_tensor,
+  const sdkl_tensor_t* restrict right_tensor,
+  sdkl_shard_mode_e mode,
+  sdkl_shard_info_t* info
+) {
+  sdkl_tensor_t r[2], x[2], w[2];
+  sdkl_fence_t fence;
+  uint64_t split = 0;
+  int rows_ok, cols_ok;
+  int ret, ret1;
+
+  if (mode >= SDKL_SHARD_INVALID) {
+    return AEE_EBADPARM;
+  }
+  ret = sdkl_mm_tensor_validate(result_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  rows_ok = sdkl_ext_can_slice_rows(result_tensor) && sdkl_ext_can_slice_rows(left_tensor);
+  cols_ok = sdkl_ext_can_slice_cols(result_tensor, right_tensor);
+
+  if (mode == SDKL_SHARD_AUTO) {
+    uint64_t n_row = result_tensor->dims[0];
+
+    if (rows_ok && n_row >= SDKL_SHARD_MIN_ROWS) {
+      mode = SDKL_SHARD_ROWS;
+    } else if (cols_ok && split_point(result_tensor->dims[1]) != 0) {
+      mode = SDKL_SHARD_COLS;
+    } else if (rows_ok && split_point(n_row) != 0) {
+      mode = SDKL_SHARD_ROWS;
+    } else {
+      mode = SDKL_SHARD_NONE;
+    }
+  }
+  if ((mode == SDKL_SHARD_ROWS && !rows_ok) || (mode == SDKL_SHARD_COLS && !cols_ok)) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  if (mode == SDKL_SHARD_ROWS) {
+    split = split_point(result_tensor->dims[0]);
+    if (split != 0) {
+      uint64_t n_row = result_tensor->dims[0];
+
+      sdkl_ext_slice_rows(&r[0], result_tensor, 0, split);
+      sdkl_ext_slice_rows(&r[1], result_tensor, split, n_row - split);
+      sdkl_ext_slice_rows(&x[0], left_tensor, 0, split);
+      sdkl_ext_slice_rows(&x[1], left_tensor, split, n_row - split);
+      w[0] = *right_tensor;
+      w[1] = *right_tensor;
+    }
+  } else if (mode == SDKL_SHARD_COLS) {
+    split = split_point(result_tensor->dims[1]);
+    if (split != 0) {
+      uint64_t n_col   = result_tensor->dims[1];
+      uint64_t n_inner = left_tensor->dims[1];
+
+      sdkl_ext_slice_cols(&r[0], &w[0], result_tensor, right_tensor, n_inner, 0, split);
+      sdkl_ext_slice_cols(&r[1], &w[1], result_tensor, right_tensor, n_inner, split, n_col - split);
+      x[0] = *left_tensor;
+      x[1] = *left_tensor;
+    }
+  }
+
+  if (info != NULL) {
+    info->mode  = split != 0 ? mode : SDKL_SHARD_NONE;
+    info->split = split;
+  }
+  if (split == 0) {
+    return sdkl_ext_mm_tensor(SDKL_PLATFORM_NPU0, result_tensor, left_tensor, right_tensor);
+  }
+
+  ret = sdkl_mm_tensor_async(SDKL_PLATFORM_NPU1, &r[1], &x[1], &w[1], &fence);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  ret  = sdkl_ext_mm_tensor(SDKL_PLATFORM_NPU0, &r[0], &x[0], &w[0]);
+  ret1 = sdkl_fence_wait(&fence);
+
+  return ret != AEE_SUCCESS ? ret : ret1;
+}
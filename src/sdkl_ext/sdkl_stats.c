@@ -0,0 +1,130 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdatomic.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Cumulative performance counters, one set per platform, updated with relaxed atomic additions. Times are kept in
+  nanoseconds and reported in microseconds.
+*/
+
+typedef struct {
+  atomic_uint_fast64_t n_matmuls;
+  atomic_uint_fast64_t n_macs;
+  atomic_uint_fast64_t bytes;
+  atomic_uint_fast64_t busy_ns;
+  atomic_uint_fast64_t wait_ns;
+  atomic_uint_fast64_t n_maps;
+  atomic_uint_fast64_t map_ns;
+} sdkl_stats_counters_t;
+
+#define SDKL_STATS_N_PLATFORMS (3U) // CPU, NPU0, NPU1
+
+static sdkl_stats_counters_t g_stats[SDKL_STATS_N_PLATFORMS];
+
+static sdkl_stats_counters_t* get_counters(int platform) {
+  switch (platform) {
+    case SDKL_PLATFORM_CPU:
+      return &g_stats[0];
+    case SDKL_PLATFORM_NPU0:
+      return &g_stats[1];
+    case SDKL_PLATFORM_NPU1:
+      return &g_stats[2];
+    default:
+      return NULL;
+  }
+}
+
+static void add(atomic_uint_fast64_t* counter, uint64_t value) {
+  atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+/* Returns the size in bytes of `n` elements of `dtype`, counting I4 as half a byte. */
+static uint64_t elements_bytes(sdkl_tensor_dtype_e dtype, uint64_t n) {
+  return dtype == SDKL_DTYPE_I4 ? (n + 1) / 2 : n * sdkl_ext_dtype_size(dtype);
+}
+
+void sdkl_ext_stats_add_mm(int platform, uint64_t n_matmuls, uint64_t n_macs, uint64_t bytes, uint64_t ns) {
+  sdkl_stats_counters_t* c = get_counters(platform);
+
+  if (c == NULL) {
+    return;
+  }
+  add(&c->n_matmuls, n_matmuls);
+  add(&c->n_macs, n_macs);
+  add(&c->bytes, bytes);
+  add(&c->busy_ns, ns);
+}
+
+void sdkl_ext_stats_add_tensor_mm(
+  int platform,
+  const sdkl_tensor_t* result_tensor,
+  const sdkl_tensor_t* left_tensor,
+  const sdkl_tensor_t* right_tensor,
+  uint64_t ns
+) {
+  uint64_t m = result_tensor->dims[0];
+  uint64_t n = result_tensor->dims[1];
+  uint64_t k = left_tensor->dims[1];
+  uint64_t bytes;
+
+  bytes = elements_bytes(left_tensor->data_dtype, m * k) + elements_bytes(right_tensor->data_dtype, n * k) +
+          elements_bytes(result_tensor->data_dtype, m * n);
+  sdkl_ext_stats_add_mm(platform, 1, m * n * k, bytes, ns);
+}
+
+void sdkl_ext_stats_add_wait(int platform, uint64_t ns) {
+  sdkl_stats_counters_t* c = get_counters(platform);
+
+  if (c != NULL) {
+    add(&c->wait_ns, ns);
+  }
+}
+
+void sdkl_ext_stats_add_map(int domain, uint64_t ns) {
+  sdkl_stats_counters_t* c = get_counters(domain);
+
+  if (c != NULL) {
+    add(&c->n_maps, 1);
+    add(&c->map_ns, ns);
+  }
+}
+
+int sdkl_get_stats(sdkl_tensor_platform_e platform, sdkl_stats_t* stats) {
+  sdkl_stats_counters_t* c = get_counters(platform);
+
+  if (c == NULL || stats == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  stats->n_matmuls = atomic_load_explicit(&c->n_matmuls, memory_order_relaxed);
+  stats->n_macs    = atomic_load_explicit(&c->n_macs, memory_order_relaxed);
+  stats->bytes     = atomic_load_explicit(&c->bytes, memory_order_relaxed);
+  stats->busy_us   = atomic_load_explicit(&c->busy_ns, memory_order_relaxed) / 1000;
+  stats->wait_us   = atomic_load_explicit(&c->wait_ns, memory_order_relaxed) / 1000;
+  stats->n_maps    = atomic_load_explicit(&c->n_maps, memory_order_relaxed);
+  stats->map_us    = atomic_load_explicit(&c->map_ns, memory_order_relaxed) / 1000;
+
+  return AEE_SUCCESS;
+}
+
+int sdkl_reset_stats(sdkl_tensor_platform_e platform) {
+  sdkl_stats_counters_t* c = get_counters(platform);
+
+  if (c == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  atomic_store(&c->n_matmuls, 0);
+  atomic_store(&c->n_macs, 0);
+  atomic_store(&c->bytes, 0);
+  atomic_store(&c->busy_ns, 0);
+  atomic_store(&c->wait_ns, 0);
+  atomic_store(&c->n_maps, 0);
+  atomic_store(&c->map_ns, 0);
+
+  return AEE_SUCCESS;
+}
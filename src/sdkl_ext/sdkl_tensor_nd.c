@@ -0,0 +1,187 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdlib.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  N-dimensional tensors are expanded into one 2D descriptor per batch item, sharing the data buffers. The CPU engine
+  runs all items in one pool dispatch; NPU platforms use the batched path.
+*/
+
+#define SDKL_ND_MAX_BATCH_DIMS (SDKL_EXT_TENSOR_MAX_NUM_OF_DIMS - 2)
+
+int sdkl_ext_tensor_nd_validate(const sdkl_tensor_nd_t* tensor) {
+  sdkl_tensor_t last;
+  uint64_t last_offset = 0;
+  int ret;
+
+  if (tensor == NULL) {
+    return AEE_EBADCLASS;
+  }
+  if (tensor->matrix.ndims != 2 || tensor->n_batch_dims > SDKL_ND_MAX_BATCH_DIMS) {
+    return AEE_EBADPARM;
+  }
+  for (uint8_t d = 0; d < tensor->n_batch_dims; d++) {
+    if (tensor->batch_dims[d] == 0) {
+      return AEE_EBADPARM;
+    }
+    last_offset += (tensor->batch_dims[d] - 1) * tensor->batch_strides[d];
+  }
+
+  ret = sdkl_tensor_validate(&tensor->matrix);
+  if (ret != AEE_SUCCESS || last_offset == 0) {
+    return ret;
+  }
+
+  last = tensor->matrix;
+  last.data_offset += last_offset;
+  return sdkl_tensor_validate(&last);
+}
+
+/* Strides of `t` along the batch dimensions of the result `r`, 0 where `t` broadcasts. */
+static int broadcast_strides(const sdkl_tensor_nd_t* t, const sdkl_tensor_nd_t* r, uint64_t* strides) {
+  size_t shift;
+
+  if (t->n_batch_dims > r->n_batch_dims) {
+    return AEE_EBADPARM;
+  }
+
+  shift = r->n_batch_dims - t->n_batch_dims;
+  for (size_t d = 0; d < r->n_batch_dims; d++) {
+    strides[d] = 0;
+    if (d < shift) {
+      continue;
+    }
+    if (t->batch_dims[d - shift] == r->batch_dims[d]) {
+      strides[d] = t->batch_strides[d - shift];
+    } else if (t->batch_dims[d - shift] != 1) {
+      return AEE_EBADPARM;
+    }
+  }
+
+  return AEE_SUCCESS;
+}
+
+int sdkl_ext_mm_tensor_nd_validate(
+  const sdkl_tensor_nd_t* restrict result_tensor,
+  const sdkl_tensor_nd_t* restrict left_tensor,
+  const sdkl_tensor_nd_t* restrict right_tensor
+) {
+  uint64_t strides[SDKL_ND_MAX_BATCH_DIMS];
+  int ret;
+
+  if (result_tensor == NULL || left_tensor == NULL || right_tensor == NULL) {
+    return AEE_EBADCLASS;
+  }
+
+  if ((ret = sdkl_ext_tensor_nd_validate(result_tensor)) != AEE_SUCCESS ||
+      (ret = sdkl_ext_tensor_nd_validate(left_tensor)) != AEE_SUCCESS ||
+      (ret = sdkl_ext_tensor_nd_validate(right_tensor)) != AEE_SUCCESS) {
+    return ret;
+  }
+  if (broadcast_strides(left_tensor, result_tensor, strides) != AEE_SUCCESS ||
+      broadcast_strides(right_tensor, result_tensor, strides) != AEE_SUCCESS) {
+    return AEE_EBADPARM;
+  }
+
+  // Result items must not alias each other
+  for (uint8_t d = 0; d < result_tensor->n_batch_dims; d++) {
+    if (result_tensor->batch_dims[d] > 1 && result_tensor->batch_strides[d] == 0) {
+      return AEE_EBADPARM;
+    }
+  }
+
+  return sdkl_mm_tensor_validate(&result_tensor->matrix, &left_tensor->matrix, &right_tensor->matrix);
+}
+
+/* Fills the 2D descriptors of all `n_items` batch items, in row-major order of the result batch index. */
+static void expand_items(
+  const sdkl_tensor_nd_t* r,
+  const sdkl_tensor_nd_t* x,
+  const sdkl_tensor_nd_t* w,
+  size_t n_items,
+  sdkl_tensor_t* results,
+  sdkl_tensor_t* lefts,
+  sdkl_tensor_t* rights
+) {
+  uint64_t x_strides[SDKL_ND_MAX_BATCH_DIMS];
+  uint64_t w_strides[SDKL_ND_MAX_BATCH_DIMS];
+  uint64_t idx[SDKL_ND_MAX_BATCH_DIMS] = {0};
+  uint64_t r_off = 0, x_off = 0, w_off = 0;
+
+  broadcast_strides(x, r, x_strides);
+  broadcast_strides(w, r, w_strides);
+
+  for (size_t b = 0; b < n_items; b++) {
+    results[b] = r->matrix;
+    lefts[b]   = x->matrix;
+    rights[b]  = w->matrix;
+    results[b].data_offset += r_off;
+    lefts[b].data_offset += x_off;
+    rights[b].data_offset += w_off;
+
+    // Advance the batch index, innermost dimension first
+    for (int d = (int)r->n_batch_dims - 1; d >= 0; d--) {
+      if (++idx[d] < r->batch_dims[d]) {
+        r_off += r->batch_strides[d];
+        x_off += x_strides[d];
+        w_off += w_strides[d];
+        break;
+      }
+      r_off -= (idx[d] - 1) * r->batch_strides[d];
+      x_off -= (idx[d] - 1) * x_strides[d];
+      w_off -= (idx[d] - 1) * w_strides[d];
+      idx[d] = 0;
+    }
+  }
+}
+
+int sdkl_ext_mm_tensor_nd(
+  sdkl_tensor_platform_e platform,
+  sdkl_tensor_nd_t* restrict result_tensor,
+  const sdkl_tensor_nd_t* restrict left_tensor,
+  const sdkl_tensor_nd_t* restrict right_tensor
+) {
+  sdkl_tensor_t* items;
+  size_t n_items = 1;
+  int ret;
+
+  ret = sdkl_ext_mm_tensor_nd_validate(result_tensor, left_tensor, right_tensor);
+  if (ret != AEE_SUCCESS) {
+    return ret;
+  }
+
+  for (uint8_t d = 0; d < result_tensor->n_batch_dims; d++) {
+    n_items *= result_tensor->batch_dims[d];
+  }
+  if (n_items == 1) {
+    return sdkl_ext_mm_tensor(platform, &result_tensor->matrix, &left_tensor->matrix, &right_tensor->matrix);
+  }
+
+  items = malloc(3 * n_items * sizeof(*items));
+  if (items == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  expand_items(result_tensor, left_tensor, right_tensor, n_items, items, items + n_items, items + 2 * n_items);
+
+  if (platform == SDKL_PLATFORM_CPU) {
+    sdkl_cpu_gemm_args_t* args = malloc(n_items * sizeof(*args));
+
+    ret = args != NULL ? AEE_SUCCESS : AEE_ENOMEMORY;
+    for (size_t b = 0; b < n_items && ret == AEE_SUCCESS; b++) {
+      ret = sdkl_cpu_gemm_args_from_tensors(&args[b], &items[b], &items[n_items + b], &items[2 * n_items + b]);
+    }
+    if (ret == AEE_SUCCESS) {
+      ret = sdkl_cpu_gemm_batch(args, n_items);
+    }
+    free(args);
+  } else {
+    ret = sdkl_mm_tensor_batched(platform, n_items, items, items + n_items, items + 2 * n_items, NULL, NULL);
+  }
+
+  free(items);
+  return ret;
+}
@@ -0,0 +1,206 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "sdkl_ext_internal.h"
+
+/*
+  Span recorder.
+
+  Writers claim a slot of the ring buffer with one atomic increment of the head and publish the span through the
+  slot's sequence number, which is cleared while the span is written and set to the span index + 1 after. A reader
+  accepts a slot only if it holds the expected index before and after copying it, so overwritten and half-written
+  spans are skipped instead of blocking the writers.
+*/
+
+#define SDKL_TRACE_MAX_EVENTS (1U << 24)
+
+typedef struct {
+  atomic_uint_fast64_t seq;
+  const char* name;
+  const char* category;
+  uint64_t ts_ns;
+  uint64_t dur_ns;
+  uint32_t tid;
+} sdkl_trace_slot_t;
+
+typedef struct {
+  const char* name;
+  const char* category;
+  uint64_t ts_ns;
+  uint64_t dur_ns;
+  uint32_t tid;
+} sdkl_trace_event_t;
+
+atomic_int sdkl_ext_trace_enabled;
+
+static struct {
+  sdkl_trace_slot_t* slots;
+  uint64_t mask;
+  atomic_uint_fast64_t head;
+} g_trace;
+
+static __thread uint32_t t_tid;
+
+static uint32_t thread_id(void) {
+  if (t_tid == 0) {
+    t_tid = (uint32_t)syscall(SYS_gettid);
+  }
+  return t_tid;
+}
+
+int sdkl_trace_start(uint32_t n_events) {
+  uint64_t capacity = 1;
+
+  if (n_events == 0 || n_events > SDKL_TRACE_MAX_EVENTS) {
+    return AEE_EBADPARM;
+  }
+  while (capacity < n_events) {
+    capacity <<= 1;
+  }
+
+  atomic_store(&sdkl_ext_trace_enabled, 0);
+  free(g_trace.slots);
+  g_trace.slots = calloc(capacity, sizeof(sdkl_trace_slot_t));
+  if (g_trace.slots == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  g_trace.mask = capacity - 1;
+  atomic_store(&g_trace.head, 0);
+  atomic_store(&sdkl_ext_trace_enabled, 1);
+
+  return AEE_SUCCESS;
+}
+
+int sdkl_trace_stop(void) {
+  atomic_store(&sdkl_ext_trace_enabled, 0);
+  return AEE_SUCCESS;
+}
+
+int sdkl_trace_finalize(void) {
+  atomic_store(&sdkl_ext_trace_enabled, 0);
+  free(g_trace.slots);
+  g_trace.slots = NULL;
+  atomic_store(&g_trace.head, 0);
+  return AEE_SUCCESS;
+}
+
+uint64_t sdkl_trace_begin(void) {
+  return atomic_load_explicit(&sdkl_ext_trace_enabled, memory_order_relaxed) ? sdkl_ext_time_ns() : 0;
+}
+
+void sdkl_trace_end(const char* name, const char* category, uint64_t begin) {
+  uint64_t end = sdkl_ext_time_ns();
+  uint64_t idx;
+  sdkl_trace_slot_t* slot;
+
+  // Spans still open when tracing stops are dropped
+  if (begin == 0 || !atomic_load_explicit(&sdkl_ext_trace_enabled, memory_order_relaxed)) {
+    return;
+  }
+
+  idx  = atomic_fetch_add_explicit(&g_trace.head, 1, memory_order_relaxed);
+  slot = &g_trace.slots[idx & g_trace.mask];
+
+  atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  slot->name     = name;
+  slot->category = category;
+  slot->ts_ns    = begin;
+  slot->dur_ns   = end - begin;
+  slot->tid      = thread_id();
+  atomic_store_explicit(&slot->seq, idx + 1, memory_order_release);
+}
+
+/* Copies the span of index `idx` into `event`. Returns 0 if the slot holds another span or is being written. */
+static int read_slot(uint64_t idx, sdkl_trace_event_t* event) {
+  sdkl_trace_slot_t* slot = &g_trace.slots[idx & g_trace.mask];
+
+  if (atomic_load_explicit(&slot->seq, memory_order_acquire) != idx + 1) {
+    return 0;
+  }
+  event->name     = slot->name;
+  event->category = slot->category;
+  event->ts_ns    = slot->ts_ns;
+  event->dur_ns   = slot->dur_ns;
+  event->tid      = slot->tid;
+  atomic_thread_fence(memory_order_acquire);
+
+  return atomic_load_explicit(&slot->seq, memory_order_relaxed) == idx + 1;
+}
+
+/* Writes `s` as a JSON string. */
+static void write_string(FILE* f, const char* s) {
+  fputc('"', f);
+  for (; *s != '\0'; s++) {
+    if (*s == '"' || *s == '\\') {
+      fputc('\\', f);
+      fputc(*s, f);
+    } else if ((unsigned char)*s < 0x20) {
+      fprintf(f, "\\u%04x", (unsigned)*s);
+    } else {
+      fputc(*s, f);
+    }
+  }
+  fputc('"', f);
+}
+
+int sdkl_trace_dump(const char* path) {
+  uint64_t head, first;
+  int pid = (int)getpid();
+  int ret;
+  FILE* f;
+
+  if (path == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  f = fopen(path, "w");
+  if (f == NULL) {
+    return AEE_EFAILED;
+  }
+
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"sdkl\"}}", pid);
+
+  if (g_trace.slots != NULL) {
+    head  = atomic_load(&g_trace.head);
+    first = head > g_trace.mask + 1 ? head - (g_trace.mask + 1) : 0;
+
+    for (uint64_t idx = first; idx < head; idx++) {
+      sdkl_trace_event_t event;
+
+      if (!read_slot(idx, &event)) {
+        continue;
+      }
+      fprintf(f, ",\n{\"name\":");
+      write_string(f, event.name);
+      fprintf(f, ",\"cat\":");
+      write_string(f, event.category);
+      fprintf(
+        f,
+        ",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"pid\":%d,\"tid\":%u}",
+        (unsigned long long)(event.ts_ns / 1000),
+        (unsigned)(event.ts_ns % 1000),
+        (unsigned long long)(event.dur_ns / 1000),
+        (unsigned)(event.dur_ns % 1000),
+        pid,
+        event.tid
+      );
+    }
+  }
+
+  fprintf(f, "\n]}\n");
+  ret = ferror(f) ? AEE_EFAILED : AEE_SUCCESS;
+  if (fclose(f) != 0) {
+    ret = AEE_EFAILED;
+  }
+
+  return ret;
+}
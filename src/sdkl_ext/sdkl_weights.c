@@ -0,0 +1,288 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+
+#include "AEEStdErr.h"
+#include "remote.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkl_ext_internal.h"
+
+#define SDKL_WEIGHTS_I4_TILE (32U)
+
+struct sdkl_weights {
+  int domain;
+  sdkl_tensor_dtype_e dtype;
+  size_t n_col;
+  size_t n_inner;
+  size_t n_col_pad;   // padded dimensions of the WH buffer (equal to n_col / n_inner except for i4)
+  size_t n_inner_pad;
+  void* data;         // sdkl_npu_alloc() buffer in WH layout
+  size_t size;        // bytes
+  int fd;             // file descriptor of the persistent mapping, -1 if not mapped
+};
+
+/*
+  The i4 layout function expects dimensions that are multiples of 32. Pads the row-major source with zeros
+  when needed; returns `W` itself otherwise.
+*/
+static const int8_t* pad_i4_weights(
+  const int8_t* W,
+  size_t n_col,
+  size_t n_inner,
+  size_t n_col_pad,
+  size_t n_inner_pad
+) {
+  int8_t* padded;
+
+  if (n_col == n_col_pad && n_inner == n_inner_pad) {
+    return W;
+  }
+
+  padded = calloc(n_col_pad * n_inner_pad, sizeof(*padded));
+  if (padded == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < n_col; i++) {
+    memcpy(padded + i * n_inner_pad, W + i * n_inner, n_inner);
+  }
+
+  return padded;
+}
+
+int sdkl_weights_create(
+  int domain,
+  sdkl_tensor_dtype_e dtype,
+  size_t n_col,
+  size_t n_inner,
+  const void* W,
+  sdkl_weights_t** weights
+) {
+  sdkl_weights_t* w;
+  uint64_t span;
+  int ret;
+
+  if (W == NULL || weights == NULL || n_col == 0 || n_inner == 0) {
+    return AEE_EBADPARM;
+  }
+  if (n_col > INT_MAX || n_inner > INT_MAX) {
+    return AEE_EBADPARM;
+  }
+  if (dtype != SDKL_DTYPE_FP16 && dtype != SDKL_DTYPE_I8 && dtype != SDKL_DTYPE_I4) {
+    return AEE_EUNSUPPORTED;
+  }
+
+  w = calloc(1, sizeof(*w));
+  if (w == NULL) {
+    return AEE_ENOMEMORY;
+  }
+  w->domain      = domain;
+  w->dtype       = dtype;
+  w->n_col       = n_col;
+  w->n_inner     = n_inner;
+  w->n_col_pad   = n_col;
+  w->n_inner_pad = n_inner;
+  w->fd          = -1;
+
+  if (dtype == SDKL_DTYPE_I4) {
+    w->n_col_pad   = SDKL_EXT_ALIGN_UP(n_col, SDKL_WEIGHTS_I4_TILE);
+    w->n_inner_pad = SDKL_EXT_ALIGN_UP(n_inner, SDKL_WEIGHTS_I4_TILE);
+    w->size        = (w->n_col_pad * w->n_inner_pad + 1) / 2;
+  } else {
+    w->size = n_col * n_inner * sdkl_ext_dtype_size(dtype);
+  }
+
+  ret = sdkl_npu_alloc(w->size, &w->data);
+  if (ret != AEE_SUCCESS) {
+    free(w);
+    return ret;
+  }
+
+  span = sdkl_ext_trace_begin();
+  switch (dtype) {
+    case SDKL_DTYPE_FP16:
+      memcpy(w->data, W, w->size);
+      ret = sdkl_cpu_rm_to_wh_f16_inplace(n_col, n_inner, (_Float16*)w->data);
+      break;
+    case SDKL_DTYPE_I8:
+      memcpy(w->data, W, w->size);
+      ret = sdkl_cpu_rm_to_wh_i8_inplace(n_col, n_inner, (int8_t*)w->data);
+      break;
+    default: {
+      const int8_t* src = pad_i4_weights((const int8_t*)W, n_col, n_inner, w->n_col_pad, w->n_inner_pad);
+      if (src == NULL) {
+        ret = AEE_ENOMEMORY;
+        break;
+      }
+      // The layout function takes the padded dimensions as (n_inner, n_col), see sdkl_npu_mm_u8i4_i32 example
+      ret = sdkl_cpu_rm_to_wh_i4((uint8_t*)w->data, (int8_t*)src, w->n_inner_pad, w->n_col_pad);
+      if (src != W) {
+        free((void*)src);
+      }
+      break;
+    }
+  }
+
+  sdkl_ext_trace_end("weights_layout", "layout", span);
+
+  if (ret != AEE_SUCCESS) {
+    sdkl_npu_free(w->data);
+    free(w);
+    return ret;
+  }
+
+  // A failed mapping is not fatal: FastRPC then maps the buffer on each call
+  if (sdkl_ext_npu_map(domain, w->data, w->size, &w->fd) != AEE_SUCCESS) {
+    w->fd = -1;
+  }
+
+  *weights = w;
+  return AEE_SUCCESS;
+}
+
+int sdkl_weights_destroy(sdkl_weights_t* weights) {
+  int ret;
+
+  if (weights == NULL) {
+    return AEE_SUCCESS;
+  }
+
+  if (weights->fd >= 0) {
+    sdkl_ext_npu_unmap(weights->domain, weights->fd, weights->data, weights->size);
+  }
+  ret = sdkl_npu_free(weights->data);
+  free(weights);
+
+  return ret;
+}
+
+int sdkl_weights_get_info(const sdkl_weights_t* weights, sdkl_weights_info_t* info) {
+  if (weights == NULL || info == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  info->domain         = weights->domain;
+  info->dtype          = weights->dtype;
+  info->n_col          = weights->n_col;
+  info->n_inner        = weights->n_inner;
+  info->resident_bytes = weights->size;
+  info->is_mapped      = weights->fd >= 0;
+
+  return AEE_SUCCESS;
+}
+
+int sdkl_weights_to_tensor(const sdkl_weights_t* weights, sdkl_tensor_t* tensor) {
+  if (weights == NULL || tensor == NULL) {
+    return AEE_EBADPARM;
+  }
+
+  memset(tensor, 0, sizeof(*tensor));
+  tensor->data          = weights->data;
+  tensor->ndims         = 2;
+  tensor->dims[0]       = weights->n_inner_pad;
+  tensor->dims[1]       = weights->n_col_pad;
+  tensor->num_elements  = weights->n_inner_pad * weights->n_col_pad;
+  tensor->is_continuous = 1;
+  tensor->quantization  = SDKL_QUANT_NONE;
+  tensor->layout        = SDKL_LAYOUT_2D_ROW_MAJOR_WEIGHTS_HMX;
+  tensor->data_dtype    = weights->dtype;
+  tensor->data_offset   = 0;
+  tensor->strides[0]    = weights->n_col_pad;
+  tensor->strides[1]    = 1;
+
+  return AEE_SUCCESS;
+}
+
+/*
+  Counts a matrix multiplication of `n_row` activation rows by the weights in the counters of their domain.
+  `x_size` and `a_size` are the element sizes of the activations and results.
+*/
+static void add_stats(const sdkl_weights_t* weights, size_t n_row, size_t x_size, size_t a_size, uint64_t ns) {
+  uint64_t bytes = weights->size + (uint64_t)n_row * (weights->n_inner * x_size + weights->n_col * a_size);
+
+  sdkl_ext_stats_add_mm(weights->domain, 1, (uint64_t)n_row * weights->n_col * weights->n_inner, bytes, ns);
+}
+
+int sdkl_weights_mm_f32f16_f32(const sdkl_weights_t* weights, size_t n_row, float* A, const float* X) {
+  uint64_t span, start;
+  int ret;
+
+  if (weights == NULL || weights->dtype != SDKL_DTYPE_FP16 || n_row > INT_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = sdkl_npu_mm_f32f16_f32(
+    weights->domain, (int)n_row, (int)weights->n_col, (int)weights->n_inner, A, X, (const _Float16*)weights->data
+  );
+  if (ret == AEE_SUCCESS) {
+    add_stats(weights, n_row, sizeof(float), sizeof(float), sdkl_ext_time_ns() - start);
+  }
+  sdkl_ext_trace_end("sdkl_npu_mm_f32f16_f32", "npu", span);
+
+  return ret;
+}
+
+int sdkl_weights_mm_f16f16_f16(const sdkl_weights_t* weights, size_t n_row, _Float16* A, const _Float16* X) {
+  uint64_t span, start;
+  int ret;
+
+  if (weights == NULL || weights->dtype != SDKL_DTYPE_FP16 || n_row > INT_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = sdkl_npu_mm_f16f16_f16(
+    weights->domain, (int)n_row, (int)weights->n_col, (int)weights->n_inner, A, X, (const _Float16*)weights->data
+  );
+  if (ret == AEE_SUCCESS) {
+    add_stats(weights, n_row, sizeof(_Float16), sizeof(_Float16), sdkl_ext_time_ns() - start);
+  }
+  sdkl_ext_trace_end("sdkl_npu_mm_f16f16_f16", "npu", span);
+
+  return ret;
+}
+
+int sdkl_weights_mm_u8i8_i32(const sdkl_weights_t* weights, size_t n_row, int32_t* A, const uint8_t* X) {
+  uint64_t span, start;
+  int ret;
+
+  if (weights == NULL || weights->dtype != SDKL_DTYPE_I8 || n_row > INT_MAX) {
+    return AEE_EBADPARM;
+  }
+
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = sdkl_npu_mm_u8i8_i32(
+    weights->domain, (int)n_row, (int)weights->n_col, (int)weights->n_inner, A, X, (const int8_t*)weights->data
+  );
+  if (ret == AEE_SUCCESS) {
+    add_stats(weights, n_row, sizeof(uint8_t), sizeof(int32_t), sdkl_ext_time_ns() - start);
+  }
+  sdkl_ext_trace_end("sdkl_npu_mm_u8i8_i32", "npu", span);
+
+  return ret;
+}
+
+int sdkl_weights_mm_u8i4_i32(const sdkl_weights_t* weights, size_t n_row, int32_t* A, const uint8_t* X) {
+  uint64_t span, start;
+  int ret;
+
+  if (weights == NULL || weights->dtype != SDKL_DTYPE_I4) {
+    return AEE_EBADPARM;
+  }
+
+  span  = sdkl_ext_trace_begin();
+  start = sdkl_ext_time_ns();
+  ret   = sdkl_npu_mm_u8i4_i32(
+    weights->domain, n_row, weights->n_col, weights->n_inner, A, X, (const uint8_t*)weights->data
+  );
+  if (ret == AEE_SUCCESS) {
+    add_stats(weights, n_row, sizeof(uint8_t), sizeof(int32_t), sdkl_ext_time_ns() - start);
+  }
+  sdkl_ext_trace_end("sdkl_npu_mm_u8i4_i32", "npu", span);
+
+  return ret;
+}